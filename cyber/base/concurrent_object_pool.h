@@ -67,6 +67,7 @@ class CCObjectPool : public std::enable_shared_from_this<CCObjectPool<T>> {
   std::atomic<Head> free_head_;
   Node *node_arena_ = nullptr;
   uint32_t capacity_ = 0;
+  bool constructed_ = false;
 };
 
 template <typename T>
@@ -83,10 +84,15 @@ void CCObjectPool<T>::ConstructAll(Args &&... args) {
   FOR_EACH(i, 0, capacity_) {
     new (node_arena_ + i) T(std::forward<Args>(args)...);
   }
+  constructed_ = true;
 }
 
 template <typename T>
 CCObjectPool<T>::~CCObjectPool() {
+  // every object is back in the pool, the deleters keep it alive until then
+  if (constructed_) {
+    FOR_EACH(i, 0, capacity_) { node_arena_[i].object.~T(); }
+  }
   std::free(node_arena_);
 }
 
@@ -147,6 +153,11 @@ void CCObjectPool<T>::ReleaseObject(T *object) {
                                              std::memory_order_acquire));
 }
 
+template <typename T>
+uint32_t CCObjectPool<T>::size() const {
+  return capacity_;
+}
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
@@ -18,11 +18,14 @@
 #define CYBER_BLOCKER_BLOCKER_H_
 
 #include <stddef.h>
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -48,16 +51,30 @@ class BlockerBase {
 };
 
 struct BlockerAttr {
-  BlockerAttr() : capacity(10), channel_name("") {}
+  BlockerAttr() : capacity(10), channel_name(""), lock_free(false) {}
   explicit BlockerAttr(const std::string& channel)
-      : capacity(10), channel_name(channel) {}
-  BlockerAttr(size_t cap, const std::string& channel)
-      : capacity(cap), channel_name(channel) {}
+      : capacity(10), channel_name(channel), lock_free(false) {}
+  BlockerAttr(size_t cap, const std::string& channel, bool lock_free = false)
+      : capacity(cap), channel_name(channel), lock_free(lock_free) {}
   BlockerAttr(const BlockerAttr& attr)
-      : capacity(attr.capacity), channel_name(attr.channel_name) {}
+      : capacity(attr.capacity),
+        channel_name(attr.channel_name),
+        lock_free(attr.lock_free) {}
 
   size_t capacity;
   std::string channel_name;
+  /**
+   * @brief Keep published messages in a fixed ring instead of a list.
+   *
+   * Publish then neither locks nor allocates, and Observe only remembers the
+   * newest position; older observed messages are read from the ring when
+   * they are asked for, so the ones overwritten since Observe are skipped.
+   * Readers never wait, a publisher only waits for the readers still copying
+   * the oldest message, the one it overwrites.
+   * The ring is sized by capacity at construction, set_capacity can shrink
+   * the window but not grow it beyond that.
+   */
+  bool lock_free;
 };
 
 template <typename T>
@@ -100,23 +117,59 @@ class Blocker : public BlockerBase {
   const std::string& channel_name() const override;
 
  private:
+  // position of a slot that a publisher is writing to
+  static constexpr uint64_t kWriting = ~0ULL;
+
+  // the slot protocol of CacheBuffer<std::shared_ptr<T>>, with writers
+  // claiming a slot by setting its position to kWriting
+  struct Slot {
+    std::atomic<uint64_t> pos = {0};
+    mutable std::atomic<uint32_t> readers = {0};
+    MessagePtr msg;
+  };
+
   void Reset() override;
   void Enqueue(const MessagePtr& msg);
   void Notify(const MessagePtr& msg);
 
+  void RingEnqueue(const MessagePtr& msg);
+  void RingWrite(Slot* slot, uint64_t pos, const MessagePtr& msg);
+  void RingClearPublished();
+  bool RingGet(uint64_t pos, MessagePtr* msg) const;
+  uint64_t RingLatest(MessagePtr* msg) const;
+  void RingListObserved() const;
+
   BlockerAttr attr_;
-  MessageQueue observed_msg_queue_;
+  mutable MessageQueue observed_msg_queue_;
   MessageQueue published_msg_queue_;
   mutable std::mutex msg_mutex_;
 
+  // lock_free mode, positions start at 1 and only grow
+  std::vector<Slot> ring_;
+  std::atomic<uint64_t> window_ = {0};
+  alignas(64) std::atomic<uint64_t> claimed_pos_ = {0};
+  alignas(64) std::atomic<uint64_t> published_pos_ = {0};
+  std::atomic<uint64_t> cleared_pos_ = {0};
+  // observed range and the latest observed message, guarded by msg_mutex_
+  uint64_t observed_begin_ = 1;
+  uint64_t observed_end_ = 0;
+  MessagePtr observed_latest_;
+  mutable bool observed_listed_ = true;
+
   CallbackMap published_callbacks_;
+  std::atomic<bool> has_callbacks_ = {false};
   mutable std::mutex cb_mutex_;
 
   MessageType dummy_msg_;
 };
 
 template <typename T>
-Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {}
+Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {
+  if (attr_.lock_free) {
+    ring_ = std::vector<Slot>(std::max<size_t>(attr_.capacity, 1));
+    window_.store(attr_.capacity);
+  }
+}
 
 template <typename T>
 Blocker<T>::~Blocker() {
@@ -138,14 +191,12 @@ void Blocker<T>::Publish(const MessagePtr& msg) {
 
 template <typename T>
 void Blocker<T>::Reset() {
-  {
-    std::lock_guard<std::mutex> lock(msg_mutex_);
-    observed_msg_queue_.clear();
-    published_msg_queue_.clear();
-  }
+  ClearObserved();
+  ClearPublished();
   {
     std::lock_guard<std::mutex> lock(cb_mutex_);
     published_callbacks_.clear();
+    has_callbacks_.store(false, std::memory_order_release);
   }
 }
 
@@ -153,10 +204,18 @@ template <typename T>
 void Blocker<T>::ClearObserved() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
   observed_msg_queue_.clear();
+  observed_begin_ = 1;
+  observed_end_ = 0;
+  observed_latest_.reset();
+  observed_listed_ = true;
 }
 
 template <typename T>
 void Blocker<T>::ClearPublished() {
+  if (attr_.lock_free) {
+    RingClearPublished();
+    return;
+  }
   std::lock_guard<std::mutex> lock(msg_mutex_);
   published_msg_queue_.clear();
 }
@@ -164,17 +223,34 @@ void Blocker<T>::ClearPublished() {
 template <typename T>
 void Blocker<T>::Observe() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  observed_msg_queue_ = published_msg_queue_;
+  if (!attr_.lock_free) {
+    observed_msg_queue_ = published_msg_queue_;
+    return;
+  }
+  observed_msg_queue_.clear();
+  observed_listed_ = false;
+  observed_end_ = RingLatest(&observed_latest_);
+  auto window = window_.load(std::memory_order_relaxed);
+  auto first = observed_end_ >= window ? observed_end_ - window + 1 : 1;
+  observed_begin_ =
+      std::max(first, cleared_pos_.load(std::memory_order_acquire) + 1);
 }
 
 template <typename T>
 bool Blocker<T>::IsObservedEmpty() const {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (attr_.lock_free) {
+    return observed_latest_ == nullptr;
+  }
   return observed_msg_queue_.empty();
 }
 
 template <typename T>
 bool Blocker<T>::IsPublishedEmpty() const {
+  if (attr_.lock_free) {
+    return published_pos_.load(std::memory_order_acquire) <=
+           cleared_pos_.load(std::memory_order_acquire);
+  }
   std::lock_guard<std::mutex> lock(msg_mutex_);
   return published_msg_queue_.empty();
 }
@@ -187,18 +263,25 @@ bool Blocker<T>::Subscribe(const std::string& callback_id,
     return false;
   }
   published_callbacks_[callback_id] = callback;
+  has_callbacks_.store(true, std::memory_order_release);
   return true;
 }
 
 template <typename T>
 bool Blocker<T>::Unsubscribe(const std::string& callback_id) {
   std::lock_guard<std::mutex> lock(cb_mutex_);
-  return published_callbacks_.erase(callback_id) != 0;
+  bool erased = published_callbacks_.erase(callback_id) != 0;
+  has_callbacks_.store(!published_callbacks_.empty(),
+                       std::memory_order_release);
+  return erased;
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (attr_.lock_free) {
+    return observed_latest_ == nullptr ? dummy_msg_ : *observed_latest_;
+  }
   if (observed_msg_queue_.empty()) {
     return dummy_msg_;
   }
@@ -208,6 +291,9 @@ auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
 template <typename T>
 auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (attr_.lock_free) {
+    return observed_latest_;
+  }
   if (observed_msg_queue_.empty()) {
     return nullptr;
   }
@@ -217,6 +303,19 @@ auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
 template <typename T>
 auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (attr_.lock_free) {
+    if (observed_listed_) {
+      return observed_msg_queue_.empty() ? observed_latest_
+                                         : observed_msg_queue_.back();
+    }
+    MessagePtr msg;
+    for (auto pos = observed_begin_; pos < observed_end_; ++pos) {
+      if (RingGet(pos, &msg)) {
+        return msg;
+      }
+    }
+    return observed_latest_;
+  }
   if (observed_msg_queue_.empty()) {
     return nullptr;
   }
@@ -225,6 +324,11 @@ auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
 
 template <typename T>
 auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
+  if (attr_.lock_free) {
+    MessagePtr msg;
+    RingLatest(&msg);
+    return msg;
+  }
   std::lock_guard<std::mutex> lock(msg_mutex_);
   if (published_msg_queue_.empty()) {
     return nullptr;
@@ -234,11 +338,17 @@ auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
 
 template <typename T>
 auto Blocker<T>::ObservedBegin() const -> Iterator {
+  if (attr_.lock_free) {
+    RingListObserved();
+  }
   return observed_msg_queue_.begin();
 }
 
 template <typename T>
 auto Blocker<T>::ObservedEnd() const -> Iterator {
+  if (attr_.lock_free) {
+    RingListObserved();
+  }
   return observed_msg_queue_.end();
 }
 
@@ -250,6 +360,11 @@ size_t Blocker<T>::capacity() const {
 template <typename T>
 void Blocker<T>::set_capacity(size_t capacity) {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (attr_.lock_free) {
+    attr_.capacity = std::min(capacity, ring_.size());
+    window_.store(attr_.capacity, std::memory_order_relaxed);
+    return;
+  }
   attr_.capacity = capacity;
   while (published_msg_queue_.size() > capacity) {
     published_msg_queue_.pop_back();
@@ -263,6 +378,10 @@ const std::string& Blocker<T>::channel_name() const {
 
 template <typename T>
 void Blocker<T>::Enqueue(const MessagePtr& msg) {
+  if (attr_.lock_free) {
+    RingEnqueue(msg);
+    return;
+  }
   if (attr_.capacity == 0) {
     return;
   }
@@ -275,12 +394,127 @@ void Blocker<T>::Enqueue(const MessagePtr& msg) {
 
 template <typename T>
 void Blocker<T>::Notify(const MessagePtr& msg) {
+  if (!has_callbacks_.load(std::memory_order_acquire)) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(cb_mutex_);
   for (const auto& item : published_callbacks_) {
     item.second(msg);
   }
 }
 
+template <typename T>
+void Blocker<T>::RingEnqueue(const MessagePtr& msg) {
+  if (window_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  auto pos = claimed_pos_.fetch_add(1, std::memory_order_relaxed) + 1;
+  auto& slot = ring_[pos % ring_.size()];
+  // two publishers only meet on a slot when one of them stalled for a whole
+  // ring, the older message is dropped then
+  auto cur = slot.pos.load(std::memory_order_relaxed);
+  for (;;) {
+    if (cur == kWriting) {
+      cur = slot.pos.load(std::memory_order_relaxed);
+      continue;
+    }
+    if (cur > pos) {
+      return;
+    }
+    if (slot.pos.compare_exchange_weak(cur, kWriting)) {
+      break;
+    }
+  }
+  RingWrite(&slot, pos, msg);
+
+  auto published = published_pos_.load(std::memory_order_relaxed);
+  while (published < pos &&
+         !published_pos_.compare_exchange_weak(published, pos,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+  }
+}
+
+// Fills a slot claimed by setting its position to kWriting. Readers that
+// come later see the claim and leave, those that came earlier are waited for.
+template <typename T>
+void Blocker<T>::RingWrite(Slot* slot, uint64_t pos, const MessagePtr& msg) {
+  while (slot->readers.load() != 0) {
+    std::this_thread::yield();
+  }
+  slot->msg = msg;
+  slot->pos.store(pos, std::memory_order_release);
+}
+
+template <typename T>
+void Blocker<T>::RingClearPublished() {
+  auto cleared = published_pos_.load(std::memory_order_acquire);
+  cleared_pos_.store(cleared, std::memory_order_release);
+  // drop the references the ring still holds, slots that are being written
+  // or already hold newer messages are left alone
+  for (auto& slot : ring_) {
+    auto cur = slot.pos.load(std::memory_order_relaxed);
+    if (cur == kWriting || cur > cleared ||
+        !slot.pos.compare_exchange_strong(cur, kWriting)) {
+      continue;
+    }
+    RingWrite(&slot, 0, MessagePtr());
+  }
+}
+
+template <typename T>
+bool Blocker<T>::RingGet(uint64_t pos, MessagePtr* msg) const {
+  auto& slot = ring_[pos % ring_.size()];
+  if (slot.pos.load(std::memory_order_acquire) != pos) {
+    return false;
+  }
+  // announce the copy before checking the slot again, so that either the
+  // writer sees the reader or the reader sees the slot claimed
+  slot.readers.fetch_add(1);
+  bool found = slot.pos.load() == pos;
+  if (found) {
+    *msg = slot.msg;
+  }
+  slot.readers.fetch_sub(1, std::memory_order_release);
+  return found;
+}
+
+// Returns the position of the latest message, 0 if there is none.
+template <typename T>
+uint64_t Blocker<T>::RingLatest(MessagePtr* msg) const {
+  for (;;) {
+    auto pos = published_pos_.load(std::memory_order_acquire);
+    if (pos <= cleared_pos_.load(std::memory_order_acquire)) {
+      msg->reset();
+      return 0;
+    }
+    if (RingGet(pos, msg)) {
+      return pos;
+    }
+  }
+}
+
+// Builds the observed list from the ring on the first iteration after
+// Observe, latest first like the list mode.
+template <typename T>
+void Blocker<T>::RingListObserved() const {
+  std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (observed_listed_) {
+    return;
+  }
+  observed_listed_ = true;
+  if (observed_latest_ == nullptr) {
+    return;
+  }
+  observed_msg_queue_.push_back(observed_latest_);
+  MessagePtr msg;
+  for (auto pos = observed_end_ - 1; pos >= observed_begin_; --pos) {
+    if (RingGet(pos, &msg)) {
+      observed_msg_queue_.push_back(msg);
+    }
+  }
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
@@ -17,7 +17,11 @@
 #include "cyber/blocker/blocker.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "cyber/proto/unit_test.pb.h"
 
@@ -125,6 +129,131 @@ TEST(BlockerTest, subscribe) {
   EXPECT_FALSE(res);
 }
 
+TEST(BlockerTest, lock_free) {
+  BlockerAttr attr(3, "channel", true);
+  Blocker<UnitTest> blocker(attr);
+  EXPECT_EQ(blocker.capacity(), 3);
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+  EXPECT_EQ(blocker.GetLatestPublishedPtr(), nullptr);
+
+  for (int i = 0; i < 5; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_case_name("publish_" + std::to_string(i));
+    blocker.Publish(msg);
+  }
+  EXPECT_FALSE(blocker.IsPublishedEmpty());
+  EXPECT_EQ(blocker.GetLatestPublishedPtr()->case_name(), "publish_4");
+
+  EXPECT_TRUE(blocker.IsObservedEmpty());
+  blocker.Observe();
+  EXPECT_FALSE(blocker.IsObservedEmpty());
+  EXPECT_EQ(blocker.GetLatestObserved().case_name(), "publish_4");
+  EXPECT_EQ(blocker.GetLatestObservedPtr()->case_name(), "publish_4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_2");
+
+  // the observed messages stay until the ring overwrites them
+  auto msg = std::make_shared<UnitTest>();
+  msg->set_case_name("publish_5");
+  blocker.Publish(msg);
+  EXPECT_EQ(blocker.GetLatestObservedPtr()->case_name(), "publish_4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_3");
+  std::vector<std::string> names;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    names.emplace_back((*it)->case_name());
+  }
+  EXPECT_EQ(names, std::vector<std::string>({"publish_4", "publish_3"}));
+
+  blocker.set_capacity(1);
+  EXPECT_EQ(blocker.capacity(), 1);
+  blocker.Observe();
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_5");
+  blocker.set_capacity(10);
+  EXPECT_EQ(blocker.capacity(), 3);
+
+  blocker.ClearPublished();
+  blocker.ClearObserved();
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+  EXPECT_TRUE(blocker.IsObservedEmpty());
+  EXPECT_EQ(blocker.GetLatestPublishedPtr(), nullptr);
+  blocker.Observe();
+  EXPECT_TRUE(blocker.IsObservedEmpty());
+  EXPECT_EQ(blocker.GetOldestObservedPtr(), nullptr);
+}
+
+TEST(BlockerTest, lock_free_concurrent_publish) {
+  BlockerAttr attr(8, "channel", true);
+  Blocker<UnitTest> blocker(attr);
+  const int kThreadNum = 4;
+  const int kMsgNum = 10000;
+
+  std::vector<std::thread> publishers;
+  for (int i = 0; i < kThreadNum; ++i) {
+    publishers.emplace_back([&blocker, i]() {
+      for (int j = 0; j < kMsgNum; ++j) {
+        auto msg = std::make_shared<UnitTest>();
+        msg->set_class_name(std::to_string(i));
+        msg->set_case_name(std::to_string(j));
+        blocker.Publish(msg);
+      }
+    });
+  }
+  for (int i = 0; i < 1000; ++i) {
+    blocker.Observe();
+    for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd();
+         ++it) {
+      EXPECT_NE(*it, nullptr);
+    }
+  }
+  for (auto& publisher : publishers) {
+    publisher.join();
+  }
+
+  blocker.Observe();
+  size_t observed = 0;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    ++observed;
+  }
+  EXPECT_EQ(observed, 8);
+}
+
+TEST(BlockerTest, lock_free_read_while_overwritten) {
+  // a single slot, every publish overwrites the message being read
+  BlockerAttr attr(1, "channel", true);
+  Blocker<UnitTest> blocker(attr);
+  const int kMsgNum = 20000;
+
+  std::atomic<bool> done = {false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; ++i) {
+    readers.emplace_back([&blocker, &done]() {
+      int last = -1;
+      while (!done.load()) {
+        auto msg = blocker.GetLatestPublishedPtr();
+        if (msg == nullptr) {
+          continue;
+        }
+        // the copy is whole and never goes back to an older message
+        int index = std::stoi(msg->case_name());
+        EXPECT_EQ(msg->class_name(), std::to_string(index * 2));
+        EXPECT_GE(index, last);
+        last = index;
+      }
+    });
+  }
+  for (int i = 0; i < kMsgNum; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_class_name(std::to_string(i * 2));
+    msg->set_case_name(std::to_string(i));
+    blocker.Publish(msg);
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(blocker.GetLatestPublishedPtr()->case_name(),
+            std::to_string(kMsgNum - 1));
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
@@ -29,12 +29,14 @@
 #include "cyber/component/component_base.h"
 #include "cyber/croutine/routine_factory.h"
 #include "cyber/data/data_visitor.h"
+#include "cyber/event/latency_tracer.h"
 #include "cyber/scheduler/scheduler.h"
 
 namespace apollo {
 namespace cyber {
 
 using apollo::cyber::common::GlobalData;
+using apollo::cyber::event::LatencyTracer;
 using apollo::cyber::proto::RoleAttributes;
 
 /**
@@ -180,6 +182,8 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(0).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(0).message_pool_size();
 
   std::weak_ptr<Component<M0>> self =
       std::dynamic_pointer_cast<Component<M0>>(shared_from_this());
@@ -210,11 +214,18 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
     return true;
   }
 
+  auto trace = LatencyTracer::Instance()->GetReader(readers_[0]->ChannelId(),
+                                                    node_->Name());
+  auto traced_func = [func, trace](const std::shared_ptr<M0>& msg) {
+    event::CallbackTrace callback_trace(trace, msg);
+    func(msg);
+  };
+
   data::VisitorConfig conf = {readers_[0]->ChannelId(),
                               readers_[0]->PendingQueueSize()};
   auto dv = std::make_shared<data::DataVisitor<M0>>(conf);
   croutine::RoutineFactory factory =
-      croutine::CreateRoutineFactory<M0>(func, dv);
+      croutine::CreateRoutineFactory<M0>(traced_func, dv);
   auto sched = scheduler::Instance();
   return sched->CreateTask(factory, node_->Name());
 }
@@ -250,12 +261,16 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(1).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(1).message_pool_size();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(0).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(0).message_pool_size();
 
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
@@ -295,10 +310,13 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   auto sched = scheduler::Instance();
   std::weak_ptr<Component<M0, M1>> self =
       std::dynamic_pointer_cast<Component<M0, M1>>(shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg0,
-                     const std::shared_ptr<M1>& msg1) {
+  auto trace = LatencyTracer::Instance()->GetReader(readers_[0]->ChannelId(),
+                                                    node_->Name());
+  auto func = [self, trace](const std::shared_ptr<M0>& msg0,
+                            const std::shared_ptr<M1>& msg1) {
     auto ptr = self.lock();
     if (ptr) {
+      event::CallbackTrace callback_trace(trace, msg0);
       ptr->Process(msg0, msg1);
     } else {
       AERROR << "Component object has been destroyed.";
@@ -347,18 +365,24 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(1).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(1).message_pool_size();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(2).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(2).qos_profile());
   reader_cfg.pending_queue_size = config.readers(2).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(2).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(2).message_pool_size();
 
   auto reader2 = node_->template CreateReader<M2>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(0).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(0).message_pool_size();
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
     reader0 = node_->template CreateReader<M0>(reader_cfg);
@@ -404,11 +428,14 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   std::weak_ptr<Component<M0, M1, M2, NullType>> self =
       std::dynamic_pointer_cast<Component<M0, M1, M2, NullType>>(
           shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg0,
-                     const std::shared_ptr<M1>& msg1,
-                     const std::shared_ptr<M2>& msg2) {
+  auto trace = LatencyTracer::Instance()->GetReader(readers_[0]->ChannelId(),
+                                                    node_->Name());
+  auto func = [self, trace](const std::shared_ptr<M0>& msg0,
+                            const std::shared_ptr<M1>& msg1,
+                            const std::shared_ptr<M2>& msg2) {
     auto ptr = self.lock();
     if (ptr) {
+      event::CallbackTrace callback_trace(trace, msg0);
       ptr->Process(msg0, msg1, msg2);
     } else {
       AERROR << "Component object has been destroyed.";
@@ -457,24 +484,32 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(1).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(1).message_pool_size();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(2).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(2).qos_profile());
   reader_cfg.pending_queue_size = config.readers(2).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(2).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(2).message_pool_size();
 
   auto reader2 = node_->template CreateReader<M2>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(3).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(3).qos_profile());
   reader_cfg.pending_queue_size = config.readers(3).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(3).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(3).message_pool_size();
 
   auto reader3 = node_->template CreateReader<M3>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.lock_free_blocker = config.readers(0).lock_free_blocker();
+  reader_cfg.message_pool_size = config.readers(0).message_pool_size();
 
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
@@ -527,16 +562,20 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   auto sched = scheduler::Instance();
   std::weak_ptr<Component<M0, M1, M2, M3>> self =
       std::dynamic_pointer_cast<Component<M0, M1, M2, M3>>(shared_from_this());
-  auto func =
-      [self](const std::shared_ptr<M0>& msg0, const std::shared_ptr<M1>& msg1,
-             const std::shared_ptr<M2>& msg2, const std::shared_ptr<M3>& msg3) {
-        auto ptr = self.lock();
-        if (ptr) {
-          ptr->Process(msg0, msg1, msg2, msg3);
-        } else {
-          AERROR << "Component object has been destroyed." << std::endl;
-        }
-      };
+  auto trace = LatencyTracer::Instance()->GetReader(readers_[0]->ChannelId(),
+                                                    node_->Name());
+  auto func = [self, trace](const std::shared_ptr<M0>& msg0,
+                            const std::shared_ptr<M1>& msg1,
+                            const std::shared_ptr<M2>& msg2,
+                            const std::shared_ptr<M3>& msg3) {
+    auto ptr = self.lock();
+    if (ptr) {
+      event::CallbackTrace callback_trace(trace, msg0);
+      ptr->Process(msg0, msg1, msg2, msg3);
+    } else {
+      AERROR << "Component object has been destroyed." << std::endl;
+    }
+  };
 
   std::vector<data::VisitorConfig> config_list;
   for (auto& reader : readers_) {
@@ -19,7 +19,6 @@
 #include <algorithm>
 #include <utility>
 
-#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
@@ -32,7 +31,6 @@ thread_local CRoutine *CRoutine::current_routine_ = nullptr;
 thread_local char *CRoutine::main_stack_ = nullptr;
 
 namespace {
-std::shared_ptr<base::CCObjectPool<RoutineContext>> context_pool = nullptr;
 std::once_flag pool_init_flag;
 
 void CRoutineEntry(void *arg) {
@@ -42,7 +40,11 @@ void CRoutineEntry(void *arg) {
 }
 }  // namespace
 
-CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
+CRoutine::CRoutine(const std::function<void()> &func)
+    : CRoutine(func, STACK_SIZE) {}
+
+CRoutine::CRoutine(const std::function<void()> &func, size_t stack_size)
+    : func_(func) {
   std::call_once(pool_init_flag, [&]() {
     uint32_t routine_num = common::GlobalData::Instance()->ComponentNums();
     auto &global_conf = common::GlobalData::Instance()->Config();
@@ -51,22 +53,30 @@ CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
       routine_num =
           std::max(routine_num, global_conf.scheduler_conf().routine_num());
     }
-    context_pool.reset(new base::CCObjectPool<RoutineContext>(routine_num));
+    // keep at most that many released stacks around for reuse
+    StackPool::Instance()->set_max_cached_num(routine_num);
   });
 
-  context_ = context_pool->GetObject();
-  if (context_ == nullptr) {
-    AWARN << "Maximum routine context number exceeded! Please check "
-             "[routine_num] in config file.";
-    context_.reset(new RoutineContext());
-  }
+  context_.reset(new RoutineContext(stack_size > 0 ? stack_size : STACK_SIZE));
 
   MakeContext(CRoutineEntry, this, context_.get());
   state_ = RoutineState::READY;
   updated_.test_and_set(std::memory_order_release);
 }
 
-CRoutine::~CRoutine() { context_ = nullptr; }
+CRoutine::~CRoutine() {
+  if (context_ != nullptr) {
+    ADEBUG << "croutine " << name_ << " stack peak usage "
+           << StackPeakUsage() << " of " << stack_size() << " bytes.";
+  }
+  context_ = nullptr;
+}
+
+size_t CRoutine::stack_size() const { return context_->stack.size; }
+
+size_t CRoutine::StackPeakUsage() const {
+  return StackPool::PeakUsage(context_->stack);
+}
 
 RoutineState CRoutine::Resume() {
   if (cyber_unlikely(force_stop_)) {
@@ -40,6 +40,7 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 class CRoutine {
  public:
   explicit CRoutine(const RoutineFunc &func);
+  CRoutine(const RoutineFunc &func, size_t stack_size);
   virtual ~CRoutine();
 
   // static interfaces
@@ -64,6 +65,10 @@ class CRoutine {
   RoutineContext *GetContext();
   char **GetStack();
 
+  size_t stack_size() const;
+  // Deepest the croutine's stack has grown so far, in bytes.
+  size_t StackPeakUsage() const;
+
   void Run();
   void Stop();
   void Wake();
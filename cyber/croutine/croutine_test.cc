@@ -16,8 +16,10 @@
 #include "cyber/croutine/croutine.h"
 
 #include <gtest/gtest.h>
+#include <signal.h>
 
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/detail/stack_pool.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
 
@@ -27,6 +29,22 @@ namespace croutine {
 
 void function() { CRoutine::Yield(RoutineState::IO_WAIT); }
 
+void DeepFunction() {
+  volatile char buf[64 * 1024];
+  for (size_t i = 0; i < sizeof(buf); i += 512) {
+    buf[i] = static_cast<char>(i);
+  }
+  CRoutine::Yield(RoutineState::IO_WAIT);
+}
+
+int Recurse(int depth) {
+  volatile char buf[1024];
+  buf[0] = static_cast<char>(depth);
+  return Recurse(depth + 1) + buf[0];
+}
+
+void OverflowFunction() { Recurse(0); }
+
 TEST(Croutine, croutinetest) {
   apollo::cyber::Init("croutine_test");
   std::shared_ptr<CRoutine> cr = std::make_shared<CRoutine>(function);
@@ -49,6 +67,38 @@ TEST(Croutine, croutinetest) {
   EXPECT_EQ(cr->Resume(), RoutineState::FINISHED);
 }
 
+TEST(Croutine, stack) {
+  auto pool = StackPool::Instance();
+  std::shared_ptr<CRoutine> cr =
+      std::make_shared<CRoutine>(DeepFunction, 256 * 1024);
+  EXPECT_EQ(256 * 1024, cr->stack_size());
+  EXPECT_LT(cr->StackPeakUsage(), 16 * 1024);
+  cr->Resume();
+  EXPECT_EQ(cr->state(), RoutineState::IO_WAIT);
+  EXPECT_GE(cr->StackPeakUsage(), 64 * 1024);
+  EXPECT_LT(cr->StackPeakUsage(), 128 * 1024);
+
+  // a released stack is reused, without the pages of its last owner
+  auto cached_num = pool->cached_num();
+  cr->Stop();
+  cr->Resume();
+  cr = nullptr;
+  EXPECT_EQ(cached_num + 1, pool->cached_num());
+  cr = std::make_shared<CRoutine>(function, 256 * 1024);
+  EXPECT_EQ(cached_num, pool->cached_num());
+  EXPECT_LT(cr->StackPeakUsage(), 16 * 1024);
+}
+
+TEST(CroutineDeathTest, stack_overflow) {
+  auto overflow = []() {
+    std::shared_ptr<CRoutine> cr =
+        std::make_shared<CRoutine>(OverflowFunction, 32 * 1024);
+    cr->Resume();
+  };
+  // the guard page stops the croutine before it runs into other memory
+  EXPECT_EXIT(overflow(), ::testing::KilledBySignal(SIGSEGV), "");
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
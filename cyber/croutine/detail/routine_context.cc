@@ -20,6 +20,19 @@ namespace apollo {
 namespace cyber {
 namespace croutine {
 
+RoutineContext::RoutineContext(size_t stack_size) {
+  if (StackPool::Instance()->Acquire(stack_size, &stack)) {
+    return;
+  }
+  AWARN << "Failed to map a croutine stack of " << stack_size
+        << " bytes, fall back to an unguarded heap stack.";
+  stack.size = StackPool::AlignSize(stack_size);
+  stack.base = new char[stack.size];
+  stack.mapped = false;
+}
+
+RoutineContext::~RoutineContext() { StackPool::Instance()->Release(stack); }
+
 //  The stack layout looks as follows:
 //
 //              +------------------+
@@ -38,12 +51,13 @@ namespace croutine {
 // ctx->sp  =>  |        RBP       |
 //              +------------------+
 void MakeContext(const func &f1, const void *arg, RoutineContext *ctx) {
-  ctx->sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *) - REGISTERS_SIZE;
+  char *top = ctx->stack.base + ctx->stack.size;
+  ctx->sp = top - 2 * sizeof(void *) - REGISTERS_SIZE;
   std::memset(ctx->sp, 0, REGISTERS_SIZE);
 #ifdef __aarch64__
-  char *sp = ctx->stack + STACK_SIZE - sizeof(void *);
+  char *sp = top - sizeof(void *);
 #else
-  char *sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *);
+  char *sp = top - 2 * sizeof(void *);
 #endif
   *reinterpret_cast<void **>(sp) = reinterpret_cast<void *>(f1);
   sp -= sizeof(void *);
@@ -22,6 +22,7 @@
 #include <iostream>
 
 #include "cyber/common/log.h"
+#include "cyber/croutine/detail/stack_pool.h"
 
 extern "C" {
 extern void ctx_swap(void**, void**) asm("ctx_swap");
@@ -40,7 +41,15 @@ constexpr size_t REGISTERS_SIZE = 56;
 
 typedef void (*func)(void*);
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  // the stack is taken from StackPool and only committed as it is used, or
+  // from the heap if StackPool cannot map one
+  explicit RoutineContext(size_t stack_size = STACK_SIZE);
+  ~RoutineContext();
+
+  RoutineContext(const RoutineContext&) = delete;
+  RoutineContext& operator=(const RoutineContext&) = delete;
+
+  RoutineStack stack;
   char* sp = nullptr;
 #if defined __aarch64__
 } __attribute__((aligned(16)));
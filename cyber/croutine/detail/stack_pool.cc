@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+StackPool::StackPool() {}
+
+StackPool::~StackPool() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  for (auto& item : free_stacks_) {
+    for (auto& stack : item.second) {
+      munmap(stack.base - PageSize(), stack.size + PageSize());
+    }
+  }
+  free_stacks_.clear();
+}
+
+size_t StackPool::PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+size_t StackPool::AlignSize(size_t size) {
+  auto page_size = PageSize();
+  size = std::max(size, kMinStackSize);
+  return (size + page_size - 1) / page_size * page_size;
+}
+
+bool StackPool::Acquire(size_t size, RoutineStack* stack) {
+  size = AlignSize(size);
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    auto iter = free_stacks_.find(size);
+    if (iter != free_stacks_.end() && !iter->second.empty()) {
+      *stack = iter->second.back();
+      iter->second.pop_back();
+      --cached_num_;
+      return true;
+    }
+  }
+
+  auto page_size = PageSize();
+  void* addr = mmap(nullptr, size + page_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "mmap croutine stack of " << size << " bytes failed: "
+           << strerror(errno);
+    return false;
+  }
+  if (mprotect(addr, page_size, PROT_NONE) != 0) {
+    AWARN << "protect croutine stack guard page failed: " << strerror(errno);
+  }
+#ifdef MADV_NOHUGEPAGE
+  // with transparent huge pages on, the first touch would commit a whole
+  // 2MB page instead of the few 4KB pages a croutine uses
+  if (madvise(addr, size + page_size, MADV_NOHUGEPAGE) != 0) {
+    ADEBUG << "madvise croutine stack no huge page failed: "
+           << strerror(errno);
+  }
+#endif
+
+  stack->base = static_cast<char*>(addr) + page_size;
+  stack->size = size;
+  stack->mapped = true;
+  return true;
+}
+
+void StackPool::Release(const RoutineStack& stack) {
+  if (stack.base == nullptr) {
+    return;
+  }
+  if (!stack.mapped) {
+    delete[] stack.base;
+    return;
+  }
+
+  // give the pages back, a reused stack starts out uncommitted again
+  madvise(stack.base, stack.size, MADV_DONTNEED);
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (cached_num_ < max_cached_num_) {
+      free_stacks_[stack.size].emplace_back(stack);
+      ++cached_num_;
+      return;
+    }
+  }
+  munmap(stack.base - PageSize(), stack.size + PageSize());
+}
+
+size_t StackPool::PeakUsage(const RoutineStack& stack) {
+  if (stack.base == nullptr) {
+    return 0;
+  }
+  if (!stack.mapped) {
+    return stack.size;
+  }
+
+  // Stacks grow down and are only committed when touched, so the lowest
+  // resident page marks the deepest the croutine has been.
+  auto page_size = PageSize();
+  auto page_num = stack.size / page_size;
+  std::vector<unsigned char> resident(page_num);
+  if (mincore(stack.base, stack.size, resident.data()) != 0) {
+    AWARN << "mincore failed: " << strerror(errno);
+    return stack.size;
+  }
+  for (size_t i = 0; i < page_num; ++i) {
+    if (resident[i] & 1) {
+      return (page_num - i) * page_size;
+    }
+  }
+  return 0;
+}
+
+size_t StackPool::cached_num() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  return cached_num_;
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
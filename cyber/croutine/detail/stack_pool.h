@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+#define CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+struct RoutineStack {
+  // usable range is [base, base + size), the guard page sits below base
+  char* base = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+};
+
+/**
+ * @brief Hands out croutine stacks backed by anonymous mappings. Pages are
+ * only committed by the kernel once the croutine touches them, and a
+ * PROT_NONE guard page below each stack turns an overflow into a SIGSEGV
+ * instead of silently corrupting the neighbouring memory.
+ *
+ * Released stacks have their pages dropped and are kept for reuse by the
+ * next croutine asking for the same size.
+ */
+class StackPool {
+ public:
+  ~StackPool();
+
+  static size_t PageSize();
+  // Rounds size up to whole pages, with a lower bound of kMinStackSize.
+  static size_t AlignSize(size_t size);
+
+  // false if no stack could be mapped
+  bool Acquire(size_t size, RoutineStack* stack);
+  // also frees stacks that are not mapped, allocated with new char[]
+  void Release(const RoutineStack& stack);
+
+  // Bytes between the top of the stack and its deepest committed page.
+  static size_t PeakUsage(const RoutineStack& stack);
+
+  void set_max_cached_num(uint32_t num) { max_cached_num_ = num; }
+  size_t cached_num();
+
+  static constexpr size_t kMinStackSize = 16 * 1024;
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<RoutineStack>> free_stacks_;
+  size_t cached_num_ = 0;
+  uint32_t max_cached_num_ = 64;
+
+  DECLARE_SINGLETON(StackPool)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_POOL_H_
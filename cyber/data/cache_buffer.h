@@ -17,8 +17,11 @@
 #ifndef CYBER_DATA_CACHE_BUFFER_H_
 #define CYBER_DATA_CACHE_BUFFER_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace apollo {
@@ -93,6 +96,115 @@ class CacheBuffer {
   FusionCallback fusion_callback_;
 };
 
+/**
+ * @brief Ring of messages filled by the dispatcher and read by any number of
+ * readers without taking a lock.
+ *
+ * Positions start at 1 and only grow, a reader keeps its own cursor and asks
+ * for a position with Get(). Each slot records the position it holds, so a
+ * reader that raced with the writer overwriting its slot gets false back and
+ * moves on to a newer position. Each slot also counts the readers copying
+ * its message, and the writer waits for them to finish before it replaces
+ * the message, which is the oldest one and rarely read. Readers never wait.
+ * Producers filling the same buffer are serialized by a lock the readers
+ * never touch.
+ */
+template <typename T>
+class CacheBuffer<std::shared_ptr<T>> {
+ public:
+  using value_type = std::shared_ptr<T>;
+  using size_type = std::size_t;
+  using FusionCallback = std::function<void(const value_type&)>;
+
+  explicit CacheBuffer(uint64_t size)
+      : capacity_(size + 1), slots_(capacity_) {}
+
+  // Oldest position that is still readable.
+  uint64_t Head() const {
+    auto tail = Tail();
+    return tail < capacity_ ? 1 : tail - capacity_ + 2;
+  }
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  uint64_t Size() const { return Tail() - Head() + 1; }
+
+  bool Empty() const { return Tail() == 0; }
+  bool Full() const { return Tail() >= capacity_ - 1; }
+  uint64_t Capacity() const { return capacity_; }
+
+  void SetFusionCallback(const FusionCallback& callback) {
+    std::lock_guard<std::mutex> lg(fill_mutex_);
+    fusion_callback_ = callback;
+  }
+
+  void Fill(const value_type& value) {
+    std::lock_guard<std::mutex> lg(fill_mutex_);
+    if (fusion_callback_) {
+      fusion_callback_(value);
+      return;
+    }
+
+    auto pos = tail_.load(std::memory_order_relaxed) + 1;
+    auto& slot = slots_[pos % capacity_];
+    // invalidate the slot first, readers that come later see it and leave,
+    // those that came earlier are waited for
+    slot.pos.store(0);
+    while (slot.readers.load() != 0) {
+      std::this_thread::yield();
+    }
+    slot.value = value;
+    slot.pos.store(pos, std::memory_order_release);
+    tail_.store(pos, std::memory_order_release);
+  }
+
+  // Returns false if pos is not filled yet or has already been overwritten.
+  bool Get(uint64_t pos, value_type* value) const {
+    if (pos == 0) {
+      return false;
+    }
+    auto& slot = slots_[pos % capacity_];
+    if (slot.pos.load(std::memory_order_acquire) != pos) {
+      return false;
+    }
+    // announce the copy before checking the slot again, so that either the
+    // writer sees the reader or the reader sees the slot invalidated
+    slot.readers.fetch_add(1);
+    bool found = slot.pos.load() == pos;
+    if (found) {
+      *value = slot.value;
+    }
+    slot.readers.fetch_sub(1, std::memory_order_release);
+    return found;
+  }
+
+  bool Latest(value_type* value) const {
+    for (;;) {
+      auto tail = Tail();
+      if (tail == 0) {
+        return false;
+      }
+      if (Get(tail, value)) {
+        return true;
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> pos = {0};
+    mutable std::atomic<uint32_t> readers = {0};
+    value_type value;
+  };
+
+  CacheBuffer(const CacheBuffer& other) = delete;
+  CacheBuffer& operator=(const CacheBuffer& other) = delete;
+
+  uint64_t capacity_ = 0;
+  std::vector<Slot> slots_;
+  alignas(64) std::atomic<uint64_t> tail_ = {0};
+  std::mutex fill_mutex_;
+  FusionCallback fusion_callback_;
+};
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
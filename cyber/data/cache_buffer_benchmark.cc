@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <memory>
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/data/cache_buffer.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+// Thread 0 publishes, every other thread reads the latest message, which is
+// what the dispatcher and the readers of a busy channel do. Run with 1, 8 and
+// 32 readers.
+constexpr uint64_t kBufferSize = 10;
+
+// Wrapping the message keeps it out of the lock-free shared_ptr variant, so
+// this is the mutex protected ring every channel used before.
+struct LockedMessage {
+  std::shared_ptr<int> msg;
+};
+
+static void BM_LockedFanOut(benchmark::State& state) {
+  static CacheBuffer<LockedMessage> buffer(kBufferSize);
+  auto msg = std::make_shared<int>(0);
+  LockedMessage value;
+  while (state.KeepRunning()) {
+    std::lock_guard<std::mutex> lg(buffer.Mutex());
+    if (state.thread_index == 0) {
+      buffer.Fill(LockedMessage{msg});
+    } else if (!buffer.Empty()) {
+      value = buffer.Back();
+    }
+  }
+}
+BENCHMARK(BM_LockedFanOut)
+    ->Threads(2)
+    ->Threads(9)
+    ->Threads(33)
+    ->UseRealTime();
+
+static void BM_LockFreeFanOut(benchmark::State& state) {
+  static CacheBuffer<std::shared_ptr<int>> buffer(kBufferSize);
+  auto msg = std::make_shared<int>(0);
+  std::shared_ptr<int> value;
+  while (state.KeepRunning()) {
+    if (state.thread_index == 0) {
+      buffer.Fill(msg);
+    } else {
+      buffer.Latest(&value);
+    }
+  }
+}
+BENCHMARK(BM_LockFreeFanOut)
+    ->Threads(2)
+    ->Threads(9)
+    ->Threads(33)
+    ->UseRealTime();
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
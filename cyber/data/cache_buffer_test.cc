@@ -17,9 +17,12 @@
 #include "cyber/data/cache_buffer.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace apollo {
 namespace cyber {
@@ -52,6 +55,72 @@ TEST(CacheBufferTest, cache_buffer_test) {
   EXPECT_TRUE(buffer1.Full());
 }
 
+TEST(CacheBufferTest, shared_ptr_buffer_test) {
+  CacheBuffer<std::shared_ptr<int>> buffer(4);
+  std::shared_ptr<int> value;
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.Latest(&value));
+  EXPECT_FALSE(buffer.Get(1, &value));
+
+  for (int i = 1; i <= 4; i++) {
+    buffer.Fill(std::make_shared<int>(i));
+  }
+  EXPECT_TRUE(buffer.Full());
+  EXPECT_EQ(4, buffer.Size());
+  EXPECT_EQ(1, buffer.Head());
+  EXPECT_EQ(4, buffer.Tail());
+  EXPECT_TRUE(buffer.Get(1, &value));
+  EXPECT_EQ(1, *value);
+  EXPECT_FALSE(buffer.Get(5, &value));
+
+  buffer.Fill(std::make_shared<int>(5));
+  buffer.Fill(std::make_shared<int>(6));
+  EXPECT_EQ(4, buffer.Size());
+  EXPECT_EQ(3, buffer.Head());
+  // overwritten positions are not readable any more
+  EXPECT_FALSE(buffer.Get(1, &value));
+  EXPECT_TRUE(buffer.Get(3, &value));
+  EXPECT_EQ(3, *value);
+  EXPECT_TRUE(buffer.Latest(&value));
+  EXPECT_EQ(6, *value);
+}
+
+TEST(CacheBufferTest, shared_ptr_buffer_concurrent_test) {
+  const int kMsgNum = 100000;
+  const int kReaderNum = 4;
+  CacheBuffer<std::shared_ptr<int>> buffer(8);
+  std::atomic<bool> done = {false};
+  std::atomic<int> errors = {0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kReaderNum; i++) {
+    readers.emplace_back([&]() {
+      std::shared_ptr<int> value;
+      uint64_t pos = 1;
+      while (!done.load()) {
+        if (buffer.Get(pos, &value)) {
+          // a slot only ever hands out the message filled at its position
+          if (*value != static_cast<int>(pos)) {
+            errors++;
+          }
+          ++pos;
+        } else if (pos < buffer.Head()) {
+          pos = buffer.Tail();
+        }
+      }
+    });
+  }
+  for (int i = 1; i <= kMsgNum; i++) {
+    buffer.Fill(std::make_shared<int>(i));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, errors.load());
+  EXPECT_EQ(kMsgNum, buffer.Tail());
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -56,50 +56,61 @@ class ChannelBuffer {
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
+  for (;;) {
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index == tail + 1) {
+      return false;
+    } else if (*index > tail + 1) {
+      *index = tail;
+    } else if (*index < buffer_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail << "] ";
+      *index = tail;
+    }
+    // the writer may have overwritten the slot since tail was read, look
+    // again from the new tail in that case
+    if (buffer_->Get(*index, &m)) {
+      return true;
+    }
   }
-  m = buffer_->at(*index);
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  m = buffer_->Back();
-  return true;
+  return buffer_->Latest(&m);
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+  auto tail = buffer_->Tail();
+  if (tail == 0) {
     return false;
   }
 
-  auto num = std::min(buffer_->Size(), fetch_size);
+  auto num = std::min(tail - buffer_->Head() + 1, fetch_size);
   vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  std::shared_ptr<T> m;
+  uint64_t skipped = 0;
+  for (auto index = tail - num + 1; index <= tail; ++index) {
+    // messages overwritten while reading are skipped, they are the oldest
+    if (buffer_->Get(index, &m)) {
+      vec->emplace_back(m);
+    } else {
+      ++skipped;
+    }
+  }
+  if (skipped > 0) {
+    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+          << "overwritten while fetching, drop_message[" << skipped << "]";
   }
   return true;
 }
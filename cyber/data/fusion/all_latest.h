@@ -63,7 +63,6 @@ class AllLatest : public DataFusion<M0, M1, M2, M3> {
           }
 
           auto data = std::make_shared<FusionDataType>(m0, m1, m2, m3);
-          std::lock_guard<std::mutex> lg(buffer_fusion_.Buffer()->Mutex());
           buffer_fusion_.Buffer()->Fill(data);
         });
   }
@@ -113,7 +112,6 @@ class AllLatest<M0, M1, M2, NullType> : public DataFusion<M0, M1, M2> {
           }
 
           auto data = std::make_shared<FusionDataType>(m0, m1, m2);
-          std::lock_guard<std::mutex> lg(buffer_fusion_.Buffer()->Mutex());
           buffer_fusion_.Buffer()->Fill(data);
         });
   }
@@ -157,7 +155,6 @@ class AllLatest<M0, M1, NullType, NullType> : public DataFusion<M0, M1> {
           }
 
           auto data = std::make_shared<FusionDataType>(m0, m1);
-          std::lock_guard<std::mutex> lg(buffer_fusion_.Buffer()->Mutex());
           buffer_fusion_.Buffer()->Fill(data);
         });
   }
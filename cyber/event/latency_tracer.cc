@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/latency_tracer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+using common::GlobalData;
+
+namespace {
+
+uint64_t Elapsed(uint64_t from, uint64_t to) {
+  return to > from ? to - from : 0;
+}
+
+}  // namespace
+
+constexpr uint32_t LatencyHistogram::kBucketNum;
+constexpr uint32_t ChannelTrace::kRingSize;
+
+LatencyHistogram::LatencyHistogram() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::Record(uint64_t latency_ns) {
+  uint64_t latency_us = latency_ns / 1000;
+  uint32_t index = 0;
+  if (latency_us > 0) {
+    index = 64 - __builtin_clzll(latency_us);
+    if (index >= kBucketNum) {
+      index = kBucketNum - 1;
+    }
+  }
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+  auto max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (latency_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, latency_ns,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Snapshot(proto::LatencyHistogram* histogram) const {
+  histogram->Clear();
+  histogram->set_count(count_.load(std::memory_order_relaxed));
+  histogram->set_sum_ns(sum_ns_.load(std::memory_order_relaxed));
+  histogram->set_max_ns(max_ns_.load(std::memory_order_relaxed));
+  for (const auto& bucket : buckets_) {
+    histogram->add_bucket(bucket.load(std::memory_order_relaxed));
+  }
+}
+
+uint64_t LatencyHistogram::Percentile(const proto::LatencyHistogram& histogram,
+                                      double percentile) {
+  uint64_t total = 0;
+  for (auto count : histogram.bucket()) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(static_cast<double>(total) *
+                                         percentile / 100.0)));
+  uint64_t seen = 0;
+  for (int i = 0; i < histogram.bucket_size(); ++i) {
+    seen += histogram.bucket(i);
+    if (seen >= rank) {
+      return std::min<uint64_t>((1ULL << i) * 1000, histogram.max_ns());
+    }
+  }
+  return histogram.max_ns();
+}
+
+void ReaderTrace::Snapshot(proto::ReaderLatency* reader) const {
+  reader->set_reader_name(reader_name_);
+  queue_.Snapshot(reader->mutable_queue());
+  compute_.Snapshot(reader->mutable_compute());
+  end_to_end_.Snapshot(reader->mutable_end_to_end());
+}
+
+ChannelTrace::ChannelTrace(uint64_t channel_id) : channel_id_(channel_id) {}
+
+void ChannelTrace::OnDispatch(const MessageKey& key, uint64_t publish_time,
+                              uint64_t transmit_time, uint64_t dispatch_time) {
+  if (publish_time != 0) {
+    publish_.Record(Elapsed(publish_time, transmit_time));
+    transport_.Record(Elapsed(transmit_time, dispatch_time));
+  }
+
+  // clear the sender first and set it last, so that a concurrent Find never
+  // pairs the key of one message with the stamps of another
+  auto& slot = ring_[next_slot_.fetch_add(1, std::memory_order_relaxed) %
+                     kRingSize];
+  slot.sender.store(0);
+  slot.publish_time.store(publish_time);
+  slot.dispatch_time.store(dispatch_time);
+  slot.seq.store(key.seq);
+  slot.sender.store(key.sender);
+}
+
+bool ChannelTrace::Find(const MessageKey& key, uint64_t* publish_time,
+                        uint64_t* dispatch_time) const {
+  if (key.sender == 0) {
+    return false;
+  }
+  auto matches = [&key](const Slot& slot) {
+    return slot.sender.load() == key.sender && slot.seq.load() == key.seq;
+  };
+  // newest first, a message is looked up shortly after its dispatch
+  auto next = next_slot_.load(std::memory_order_relaxed);
+  for (uint32_t i = 1; i <= kRingSize; ++i) {
+    const auto& slot = ring_[(next - i) % kRingSize];
+    if (!matches(slot)) {
+      continue;
+    }
+    *publish_time = slot.publish_time.load();
+    *dispatch_time = slot.dispatch_time.load();
+    if (matches(slot)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ChannelTrace::Snapshot(proto::ChannelLatency* channel) const {
+  channel->set_channel_name(GlobalData::GetChannelById(channel_id_));
+  publish_.Snapshot(channel->mutable_publish());
+  transport_.Snapshot(channel->mutable_transport());
+  for (const auto& reader : readers_) {
+    reader->Snapshot(channel->add_reader());
+  }
+}
+
+LatencyTracer::LatencyTracer() {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_perf_conf()) {
+    enabled_ = global_conf.perf_conf().latency_trace();
+  }
+}
+
+uint64_t LatencyTracer::Now() { return Time::Now().ToNanosecond(); }
+
+ChannelTrace* LatencyTracer::GetChannel(uint64_t channel_id) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return GetChannelLocked(channel_id);
+}
+
+ReaderTrace* LatencyTracer::GetReader(uint64_t channel_id,
+                                      const std::string& reader_name) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto channel = GetChannelLocked(channel_id);
+  for (auto& reader : channel->readers_) {
+    if (reader->reader_name() == reader_name) {
+      return reader.get();
+    }
+  }
+  channel->readers_.emplace_back(new ReaderTrace(reader_name, channel));
+  return channel->readers_.back().get();
+}
+
+ChannelTrace* LatencyTracer::GetChannelLocked(uint64_t channel_id) {
+  auto& channel = channels_[channel_id];
+  if (channel == nullptr) {
+    channel.reset(new ChannelTrace(channel_id));
+  }
+  return channel.get();
+}
+
+void LatencyTracer::Snapshot(const std::string& channel_name,
+                             proto::LatencyReport* report) {
+  report->Clear();
+  report->set_host_name(GlobalData::Instance()->HostName());
+  report->set_process_id(GlobalData::Instance()->ProcessId());
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& item : channels_) {
+    if (!channel_name.empty() &&
+        GlobalData::GetChannelById(item.first) != channel_name) {
+      continue;
+    }
+    item.second->Snapshot(report->add_channel());
+  }
+}
+
+CallbackTrace::CallbackTrace(ReaderTrace* reader, const MessageKey* key)
+    : reader_(reader) {
+  if (reader_ == nullptr) {
+    return;
+  }
+  start_time_ = LatencyTracer::Now();
+  uint64_t dispatch_time = 0;
+  if (key != nullptr &&
+      reader_->channel()->Find(*key, &publish_time_, &dispatch_time)) {
+    reader_->queue()->Record(Elapsed(dispatch_time, start_time_));
+  }
+}
+
+CallbackTrace::~CallbackTrace() {
+  if (reader_ == nullptr) {
+    return;
+  }
+  auto end_time = LatencyTracer::Now();
+  reader_->compute()->Record(Elapsed(start_time_, end_time));
+  if (publish_time_ != 0) {
+    reader_->end_to_end()->Record(Elapsed(publish_time_, end_time));
+  }
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
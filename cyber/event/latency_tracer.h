@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_LATENCY_TRACER_H_
+#define CYBER_EVENT_LATENCY_TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "cyber/proto/latency_trace.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+/**
+ * @brief Log2 histogram of latencies that any thread may record into without
+ * locking, the bucket layout is described in proto::LatencyHistogram.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t kBucketNum = 32;
+
+  LatencyHistogram();
+
+  void Record(uint64_t latency_ns);
+  void Snapshot(proto::LatencyHistogram* histogram) const;
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Upper bound in nanoseconds of the bucket holding the given
+   * percentile (0 to 100), the max for the last non-empty bucket.
+   */
+  static uint64_t Percentile(const proto::LatencyHistogram& histogram,
+                             double percentile);
+
+ private:
+  std::atomic<uint64_t> buckets_[kBucketNum];
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> sum_ns_ = {0};
+  std::atomic<uint64_t> max_ns_ = {0};
+};
+
+/**
+ * @brief Names a message of a channel, sender is the hash of the writer id
+ * and seq its sequence number, both from transport::MessageInfo. A sender of
+ * zero names no message.
+ */
+struct MessageKey {
+  uint64_t sender = 0;
+  uint64_t seq = 0;
+};
+
+namespace internal {
+
+template <typename T>
+struct KeyedDeleter {
+  void operator()(T*) { msg.reset(); }
+
+  std::shared_ptr<T> msg;
+  MessageKey key;
+};
+
+}  // namespace internal
+
+/**
+ * @brief A pointer to the same message that also carries its key, for the
+ * callbacks, which are given the message only. Costs one allocation.
+ */
+template <typename T>
+std::shared_ptr<T> WithMessageKey(const std::shared_ptr<T>& msg,
+                                  const MessageKey& key) {
+  return std::shared_ptr<T>(msg.get(), internal::KeyedDeleter<T>{msg, key});
+}
+
+/**
+ * @brief The key given to WithMessageKey, nullptr if msg was not made by it.
+ */
+template <typename T>
+const MessageKey* GetMessageKey(const std::shared_ptr<T>& msg) {
+  auto deleter = std::get_deleter<internal::KeyedDeleter<T>>(msg);
+  return deleter == nullptr ? nullptr : &deleter->key;
+}
+
+class ChannelTrace;
+
+/**
+ * @brief Callback stages of one reader on a channel.
+ */
+class ReaderTrace {
+ public:
+  ReaderTrace(const std::string& reader_name, ChannelTrace* channel)
+      : reader_name_(reader_name), channel_(channel) {}
+
+  const std::string& reader_name() const { return reader_name_; }
+  ChannelTrace* channel() const { return channel_; }
+
+  LatencyHistogram* queue() { return &queue_; }
+  LatencyHistogram* compute() { return &compute_; }
+  LatencyHistogram* end_to_end() { return &end_to_end_; }
+
+  void Snapshot(proto::ReaderLatency* reader) const;
+
+ private:
+  std::string reader_name_;
+  ChannelTrace* channel_;
+
+  LatencyHistogram queue_;
+  LatencyHistogram compute_;
+  LatencyHistogram end_to_end_;
+};
+
+/**
+ * @brief Transport stages of a channel in the reading process.
+ *
+ * The stamps of the last dispatched messages are kept in a small ring keyed by
+ * MessageKey, so that a callback started later finds them without the stamps
+ * being threaded through the data visitors. Message addresses are not unique,
+ * the message pools reuse them and a writer may publish one object twice.
+ */
+class ChannelTrace {
+ public:
+  static constexpr uint32_t kRingSize = 64;
+
+  explicit ChannelTrace(uint64_t channel_id);
+
+  uint64_t channel_id() const { return channel_id_; }
+
+  /**
+   * @brief Called once per message right before it is handed to the readers,
+   * publish_time and transmit_time are zero if the writer did not trace.
+   */
+  void OnDispatch(const MessageKey& key, uint64_t publish_time,
+                  uint64_t transmit_time, uint64_t dispatch_time);
+
+  /**
+   * @brief Find the stamps of a message among the last kRingSize dispatched.
+   */
+  bool Find(const MessageKey& key, uint64_t* publish_time,
+            uint64_t* dispatch_time) const;
+
+  void Snapshot(proto::ChannelLatency* channel) const;
+
+ private:
+  friend class LatencyTracer;
+
+  struct Slot {
+    std::atomic<uint64_t> sender = {0};
+    std::atomic<uint64_t> seq = {0};
+    std::atomic<uint64_t> publish_time = {0};
+    std::atomic<uint64_t> dispatch_time = {0};
+  };
+
+  uint64_t channel_id_;
+
+  LatencyHistogram publish_;
+  LatencyHistogram transport_;
+
+  Slot ring_[kRingSize];
+  std::atomic<uint32_t> next_slot_ = {0};
+
+  // guarded by the mutex of LatencyTracer
+  std::vector<std::unique_ptr<ReaderTrace>> readers_;
+};
+
+/**
+ * @brief Per channel latency histograms of this process, enabled by
+ * perf_conf.latency_trace in cyber.pb.conf.
+ *
+ * Writers stamp publish and transmit into the MessageInfo, the reading side
+ * stamps dispatch, passes the messages on WithMessageKey and runs every
+ * callback in a CallbackTrace. The stages are
+ * publish, transport, queue, compute and end to end, see
+ * proto::ChannelLatency and proto::ReaderLatency. Stamps are taken with
+ * Time::Now(), stages that span hosts are only meaningful with synchronized
+ * clocks.
+ *
+ * A traced MessageInfo is 16 bytes longer than an untraced one and readers
+ * built before the stamps existed drop messages whose info has another size.
+ * Enable it only once every process on the channels, on every host, runs a
+ * build that knows the traced format.
+ */
+class LatencyTracer {
+ public:
+  bool enabled() const { return enabled_; }
+
+  static uint64_t Now();
+
+  /**
+   * @brief nullptr if tracing is disabled. The pointers stay valid for the
+   * life of the process, keep them instead of looking up per message.
+   */
+  ChannelTrace* GetChannel(uint64_t channel_id);
+  ReaderTrace* GetReader(uint64_t channel_id, const std::string& reader_name);
+
+  void Snapshot(const std::string& channel_name,
+                proto::LatencyReport* report);
+
+ private:
+  ChannelTrace* GetChannelLocked(uint64_t channel_id);
+
+  bool enabled_ = false;
+
+  // key: channel_id
+  std::unordered_map<uint64_t, std::unique_ptr<ChannelTrace>> channels_;
+  std::mutex mutex_;
+
+  DECLARE_SINGLETON(LatencyTracer)
+};
+
+/**
+ * @brief Records the queue, compute and end to end stages of one callback,
+ * does nothing for a null reader. Only the compute stage is recorded for a
+ * message that was not passed on WithMessageKey.
+ */
+class CallbackTrace {
+ public:
+  template <typename T>
+  CallbackTrace(ReaderTrace* reader, const std::shared_ptr<T>& msg)
+      : CallbackTrace(reader,
+                      reader == nullptr ? nullptr : GetMessageKey(msg)) {}
+  CallbackTrace(ReaderTrace* reader, const MessageKey* key);
+  ~CallbackTrace();
+
+ private:
+  CallbackTrace(const CallbackTrace&) = delete;
+  CallbackTrace& operator=(const CallbackTrace&) = delete;
+
+  ReaderTrace* reader_;
+  uint64_t start_time_ = 0;
+  uint64_t publish_time_ = 0;
+};
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_LATENCY_TRACER_H_
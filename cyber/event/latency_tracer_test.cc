@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/latency_tracer.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+TEST(LatencyHistogramTest, record) {
+  LatencyHistogram histogram;
+  histogram.Record(500);        // < 1us
+  histogram.Record(1500);       // [1, 2) us
+  histogram.Record(3000);       // [2, 4) us
+  histogram.Record(3500);       // [2, 4) us
+  histogram.Record(1000000);    // [512, 1024) us
+  EXPECT_EQ(histogram.count(), 5);
+
+  proto::LatencyHistogram snapshot;
+  histogram.Snapshot(&snapshot);
+  EXPECT_EQ(snapshot.count(), 5);
+  EXPECT_EQ(snapshot.sum_ns(), 1008500);
+  EXPECT_EQ(snapshot.max_ns(), 1000000);
+  ASSERT_EQ(snapshot.bucket_size(), LatencyHistogram::kBucketNum);
+  EXPECT_EQ(snapshot.bucket(0), 1);
+  EXPECT_EQ(snapshot.bucket(1), 1);
+  EXPECT_EQ(snapshot.bucket(2), 2);
+  EXPECT_EQ(snapshot.bucket(10), 1);
+
+  EXPECT_EQ(LatencyHistogram::Percentile(snapshot, 20), 1000);
+  EXPECT_EQ(LatencyHistogram::Percentile(snapshot, 50), 4000);
+  EXPECT_EQ(LatencyHistogram::Percentile(snapshot, 80), 4000);
+  EXPECT_EQ(LatencyHistogram::Percentile(snapshot, 99), 1000000);
+
+  proto::LatencyHistogram empty;
+  EXPECT_EQ(LatencyHistogram::Percentile(empty, 50), 0);
+}
+
+TEST(LatencyHistogramTest, multi_thread) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&histogram, i]() {
+      for (int j = 0; j < 10000; ++j) {
+        histogram.Record((i + 1) * 1000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  proto::LatencyHistogram snapshot;
+  histogram.Snapshot(&snapshot);
+  EXPECT_EQ(snapshot.count(), 40000);
+  EXPECT_EQ(snapshot.max_ns(), 4000);
+  EXPECT_EQ(snapshot.sum_ns(), 100000000);
+}
+
+TEST(ChannelTraceTest, stages) {
+  ChannelTrace channel(1);
+  ReaderTrace reader("reader", &channel);
+  const MessageKey key = {7, 1};
+  const MessageKey untraced_key = {7, 2};
+  auto msg = WithMessageKey(std::make_shared<int>(0), key);
+  auto untraced_msg = WithMessageKey(std::make_shared<int>(0), untraced_key);
+
+  auto now = LatencyTracer::Now();
+  channel.OnDispatch(key, now - 3000000, now - 2000000, now - 1000000);
+  channel.OnDispatch(untraced_key, 0, 0, now);
+
+  uint64_t publish_time = 0;
+  uint64_t dispatch_time = 0;
+  EXPECT_TRUE(channel.Find(key, &publish_time, &dispatch_time));
+  EXPECT_EQ(publish_time, now - 3000000);
+  EXPECT_EQ(dispatch_time, now - 1000000);
+  EXPECT_FALSE(channel.Find({8, 1}, &publish_time, &dispatch_time));
+  EXPECT_FALSE(channel.Find({7, 3}, &publish_time, &dispatch_time));
+
+  { CallbackTrace callback_trace(&reader, msg); }
+  { CallbackTrace callback_trace(&reader, untraced_msg); }
+  { CallbackTrace callback_trace(nullptr, msg); }
+  // a message dispatched without its key only has a compute stage
+  { CallbackTrace callback_trace(&reader, std::make_shared<int>(0)); }
+
+  proto::ChannelLatency snapshot;
+  channel.Snapshot(&snapshot);
+  EXPECT_EQ(snapshot.publish().count(), 1);
+  EXPECT_EQ(snapshot.publish().sum_ns(), 1000000);
+  EXPECT_EQ(snapshot.transport().count(), 1);
+  EXPECT_EQ(snapshot.transport().sum_ns(), 1000000);
+
+  proto::ReaderLatency reader_snapshot;
+  reader.Snapshot(&reader_snapshot);
+  EXPECT_EQ(reader_snapshot.reader_name(), "reader");
+  EXPECT_EQ(reader_snapshot.queue().count(), 2);
+  EXPECT_GE(reader_snapshot.queue().max_ns(), 1000000);
+  EXPECT_EQ(reader_snapshot.compute().count(), 3);
+  // only the traced message knows when it was published
+  EXPECT_EQ(reader_snapshot.end_to_end().count(), 1);
+  EXPECT_GE(reader_snapshot.end_to_end().sum_ns(), 3000000);
+}
+
+TEST(ChannelTraceTest, message_key) {
+  auto msg = std::make_shared<int>(5);
+  EXPECT_EQ(GetMessageKey(msg), nullptr);
+
+  auto keyed = WithMessageKey(msg, {3, 4});
+  EXPECT_EQ(keyed.get(), msg.get());
+  ASSERT_NE(GetMessageKey(keyed), nullptr);
+  EXPECT_EQ(GetMessageKey(keyed)->sender, 3);
+  EXPECT_EQ(GetMessageKey(keyed)->seq, 4);
+
+  // the keyed pointer keeps the message alive
+  std::weak_ptr<int> weak = msg;
+  msg.reset();
+  EXPECT_FALSE(weak.expired());
+  keyed.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(ChannelTraceTest, same_address) {
+  // a pooled message object comes back with new stamps
+  ChannelTrace channel(1);
+  ReaderTrace reader("reader", &channel);
+  auto msg = std::make_shared<int>(0);
+  channel.OnDispatch({7, 1}, 1000, 1000, 2000);
+  auto first = WithMessageKey(msg, {7, 1});
+  channel.OnDispatch({7, 2}, 5000, 5000, 6000);
+  auto second = WithMessageKey(msg, {7, 2});
+
+  uint64_t publish_time = 0;
+  uint64_t dispatch_time = 0;
+  ASSERT_TRUE(
+      channel.Find(*GetMessageKey(first), &publish_time, &dispatch_time));
+  EXPECT_EQ(dispatch_time, 2000);
+  ASSERT_TRUE(
+      channel.Find(*GetMessageKey(second), &publish_time, &dispatch_time));
+  EXPECT_EQ(dispatch_time, 6000);
+}
+
+TEST(ChannelTraceTest, ring) {
+  ChannelTrace channel(1);
+  const uint64_t msg_num = ChannelTrace::kRingSize + 1;
+  for (uint64_t i = 0; i < msg_num; ++i) {
+    channel.OnDispatch({7, i}, 0, 0, i + 1);
+  }
+  uint64_t publish_time = 0;
+  uint64_t dispatch_time = 0;
+  // the oldest message was overwritten
+  EXPECT_FALSE(channel.Find({7, 0}, &publish_time, &dispatch_time));
+  EXPECT_TRUE(channel.Find({7, 1}, &publish_time, &dispatch_time));
+  EXPECT_EQ(dispatch_time, 2);
+  EXPECT_TRUE(channel.Find({7, msg_num - 1}, &publish_time, &dispatch_time));
+  EXPECT_EQ(dispatch_time, msg_num);
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
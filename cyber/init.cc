@@ -30,6 +30,7 @@
 #include "cyber/logger/async_logger.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
+#include "cyber/sysmo/latency_service.h"
 #include "cyber/sysmo/sysmo.h"
 #include "cyber/task/task.h"
 #include "cyber/timer/timing_wheel.h"
@@ -106,6 +107,8 @@ bool Init(const char* binary_name) {
     g_atexit_registered = true;
   }
   SetState(STATE_INITIALIZED);
+  // needs the initialized state to join the topology
+  LatencyService::Instance()->Start();
   return true;
 }
 
@@ -115,6 +118,7 @@ void Clear() {
     return;
   }
   SysMo::CleanUp();
+  LatencyService::CleanUp();
   TaskManager::CleanUp();
   TimingWheel::CleanUp();
   scheduler::CleanUp();
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_MESSAGE_POOL_H_
+#define CYBER_MESSAGE_MESSAGE_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "cyber/base/concurrent_object_pool.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @brief Recycles the messages received on one channel.
+ *
+ * Pooled messages go back to the pool when their last shared_ptr drops and
+ * keep their content, so parsing the next message into one reuses the
+ * memory of its strings and repeated fields instead of allocating it again.
+ * Until a reader reserves messages every Acquire is a plain make_shared.
+ * When all pooled messages are in use Acquire falls back to make_shared too.
+ */
+template <typename MessageT>
+class MessagePool {
+ public:
+  using ObjectPool = base::CCObjectPool<MessageT>;
+
+  MessagePool() = default;
+
+  /**
+   * @brief Keep at least size messages in the pool. The pool only grows,
+   * messages of a replaced pool are freed once the last of them is released.
+   */
+  void Reserve(uint32_t size);
+
+  std::shared_ptr<MessageT> Acquire();
+
+  uint32_t size() const;
+  // messages served from the pool
+  uint64_t reused_num() const {
+    return reused_num_.load(std::memory_order_relaxed);
+  }
+  // messages allocated because the pool was disabled or empty
+  uint64_t allocated_num() const {
+    return allocated_num_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  MessagePool(const MessagePool&) = delete;
+  MessagePool& operator=(const MessagePool&) = delete;
+
+  // the current pool, a replaced one is kept alive by its messages only
+  std::atomic<ObjectPool*> pool_ = {nullptr};
+  std::shared_ptr<ObjectPool> pool_holder_ = nullptr;
+  mutable std::mutex pool_holder_mutex_;
+  // Acquire calls that may still use a pool they loaded before it was
+  // replaced, Reserve waits for them before it drops the replaced pool
+  std::atomic<uint32_t> acquiring_num_ = {0};
+
+  std::atomic<uint64_t> reused_num_ = {0};
+  std::atomic<uint64_t> allocated_num_ = {0};
+};
+
+template <typename MessageT>
+void MessagePool<MessageT>::Reserve(uint32_t size) {
+  std::lock_guard<std::mutex> lock(pool_holder_mutex_);
+  if (size == 0 || (pool_holder_ != nullptr && pool_holder_->size() >= size)) {
+    return;
+  }
+  auto pool = std::make_shared<ObjectPool>(size);
+  pool->ConstructAll();
+  pool_holder_.swap(pool);
+  pool_.store(pool_holder_.get());
+  // the replaced pool, now in pool, is dropped once no Acquire may use it
+  while (acquiring_num_.load() != 0) {
+    std::this_thread::yield();
+  }
+}
+
+template <typename MessageT>
+std::shared_ptr<MessageT> MessagePool<MessageT>::Acquire() {
+  acquiring_num_.fetch_add(1);
+  auto pool = pool_.load();
+  std::shared_ptr<MessageT> msg = nullptr;
+  if (pool != nullptr) {
+    // the message holds the pool from here on
+    msg = pool->GetObject();
+  }
+  acquiring_num_.fetch_sub(1, std::memory_order_release);
+  if (msg != nullptr) {
+    reused_num_.fetch_add(1, std::memory_order_relaxed);
+    return msg;
+  }
+  allocated_num_.fetch_add(1, std::memory_order_relaxed);
+  return std::make_shared<MessageT>();
+}
+
+template <typename MessageT>
+uint32_t MessagePool<MessageT>::size() const {
+  std::lock_guard<std::mutex> lock(pool_holder_mutex_);
+  return pool_holder_ == nullptr ? 0 : pool_holder_->size();
+}
+
+/**
+ * @brief Holds one MessagePool per channel for the readers of MessageT.
+ */
+template <typename MessageT>
+class MessagePoolManager {
+ public:
+  using MessagePoolPtr = std::shared_ptr<MessagePool<MessageT>>;
+
+  MessagePoolPtr GetPool(uint64_t channel_id);
+
+ private:
+  // key: channel_id
+  std::unordered_map<uint64_t, MessagePoolPtr> pools_;
+  std::mutex pools_mutex_;
+
+  DECLARE_SINGLETON(MessagePoolManager<MessageT>)
+};
+
+template <typename MessageT>
+MessagePoolManager<MessageT>::MessagePoolManager() {}
+
+template <typename MessageT>
+auto MessagePoolManager<MessageT>::GetPool(uint64_t channel_id)
+    -> MessagePoolPtr {
+  std::lock_guard<std::mutex> lock(pools_mutex_);
+  auto& pool = pools_[channel_id];
+  if (pool == nullptr) {
+    pool = std::make_shared<MessagePool<MessageT>>();
+  }
+  return pool;
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_MESSAGE_POOL_H_
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/message_pool.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+using apollo::cyber::proto::Chatter;
+
+TEST(MessagePoolTest, disabled) {
+  MessagePool<Chatter> pool;
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_NE(pool.Acquire(), nullptr);
+  EXPECT_NE(pool.Acquire(), nullptr);
+  EXPECT_EQ(pool.reused_num(), 0);
+  EXPECT_EQ(pool.allocated_num(), 2);
+}
+
+TEST(MessagePoolTest, reuse) {
+  MessagePool<Chatter> pool;
+  pool.Reserve(2);
+  pool.Reserve(1);
+  EXPECT_EQ(pool.size(), 2);
+
+  Chatter large;
+  large.set_seq(1);
+  large.set_content(std::string(4096, 'x'));
+  std::string large_str;
+  large.SerializeToString(&large_str);
+
+  Chatter* raw = nullptr;
+  {
+    auto msg = pool.Acquire();
+    ASSERT_TRUE(msg->ParseFromString(large_str));
+    raw = msg.get();
+  }
+
+  Chatter small;
+  small.set_seq(2);
+  small.set_content("y");
+  std::string small_str;
+  small.SerializeToString(&small_str);
+
+  auto msg = pool.Acquire();
+  EXPECT_EQ(msg.get(), raw);
+  ASSERT_TRUE(msg->ParseFromString(small_str));
+  EXPECT_EQ(msg->seq(), 2);
+  EXPECT_EQ(msg->content(), "y");
+  // the parsed message reuses the buffer of the previous one
+  EXPECT_GE(msg->content().capacity(), 4096);
+
+  auto other = pool.Acquire();
+  auto allocated = pool.Acquire();
+  EXPECT_NE(other, nullptr);
+  EXPECT_NE(allocated, nullptr);
+  EXPECT_EQ(pool.reused_num(), 3);
+  EXPECT_EQ(pool.allocated_num(), 1);
+
+  // messages of the replaced pool stay valid
+  pool.Reserve(4);
+  EXPECT_EQ(pool.size(), 4);
+  EXPECT_EQ(msg->content(), "y");
+}
+
+namespace {
+int destroyed_num = 0;
+struct Counted {
+  ~Counted() { ++destroyed_num; }
+};
+}  // namespace
+
+TEST(MessagePoolTest, free_replaced_pools) {
+  MessagePool<Counted> pool;
+  pool.Reserve(2);
+  pool.Reserve(4);
+  EXPECT_EQ(destroyed_num, 2);
+
+  auto msg = pool.Acquire();
+  pool.Reserve(8);
+  EXPECT_EQ(destroyed_num, 2);
+  msg = nullptr;
+  EXPECT_EQ(destroyed_num, 6);
+}
+
+TEST(MessagePoolTest, multi_thread) {
+  auto pool = std::make_shared<MessagePool<Chatter>>();
+  pool->Reserve(8);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([pool, i]() {
+      for (int j = 0; j < 10000; ++j) {
+        auto msg = pool->Acquire();
+        msg->set_seq(i);
+        EXPECT_EQ(msg->seq(), i);
+      }
+    });
+  }
+  pool->Reserve(16);
+  pool->Reserve(32);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool->reused_num() + pool->allocated_num(), 40000);
+}
+
+TEST(MessagePoolManagerTest, get_pool) {
+  auto manager = MessagePoolManager<Chatter>::Instance();
+  auto pool = manager->GetPool(1);
+  EXPECT_EQ(pool, manager->GetPool(1));
+  EXPECT_NE(pool, manager->GetPool(2));
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
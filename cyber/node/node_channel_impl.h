@@ -23,6 +23,7 @@
 #include "cyber/blocker/intra_reader.h"
 #include "cyber/blocker/intra_writer.h"
 #include "cyber/common/global_data.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/node/reader.h"
 #include "cyber/node/writer.h"
@@ -43,11 +44,15 @@ struct ReaderConfig {  ///< configurations for a Reader
     qos_profile.set_durability(proto::QosDurabilityPolicy::DURABILITY_VOLATILE);
 
     pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE;
+    lock_free_blocker = false;
+    message_pool_size = 0;
   }
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        lock_free_blocker(other.lock_free_blocker),
+        message_pool_size(other.message_pool_size) {}
 
   std::string channel_name;       //< channel reads
   proto::QosProfile qos_profile;  //< the qos configuration
@@ -56,6 +61,17 @@ struct ReaderConfig {  ///< configurations for a Reader
    * Older messages will dropped if you have no time to handle
    */
   uint32_t pending_queue_size;
+  /**
+   * @brief cache the messages for Observe in a lock-free ring of
+   * qos_profile.depth slots, for high rate channels
+   */
+  bool lock_free_blocker;
+  /**
+   * @brief number of received messages recycled for the channel, 0 disables
+   * it. Recycled messages keep their memory, so this pays off for large
+   * messages with repeated fields.
+   */
+  uint32_t message_pool_size;
 };
 
 /**
@@ -131,7 +147,8 @@ class NodeChannelImpl {
   template <typename MessageT>
   auto CreateReader(const proto::RoleAttributes& role_attr,
                     const CallbackFunc<MessageT>& reader_func,
-                    uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE)
+                    uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE,
+                    bool lock_free_blocker = false)
       -> std::shared_ptr<Reader<MessageT>>;
 
   template <typename MessageT>
@@ -193,14 +210,21 @@ auto NodeChannelImpl::CreateReader(const ReaderConfig& config,
   proto::RoleAttributes role_attr;
   role_attr.set_channel_name(config.channel_name);
   role_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  if (config.message_pool_size > 0 && !config.channel_name.empty()) {
+    message::MessagePoolManager<MessageT>::Instance()
+        ->GetPool(GlobalData::RegisterChannel(config.channel_name))
+        ->Reserve(config.message_pool_size);
+  }
   return this->template CreateReader<MessageT>(role_attr, reader_func,
-                                               config.pending_queue_size);
+                                               config.pending_queue_size,
+                                               config.lock_free_blocker);
 }
 
 template <typename MessageT>
 auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
                                    const CallbackFunc<MessageT>& reader_func,
-                                   uint32_t pending_queue_size)
+                                   uint32_t pending_queue_size,
+                                   bool lock_free_blocker)
     -> std::shared_ptr<Reader<MessageT>> {
   if (!role_attr.has_channel_name() || role_attr.channel_name().empty()) {
     AERROR << "Can't create a reader with empty channel name!";
@@ -215,8 +239,8 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
     reader_ptr =
         std::make_shared<blocker::IntraReader<MessageT>>(new_attr, reader_func);
   } else {
-    reader_ptr = std::make_shared<Reader<MessageT>>(new_attr, reader_func,
-                                                    pending_queue_size);
+    reader_ptr = std::make_shared<Reader<MessageT>>(
+        new_attr, reader_func, pending_queue_size, lock_free_blocker);
   }
 
   RETURN_VAL_IF_NULL(reader_ptr, nullptr);
@@ -79,12 +79,15 @@ class Reader : public ReaderBase {
    * channel name and other info.
    * @param reader_func is the callback function, when the message is received.
    * @param pending_queue_size is the max depth of message cache queue.
+   * @param lock_free_blocker keeps the received messages in a lock-free ring,
+   * see blocker::BlockerAttr::lock_free
    * @warning the received messages is enqueue a queue,the queue's depth is
    * pending_queue_size
    */
   explicit Reader(const proto::RoleAttributes& role_attr,
                   const CallbackFunc<MessageT>& reader_func = nullptr,
-                  uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE);
+                  uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE,
+                  bool lock_free_blocker = false);
   virtual ~Reader();
 
   /**
@@ -228,12 +231,14 @@ class Reader : public ReaderBase {
 template <typename MessageT>
 Reader<MessageT>::Reader(const proto::RoleAttributes& role_attr,
                          const CallbackFunc<MessageT>& reader_func,
-                         uint32_t pending_queue_size)
+                         uint32_t pending_queue_size,
+                         bool lock_free_blocker)
     : ReaderBase(role_attr),
       pending_queue_size_(pending_queue_size),
       reader_func_(reader_func) {
-  blocker_.reset(new blocker::Blocker<MessageT>(blocker::BlockerAttr(
-      role_attr.qos_profile().depth(), role_attr.channel_name())));
+  blocker_.reset(new blocker::Blocker<MessageT>(
+      blocker::BlockerAttr(role_attr.qos_profile().depth(),
+                           role_attr.channel_name(), lock_free_blocker)));
 }
 
 template <typename MessageT>
@@ -260,8 +265,11 @@ bool Reader<MessageT>::Init() {
   }
   std::function<void(const std::shared_ptr<MessageT>&)> func;
   if (reader_func_ != nullptr) {
-    func = [this](const std::shared_ptr<MessageT>& msg) {
+    auto trace = LatencyTracer::Instance()->GetReader(
+        role_attr_.channel_id(), role_attr_.node_name());
+    func = [this, trace](const std::shared_ptr<MessageT>& msg) {
       this->Enqueue(msg);
+      event::CallbackTrace callback_trace(trace, msg);
       this->reader_func_(msg);
     };
   } else {
@@ -25,6 +25,7 @@
 
 #include "cyber/common/macros.h"
 #include "cyber/common/util.h"
+#include "cyber/event/latency_tracer.h"
 #include "cyber/event/perf_event_cache.h"
 #include "cyber/transport/transport.h"
 
@@ -32,6 +33,7 @@ namespace apollo {
 namespace cyber {
 
 using apollo::cyber::common::GlobalData;
+using apollo::cyber::event::LatencyTracer;
 using apollo::cyber::event::PerfEventCache;
 using apollo::cyber::event::TransPerf;
 
@@ -204,18 +206,33 @@ auto ReceiverManager<MessageT>::GetReceiver(
   // so reader for datacache we use map to keep one instance for per channel
   const std::string& channel_name = role_attr.channel_name();
   if (receiver_map_.count(channel_name) == 0) {
+    auto trace = LatencyTracer::Instance()->GetChannel(role_attr.channel_id());
     receiver_map_[channel_name] =
         transport::Transport::Instance()->CreateReceiver<MessageT>(
-            role_attr, [](const std::shared_ptr<MessageT>& msg,
-                          const transport::MessageInfo& msg_info,
-                          const proto::RoleAttributes& reader_attr) {
+            role_attr, [trace](const std::shared_ptr<MessageT>& msg,
+                               const transport::MessageInfo& msg_info,
+                               const proto::RoleAttributes& reader_attr) {
               (void)msg_info;
               (void)reader_attr;
               PerfEventCache::Instance()->AddTransportEvent(
                   TransPerf::DISPATCH, reader_attr.channel_id(),
                   msg_info.seq_num());
-              data::DataDispatcher<MessageT>::Instance()->Dispatch(
-                  reader_attr.channel_id(), msg);
+              if (trace == nullptr) {
+                data::DataDispatcher<MessageT>::Instance()->Dispatch(
+                    reader_attr.channel_id(), msg);
+              } else {
+                // intra messages are dispatched right here
+                auto dispatch_time = msg_info.dispatch_time() != 0
+                                         ? msg_info.dispatch_time()
+                                         : LatencyTracer::Now();
+                event::MessageKey key;
+                key.sender = msg_info.sender_id().HashValue();
+                key.seq = msg_info.seq_num();
+                trace->OnDispatch(key, msg_info.publish_time(),
+                                  msg_info.transmit_time(), dispatch_time);
+                data::DataDispatcher<MessageT>::Instance()->Dispatch(
+                    reader_attr.channel_id(), event::WithMessageKey(msg, key));
+              }
               PerfEventCache::Instance()->AddTransportEvent(
                   TransPerf::NOTIFY, reader_attr.channel_id(),
                   msg_info.seq_num());
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -41,6 +42,7 @@ template <typename MessageT>
 class Writer : public WriterBase {
  public:
   using TransmitterPtr = std::shared_ptr<transport::Transmitter<MessageT>>;
+  using Loaned = transport::LoanedMessage<MessageT>;
   using ChangeConnection =
       typename service_discovery::Manager::ChangeConnection;
 
@@ -83,6 +85,27 @@ class Writer : public WriterBase {
    */
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  /**
+   * @brief Borrow a buffer to serialize a message into in place, e.g. the
+   * payload of a RawMessage. When the channel is carried over shared memory
+   * the buffer is a shared memory block and Publish sends it without copying.
+   * Until it is published the segment keeps its size, so that a Write of a
+   * larger message on this Writer fails; see LoanedMessage.
+   *
+   * @param size the largest serialized size the message may have
+   * @return Loaned the buffer, invalid if the Writer is not initialized
+   */
+  Loaned Loan(std::size_t size);
+
+  /**
+   * @brief Publish a message built in a buffer obtained from Loan
+   *
+   * @param loaned the loan, whose size must have been set to the bytes used
+   * @return true if publish successfully
+   * @return false if publish failed
+   */
+  bool Publish(Loaned&& loaned);
+
   /**
    * @brief Is there any Reader that subscribes our Channel?
    * You can publish message when this return true
@@ -168,6 +191,24 @@ bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   return transmitter_->Transmit(msg_ptr);
 }
 
+template <typename MessageT>
+auto Writer<MessageT>::Loan(std::size_t size) -> Loaned {
+  Loaned loaned;
+  RETURN_VAL_IF(!WriterBase::IsInit(), loaned);
+  if (!transmitter_->AcquireLoan(size, &loaned)) {
+    loaned.Allocate(size);
+  }
+  return loaned;
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::Publish(Loaned&& loaned) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  Loaned owned(std::move(loaned));
+  RETURN_VAL_IF(!owned.is_valid(), false);
+  return transmitter_->Transmit(&owned);
+}
+
 template <typename MessageT>
 void Writer<MessageT>::JoinTheTopology() {
   // add listener
@@ -45,14 +45,17 @@ T PyObjectToPtr(PyObject *pyobj, const std::string &type_ptr) {
 PyObject *cyber_new_PyRecordReader(PyObject *self, PyObject *args) {
   char *filepath = nullptr;
   Py_ssize_t len = 0;
-  if (!PyArg_ParseTuple(args, const_cast<char *>("s#:new_PyRecordReader"),
-                        &filepath, &len)) {
+  int use_mmap = 0;
+  unsigned int prefetch_chunks = 0;
+  if (!PyArg_ParseTuple(args, const_cast<char *>("s#|iI:new_PyRecordReader"),
+                        &filepath, &len, &use_mmap, &prefetch_chunks)) {
     AERROR << "cyber_new_PyRecordReader parsetuple failed!";
     Py_INCREF(Py_None);
     return Py_None;
   }
 
-  PyRecordReader *reader = new PyRecordReader(std::string(filepath, len));
+  PyRecordReader *reader = new PyRecordReader(std::string(filepath, len),
+                                              use_mmap != 0, prefetch_chunks);
   return PyCapsule_New(reader, "apollo_cyber_record_pyrecordfilereader",
                        nullptr);
 }
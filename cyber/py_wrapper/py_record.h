@@ -48,8 +48,12 @@ struct BagMessage {
 
 class PyRecordReader {
  public:
-  explicit PyRecordReader(const std::string& file) {
-    record_reader_.reset(new RecordReader(file));
+  explicit PyRecordReader(const std::string& file, bool use_mmap = false,
+                          uint32_t prefetch_chunks = 0) {
+    ReadOptions options;
+    options.use_mmap = use_mmap;
+    options.prefetch_chunks = prefetch_chunks;
+    record_reader_.reset(new RecordReader(file, options));
   }
 
   BagMessage ReadMessage(uint64_t begin_time = 0,
@@ -50,8 +50,11 @@ class RecordReader(object):
     # @brief the constructor function.
     #
     # @param file_name the record file name.
-    def __init__(self, file_name):
-        self.record_reader = _CYBER_RECORD.new_PyRecordReader(file_name)
+    # @param use_mmap map the file instead of reading it through the fd.
+    # @param prefetch_chunks number of chunks decoded ahead in the background.
+    def __init__(self, file_name, use_mmap=False, prefetch_chunks=0):
+        self.record_reader = _CYBER_RECORD.new_PyRecordReader(
+            file_name, int(use_mmap), prefetch_chunks)
 
     def __del__(self):
         _CYBER_RECORD.delete_PyRecordReader(self.record_reader)
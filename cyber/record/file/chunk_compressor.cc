@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compressor.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+// raw size followed by the compress type
+constexpr size_t kSizeBytes = sizeof(uint64_t);
+constexpr size_t kPrefixBytes = kSizeBytes + 1;
+constexpr int kZstdDefaultLevel = 3;
+
+void PutPrefix(uint64_t size, CompressType type, std::string* out) {
+  unsigned char bytes[kPrefixBytes];
+  for (size_t i = 0; i < kSizeBytes; ++i) {
+    bytes[i] = static_cast<unsigned char>(size >> (i * 8));
+  }
+  bytes[kSizeBytes] = static_cast<unsigned char>(type);
+  out->assign(reinterpret_cast<char*>(bytes), kPrefixBytes);
+}
+
+uint64_t GetRawSize(const char* in) {
+  uint64_t size = 0;
+  for (size_t i = 0; i < kSizeBytes; ++i) {
+    auto byte = static_cast<unsigned char>(in[i]);
+    size |= static_cast<uint64_t>(byte) << (i * 8);
+  }
+  return size;
+}
+
+}  // namespace
+
+bool ChunkCompressor::IsSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_LZ4 ||
+         type == CompressType::COMPRESS_ZSTD;
+}
+
+bool ChunkCompressor::Compress(CompressType type, int level,
+                               const std::string& raw, std::string* out) {
+  PutPrefix(raw.size(), type, out);
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      out->append(raw);
+      return true;
+    case CompressType::COMPRESS_LZ4: {
+      if (raw.size() > LZ4_MAX_INPUT_SIZE) {
+        AERROR << "chunk of " << raw.size() << " bytes is too large for lz4.";
+        return false;
+      }
+      int src_size = static_cast<int>(raw.size());
+      int bound = LZ4_compressBound(src_size);
+      out->resize(kPrefixBytes + bound);
+      char* dst = &(*out)[kPrefixBytes];
+      int size = level > 0 ? LZ4_compress_HC(raw.data(), dst, src_size, bound,
+                                             level)
+                           : LZ4_compress_default(raw.data(), dst, src_size,
+                                                  bound);
+      if (size <= 0) {
+        AERROR << "lz4 compress chunk failed.";
+        return false;
+      }
+      out->resize(kPrefixBytes + size);
+      return true;
+    }
+    case CompressType::COMPRESS_ZSTD: {
+      size_t bound = ZSTD_compressBound(raw.size());
+      out->resize(kPrefixBytes + bound);
+      size_t size =
+          ZSTD_compress(&(*out)[kPrefixBytes], bound, raw.data(), raw.size(),
+                        level == 0 ? kZstdDefaultLevel : level);
+      if (ZSTD_isError(size)) {
+        AERROR << "zstd compress chunk failed: " << ZSTD_getErrorName(size);
+        return false;
+      }
+      out->resize(kPrefixBytes + size);
+      return true;
+    }
+    default:
+      AERROR << "unsupported compress type: " << static_cast<int>(type);
+      return false;
+  }
+}
+
+bool ChunkCompressor::Decompress(const std::string& in, std::string* raw) {
+  return Decompress(in.data(), in.size(), raw);
+}
+
+bool ChunkCompressor::Decompress(const char* in, size_t size,
+                                 std::string* raw) {
+  if (size < kPrefixBytes) {
+    AERROR << "compressed chunk is truncated.";
+    return false;
+  }
+  uint64_t raw_size = GetRawSize(in);
+  auto type = static_cast<CompressType>(in[kSizeBytes]);
+  const char* src = in + kPrefixBytes;
+  size_t src_size = size - kPrefixBytes;
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      raw->assign(src, src_size);
+      return raw->size() == raw_size;
+    case CompressType::COMPRESS_LZ4: {
+      if (raw_size > LZ4_MAX_INPUT_SIZE) {
+        AERROR << "invalid lz4 chunk size: " << raw_size;
+        return false;
+      }
+      raw->resize(raw_size);
+      int size = LZ4_decompress_safe(src, &(*raw)[0],
+                                     static_cast<int>(src_size),
+                                     static_cast<int>(raw_size));
+      if (size < 0 || static_cast<uint64_t>(size) != raw_size) {
+        AERROR << "lz4 decompress chunk failed.";
+        return false;
+      }
+      return true;
+    }
+    case CompressType::COMPRESS_ZSTD: {
+      // check against the frame header before allocating for a broken size
+      if (ZSTD_getFrameContentSize(src, src_size) != raw_size) {
+        AERROR << "invalid zstd chunk size: " << raw_size;
+        return false;
+      }
+      raw->resize(raw_size);
+      size_t size = ZSTD_decompress(&(*raw)[0], raw_size, src, src_size);
+      if (ZSTD_isError(size) || size != raw_size) {
+        AERROR << "zstd decompress chunk failed.";
+        return false;
+      }
+      return true;
+    }
+    default:
+      AERROR << "unsupported compress type: " << static_cast<int>(type);
+      return false;
+  }
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+#define CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+
+#include <string>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief Compresses serialized chunk bodies. Every chunk is compressed on
+ * its own and describes itself: the uncompressed size as a 64 bit little
+ * endian integer and the compress type as one byte come first, followed by
+ * the data in the format of the codec.
+ */
+class ChunkCompressor {
+ public:
+  static bool IsSupported(proto::CompressType type);
+
+  /**
+   * @brief Compress raw into out.
+   *
+   * @param type codec, COMPRESS_NONE only adds the prefix
+   * @param level codec level, 0 for the default of the codec. For lz4 a
+   * positive level selects the high compression mode.
+   */
+  static bool Compress(proto::CompressType type, int level,
+                       const std::string& raw, std::string* out);
+
+  static bool Decompress(const std::string& in, std::string* raw);
+  static bool Decompress(const char* in, size_t size, std::string* raw);
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
@@ -37,15 +37,15 @@ class RecordFileBase {
   const std::string& GetPath() const { return path_; }
   const proto::Header& GetHeader() const { return header_; }
   const proto::Index& GetIndex() const { return index_; }
-  int64_t CurrentPosition();
-  bool SetPosition(int64_t position);
+  virtual int64_t CurrentPosition();
+  virtual bool SetPosition(int64_t position);
 
  protected:
   std::mutex mutex_;
   std::string path_;
   proto::Header header_;
   proto::Index index_;
-  int fd_;
+  int fd_ = -1;
 };
 
 }  // namespace record
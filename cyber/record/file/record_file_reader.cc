@@ -16,7 +16,13 @@
 
 #include "cyber/record/file/record_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cstring>
+
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 
 namespace apollo {
 namespace cyber {
@@ -38,6 +44,10 @@ bool RecordFileReader::Open(const std::string& path) {
     return false;
   }
   end_of_file_ = false;
+  if (use_mmap_ && !MapFile()) {
+    AWARN << "Map file failed, read it through the fd instead, file: "
+          << path_;
+  }
   if (!ReadHeader()) {
     AERROR << "Read header section fail, file: " << path_;
     return false;
@@ -45,7 +55,64 @@ bool RecordFileReader::Open(const std::string& path) {
   return true;
 }
 
-void RecordFileReader::Close() { close(fd_); }
+RecordFileReader::~RecordFileReader() { Close(); }
+
+void RecordFileReader::Close() {
+  UnmapFile();
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool RecordFileReader::MapFile() {
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) < 0 || file_stat.st_size <= 0) {
+    return false;
+  }
+  void* data =
+      mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (data == MAP_FAILED) {
+    AERROR << "mmap failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  // chunks are mostly read front to back, let the kernel read ahead
+  if (madvise(data, file_stat.st_size, MADV_SEQUENTIAL) < 0) {
+    AWARN << "madvise failed, file: " << path_ << ", errno: " << errno;
+  }
+  data_ = static_cast<const char*>(data);
+  data_size_ = file_stat.st_size;
+  position_ = 0;
+  return true;
+}
+
+void RecordFileReader::UnmapFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), data_size_);
+    data_ = nullptr;
+    data_size_ = 0;
+  }
+}
+
+int64_t RecordFileReader::CurrentPosition() {
+  if (data_ != nullptr) {
+    return position_;
+  }
+  return RecordFileBase::CurrentPosition();
+}
+
+bool RecordFileReader::SetPosition(int64_t position) {
+  if (data_ != nullptr) {
+    if (position < 0 || position > data_size_) {
+      AERROR << "Position out of the mapped file, file: " << path_
+             << ", position: " << position << ", size: " << data_size_;
+      return false;
+    }
+    position_ = position;
+    return true;
+  }
+  return RecordFileBase::SetPosition(position);
+}
 
 bool RecordFileReader::Reset() {
   if (!SetPosition(sizeof(struct Section) + HEADER_LENGTH)) {
@@ -110,6 +177,20 @@ bool RecordFileReader::ReadIndex() {
 }
 
 bool RecordFileReader::ReadSection(Section* section) {
+  if (data_ != nullptr) {
+    if (position_ >= data_size_) {
+      end_of_file_ = true;
+      AINFO << "Reach end of file.";
+      return false;
+    }
+    if (data_size_ - position_ < static_cast<int64_t>(sizeof(Section))) {
+      AERROR << "Section header is truncated, file: " << path_;
+      return false;
+    }
+    std::memcpy(section, data_ + position_, sizeof(Section));
+    position_ += sizeof(Section);
+    return true;
+  }
   ssize_t count = read(fd_, section, sizeof(struct Section));
   if (count < 0) {
     AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
@@ -142,6 +223,55 @@ bool RecordFileReader::SkipSection(int64_t size) {
   return true;
 }
 
+bool RecordFileReader::ReadCompressedSection(
+    int64_t size, google::protobuf::Message* message) {
+  if (data_ != nullptr) {
+    if (size > data_size_ - position_) {
+      AERROR << "Compressed section is truncated, expect: " << size
+             << ", actual: " << data_size_ - position_;
+      end_of_file_ = true;
+      return false;
+    }
+    position_ += size;
+    return ParseCompressedSection(data_ + position_ - size, size, message);
+  }
+
+  std::string data(size, '\0');
+  int64_t offset = 0;
+  while (offset < size) {
+    ssize_t count = read(fd_, &data[offset], size - offset);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    if (count == 0) {
+      end_of_file_ = true;
+      AERROR << "Compressed section is truncated, expect: " << size
+             << ", actual: " << offset;
+      return false;
+    }
+    offset += count;
+  }
+  return ParseCompressedSection(data.data(), size, message);
+}
+
+bool RecordFileReader::ParseCompressedSection(
+    const char* data, int64_t size, google::protobuf::Message* message) {
+  std::string raw;
+  if (!ChunkCompressor::Decompress(data, size, &raw)) {
+    AERROR << "Decompress section failed.";
+    return false;
+  }
+  if (!message->ParseFromString(raw)) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -24,6 +24,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -43,9 +44,18 @@ using google::protobuf::io::ZeroCopyInputStream;
 class RecordFileReader : public RecordFileBase {
  public:
   RecordFileReader() = default;
-  virtual ~RecordFileReader() = default;
+  /**
+   * @param use_mmap map the file and parse sections straight from the
+   * mapping instead of reading them through the file descriptor. Only the
+   * part of the file that exists at Open() is visible, so this does not fit
+   * files that are still being written.
+   */
+  explicit RecordFileReader(bool use_mmap) : use_mmap_(use_mmap) {}
+  virtual ~RecordFileReader();
   bool Open(const std::string& path) override;
   void Close() override;
+  int64_t CurrentPosition() override;
+  bool SetPosition(int64_t position) override;
   bool Reset();
   bool ReadSection(Section* section);
   bool SkipSection(int64_t size);
@@ -55,8 +65,22 @@ class RecordFileReader : public RecordFileBase {
   bool EndOfFile() { return end_of_file_; }
 
  private:
+  bool MapFile();
+  void UnmapFile();
   bool ReadHeader();
+  bool ReadCompressedSection(int64_t size,
+                             google::protobuf::Message* message);
+  bool ParseCompressedSection(const char* data, int64_t size,
+                              google::protobuf::Message* message);
+  template <typename T>
+  bool ReadMappedSection(int64_t size, T* message);
+
   bool end_of_file_ = false;
+  bool use_mmap_ = false;
+  // the mapped file, nullptr when reading through the file descriptor
+  const char* data_ = nullptr;
+  int64_t data_size_ = 0;
+  int64_t position_ = 0;
 };
 
 template <typename T>
@@ -65,6 +89,13 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
     AERROR << "Size value greater than the range of int value.";
     return false;
   }
+  if (std::is_same<T, proto::ChunkBody>::value &&
+      header_.compress() != proto::CompressType::COMPRESS_NONE) {
+    return ReadCompressedSection(size, message);
+  }
+  if (data_ != nullptr) {
+    return ReadMappedSection(size, message);
+  }
   FileInputStream raw_input(fd_, static_cast<int>(size));
   CodedInputStream coded_input(&raw_input);
   CodedInputStream::Limit limit = coded_input.PushLimit(static_cast<int>(size));
@@ -86,6 +117,24 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
   return true;
 }
 
+template <typename T>
+bool RecordFileReader::ReadMappedSection(int64_t size, T* message) {
+  if (size > data_size_ - position_) {
+    AERROR << "Section is truncated, expect: " << size
+           << ", actual: " << data_size_ - position_;
+    end_of_file_ = true;
+    return false;
+  }
+  const char* begin = data_ + position_;
+  position_ += size;
+  // the message is parsed in place, without copying it out of the mapping
+  if (!message->ParseFromArray(begin, static_cast<int>(size))) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
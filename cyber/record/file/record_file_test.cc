@@ -31,6 +31,7 @@ namespace record {
 using apollo::cyber::proto::Channel;
 using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleMessage;
@@ -306,6 +307,68 @@ TEST(RecordFileTest, TestIndex) {
   }
 }
 
+TEST(RecordFileTest, TestCompressedChunks) {
+  const int kMsgNum = 64;
+  const std::string content(1024, 'a');
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+
+    // a chunk every few messages, so that several are compressed at once
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 4 * 1024);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+
+    for (int i = 0; i < kMsgNum; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(kChan1);
+      msg.set_content(content + std::to_string(i));
+      msg.set_time(1e9 + i);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+    ASSERT_TRUE(rfw.GetHeader().is_complete());
+    ASSERT_GT(rfw.GetHeader().chunk_number(), 1);
+    ASSERT_EQ(kMsgNum, rfw.GetHeader().message_number());
+    ASSERT_GT(rfw.GetHeader().body_raw_size(),
+              rfw.GetHeader().body_stored_size());
+
+    RecordFileReader rfr;
+    ASSERT_TRUE(rfr.Open(kTestFile1));
+    ASSERT_EQ(type, rfr.GetHeader().compress());
+    Section sec;
+    int msg_num = 0;
+    while (rfr.ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr.SkipSection(sec.size));
+        continue;
+      }
+      ChunkBody body;
+      ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &body));
+      // the writer waits for the flush thread rather than growing a chunk
+      EXPECT_LE(body.messages_size(), 5);
+      for (const auto& msg : body.messages()) {
+        // chunks are written in the order they were filled
+        EXPECT_EQ(1e9 + msg_num, msg.time());
+        EXPECT_EQ(content + std::to_string(msg_num), msg.content());
+        ++msg_num;
+      }
+    }
+    EXPECT_EQ(kMsgNum, msg_num);
+    ASSERT_FALSE(remove(kTestFile1));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -19,6 +19,7 @@
 #include <fcntl.h>
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
@@ -31,10 +32,33 @@ using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkBodyCache;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleIndex;
 
+namespace {
+// chunks compressed at the same time, each one holds a full chunk in memory
+constexpr size_t kMaxCompressingChunks = 4;
+constexpr auto kFlushPollInterval = std::chrono::milliseconds(100);
+
+std::unique_ptr<Chunk> CompressChunk(std::unique_ptr<Chunk> chunk,
+                                     const CompressType compress_type,
+                                     const int compress_level) {
+  std::string raw;
+  chunk->body_->SerializeToString(&raw);
+  chunk->body_size_ = raw.size();
+  if (!ChunkCompressor::Compress(compress_type, compress_level, raw,
+                                 &chunk->compressed_body_)) {
+    AWARN << "Compress chunk failed, store it uncompressed.";
+    ChunkCompressor::Compress(CompressType::COMPRESS_NONE, 0, raw,
+                              &chunk->compressed_body_);
+  }
+  chunk->body_.reset();
+  return chunk;
+}
+}  // namespace
+
 RecordFileWriter::RecordFileWriter() {}
 
 RecordFileWriter::~RecordFileWriter() { Close(); }
@@ -65,24 +89,20 @@ bool RecordFileWriter::Open(const std::string& path) {
 
 void RecordFileWriter::Close() {
   if (is_writing_) {
-    // wait for the flush operation that may exist now
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    // last swap
     {
       std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      // wait for the flush operation that may exist now
+      flushed_cv_.wait(flush_lock, [this] { return chunk_flush_->empty(); });
+
+      // last swap
       chunk_flush_.swap(chunk_active_);
       flush_cv_.notify_one();
-    }
 
-    // wait for the last flush operation
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      // wait for the last flush operation, the chunks still compressing are
+      // written before the flush thread exits
+      flushed_cv_.wait(flush_lock, [this] { return chunk_flush_->empty(); });
+      is_writing_ = false;
     }
-
-    is_writing_ = false;
     flush_cv_.notify_all();
     if (flush_thread_ && flush_thread_->joinable()) {
       flush_thread_->join();
@@ -108,6 +128,11 @@ void RecordFileWriter::Close() {
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
   header_ = header;
+  if (!ChunkCompressor::IsSupported(header_.compress())) {
+    AWARN << "Compress type " << CompressType_Name(header_.compress())
+          << " is not supported, write uncompressed chunks.";
+    header_.set_compress(CompressType::COMPRESS_NONE);
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -156,9 +181,9 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
   return true;
 }
 
-bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
-                                  const ChunkBody& chunk_body) {
+bool RecordFileWriter::WriteChunk(const Chunk& chunk) {
   std::lock_guard<std::mutex> lock(mutex_);
+  const ChunkHeader& chunk_header = chunk.header_;
   uint64_t pos = CurrentPosition();
   if (!WriteSection<ChunkHeader>(chunk_header)) {
     AERROR << "Write chunk header fail";
@@ -175,9 +200,24 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
 
   pos = CurrentPosition();
-  if (!WriteSection<ChunkBody>(chunk_body)) {
-    AERROR << "Write chunk body fail";
-    return false;
+  if (header_.compress() == CompressType::COMPRESS_NONE) {
+    if (!WriteSection<ChunkBody>(*chunk.body_)) {
+      AERROR << "Write chunk body fail";
+      return false;
+    }
+    header_.set_body_raw_size(header_.body_raw_size() +
+                              chunk.body_->ByteSize());
+    header_.set_body_stored_size(header_.body_stored_size() +
+                                 chunk.body_->ByteSize());
+  } else {
+    if (!WriteSection(SectionType::SECTION_CHUNK_BODY,
+                      chunk.compressed_body_)) {
+      AERROR << "Write compressed chunk body fail";
+      return false;
+    }
+    header_.set_body_raw_size(header_.body_raw_size() + chunk.body_size_);
+    header_.set_body_stored_size(header_.body_stored_size() +
+                                 chunk.compressed_body_.size());
   }
   header_.set_chunk_number(header_.chunk_number() + 1);
   if (header_.begin_time() == 0) {
@@ -190,11 +230,42 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   single_index->set_type(SectionType::SECTION_CHUNK_BODY);
   single_index->set_position(pos);
   ChunkBodyCache* chunk_body_cache = new ChunkBodyCache();
-  chunk_body_cache->set_message_number(chunk_body.messages_size());
+  chunk_body_cache->set_message_number(chunk_header.message_number());
+  for (const auto& item : chunk.channel_message_number_) {
+    auto channel_cache = chunk_body_cache->add_channel_cache();
+    channel_cache->set_name(item.first);
+    channel_cache->set_message_number(item.second);
+  }
   single_index->set_allocated_chunk_body_cache(chunk_body_cache);
   return true;
 }
 
+bool RecordFileWriter::WriteSection(SectionType type, const std::string& data) {
+  Section section;
+  /// zero out whole struct even if padded
+  memset(&section, 0, sizeof(section));
+  section = {type, static_cast<int64_t>(data.size())};
+  ssize_t count = write(fd_, &section, sizeof(section));
+  if (count != sizeof(section)) {
+    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+    return false;
+  }
+  size_t written = 0;
+  while (written < data.size()) {
+    count = write(fd_, data.data() + written, data.size() - written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    written += count;
+  }
+  header_.set_size(CurrentPosition());
+  return true;
+}
+
 bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
   chunk_active_->add(message);
   auto it = channel_message_number_map_.find(message.channel_name());
@@ -219,6 +290,9 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
   }
   {
     std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+    // wait for the flush thread to take the last chunk, it takes no more
+    // than kMaxCompressingChunks at a time, which bounds the memory held
+    flushed_cv_.wait(flush_lock, [this] { return chunk_flush_->empty(); });
     chunk_flush_.swap(chunk_active_);
     flush_cv_.notify_one();
   }
@@ -226,20 +300,61 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
 }
 
 void RecordFileWriter::Flush() {
-  while (is_writing_) {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    flush_cv_.wait(flush_lock,
-                   [this] { return !chunk_flush_->empty() || !is_writing_; });
-    if (!is_writing_) {
-      break;
+  // Compressed chunks are compressed in parallel and written out in the
+  // order they were flushed.
+  std::deque<std::future<std::unique_ptr<Chunk>>> compressing;
+  while (true) {
+    std::unique_ptr<Chunk> chunk;
+    CompressType compress_type = CompressType::COMPRESS_NONE;
+    int compress_level = 0;
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      flush_cv_.wait_for(flush_lock, kFlushPollInterval, [this] {
+        return !chunk_flush_->empty() || !is_writing_;
+      });
+      if (!chunk_flush_->empty()) {
+        {
+          // WriteChunk changes header_ while the chunks are compressed
+          std::lock_guard<std::mutex> lock(mutex_);
+          compress_type = header_.compress();
+          compress_level = header_.compress_level();
+        }
+        if (compress_type == CompressType::COMPRESS_NONE) {
+          if (!WriteChunk(*chunk_flush_)) {
+            AERROR << "Write chunk fail.";
+          }
+          chunk_flush_->clear();
+          flushed_cv_.notify_one();
+          continue;
+        }
+        chunk.reset(new Chunk());
+        chunk.swap(chunk_flush_);
+        flushed_cv_.notify_one();
+      } else if (!is_writing_) {
+        break;
+      }
+    }
+
+    if (chunk != nullptr) {
+      compressing.emplace_back(std::async(std::launch::async, &CompressChunk,
+                                          std::move(chunk), compress_type,
+                                          compress_level));
     }
-    if (chunk_flush_->empty()) {
-      continue;
+    while (!compressing.empty() &&
+           (compressing.size() > kMaxCompressingChunks ||
+            compressing.front().wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready)) {
+      if (!WriteChunk(*compressing.front().get())) {
+        AERROR << "Write chunk fail.";
+      }
+      compressing.pop_front();
     }
-    if (!WriteChunk(chunk_flush_->header_, *(chunk_flush_->body_.get()))) {
+  }
+
+  for (auto& future : compressing) {
+    if (!WriteChunk(*future.get())) {
       AERROR << "Write chunk fail.";
     }
-    chunk_flush_->clear();
   }
 }
 
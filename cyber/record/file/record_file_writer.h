@@ -21,7 +21,10 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/text_format.h>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
@@ -43,6 +46,9 @@ struct Chunk {
 
   inline void clear() {
     body_.reset(new proto::ChunkBody());
+    compressed_body_.clear();
+    body_size_ = 0;
+    channel_message_number_.clear();
     header_.set_begin_time(0);
     header_.set_end_time(0);
     header_.set_message_number(0);
@@ -64,6 +70,7 @@ struct Chunk {
     }
     header_.set_message_number(header_.message_number() + 1);
     header_.set_raw_size(header_.raw_size() + message.content().size());
+    ++channel_message_number_[message.channel_name()];
   }
 
   inline bool empty() { return header_.message_number() == 0; }
@@ -71,6 +78,10 @@ struct Chunk {
   std::mutex mutex_;
   proto::ChunkHeader header_;
   std::unique_ptr<proto::ChunkBody> body_ = nullptr;
+  // filled by the flush thread when the record file is compressed
+  std::string compressed_body_;
+  uint64_t body_size_ = 0;
+  std::map<std::string, uint64_t> channel_message_number_;
 };
 
 class RecordFileWriter : public RecordFileBase {
@@ -85,10 +96,10 @@ class RecordFileWriter : public RecordFileBase {
   uint64_t GetMessageNumber(const std::string& channel_name) const;
 
  private:
-  bool WriteChunk(const proto::ChunkHeader& chunk_header,
-                  const proto::ChunkBody& chunk_body);
+  bool WriteChunk(const Chunk& chunk);
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteSection(proto::SectionType type, const std::string& data);
   bool WriteIndex();
   void Flush();
   bool is_writing_ = false;
@@ -97,6 +108,8 @@ class RecordFileWriter : public RecordFileBase {
   std::shared_ptr<std::thread> flush_thread_ = nullptr;
   std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
+  // notified when the flush thread took chunk_flush_
+  std::condition_variable flushed_cv_;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
 };
 
@@ -16,6 +16,7 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace apollo {
@@ -27,10 +28,14 @@ using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::SectionType;
 
-RecordReader::~RecordReader() {}
+RecordReader::~RecordReader() { StopPrefetch(); }
 
-RecordReader::RecordReader(const std::string& file) {
-  file_reader_.reset(new RecordFileReader());
+RecordReader::RecordReader(const std::string& file)
+    : RecordReader(file, ReadOptions()) {}
+
+RecordReader::RecordReader(const std::string& file, const ReadOptions& options)
+    : options_(options) {
+  file_reader_.reset(new RecordFileReader(options_.use_mmap));
   if (!file_reader_->Open(file)) {
     AERROR << "Failed to open record file: " << file;
     return;
@@ -53,17 +58,62 @@ RecordReader::RecordReader(const std::string& file) {
       channel_info_.insert(
           std::make_pair(channel_cache->name(), *channel_cache));
     }
+    BuildChunkIndex();
   }
   file_reader_->Reset();
 }
 
+void RecordReader::BuildChunkIndex() {
+  // the writer indexes every chunk header right before its body
+  ChunkInfo chunk;
+  bool has_header = false;
+  for (const auto& single_idx : index_.indexes()) {
+    if (single_idx.type() == SectionType::SECTION_CHUNK_HEADER &&
+        single_idx.has_chunk_header_cache()) {
+      const auto& cache = single_idx.chunk_header_cache();
+      chunk = ChunkInfo();
+      chunk.begin_time = cache.begin_time();
+      chunk.end_time = cache.end_time();
+      has_header = true;
+    } else if (single_idx.type() == SectionType::SECTION_CHUNK_BODY &&
+               has_header) {
+      chunk.body_position = single_idx.position();
+      for (const auto& channel_cache :
+           single_idx.chunk_body_cache().channel_cache()) {
+        chunk.channels.insert(channel_cache.name());
+      }
+      chunk.max_end_time = chunk_index_.empty()
+                               ? chunk.end_time
+                               : std::max(chunk.end_time,
+                                          chunk_index_.back().max_end_time);
+      chunk_index_.emplace_back(std::move(chunk));
+      has_header = false;
+    }
+  }
+  if (chunk_index_.size() != header_.chunk_number()) {
+    AWARN << "Chunk index does not match the header, scan the file instead"
+          << ", indexed: " << chunk_index_.size()
+          << ", chunks: " << header_.chunk_number();
+    chunk_index_.clear();
+  }
+}
+
 void RecordReader::Reset() {
+  StopPrefetch();
   file_reader_->Reset();
   reach_end_ = false;
+  next_chunk_ = 0;
   message_index_ = 0;
   chunk_.reset(new ChunkBody());
 }
 
+void RecordReader::set_prefetch_enabled(bool enabled) {
+  if (!enabled) {
+    StopPrefetch();
+  }
+  prefetch_enabled_ = enabled;
+}
+
 std::set<std::string> RecordReader::GetChannelList() const {
   std::set<std::string> channel_list;
   for (auto& item : channel_info_) {
@@ -73,7 +123,8 @@ std::set<std::string> RecordReader::GetChannelList() const {
 }
 
 bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
-                               uint64_t end_time) {
+                               uint64_t end_time,
+                               const std::set<std::string>& channels) {
   if (!is_valid_) {
     return false;
   }
@@ -92,6 +143,9 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     if (time < begin_time) {
       continue;
     }
+    if (!channels.empty() && channels.count(next_message.channel_name()) == 0) {
+      continue;
+    }
 
     message->channel_name = next_message.channel_name();
     message->content = next_message.content();
@@ -100,16 +154,178 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   }
 
   ADEBUG << "Read next chunk.";
-  if (ReadNextChunk(begin_time, end_time)) {
+  if (ReadNextChunk(begin_time, end_time, channels)) {
     ADEBUG << "Read chunk successfully.";
     message_index_ = 0;
-    return ReadMessage(message, begin_time, end_time);
+    return ReadMessage(message, begin_time, end_time, channels);
   }
   ADEBUG << "No chunk to read.";
   return false;
 }
 
-bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
+size_t RecordReader::SeekChunk(size_t from, uint64_t begin_time) const {
+  // every chunk before the first one that may end at or after begin_time can
+  // be passed over without looking at it
+  auto first = std::lower_bound(
+      chunk_index_.begin() + from, chunk_index_.end(), begin_time,
+      [](const ChunkInfo& chunk, uint64_t time) {
+        return chunk.max_end_time < time;
+      });
+  return first - chunk_index_.begin();
+}
+
+bool RecordReader::NeedChunk(const ChunkInfo& chunk, uint64_t begin_time,
+                             const std::set<std::string>& channels) const {
+  if (chunk.end_time < begin_time) {
+    return false;
+  }
+  if (channels.empty() || chunk.channels.empty()) {
+    return true;
+  }
+  return std::any_of(channels.begin(), channels.end(),
+                     [&chunk](const std::string& channel) {
+                       return chunk.channels.count(channel) > 0;
+                     });
+}
+
+bool RecordReader::ReadChunkBody(const ChunkInfo& chunk, ChunkBody* body) {
+  Section section;
+  if (!file_reader_->SetPosition(chunk.body_position) ||
+      !file_reader_->ReadSection(&section) ||
+      section.type != SectionType::SECTION_CHUNK_BODY) {
+    AERROR << "Failed to seek to chunk body at " << chunk.body_position
+           << ", file: " << file_reader_->GetPath();
+    return false;
+  }
+  if (!file_reader_->ReadSection<ChunkBody>(section.size, body)) {
+    AERROR << "Failed to read chunk body section.";
+    return false;
+  }
+  return true;
+}
+
+bool RecordReader::ReadNextIndexedChunk(uint64_t begin_time, uint64_t end_time,
+                                        const std::set<std::string>& channels) {
+  next_chunk_ = SeekChunk(next_chunk_, begin_time);
+  while (next_chunk_ < chunk_index_.size()) {
+    const auto& chunk = chunk_index_[next_chunk_];
+    if (chunk.begin_time > end_time) {
+      return false;
+    }
+    ++next_chunk_;
+    if (!NeedChunk(chunk, begin_time, channels)) {
+      continue;
+    }
+    chunk_.reset(new ChunkBody());
+    return ReadChunkBody(chunk, chunk_.get());
+  }
+  reach_end_ = true;
+  return false;
+}
+
+bool RecordReader::ReadPrefetchedChunk(uint64_t begin_time, uint64_t end_time,
+                                       const std::set<std::string>& channels) {
+  // a later begin time only drops more chunks, which is done here, anything
+  // else changes what the thread has to read
+  if (!prefetch_thread_.joinable() || begin_time < prefetch_begin_time_ ||
+      channels != prefetch_channels_) {
+    StopPrefetch();
+    StartPrefetch(begin_time, channels);
+  }
+
+  std::unique_lock<std::mutex> lock(prefetch_mutex_);
+  while (true) {
+    prefetch_cv_.wait(
+        lock, [this] { return !prefetched_.empty() || prefetch_done_; });
+    if (prefetched_.empty()) {
+      reach_end_ = true;
+      return false;
+    }
+    auto& front = prefetched_.front();
+    const auto& chunk = chunk_index_[front.first];
+    if (chunk.begin_time > end_time) {
+      // keep it for a later time range
+      return false;
+    }
+    next_chunk_ = front.first + 1;
+    ChunkPtr body = std::move(front.second);
+    prefetched_.pop_front();
+    prefetch_cv_.notify_all();
+    if (body == nullptr) {
+      return false;
+    }
+    if (chunk.end_time < begin_time) {
+      continue;
+    }
+    chunk_ = std::move(body);
+    return true;
+  }
+}
+
+void RecordReader::StartPrefetch(uint64_t begin_time,
+                                 const std::set<std::string>& channels) {
+  prefetch_begin_time_ = begin_time;
+  prefetch_channels_ = channels;
+  prefetched_.clear();
+  prefetch_running_ = true;
+  prefetch_done_ = false;
+  prefetch_thread_ = std::thread(&RecordReader::PrefetchFunc, this,
+                                 SeekChunk(next_chunk_, begin_time));
+}
+
+void RecordReader::StopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_running_ = false;
+  }
+  prefetch_cv_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  prefetched_.clear();
+}
+
+void RecordReader::PrefetchFunc(size_t first_chunk) {
+  for (size_t i = first_chunk; i < chunk_index_.size(); ++i) {
+    const auto& chunk = chunk_index_[i];
+    if (!NeedChunk(chunk, prefetch_begin_time_, prefetch_channels_)) {
+      continue;
+    }
+    ChunkPtr body(new ChunkBody());
+    if (!ReadChunkBody(chunk, body.get())) {
+      body.reset();
+    }
+    bool failed = body == nullptr;
+
+    std::unique_lock<std::mutex> lock(prefetch_mutex_);
+    prefetch_cv_.wait(lock, [this] {
+      return prefetched_.size() < options_.prefetch_chunks ||
+             !prefetch_running_;
+    });
+    if (!prefetch_running_) {
+      return;
+    }
+    prefetched_.emplace_back(i, std::move(body));
+    prefetch_cv_.notify_all();
+    if (failed) {
+      break;
+    }
+  }
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  prefetch_done_ = true;
+  prefetch_cv_.notify_all();
+}
+
+bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time,
+                                 const std::set<std::string>& channels) {
+  if (!chunk_index_.empty()) {
+    if (options_.prefetch_chunks > 0 && prefetch_enabled_) {
+      return ReadPrefetchedChunk(begin_time, end_time, channels);
+    }
+    return ReadNextIndexedChunk(begin_time, end_time, channels);
+  }
+
+  // files without a usable index are scanned section by section
   bool skip_next_chunk_body = false;
   while (!reach_end_) {
     Section section;
@@ -17,10 +17,16 @@
 #ifndef CYBER_RECORD_RECORD_READER_H_
 #define CYBER_RECORD_RECORD_READER_H_
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cyber/proto/record.pb.h"
 #include "cyber/record/file/record_file_reader.h"
@@ -31,6 +37,17 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+/**
+ * @brief How a record reader gets chunks out of the file.
+ */
+struct ReadOptions {
+  // map the file and parse chunks straight from the mapping
+  bool use_mmap = false;
+  // number of chunks a background thread decodes ahead of the reader, 0 to
+  // decode them on the reading thread. Needs the index of a complete file.
+  uint32_t prefetch_chunks = 0;
+};
+
 /**
  * @brief The record reader.
  */
@@ -46,6 +63,14 @@ class RecordReader : public RecordBase {
    */
   explicit RecordReader(const std::string& file);
 
+  /**
+   * @brief The constructor with record file path and read options.
+   *
+   * @param file
+   * @param options
+   */
+  RecordReader(const std::string& file, const ReadOptions& options);
+
   /**
    * @brief The destructor.
    */
@@ -64,17 +89,28 @@ class RecordReader : public RecordBase {
    * @param message
    * @param begin_time
    * @param end_time
+   * @param channels only read messages of these channels, empty for all
    *
    * @return True for success, flase for not.
    */
   bool ReadMessage(RecordMessage* message, uint64_t begin_time = 0,
-                   uint64_t end_time = UINT64_MAX);
+                   uint64_t end_time = UINT64_MAX,
+                   const std::set<std::string>& channels = {});
 
   /**
    * @brief Reset the message index of record reader.
    */
   void Reset();
 
+  /**
+   * @brief Pause or resume the prefetch thread of the read options, for
+   * callers which read on a thread of their own already. Call it while no
+   * read is running.
+   *
+   * @param enabled
+   */
+  void set_prefetch_enabled(bool enabled);
+
   /**
    * @brief Get message number by channel name.
    *
@@ -112,7 +148,35 @@ class RecordReader : public RecordBase {
   std::set<std::string> GetChannelList() const override;
 
  private:
-  bool ReadNextChunk(uint64_t begin_time, uint64_t end_time);
+  // Position and contents of one chunk, taken from the index section.
+  struct ChunkInfo {
+    int64_t body_position = 0;
+    uint64_t begin_time = 0;
+    uint64_t end_time = 0;
+    // largest end time of this chunk and all chunks before it, chunks are
+    // not strictly ordered by time but this is, so it can be searched
+    uint64_t max_end_time = 0;
+    // empty if the file does not record the channels of its chunks
+    std::set<std::string> channels;
+  };
+
+  using ChunkPtr = std::unique_ptr<proto::ChunkBody>;
+
+  void BuildChunkIndex();
+  size_t SeekChunk(size_t from, uint64_t begin_time) const;
+  bool NeedChunk(const ChunkInfo& chunk, uint64_t begin_time,
+                 const std::set<std::string>& channels) const;
+  bool ReadChunkBody(const ChunkInfo& chunk, proto::ChunkBody* body);
+  bool ReadNextChunk(uint64_t begin_time, uint64_t end_time,
+                     const std::set<std::string>& channels);
+  bool ReadNextIndexedChunk(uint64_t begin_time, uint64_t end_time,
+                            const std::set<std::string>& channels);
+  bool ReadPrefetchedChunk(uint64_t begin_time, uint64_t end_time,
+                           const std::set<std::string>& channels);
+  void StartPrefetch(uint64_t begin_time,
+                     const std::set<std::string>& channels);
+  void StopPrefetch();
+  void PrefetchFunc(size_t first_chunk);
 
   bool is_valid_ = false;
   bool reach_end_ = false;
@@ -121,6 +185,21 @@ class RecordReader : public RecordBase {
   int message_index_ = 0;
   ChannelInfoMap channel_info_;
   FileReaderPtr file_reader_;
+  std::vector<ChunkInfo> chunk_index_;
+  size_t next_chunk_ = 0;
+
+  ReadOptions options_;
+  bool prefetch_enabled_ = true;
+  // The prefetch thread owns file_reader_ while it runs and hands decoded
+  // chunks over in index order, nullptr marks a chunk it failed to read.
+  std::thread prefetch_thread_;
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cv_;
+  std::deque<std::pair<size_t, ChunkPtr>> prefetched_;
+  bool prefetch_running_ = false;
+  bool prefetch_done_ = false;
+  uint64_t prefetch_begin_time_ = 0;
+  std::set<std::string> prefetch_channels_;
 };
 
 }  // namespace record
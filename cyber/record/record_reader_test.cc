@@ -15,9 +15,11 @@
  *****************************************************************************/
 
 #include "cyber/record/record_reader.h"
+#include "cyber/record/header_builder.h"
 #include "cyber/record/record_writer.h"
 
 #include <gtest/gtest.h>
+#include <set>
 #include <string>
 
 namespace apollo {
@@ -27,6 +29,7 @@ namespace record {
 using apollo::cyber::message::RawMessage;
 
 constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
 constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
 constexpr char kProtoDesc[] = "1234567890";
 constexpr char kStr10B[] = "1234567890";
@@ -86,6 +89,61 @@ TEST(RecordTest, TestSingleRecordFile) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, TestSeekAndSkipChunks) {
+  // a new chunk about every ten messages, channel2 only in [60, 70)
+  RecordWriter writer(HeaderBuilder::GetHeaderWithChunkParams(9, 0));
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc);
+  for (uint64_t i = 0; i < 100; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    const char* channel = i >= 60 && i < 70 ? kChannelName2 : kChannelName1;
+    writer.WriteMessage(channel, msg, i);
+  }
+  writer.Close();
+
+  // the same through the fd, the mapped file and the prefetch thread
+  ReadOptions mapped;
+  mapped.use_mmap = true;
+  ReadOptions prefetched;
+  prefetched.use_mmap = true;
+  prefetched.prefetch_chunks = 2;
+  for (const auto& options : {ReadOptions(), mapped, prefetched}) {
+    RecordReader reader(kTestFile, options);
+    RecordMessage message;
+    std::set<std::string> channel2 = {kChannelName2};
+    for (uint64_t i = 60; i < 70; ++i) {
+      ASSERT_TRUE(reader.ReadMessage(&message, 30, UINT64_MAX, channel2));
+      ASSERT_EQ(kChannelName2, message.channel_name);
+      ASSERT_EQ(i, message.time);
+    }
+    ASSERT_FALSE(reader.ReadMessage(&message, 30, UINT64_MAX, channel2));
+
+    reader.Reset();
+    std::set<std::string> channel1 = {kChannelName1};
+    for (uint64_t i = 55; i <= 75; ++i) {
+      if (i >= 60 && i < 70) {
+        continue;
+      }
+      ASSERT_TRUE(reader.ReadMessage(&message, 55, 75, channel1));
+      ASSERT_EQ(kChannelName1, message.channel_name);
+      ASSERT_EQ(std::to_string(i), message.content);
+      ASSERT_EQ(i, message.time);
+    }
+    ASSERT_FALSE(reader.ReadMessage(&message, 55, 75, channel1));
+
+    reader.Reset();
+    for (uint64_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(reader.ReadMessage(&message));
+      ASSERT_EQ(i, message.time);
+    }
+    ASSERT_FALSE(reader.ReadMessage(&message));
+  }
+  ASSERT_FALSE(remove(kTestFile));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -17,6 +17,10 @@
 #include "cyber/record/record_viewer.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -25,6 +29,130 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+/**
+ * @brief Decodes one reader on its own thread. It reads the same time steps
+ * as FillBuffer() and sorts each of them, so the messages come out in the
+ * order msg_buffer_ would give them for this reader.
+ *
+ * At most capacity_ messages wait to be merged, counting those of the step
+ * being read, unless a single step has more than that, which is then queued
+ * alone as FillBuffer() would buffer it. The thread is the only read ahead,
+ * the prefetch thread of the reader is paused while it runs.
+ */
+class RecordViewer::MergeSource {
+ public:
+  MergeSource(const RecordReaderPtr& reader, const RecordViewer* viewer)
+      : reader_(reader),
+        begin_time_(viewer->begin_time_),
+        end_time_(viewer->end_time_),
+        step_time_(viewer->kStepTimeNanoSec),
+        capacity_(viewer->kBufferMinSize),
+        channels_(viewer->channels_) {}
+
+  ~MergeSource() { Stop(); }
+
+  void Start() {
+    reader_->set_prefetch_enabled(false);
+    running_ = true;
+    thread_ = std::thread(&MergeSource::DecodeFunc, this);
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+      reader_->set_prefetch_enabled(true);
+    }
+  }
+
+  // Blocks until the next message is decoded, nullptr after the last one.
+  RecordMessage* Front() {
+    if (pos_ < batch_.size()) {
+      return &batch_[pos_];
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !batches_.empty() || done_; });
+    if (batches_.empty()) {
+      return nullptr;
+    }
+    batch_ = std::move(batches_.front());
+    batches_.pop_front();
+    queued_ -= batch_.size();
+    pos_ = 0;
+    cv_.notify_all();
+    return &batch_[pos_];
+  }
+
+  void Pop() { ++pos_; }
+
+ private:
+  void DecodeFunc() {
+    const auto& header = reader_->GetHeader();
+    uint64_t this_begin_time = begin_time_;
+    while (this_begin_time <= end_time_ &&
+           header.end_time() >= this_begin_time) {
+      uint64_t this_end_time =
+          std::min(this_begin_time + step_time_, end_time_);
+      std::vector<RecordMessage> batch;
+      RecordMessage message;
+      while (reader_->ReadMessage(&message, this_begin_time, this_end_time,
+                                  channels_)) {
+        batch.emplace_back(std::move(message));
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this, &batch] {
+          return queued_ + batch.size() <= capacity_ || batches_.empty() ||
+                 !running_;
+        });
+        if (!running_) {
+          return;
+        }
+      }
+      this_begin_time = this_end_time + 1;
+      if (batch.empty()) {
+        continue;
+      }
+      std::stable_sort(batch.begin(), batch.end(),
+                       [](const RecordMessage& lhs, const RecordMessage& rhs) {
+                         return lhs.time < rhs.time;
+                       });
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) {
+        return;
+      }
+      queued_ += batch.size();
+      batches_.emplace_back(std::move(batch));
+      cv_.notify_all();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    cv_.notify_all();
+  }
+
+  RecordReaderPtr reader_;
+  uint64_t begin_time_;
+  uint64_t end_time_;
+  uint64_t step_time_;
+  size_t capacity_;
+  std::set<std::string> channels_;
+  std::thread thread_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::vector<RecordMessage>> batches_;
+  size_t queued_ = 0;
+  bool running_ = false;
+  bool done_ = false;
+
+  // owned by the merging thread
+  std::vector<RecordMessage> batch_;
+  size_t pos_ = 0;
+};
+
 RecordViewer::RecordViewer(const RecordReaderPtr& reader, uint64_t begin_time,
                            uint64_t end_time,
                            const std::set<std::string>& channels)
@@ -57,6 +185,9 @@ bool RecordViewer::IsValid() const {
 }
 
 bool RecordViewer::Update(RecordMessage* message) {
+  if (parallel_merge_) {
+    return Merge(message);
+  }
   bool find = false;
   do {
     if (msg_buffer_.empty() && !FillBuffer()) {
@@ -100,12 +231,71 @@ void RecordViewer::Init() {
 }
 
 void RecordViewer::Reset() {
+  // the sources must stop using the readers first
+  for (auto& source : sources_) {
+    source->Stop();
+  }
+  sources_.clear();
+  merge_heap_ = decltype(merge_heap_)();
+  merged_sources_ = 0;
+  started_sources_ = 0;
+
   for (auto& reader : readers_) {
     reader->Reset();
   }
   std::fill(readers_finished_.begin(), readers_finished_.end(), false);
   curr_begin_time_ = begin_time_;
   msg_buffer_.clear();
+
+  if (parallel_merge_) {
+    for (auto& reader : readers_) {
+      sources_.emplace_back(std::make_shared<MergeSource>(reader, this));
+    }
+  }
+}
+
+void RecordViewer::StartNextSource() {
+  // sources are started ahead of the merge, so that readers which come next
+  // are already decoding when their first message is needed
+  size_t ahead = std::max(1U, std::thread::hardware_concurrency());
+  size_t index = merged_sources_++;
+  while (started_sources_ < sources_.size() &&
+         started_sources_ <= index + ahead) {
+    sources_[started_sources_++]->Start();
+  }
+  auto message = sources_[index]->Front();
+  if (message != nullptr) {
+    merge_heap_.emplace(message->time, index);
+  } else {
+    sources_[index]->Stop();
+  }
+}
+
+bool RecordViewer::Merge(RecordMessage* message) {
+  // readers are sorted by begin time, a reader that begins after the
+  // earliest pending message can not have anything to go before it
+  while (merged_sources_ < sources_.size() &&
+         (merge_heap_.empty() ||
+          readers_[merged_sources_]->GetHeader().begin_time() <=
+              merge_heap_.top().first)) {
+    StartNextSource();
+  }
+  if (merge_heap_.empty()) {
+    return false;
+  }
+
+  size_t index = merge_heap_.top().second;
+  merge_heap_.pop();
+  auto& source = sources_[index];
+  *message = std::move(*source->Front());
+  source->Pop();
+  auto next = source->Front();
+  if (next != nullptr) {
+    merge_heap_.emplace(next->time, index);
+  } else {
+    source->Stop();
+  }
+  return true;
 }
 
 void RecordViewer::UpdateTime() {
@@ -160,7 +350,7 @@ bool RecordViewer::FillBuffer() {
       while (true) {
         auto record_msg = std::make_shared<RecordMessage>();
         if (!reader->ReadMessage(record_msg.get(), this_begin_time,
-                                 this_end_time)) {
+                                 this_end_time, channels_)) {
           break;
         }
         msg_buffer_.emplace(std::make_pair(record_msg->time, record_msg));
@@ -18,10 +18,13 @@
 #define CYBER_RECORD_RECORD_VIEWER_H_
 
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <queue>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/record/record_message.h"
@@ -62,6 +65,18 @@ class RecordViewer {
                uint64_t begin_time = 0, uint64_t end_time = UINT64_MAX,
                const std::set<std::string>& channels = std::set<std::string>());
 
+  /**
+   * @brief Decode the readers on worker threads, one per reader, and merge
+   * their messages by time, instead of reading them all on the iterating
+   * thread. Messages come out in the same order either way. Takes effect at
+   * the next begin().
+   *
+   * @param parallel_merge
+   */
+  void set_parallel_merge(bool parallel_merge) {
+    parallel_merge_ = parallel_merge;
+  }
+
   /**
    * @brief Is this record reader is valid.
    *
@@ -176,12 +191,16 @@ class RecordViewer {
 
  private:
   friend class Iterator;
+  class MergeSource;
+  using MergeEntry = std::pair<uint64_t, size_t>;
 
   void Init();
   void Reset();
   void UpdateTime();
   bool FillBuffer();
   bool Update(RecordMessage* message);
+  bool Merge(RecordMessage* message);
+  void StartNextSource();
 
   uint64_t begin_time_ = 0;
   uint64_t end_time_ = UINT64_MAX;
@@ -195,6 +214,17 @@ class RecordViewer {
   uint64_t curr_begin_time_ = 0;
   std::multimap<uint64_t, std::shared_ptr<RecordMessage>> msg_buffer_;
 
+  // Parallel merge: one source per reader, in the order of readers_. The
+  // heap holds the time of the front message of every started source that
+  // is not done yet, ties go to the first reader like in msg_buffer_.
+  bool parallel_merge_ = false;
+  std::vector<std::shared_ptr<MergeSource>> sources_;
+  std::priority_queue<MergeEntry, std::vector<MergeEntry>,
+                      std::greater<MergeEntry>>
+      merge_heap_;
+  size_t merged_sources_ = 0;
+  size_t started_sources_ = 0;
+
   const uint64_t kStepTimeNanoSec = 1000000000UL;  // 1 second
   const std::size_t kBufferMinSize = 128;
 };
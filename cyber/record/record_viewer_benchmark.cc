@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cyber/record/record_reader.h"
+#include "cyber/record/record_viewer.h"
+#include "cyber/record/record_writer.h"
+
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::record::RecordReader;
+using apollo::cyber::record::RecordViewer;
+using apollo::cyber::record::RecordWriter;
+
+namespace {
+
+const char kMessageType[] = "apollo.cyber.proto.Test";
+const char kProtoDesc[] = "1234567890";
+const uint64_t kTimeStepNs = 1000000;  // 1ms
+const size_t kContentSize = 1024;
+
+// Splits total_msg_num messages over file_num files like a recording that
+// was segmented by time, every file holds the next part of the timeline.
+std::vector<std::string> WriteSplitRecord(const std::string& dir,
+                                          uint32_t file_num,
+                                          uint64_t total_msg_num) {
+  std::vector<std::string> files;
+  std::string content(kContentSize, 'x');
+  uint64_t msg_per_file = total_msg_num / file_num;
+  for (uint32_t i = 0; i < file_num; ++i) {
+    std::string file = dir + "/viewer_benchmark." + std::to_string(i);
+    RecordWriter writer;
+    writer.SetSizeOfFileSegmentation(0);
+    writer.SetIntervalOfFileSegmentation(0);
+    writer.Open(file);
+    for (uint32_t channel = 0; channel < 4; ++channel) {
+      writer.WriteChannel("/benchmark/" + std::to_string(channel),
+                          kMessageType, kProtoDesc);
+    }
+    for (uint64_t j = 0; j < msg_per_file; ++j) {
+      uint64_t index = i * msg_per_file + j;
+      writer.WriteMessage("/benchmark/" + std::to_string(index % 4),
+                          std::make_shared<RawMessage>(content),
+                          (index + 1) * kTimeStepNs);
+    }
+    writer.Close();
+    files.emplace_back(file);
+  }
+  return files;
+}
+
+double MessagesPerSecond(const std::vector<std::string>& files,
+                         bool parallel_merge, uint64_t* msg_num) {
+  std::vector<RecordViewer::RecordReaderPtr> readers;
+  for (const auto& file : files) {
+    readers.emplace_back(std::make_shared<RecordReader>(file));
+  }
+  RecordViewer viewer(readers);
+  viewer.set_parallel_merge(parallel_merge);
+
+  auto start = std::chrono::steady_clock::now();
+  *msg_num = 0;
+  for (auto& msg : viewer) {
+    if (!msg.content.empty()) {
+      ++*msg_num;
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return static_cast<double>(*msg_num) / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 3) {
+    std::cout << "Usage: " << argv[0]
+              << " [total message number, default 200000] [dir, default /tmp]"
+              << std::endl;
+    return -1;
+  }
+  uint64_t total_msg_num = 200000;
+  if (argc > 1) {
+    total_msg_num = std::strtoull(argv[1], nullptr, 10);
+  }
+  std::string dir = argc > 2 ? argv[2] : "/tmp";
+
+  for (uint32_t file_num : {1, 2, 5, 10, 20, 50}) {
+    auto files = WriteSplitRecord(dir, file_num, total_msg_num);
+    uint64_t serial_num = 0;
+    uint64_t parallel_num = 0;
+    double serial = MessagesPerSecond(files, false, &serial_num);
+    double parallel = MessagesPerSecond(files, true, &parallel_num);
+    std::cout << "files: " << file_num << " messages: " << serial_num
+              << " serial: " << static_cast<uint64_t>(serial) << " msg/s"
+              << " parallel: " << static_cast<uint64_t>(parallel) << " msg/s"
+              << (serial_num == parallel_num ? "" : " MISMATCH") << std::endl;
+    for (const auto& file : files) {
+      std::remove(file.c_str());
+    }
+  }
+  return 0;
+}
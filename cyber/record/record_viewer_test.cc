@@ -22,6 +22,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "cyber/record/record_reader.h"
@@ -34,6 +35,7 @@ namespace record {
 using apollo::cyber::message::RawMessage;
 
 constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
 constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
 constexpr char kProtoDesc1[] = "1234567890";
 constexpr char kTestFile[] = "viewer_test.record";
@@ -182,6 +184,77 @@ TEST(RecordTest, mult_iterator_test) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+void ConstructRecord(const std::string& file, const std::string& channel,
+                     uint64_t msg_num, uint64_t begin_time,
+                     uint64_t time_step) {
+  RecordWriter writer;
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(file);
+  writer.WriteChannel(channel, kMessageType1, kProtoDesc1);
+  for (uint64_t i = 0; i < msg_num; i++) {
+    auto msg = std::make_shared<RawMessage>(file + std::to_string(i));
+    writer.WriteMessage(channel, msg, begin_time + time_step * i);
+  }
+  writer.Close();
+}
+
+std::vector<RecordMessage> ReadAll(const std::vector<std::string>& files,
+                                   bool parallel_merge, uint64_t begin_time,
+                                   uint64_t end_time,
+                                   const std::set<std::string>& channels,
+                                   const ReadOptions& options = ReadOptions()) {
+  std::vector<RecordViewer::RecordReaderPtr> readers;
+  for (const auto& file : files) {
+    readers.emplace_back(std::make_shared<RecordReader>(file, options));
+  }
+  RecordViewer viewer(readers, begin_time, end_time, channels);
+  viewer.set_parallel_merge(parallel_merge);
+  std::vector<RecordMessage> messages;
+  for (auto& msg : viewer) {
+    messages.emplace_back(msg);
+  }
+  return messages;
+}
+
+TEST(RecordTest, parallel_merge_test) {
+  uint64_t step_time = 100000000;  // 100ms
+  std::vector<std::string> files = {
+      "viewer_test_a.record", "viewer_test_b.record", "viewer_test_c.record",
+      "viewer_test_d.record"};
+  // b interleaves with a, c overlaps a with the same timestamps, d has more
+  // messages in one second than a source queues
+  ConstructRecord(files[0], kChannelName1, 100, 0, step_time);
+  ConstructRecord(files[1], kChannelName2, 100, step_time / 2, step_time);
+  ConstructRecord(files[2], kChannelName1, 100, step_time * 50, step_time);
+  ConstructRecord(files[3], kChannelName2, 300, step_time * 20 + 1,
+                  step_time / 1000);
+  ReadOptions prefetched;
+  prefetched.prefetch_chunks = 2;
+
+  for (const auto& channels :
+       {std::set<std::string>(), std::set<std::string>({kChannelName1})}) {
+    for (uint64_t begin_time : {0UL, step_time * 30}) {
+      auto expected =
+          ReadAll(files, false, begin_time, step_time * 120, channels);
+      ASSERT_FALSE(expected.empty());
+      for (const auto& options : {ReadOptions(), prefetched}) {
+        auto merged = ReadAll(files, true, begin_time, step_time * 120,
+                              channels, options);
+        ASSERT_EQ(expected.size(), merged.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+          EXPECT_EQ(expected[i].channel_name, merged[i].channel_name);
+          EXPECT_EQ(expected[i].content, merged[i].content);
+          EXPECT_EQ(expected[i].time, merged[i].time);
+        }
+      }
+    }
+  }
+  for (const auto& file : files) {
+    ASSERT_FALSE(remove(file.c_str()));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -125,6 +125,16 @@ class RecordWriter : public RecordBase {
    */
   bool SetIntervalOfFileSegmentation(uint64_t time_sec);
 
+  /**
+   * @brief Set the compression of the chunks in the record file.
+   *
+   * @param type
+   * @param level codec level, 0 for the default of the codec
+   *
+   * @return True for success, false for fail.
+   */
+  bool SetCompression(proto::CompressType type, int level = 0);
+
   /**
    * @brief Get message number by channel name.
    *
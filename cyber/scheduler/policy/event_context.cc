@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/event_context.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+
+namespace {
+
+int64_t SteadyNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void ReadyNotifier::Notify() {
+  ready_num_.fetch_add(1);
+  if (waiters_.load() > 0) {
+    { std::lock_guard<std::mutex> lg(mtx_wq_); }
+    cv_wq_.notify_one();
+  }
+}
+
+void ReadyNotifier::Wait(std::chrono::nanoseconds timeout) {
+  waiters_.fetch_add(1);
+  {
+    std::unique_lock<std::mutex> lk(mtx_wq_);
+    cv_wq_.wait_for(lk, timeout, [this]() {
+      return stop_.load() || ready_num_.load() > 0;
+    });
+  }
+  waiters_.fetch_sub(1);
+}
+
+void ReadyNotifier::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lg(mtx_wq_);
+    stop_.store(true);
+  }
+  cv_wq_.notify_all();
+}
+
+ReadyQueue::ReadyQueue(const std::shared_ptr<ReadyNotifier>& notifier)
+    : notifier_(notifier), next_wake_(std::numeric_limits<int64_t>::max()) {
+  for (auto& queue : queues_) {
+    queue.Init(kQueueSize);
+  }
+}
+
+std::shared_ptr<CRoutine> ReadyEntry::GetCRoutine() const {
+  if (!has_cr_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // announce the copy before checking again, so that either the writer sees
+  // the reader or the reader sees the croutine reset
+  std::shared_ptr<CRoutine> routine = nullptr;
+  cr_readers_.fetch_add(1);
+  if (has_cr_.load()) {
+    routine = cr_;
+  }
+  cr_readers_.fetch_sub(1, std::memory_order_release);
+  return routine;
+}
+
+void ReadyEntry::SetCRoutine(const std::shared_ptr<CRoutine>& routine) {
+  has_cr_.store(false);
+  while (cr_readers_.load() != 0) {
+    std::this_thread::yield();
+  }
+  cr_ = routine;
+  if (routine != nullptr) {
+    has_cr_.store(true, std::memory_order_release);
+  }
+}
+
+void ReadyQueue::Push(ReadyEntry* entry) {
+  if (entry->queued.exchange(true)) {
+    return;
+  }
+  entry->holders.fetch_add(1);
+
+  if (cyber_unlikely(!queues_[entry->prio].Enqueue(entry))) {
+    AWARN_EVERY(100) << "ready queue of prio " << entry->prio
+                     << " is full, deferring croutine.";
+    std::lock_guard<std::mutex> lg(parked_mutex_);
+    parked_.emplace(0, entry);
+    next_wake_.store(0);
+    return;
+  }
+
+  ready_num_.fetch_add(1);
+  notifier_->Notify();
+}
+
+bool ReadyQueue::Pop(ReadyEntry** entry) {
+  if (ready_num_.load() <= 0) {
+    return false;
+  }
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    if (queues_[i].Dequeue(entry)) {
+      ready_num_.fetch_sub(1);
+      notifier_->Consume();
+      (*entry)->queued.store(false);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReadyQueue::Park(ReadyEntry* entry,
+                      std::chrono::steady_clock::time_point wake) {
+  if (entry->queued.exchange(true)) {
+    return;
+  }
+  entry->holders.fetch_add(1);
+
+  auto wake_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     wake.time_since_epoch())
+                     .count();
+  std::lock_guard<std::mutex> lg(parked_mutex_);
+  parked_.emplace(wake_ns, entry);
+  if (wake_ns < next_wake_.load()) {
+    next_wake_.store(wake_ns);
+  }
+}
+
+void ReadyQueue::WakeParked() {
+  auto now = SteadyNow();
+  if (now < next_wake_.load()) {
+    return;
+  }
+
+  std::vector<ReadyEntry*> due;
+  {
+    std::lock_guard<std::mutex> lg(parked_mutex_);
+    auto end = parked_.upper_bound(now);
+    for (auto it = parked_.begin(); it != end; ++it) {
+      due.emplace_back(it->second);
+    }
+    parked_.erase(parked_.begin(), end);
+    next_wake_.store(parked_.empty() ? std::numeric_limits<int64_t>::max()
+                                     : parked_.begin()->first);
+  }
+
+  for (auto entry : due) {
+    entry->queued.store(false);
+    Push(entry);
+    entry->holders.fetch_sub(1);
+  }
+}
+
+EventContext::EventContext(const std::shared_ptr<ReadyQueue>& rq) : rq_(rq) {}
+
+EventContext::EventContext(
+    const std::shared_ptr<ReadyQueue>& rq,
+    const std::vector<std::shared_ptr<ReadyQueue>>& group_rqs)
+    : rq_(rq) {
+  for (auto& peer : group_rqs) {
+    if (peer != rq) {
+      peers_.emplace_back(peer);
+    }
+  }
+}
+
+std::shared_ptr<CRoutine> EventContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  if (last_ != nullptr) {
+    Settle(last_);
+    last_ = nullptr;
+  }
+
+  rq_->WakeParked();
+  auto cr = Take(rq_.get());
+  if (cr != nullptr || peers_.empty()) {
+    return cr;
+  }
+
+  // Nothing of our own to run, steal from the other processors of the group,
+  // starting from a different one each time to spread the load.
+  for (size_t i = 0; i < peers_.size(); ++i) {
+    auto& peer = peers_[(next_victim_ + i) % peers_.size()];
+    peer->WakeParked();
+    cr = Take(peer.get());
+    if (cr != nullptr) {
+      next_victim_ = (next_victim_ + i + 1) % peers_.size();
+      stats_.steal_count.fetch_add(1, std::memory_order_relaxed);
+      return cr;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> EventContext::Take(ReadyQueue* rq) {
+  ReadyEntry* entry = nullptr;
+  while (rq->Pop(&entry)) {
+    // the entry is held from the pop, and kept in last_ while it runs
+    auto cr = Claim(entry);
+    if (cr == nullptr) {
+      entry->holders.fetch_sub(1);
+      continue;
+    }
+
+    auto state = cr->UpdateState();
+    if (state == RoutineState::READY) {
+      last_ = entry;
+      return cr;
+    }
+
+    if (state == RoutineState::SLEEP) {
+      entry->rq->Park(entry, cr->wake_time());
+    }
+    Unclaim(entry, cr);
+    entry->holders.fetch_sub(1);
+  }
+  return nullptr;
+}
+
+void EventContext::Settle(ReadyEntry* entry) {
+  // The processor has just run and released the croutine, find out whether
+  // it yielded runnable, was notified meanwhile or went to sleep.
+  auto cr = Claim(entry);
+  if (cr == nullptr) {
+    entry->holders.fetch_sub(1);
+    return;
+  }
+
+  auto state = cr->UpdateState();
+  if (state == RoutineState::SLEEP) {
+    entry->rq->Park(entry, cr->wake_time());
+  }
+  Unclaim(entry, cr);
+
+  if (state == RoutineState::READY) {
+    entry->rq->Push(entry);
+  }
+  entry->holders.fetch_sub(1);
+}
+
+std::shared_ptr<CRoutine> EventContext::Claim(ReadyEntry* entry) {
+  auto cr = entry->GetCRoutine();
+  if (cr == nullptr) {
+    return nullptr;
+  }
+
+  if (!cr->Acquire()) {
+    entry->pending.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!cr->Acquire()) {
+      return nullptr;
+    }
+  }
+  return cr;
+}
+
+void EventContext::Unclaim(ReadyEntry* entry,
+                           const std::shared_ptr<CRoutine>& cr) {
+  cr->Release();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (entry->pending.exchange(false)) {
+    entry->rq->Push(entry);
+  }
+}
+
+void EventContext::Wait() {
+  // wake up for the first parked croutine, at the latest after 1s as
+  // ClassicContext does
+  auto next_wake = rq_->next_wake();
+  for (auto& peer : peers_) {
+    next_wake = std::min(next_wake, peer->next_wake());
+  }
+  auto timeout = std::chrono::nanoseconds(std::max<int64_t>(
+      std::min<int64_t>(next_wake - SteadyNow(), 1000000000), 0));
+  rq_->notifier()->Wait(timeout);
+}
+
+void EventContext::Shutdown() {
+  stop_.store(true);
+  rq_->notifier()->Shutdown();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
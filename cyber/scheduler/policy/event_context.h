@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_EVENT_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_EVENT_CONTEXT_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cyber/base/bounded_queue.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+class ReadyQueue;
+
+/**
+ * @brief Scheduling state of one croutine in event mode. The croutine is
+ * reset on removal while the entry may still be sitting in a ready queue,
+ * so it is read with GetCRoutine and written with SetCRoutine, the slot
+ * protocol of CacheBuffer: readers never wait, a writer waits for the
+ * readers copying the croutine it replaces. Writers of an entry are
+ * serialized by the scheduler.
+ */
+struct ReadyEntry {
+  std::shared_ptr<CRoutine> GetCRoutine() const;
+  void SetCRoutine(const std::shared_ptr<CRoutine>& routine);
+
+  ReadyQueue* rq = nullptr;
+  uint32_t prio = 0;
+  // set while the entry is in one of the ready queues or parked
+  std::atomic<bool> queued = {false};
+  // set when the croutine was wanted while another processor held it
+  std::atomic<bool> pending = {false};
+  // the ready queue while queued or parked, and the processor which popped
+  // it until done with it, each count once. An entry without croutine is
+  // not pushed again, so it can be freed once this drops to 0.
+  std::atomic<uint32_t> holders = {0};
+
+ private:
+  std::shared_ptr<CRoutine> cr_ = nullptr;
+  std::atomic<bool> has_cr_ = {false};
+  mutable std::atomic<uint32_t> cr_readers_ = {0};
+};
+
+/**
+ * @brief Wakes the idle processors of a group when any of the ready queues
+ * of the group gets work.
+ */
+class ReadyNotifier {
+ public:
+  void Notify();
+  void Consume() { ready_num_.fetch_sub(1); }
+  void Wait(std::chrono::nanoseconds timeout);
+  void Shutdown();
+
+ private:
+  alignas(CACHELINE_SIZE) std::atomic<int64_t> ready_num_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<int> waiters_ = {0};
+  std::atomic<bool> stop_ = {false};
+  std::mutex mtx_wq_;
+  std::condition_variable cv_wq_;
+};
+
+/**
+ * @brief Multi-priority ready queue. Croutines are pushed when they become
+ * runnable, so picking the next one is a pop instead of a scan over every
+ * croutine of the group. A group has either one queue shared by all of its
+ * processors, or one queue per processor when work stealing is enabled.
+ */
+class ReadyQueue {
+ public:
+  static constexpr uint64_t kQueueSize = 1024;
+
+  explicit ReadyQueue(const std::shared_ptr<ReadyNotifier>& notifier =
+                          std::make_shared<ReadyNotifier>());
+
+  void Push(ReadyEntry* entry);
+  bool Pop(ReadyEntry** entry);
+
+  // Keeps a sleeping croutine aside until its wake time.
+  void Park(ReadyEntry* entry, std::chrono::steady_clock::time_point wake);
+  void WakeParked();
+  int64_t next_wake() const { return next_wake_.load(); }
+
+  const std::shared_ptr<ReadyNotifier>& notifier() const { return notifier_; }
+
+ private:
+  std::array<base::BoundedQueue<ReadyEntry*>, MAX_PRIO> queues_;
+  alignas(CACHELINE_SIZE) std::atomic<int64_t> ready_num_ = {0};
+  std::shared_ptr<ReadyNotifier> notifier_;
+
+  std::mutex parked_mutex_;
+  std::multimap<int64_t, ReadyEntry*> parked_;
+  std::atomic<int64_t> next_wake_;
+};
+
+class EventContext : public ProcessorContext {
+ public:
+  explicit EventContext(const std::shared_ptr<ReadyQueue>& rq);
+  // Work stealing: rq is owned by this processor, and the queues of the other
+  // processors of the group are visited when it runs dry.
+  EventContext(const std::shared_ptr<ReadyQueue>& rq,
+               const std::vector<std::shared_ptr<ReadyQueue>>& group_rqs);
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+  // Takes the croutine of entry for the caller, or leaves a mark so that its
+  // current holder puts it back once done with it.
+  static std::shared_ptr<CRoutine> Claim(ReadyEntry* entry);
+  static void Unclaim(ReadyEntry* entry, const std::shared_ptr<CRoutine>& cr);
+
+ private:
+  std::shared_ptr<CRoutine> Take(ReadyQueue* rq);
+  void Settle(ReadyEntry* entry);
+
+  std::shared_ptr<ReadyQueue> rq_;
+  std::vector<std::shared_ptr<ReadyQueue>> peers_;
+  size_t next_victim_ = 0;
+  ReadyEntry* last_ = nullptr;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_EVENT_CONTEXT_H_
@@ -51,6 +51,8 @@ SchedulerChoreography::SchedulerChoreography() {
       inner_thr_confs_[thr.name()] = thr;
     }
 
+    default_stack_size_ = cfg.scheduler_conf().default_stack_size();
+
     if (cfg.scheduler_conf().has_process_level_cpuset()) {
       process_level_cpuset_ = cfg.scheduler_conf().process_level_cpuset();
       ProcessLevelResourceControl();
@@ -75,6 +77,9 @@ SchedulerChoreography::SchedulerChoreography() {
 
     for (const auto& task : choreography_conf.tasks()) {
       cr_confs_[task.name()] = task;
+      if (task.has_stack_size()) {
+        cr_stack_sizes_[task.name()] = task.stack_size();
+      }
     }
   }
 
@@ -49,6 +49,8 @@ SchedulerClassic::SchedulerClassic() {
       inner_thr_confs_[thr.name()] = thr;
     }
 
+    default_stack_size_ = cfg.scheduler_conf().default_stack_size();
+
     if (cfg.scheduler_conf().has_process_level_cpuset()) {
       process_level_cpuset_ = cfg.scheduler_conf().process_level_cpuset();
       ProcessLevelResourceControl();
@@ -60,6 +62,9 @@ SchedulerClassic::SchedulerClassic() {
       for (auto task : group.tasks()) {
         task.set_group_name(group_name);
         cr_confs_[task.name()] = task;
+        if (task.has_stack_size()) {
+          cr_stack_sizes_[task.name()] = task.stack_size();
+        }
       }
     }
   } else {
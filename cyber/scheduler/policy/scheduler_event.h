@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_SCHEDULER_EVENT_H_
+#define CYBER_SCHEDULER_POLICY_SCHEDULER_EVENT_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/proto/classic_conf.pb.h"
+#include "cyber/scheduler/policy/event_context.h"
+#include "cyber/scheduler/scheduler.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::proto::ClassicConf;
+using apollo::cyber::proto::ClassicTask;
+
+/**
+ * @brief Event driven variant of the classic policy. It takes the same
+ * classic_conf groups and task priorities, but croutines are pushed to the
+ * ready queue of their group when they are dispatched, notified or due to
+ * wake up, instead of being found by scanning the whole group.
+ *
+ * In groups with work_steal set, each croutine is homed on the queue of one
+ * processor, and processors running out of work steal from their peers.
+ */
+class SchedulerEvent : public Scheduler {
+ public:
+  bool RemoveCRoutine(uint64_t crid) override;
+  bool RemoveTask(const std::string& name) override;
+  bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+
+ private:
+  friend Scheduler* Instance();
+  SchedulerEvent();
+
+  void CreateProcessor();
+  bool NotifyProcessor(uint64_t crid) override;
+
+  std::unordered_map<std::string, ClassicTask> cr_confs_;
+  // one queue per group, or one per processor for work stealing groups
+  std::unordered_map<std::string, std::vector<std::shared_ptr<ReadyQueue>>>
+      rqs_;
+  std::unordered_map<std::string, uint32_t> rq_cursors_;
+
+  // entries are kept after removal as they may still sit in a ready queue,
+  // and reused when a croutine with the same id comes back. One coming back
+  // to another queue or priority gets a new entry, the old one is retired
+  // and freed once no queue or processor holds it.
+  std::unordered_map<uint64_t, std::shared_ptr<ReadyEntry>> entries_;
+  std::vector<std::shared_ptr<ReadyEntry>> retired_entries_;
+
+  ClassicConf classic_conf_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_SCHEDULER_EVENT_H_
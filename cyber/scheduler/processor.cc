@@ -49,8 +49,10 @@ void Processor::Run() {
         snap_shot_->routine_name = croutine->name();
         croutine->Resume();
         croutine->Release();
+        context_->stats().run_count.fetch_add(1, std::memory_order_relaxed);
       } else {
         snap_shot_->execute_start_time.store(0);
+        context_->stats().idle_count.fetch_add(1, std::memory_order_relaxed);
         context_->Wait();
       }
     } else {
@@ -17,6 +17,7 @@
 #ifndef CYBER_SCHEDULER_POLICY_PROCESSOR_CONTEXT_H_
 #define CYBER_SCHEDULER_POLICY_PROCESSOR_CONTEXT_H_
 
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -30,14 +31,24 @@ namespace scheduler {
 
 using croutine::CRoutine;
 
+struct ProcessorStats {
+  // croutines resumed, croutines taken from a peer, waits for work
+  std::atomic<uint64_t> run_count = {0};
+  std::atomic<uint64_t> steal_count = {0};
+  std::atomic<uint64_t> idle_count = {0};
+};
+
 class ProcessorContext {
  public:
   virtual void Shutdown();
   virtual std::shared_ptr<CRoutine> NextRoutine() = 0;
   virtual void Wait() = 0;
 
+  ProcessorStats& stats() { return stats_; }
+
  protected:
   std::atomic<bool> stop_{false};
+  ProcessorStats stats_;
 };
 
 }  // namespace scheduler
@@ -17,6 +17,7 @@
 #include "cyber/scheduler/scheduler.h"
 
 #include <sched.h>
+#include <algorithm>
 #include <utility>
 
 #include "cyber/common/environment.h"
@@ -48,7 +49,13 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
 
   auto task_id = GlobalData::RegisterTaskName(name);
 
-  auto cr = std::make_shared<CRoutine>(func);
+  auto stack_size = default_stack_size_;
+  auto iter = cr_stack_sizes_.find(name);
+  if (iter != cr_stack_sizes_.end()) {
+    stack_size = iter->second;
+  }
+
+  auto cr = std::make_shared<CRoutine>(func, stack_size);
   cr->set_id(task_id);
   cr->set_name(name);
   AINFO << "create croutine: " << name;
@@ -101,8 +108,8 @@ void Scheduler::SetInnerThreadAttr(const std::string& name, std::thread* thr) {
 void Scheduler::CheckSchedStatus() {
   std::string snap_info;
   auto now = Time::Now().ToNanosecond();
-  for (auto processor : processors_) {
-    auto snap = processor->ProcSnapshot();
+  for (size_t i = 0; i < processors_.size(); ++i) {
+    auto snap = processors_[i]->ProcSnapshot();
     if (snap->execute_start_time.load()) {
       auto execute_time = (now - snap->execute_start_time.load()) / 1000000;
       snap_info.append(std::to_string(snap->processor_id.load()))
@@ -114,6 +121,16 @@ void Scheduler::CheckSchedStatus() {
       snap_info.append(std::to_string(snap->processor_id.load()))
           .append(":idle");
     }
+    if (i < pctxs_.size()) {
+      auto& stats = pctxs_[i]->stats();
+      snap_info.append("[run:")
+          .append(std::to_string(stats.run_count.load()))
+          .append(",steal:")
+          .append(std::to_string(stats.steal_count.load()))
+          .append(",idle:")
+          .append(std::to_string(stats.idle_count.load()))
+          .append("]");
+    }
     snap_info.append(", ");
   }
   snap_info.append("timestamp: ").append(std::to_string(now));
@@ -121,11 +138,33 @@ void Scheduler::CheckSchedStatus() {
   snap_info.clear();
 }
 
+void Scheduler::ReportStackUsage() {
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  {
+    ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    for (auto& cr : id_cr_) {
+      crs.emplace_back(cr.second);
+    }
+  }
+  std::sort(crs.begin(), crs.end(),
+            [](const std::shared_ptr<CRoutine>& lhs,
+               const std::shared_ptr<CRoutine>& rhs) {
+              return lhs->name() < rhs->name();
+            });
+  for (auto& cr : crs) {
+    AINFO << "croutine stack usage: " << cr->name() << " peak "
+          << cr->StackPeakUsage() / 1024 << "KB of "
+          << cr->stack_size() / 1024 << "KB";
+  }
+}
+
 void Scheduler::Shutdown() {
   if (cyber_unlikely(stop_.exchange(true))) {
     return;
   }
 
+  ReportStackUsage();
+
   for (auto& ctx : pctxs_) {
     ctx->Shutdown();
   }
@@ -76,6 +76,8 @@ class Scheduler {
   virtual bool RemoveCRoutine(uint64_t crid) = 0;
 
   void CheckSchedStatus();
+  // Logs the peak stack usage of every croutine to help size their stacks.
+  void ReportStackUsage();
 
   void SetInnerThreadConfs(
       const std::unordered_map<std::string, InnerThread>& confs) {
@@ -95,6 +97,10 @@ class Scheduler {
 
   std::unordered_map<std::string, InnerThread> inner_thr_confs_;
 
+  // croutine stack sizes from the scheduler conf, 0 for the default
+  std::unordered_map<std::string, uint32_t> cr_stack_sizes_;
+  uint32_t default_stack_size_ = 0;
+
   std::string process_level_cpuset_;
   uint32_t proc_num_ = 0;
   uint32_t task_pool_size_ = 0;
@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cyber/base/for_each.h"
+#include "cyber/cyber.h"
+#include "cyber/scheduler/policy/event_context.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+TEST(SchedulerEventTest, ready_queue) {
+  ReadyQueue rq;
+  std::vector<ReadyEntry> entries(3);
+  FOR_EACH(i, 0, 3) {
+    entries[i].rq = &rq;
+    entries[i].prio = i * 5;
+  }
+
+  ReadyEntry* entry = nullptr;
+  EXPECT_FALSE(rq.Pop(&entry));
+
+  rq.Push(&entries[0]);
+  rq.Push(&entries[2]);
+  rq.Push(&entries[1]);
+  // an entry already queued is not queued twice
+  rq.Push(&entries[2]);
+  EXPECT_EQ(1, entries[2].holders.load());
+
+  EXPECT_TRUE(rq.Pop(&entry));
+  EXPECT_EQ(&entries[2], entry);
+  EXPECT_TRUE(rq.Pop(&entry));
+  EXPECT_EQ(&entries[1], entry);
+  EXPECT_TRUE(rq.Pop(&entry));
+  EXPECT_EQ(&entries[0], entry);
+  EXPECT_FALSE(rq.Pop(&entry));
+  // the queue hands its hold over to the caller of Pop
+  EXPECT_EQ(1, entries[0].holders.load());
+  entries[0].holders.store(0);
+
+  rq.Park(&entries[0],
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+  rq.WakeParked();
+  EXPECT_FALSE(rq.Pop(&entry));
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  rq.WakeParked();
+  EXPECT_TRUE(rq.Pop(&entry));
+  EXPECT_EQ(&entries[0], entry);
+  EXPECT_EQ(1, entries[0].holders.load());
+}
+
+TEST(SchedulerEventTest, reset_croutine_while_read) {
+  ReadyEntry entry;
+  auto cr = std::make_shared<CRoutine>([]() {});
+  std::atomic<bool> done = {false};
+  std::thread reader([&entry, &cr, &done]() {
+    while (!done.load()) {
+      auto read = entry.GetCRoutine();
+      EXPECT_TRUE(read == nullptr || read == cr);
+    }
+  });
+  FOR_EACH(i, 0, 10000) {
+    entry.SetCRoutine(i % 2 == 0 ? cr : nullptr);
+  }
+  done.store(true);
+  reader.join();
+  EXPECT_EQ(nullptr, entry.GetCRoutine());
+}
+
+TEST(SchedulerEventTest, event_context) {
+  auto rq = std::make_shared<ReadyQueue>();
+  std::vector<std::shared_ptr<EventContext>> ctxs;
+  std::vector<std::shared_ptr<Processor>> procs;
+  FOR_EACH(i, 0, 2) {
+    ctxs.emplace_back(std::make_shared<EventContext>(rq));
+    procs.emplace_back(std::make_shared<Processor>());
+    procs.back()->BindContext(ctxs.back());
+  }
+
+  const int kRoutineNum = 8;
+  std::atomic<int> runs = {0};
+  std::atomic<int> slept = {0};
+  std::vector<std::shared_ptr<ReadyEntry>> entries;
+  FOR_EACH(i, 0, kRoutineNum) {
+    auto cr = std::make_shared<CRoutine>([&runs, &slept]() {
+      cyber::SleepFor(std::chrono::milliseconds(5));
+      slept++;
+      for (;;) {
+        runs++;
+        CRoutine::GetCurrentRoutine()->HangUp();
+      }
+    });
+    auto entry = std::make_shared<ReadyEntry>();
+    entry->SetCRoutine(cr);
+    entry->rq = rq.get();
+    entry->prio = i % MAX_PRIO;
+    entries.emplace_back(entry);
+    rq->Push(entry.get());
+  }
+
+  auto wait_for = [](const std::atomic<int>& value, int expected) {
+    FOR_EACH(i, 0, 200) {
+      if (value.load() >= expected) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load();
+  };
+
+  EXPECT_EQ(kRoutineNum, wait_for(slept, kRoutineNum));
+  EXPECT_EQ(kRoutineNum, wait_for(runs, kRoutineNum));
+
+  // croutines waiting for data only run again once notified
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(kRoutineNum, runs.load());
+
+  FOR_EACH(round, 1, 4) {
+    for (auto& entry : entries) {
+      entry->GetCRoutine()->SetUpdateFlag();
+      rq->Push(entry.get());
+    }
+    EXPECT_EQ(kRoutineNum * (round + 1),
+              wait_for(runs, kRoutineNum * (round + 1)));
+  }
+
+  for (auto& ctx : ctxs) {
+    ctx->Shutdown();
+  }
+  for (auto& proc : procs) {
+    proc->Stop();
+  }
+}
+
+TEST(SchedulerEventTest, release_entries) {
+  auto rq = std::make_shared<ReadyQueue>();
+  auto ctx = std::make_shared<EventContext>(rq);
+  auto proc = std::make_shared<Processor>();
+  proc->BindContext(ctx);
+
+  // a removed croutine leaves its entry queued without croutine, and one
+  // that ran is held until its processor looks for the next one
+  std::atomic<int> runs = {0};
+  std::vector<std::shared_ptr<ReadyEntry>> entries(2);
+  for (auto& entry : entries) {
+    entry = std::make_shared<ReadyEntry>();
+    entry->rq = rq.get();
+  }
+  entries[1]->SetCRoutine(std::make_shared<CRoutine>([&runs]() { runs++; }));
+  for (auto& entry : entries) {
+    rq->Push(entry.get());
+  }
+
+  FOR_EACH(i, 0, 400) {
+    if (runs.load() == 1 && entries[0]->holders.load() == 0 &&
+        entries[1]->holders.load() == 0) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(1, runs.load());
+  EXPECT_EQ(0, entries[0]->holders.load());
+  EXPECT_EQ(0, entries[1]->holders.load());
+
+  ctx->Shutdown();
+  proc->Stop();
+}
+
+TEST(SchedulerEventTest, work_steal) {
+  auto notifier = std::make_shared<ReadyNotifier>();
+  std::vector<std::shared_ptr<ReadyQueue>> rqs = {
+      std::make_shared<ReadyQueue>(notifier),
+      std::make_shared<ReadyQueue>(notifier)};
+  // only the processor of the second queue runs, everything it does has to
+  // be stolen from the first one
+  auto ctx = std::make_shared<EventContext>(rqs[1], rqs);
+  auto proc = std::make_shared<Processor>();
+  proc->BindContext(ctx);
+
+  const int kRoutineNum = 4;
+  std::atomic<int> runs = {0};
+  std::vector<std::shared_ptr<ReadyEntry>> entries;
+  FOR_EACH(i, 0, kRoutineNum) {
+    auto entry = std::make_shared<ReadyEntry>();
+    entry->SetCRoutine(std::make_shared<CRoutine>([&runs]() { runs++; }));
+    entry->rq = rqs[0].get();
+    entry->prio = i;
+    entries.emplace_back(entry);
+    rqs[0]->Push(entry.get());
+  }
+
+  FOR_EACH(i, 0, 200) {
+    if (runs.load() == kRoutineNum) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(kRoutineNum, runs.load());
+  EXPECT_EQ(kRoutineNum, ctx->stats().steal_count.load());
+  EXPECT_EQ(kRoutineNum, ctx->stats().run_count.load());
+  EXPECT_GT(ctx->stats().idle_count.load(), 0);
+
+  ctx->Shutdown();
+  proc->Stop();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
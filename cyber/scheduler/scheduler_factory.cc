@@ -29,6 +29,7 @@
 #include "cyber/common/util.h"
 #include "cyber/scheduler/policy/scheduler_choreography.h"
 #include "cyber/scheduler/policy/scheduler_classic.h"
+#include "cyber/scheduler/policy/scheduler_event.h"
 #include "cyber/scheduler/scheduler.h"
 
 namespace apollo {
@@ -66,6 +67,8 @@ Scheduler* Instance() {
         obj = new SchedulerClassic();
       } else if (!policy.compare("choreography")) {
         obj = new SchedulerChoreography();
+      } else if (!policy.compare("event")) {
+        obj = new SchedulerEvent();
       } else {
         AWARN << "Invalid scheduler policy: " << policy;
         obj = new SchedulerClassic();
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/latency_service.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/event/latency_tracer.h"
+
+namespace apollo {
+namespace cyber {
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::event::LatencyTracer;
+using apollo::cyber::proto::LatencyReport;
+using apollo::cyber::proto::LatencyRequest;
+
+const char LatencyService::kServicePrefix[] = "/apollo/cyber/latency/";
+
+LatencyService::LatencyService() {}
+
+void LatencyService::Start() {
+  if (node_ != nullptr || !LatencyTracer::Instance()->enabled()) {
+    return;
+  }
+  auto global_data = GlobalData::Instance();
+  auto process = global_data->HostName() + "_" +
+                 std::to_string(global_data->ProcessId());
+  node_.reset(new Node("latency_service_" + process));
+  service_name_ = kServicePrefix + global_data->HostName() + "/" +
+                  std::to_string(global_data->ProcessId());
+  service_ = node_->CreateService<LatencyRequest, LatencyReport>(
+      service_name_, [](const std::shared_ptr<LatencyRequest>& request,
+                        std::shared_ptr<LatencyReport>& report) {
+        LatencyTracer::Instance()->Snapshot(request->channel_name(),
+                                            report.get());
+      });
+  if (service_ == nullptr) {
+    AERROR << "create latency service failed.";
+    node_.reset();
+  }
+}
+
+void LatencyService::Shutdown() {
+  service_.reset();
+  node_.reset();
+}
+
+}  // namespace cyber
+}  // namespace apollo
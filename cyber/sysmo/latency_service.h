@@ -14,34 +14,43 @@
  * limitations under the License.
  *****************************************************************************/
 
-#ifndef CYBER_TIMER_TIMER_BUCKET_H_
-#define CYBER_TIMER_TIMER_BUCKET_H_
+#ifndef CYBER_SYSMO_LATENCY_SERVICE_H_
+#define CYBER_SYSMO_LATENCY_SERVICE_H_
 
-#include <list>
 #include <memory>
-#include <mutex>
+#include <string>
 
-#include "cyber/timer/timer_task.h"
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+#include "cyber/proto/latency_trace.pb.h"
 
 namespace apollo {
 namespace cyber {
 
-class TimerBucket {
+/**
+ * @brief Serves the histograms of event::LatencyTracer, one service per
+ * process named kServicePrefix + host name + "/" + process id. Only started
+ * if latency tracing is enabled.
+ */
+class LatencyService {
  public:
-  void AddTask(const std::shared_ptr<TimerTask>& task) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    task_list_.push_back(task);
-  }
+  static const char kServicePrefix[];
 
-  std::mutex& mutex() { return mutex_; }
-  std::list<std::weak_ptr<TimerTask>>& task_list() { return task_list_; }
+  void Start();
+  void Shutdown();
+
+  const std::string& service_name() const { return service_name_; }
 
  private:
-  std::mutex mutex_;
-  std::list<std::weak_ptr<TimerTask>> task_list_;
+  std::string service_name_;
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Service<proto::LatencyRequest, proto::LatencyReport>>
+      service_;
+
+  DECLARE_SINGLETON(LatencyService)
 };
 
 }  // namespace cyber
 }  // namespace apollo
 
-#endif  // CYBER_TIMER_TIMER_BUCKET_H_
+#endif  // CYBER_SYSMO_LATENCY_SERVICE_H_
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include "cyber/init.h"
+#include "cyber/task/task.h"
+
+using apollo::cyber::Async;
+using apollo::cyber::ParallelFor;
+
+namespace {
+
+// Stand-in for one DP graph node or one obstacle, iterations sets how much
+// work a single item does.
+double Work(size_t item, uint32_t iterations) {
+  double value = static_cast<double>(item);
+  for (uint32_t i = 0; i < iterations; ++i) {
+    value = std::sqrt(value + i);
+  }
+  return value;
+}
+
+template <typename F>
+double AverageUs(uint32_t repeat, F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repeat; ++i) {
+    run();
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repeat;
+}
+
+void Bench(size_t item_num, uint32_t iterations, uint32_t repeat) {
+  std::vector<double> out(item_num);
+
+  auto serial = AverageUs(repeat, [&]() {
+    for (size_t i = 0; i < item_num; ++i) {
+      out[i] = Work(i, iterations);
+    }
+  });
+
+  // what the planning call sites did: one task and one future per item
+  auto async = AverageUs(repeat, [&]() {
+    std::vector<std::future<void>> results;
+    results.reserve(item_num);
+    for (size_t i = 0; i < item_num; ++i) {
+      results.emplace_back(
+          Async([&out, i, iterations]() { out[i] = Work(i, iterations); }));
+    }
+    for (auto& result : results) {
+      result.get();
+    }
+  });
+
+  std::cout << "items: " << item_num << " iterations: " << iterations
+            << " serial: " << serial << "us async: " << async << "us";
+  for (size_t grain : {1, 2, 4, 8, 16}) {
+    auto parallel = AverageUs(repeat, [&]() {
+      ParallelFor(size_t(0), item_num, grain,
+                  [&](size_t i) { out[i] = Work(i, iterations); });
+    });
+    std::cout << " parallel_for(" << grain << "): " << parallel << "us";
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cout << "Usage: " << argv[0] << " [repeat, default 1000]"
+              << std::endl;
+    return -1;
+  }
+  uint32_t repeat = 1000;
+  if (argc == 2) {
+    repeat = static_cast<uint32_t>(std::atoi(argv[1]));
+  }
+
+  apollo::cyber::Init(argv[0]);
+  // sizes of the planning call sites: samples of a DP road graph level,
+  // rows of a speed DP column and obstacles of a reference line
+  for (size_t item_num : {10, 50, 200}) {
+    for (uint32_t iterations : {100, 1000, 10000}) {
+      Bench(item_num, iterations, repeat);
+    }
+  }
+  apollo::cyber::Clear();
+  return 0;
+}
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/task/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/task/task_manager.h"
+
+namespace apollo {
+namespace cyber {
+namespace internal {
+
+namespace {
+
+using apollo::cyber::common::GlobalData;
+
+// Shared by the caller and the helpers, a helper that starts after all jobs
+// were taken finds nothing to do and only drops its reference. A job that
+// throws still counts as done, so that the caller does not wait forever, and
+// the jobs claimed after it are skipped.
+class ForkJoinState {
+ public:
+  ForkJoinState(size_t num_jobs, const std::function<void(size_t)>& job)
+      : num_jobs_(num_jobs), job_(job) {}
+
+  void Work() {
+    size_t done = 0;
+    for (;;) {
+      auto index = next_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= num_jobs_) {
+        break;
+      }
+      if (!failed_.load(std::memory_order_relaxed)) {
+        try {
+          job_(index);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (!exception_) {
+            exception_ = std::current_exception();
+          }
+          failed_.store(true, std::memory_order_relaxed);
+        }
+      }
+      ++done;
+    }
+    if (done > 0 &&
+        done_.fetch_add(done, std::memory_order_acq_rel) + done == num_jobs_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_all();
+    }
+  }
+
+  void WaitDone() {
+    if (croutine::CRoutine::GetCurrentRoutine() != nullptr) {
+      while (!IsDone()) {
+        croutine::CRoutine::Yield();
+      }
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return IsDone(); });
+  }
+
+  // Only called after WaitDone(), when no job is left to set the exception.
+  void RethrowIfFailed() {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  bool IsDone() const {
+    return done_.load(std::memory_order_acquire) == num_jobs_;
+  }
+
+  const size_t num_jobs_;
+  std::function<void(size_t)> job_;
+  std::atomic<size_t> next_ = {0};
+  std::atomic<size_t> done_ = {0};
+  std::atomic<bool> failed_ = {false};
+  std::exception_ptr exception_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace
+
+void ForkJoin(size_t num_jobs, const std::function<void(size_t)>& job) {
+  if (num_jobs == 0) {
+    return;
+  }
+  auto state = std::make_shared<ForkJoinState>(num_jobs, job);
+  auto helper = [state]() { state->Work(); };
+
+  if (GlobalData::Instance()->IsRealityMode()) {
+    auto helper_num = static_cast<uint32_t>(std::min<size_t>(
+        num_jobs - 1, TaskManager::Instance()->num_threads()));
+    auto queued = TaskManager::Instance()->EnqueueBulk(helper, helper_num);
+    if (queued < helper_num) {
+      // the caller claims from the same counter, so it runs the jobs of the
+      // helpers that did not fit in the queue
+      ADEBUG << "task queue full, " << helper_num - queued
+             << " fork join helpers not queued";
+    }
+    state->Work();
+    state->WaitDone();
+    state->RethrowIfFailed();
+    return;
+  }
+
+  // same as Async, simulation runs the helpers on their own threads
+  auto helper_num = std::min<size_t>(
+      num_jobs - 1, std::max(std::thread::hardware_concurrency(), 2U) - 1);
+  std::vector<std::future<void>> helpers;
+  helpers.reserve(helper_num);
+  for (size_t i = 0; i < helper_num; ++i) {
+    helpers.emplace_back(std::async(std::launch::async, helper));
+  }
+  state->Work();
+  state->WaitDone();
+  state->RethrowIfFailed();
+}
+
+}  // namespace internal
+
+void TaskGroup::Wait() {
+  auto tasks = std::move(tasks_);
+  tasks_.clear();
+  internal::ForkJoin(tasks.size(), [&tasks](size_t i) { tasks[i](); });
+}
+
+}  // namespace cyber
+}  // namespace apollo
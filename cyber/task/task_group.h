@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TASK_TASK_GROUP_H_
+#define CYBER_TASK_TASK_GROUP_H_
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+namespace internal {
+
+/**
+ * @brief Run job(0) to job(num_jobs - 1) on the task threads and the calling
+ * thread, and return when all of them finished.
+ *
+ * Helpers are queued in one batch and take the next job index from a shared
+ * counter, as does the caller, so the caller never waits for a busy task
+ * thread to pick up work that it could run itself. The caller yields while
+ * the last jobs finish elsewhere if it is a croutine and sleeps otherwise.
+ * Helpers that do not fit in the task queue are not queued and the caller
+ * runs their jobs itself.
+ *
+ * If a job throws, the jobs not started yet are skipped and the first
+ * exception is rethrown in the caller once the running jobs finished.
+ */
+void ForkJoin(size_t num_jobs, const std::function<void(size_t)>& job);
+
+}  // namespace internal
+
+/**
+ * @brief Call func(i) for every i in [begin, end), grain indexes per task.
+ *
+ * Pick the grain so that a chunk does at least a few microseconds of work,
+ * smaller chunks spend more time on claiming than on running.
+ */
+template <typename Index, typename F>
+void ParallelFor(Index begin, Index end, Index grain, F&& func) {
+  if (!(begin < end)) {
+    return;
+  }
+  if (!(Index(0) < grain)) {
+    grain = 1;
+  }
+  size_t num_chunks = static_cast<size_t>((end - begin + grain - 1) / grain);
+  auto run_chunk = [&](size_t chunk) {
+    Index first = begin + static_cast<Index>(chunk) * grain;
+    Index last = end - first > grain ? first + grain : end;
+    for (Index i = first; i < last; ++i) {
+      func(i);
+    }
+  };
+  if (num_chunks == 1) {
+    run_chunk(0);
+    return;
+  }
+  internal::ForkJoin(num_chunks, run_chunk);
+}
+
+/**
+ * @brief A batch of tasks that runs in Wait(), with the caller taking part.
+ */
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+
+  void Run(std::function<void()> func) {
+    tasks_.emplace_back(std::move(func));
+  }
+
+  /**
+   * @brief Run all tasks added since the last Wait() and return when they
+   * finished.
+   */
+  void Wait();
+
+  size_t size() const { return tasks_.size(); }
+
+ private:
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  std::vector<std::function<void()>> tasks_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TASK_TASK_GROUP_H_
@@ -16,6 +16,8 @@
 
 #include "cyber/task/task_manager.h"
 
+#include <algorithm>
+
 #include "cyber/common/global_data.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/croutine/routine_factory.h"
@@ -60,6 +62,25 @@ TaskManager::TaskManager()
 
 TaskManager::~TaskManager() { Shutdown(); }
 
+uint32_t TaskManager::EnqueueBulk(const std::function<void()>& func,
+                                  uint32_t num) {
+  if (stop_.load() || tasks_.empty()) {
+    return 0;
+  }
+  uint32_t queued = 0;
+  while (queued < num && task_queue_->Enqueue(func)) {
+    ++queued;
+  }
+  // rotate the woken threads, so that batches smaller than the pool don't
+  // always land on the first threads
+  auto notify_num = std::min<size_t>(queued, tasks_.size());
+  auto first = next_notify_.fetch_add(static_cast<uint32_t>(notify_num));
+  for (size_t i = 0; i < notify_num; ++i) {
+    scheduler::Instance()->NotifyTask(tasks_[(first + i) % tasks_.size()]);
+  }
+  return queued;
+}
+
 void TaskManager::Shutdown() {
   if (stop_.exchange(true)) {
     return;
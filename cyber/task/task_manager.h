@@ -18,6 +18,7 @@
 #define CYBER_TASK_TASK_MANAGER_H_
 
 #include <atomic>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -53,10 +54,22 @@ class TaskManager {
     return res;
   }
 
+  /**
+   * @brief Queue num copies of func and wake every task thread at most once.
+   * Copies that don't fit in the queue are not queued, so func has to be work
+   * that the caller finishes by itself if no copy runs.
+   *
+   * @return the number of copies queued, the caller runs the rest itself
+   */
+  uint32_t EnqueueBulk(const std::function<void()>& func, uint32_t num);
+
+  uint32_t num_threads() const { return num_threads_; }
+
  private:
   uint32_t num_threads_ = 0;
   uint32_t task_queue_size_ = 1000;
   std::atomic<bool> stop_ = {false};
+  std::atomic<uint32_t> next_notify_ = {0};
   std::vector<uint64_t> tasks_;
   std::shared_ptr<base::BoundedQueue<std::function<void()>>> task_queue_;
   DECLARE_SINGLETON(TaskManager);
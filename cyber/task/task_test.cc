@@ -17,7 +17,9 @@
 #include "cyber/task/task.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -97,6 +99,77 @@ TEST(AsyncTest, run_member_function) {
   foo.RunOnce();
 }
 
+TEST(ParallelForTest, run_every_index_once) {
+  for (int grain : {0, 1, 3, 100}) {
+    std::vector<std::atomic<int>> counts(97);
+    for (auto& count : counts) {
+      count = 0;
+    }
+    ParallelFor(0, 97, grain, [&counts](int i) { ++counts[i]; });
+    for (auto& count : counts) {
+      EXPECT_EQ(count.load(), 1);
+    }
+  }
+
+  int calls = 0;
+  ParallelFor(5, 5, 1, [&calls](int i) { ++calls; });
+  ParallelFor(5, 1, 1, [&calls](int i) { ++calls; });
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelForTest, run_in_task) {
+  // the task threads are croutines, nested loops finish even when every
+  // task thread is busy because the callers take part
+  std::atomic<int> sum = {0};
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 4; ++i) {
+    results.emplace_back(Async([&sum]() {
+      ParallelFor(0, 100, 1, [&sum](int j) { sum += j; });
+    }));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+  EXPECT_EQ(sum.load(), 4 * 4950);
+}
+
+TEST(ParallelForTest, rethrow_in_caller) {
+  std::atomic<int> calls = {0};
+  EXPECT_THROW(ParallelFor(0, 100, 1,
+                           [&calls](int i) {
+                             ++calls;
+                             if (i == 10) {
+                               throw std::runtime_error("job failed");
+                             }
+                           }),
+               std::runtime_error);
+  EXPECT_GE(calls.load(), 11);
+  EXPECT_LE(calls.load(), 100);
+
+  // the task threads are free again
+  std::atomic<int> sum = {0};
+  ParallelFor(0, 100, 1, [&sum](int i) { sum += i; });
+  EXPECT_EQ(sum.load(), 4950);
+}
+
+TEST(TaskGroupTest, wait) {
+  TaskGroup group;
+  group.Wait();
+
+  std::atomic<int> sum = {0};
+  for (int i = 1; i <= 10; ++i) {
+    group.Run([&sum, i]() { sum += i; });
+  }
+  EXPECT_EQ(group.size(), 10);
+  group.Wait();
+  EXPECT_EQ(group.size(), 0);
+  EXPECT_EQ(sum.load(), 55);
+
+  group.Run([&sum]() { sum = 0; });
+  group.Wait();
+  EXPECT_EQ(sum.load(), 0);
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
@@ -17,6 +17,7 @@
 #include "cyber/timer/timer.h"
 
 #include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -52,14 +53,15 @@ bool Timer::InitTimerTask() {
     return false;
   }
 
-  if (timer_opt_.period >= TIMER_MAX_INTERVAL_MS) {
-    AERROR << "Max interval must less than " << TIMER_MAX_INTERVAL_MS;
+  if (timer_opt_.period >= timing_wheel_->MaxIntervalMs()) {
+    AERROR << "Max interval must less than " << timing_wheel_->MaxIntervalMs();
     return false;
   }
 
   task_.reset(new TimerTask(timer_id_));
   task_->interval_ms = timer_opt_.period;
-  task_->next_fire_duration_ms = task_->interval_ms;
+  task_->next_fire_time_ns =
+      Time::MonoTime().ToNanosecond() + task_->interval_ms * 1000000;
   if (timer_opt_.oneshot) {
     std::weak_ptr<TimerTask> task_weak_ptr = task_;
     task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
@@ -77,46 +79,16 @@ bool Timer::InitTimerTask() {
         return;
       }
       std::lock_guard<std::mutex> lg(task->mutex);
-      auto start = Time::MonoTime().ToNanosecond();
       callback();
-      auto end = Time::MonoTime().ToNanosecond();
-      uint64_t execute_time_ns = end - start;
-      uint64_t execute_time_ms =
-#if defined(__aarch64__)
-          ::llround(static_cast<double>(execute_time_ns) / 1e6);
-#else
-          std::llround(static_cast<double>(execute_time_ns) / 1e6);
-#endif
-      if (task->last_execute_time_ns == 0) {
-        task->last_execute_time_ns = start;
-      } else {
-        task->accumulated_error_ns +=
-            start - task->last_execute_time_ns - task->interval_ms * 1000000;
-      }
-      ADEBUG << "start: " << start << "\t last: " << task->last_execute_time_ns
-             << "\t execut time:" << execute_time_ms
-             << "\t accumulated_error_ns: " << task->accumulated_error_ns;
-      task->last_execute_time_ns = start;
-      if (execute_time_ms >= task->interval_ms) {
-        task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-      } else {
-#if defined(__aarch64__)
-        int64_t accumulated_error_ms = ::llround(
-#else
-        int64_t accumulated_error_ms = std::llround(
-#endif
-            static_cast<double>(task->accumulated_error_ns) / 1e6);
-        if (static_cast<int64_t>(task->interval_ms - execute_time_ms -
-                                 TIMER_RESOLUTION_MS) >= accumulated_error_ms) {
-          task->next_fire_duration_ms =
-              task->interval_ms - execute_time_ms - accumulated_error_ms;
-        } else {
-          task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-        }
-        ADEBUG << "error ms: " << accumulated_error_ms
-               << "  execute time: " << execute_time_ms
-               << " next fire: " << task->next_fire_duration_ms
-               << " error ns: " << task->accumulated_error_ns;
+
+      // Stay on the original grid of fire times. If the callback overran
+      // the period, fire again right away and restart the grid from now.
+      auto now = Time::MonoTime().ToNanosecond();
+      task->next_fire_time_ns += task->interval_ms * 1000000;
+      if (task->next_fire_time_ns <= now) {
+        ADEBUG << "timer [" << task->timer_id_ << "] overran its period by "
+               << now - task->next_fire_time_ns << "ns";
+        task->next_fire_time_ns = now;
       }
       TimingWheel::Instance()->AddTask(task);
     };
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/component/timer_component.h"
+#include "cyber/init.h"
+#include "cyber/time/time.h"
+#include "cyber/timer/timer.h"
+
+using apollo::cyber::Time;
+using apollo::cyber::Timer;
+using apollo::cyber::TimerComponent;
+
+// Records the distance of each fire from its ideal time. The ideal time of
+// the n-th fire is first + n * period, so a timer that slowly drifts shows
+// growing jitter instead of hiding behind small period to period deltas.
+class JitterRecorder {
+ public:
+  explicit JitterRecorder(uint64_t period_ms)
+      : period_ns_(period_ms * 1000000) {}
+
+  void Record() {
+    auto now = Time::MonoTime().ToNanosecond();
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (count_ == 0) {
+      first_ns_ = now;
+    } else {
+      int64_t ideal = static_cast<int64_t>(first_ns_ + count_ * period_ns_);
+      jitter_us_.emplace_back(
+          std::abs(static_cast<int64_t>(now) - ideal) / 1000);
+    }
+    ++count_;
+  }
+
+  void Report(const std::string& name) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (jitter_us_.empty()) {
+      std::cout << name << ": no samples" << std::endl;
+      return;
+    }
+    std::sort(jitter_us_.begin(), jitter_us_.end());
+    auto percentile = [this](double p) {
+      return jitter_us_[static_cast<size_t>(p * (jitter_us_.size() - 1))];
+    };
+    std::cout << name << " samples: " << jitter_us_.size()
+              << " p50: " << percentile(0.5) << "us p99: " << percentile(0.99)
+              << "us max: " << jitter_us_.back() << "us" << std::endl;
+  }
+
+ private:
+  std::mutex mutex_;
+  uint64_t period_ns_ = 0;
+  uint64_t first_ns_ = 0;
+  uint64_t count_ = 0;
+  std::vector<int64_t> jitter_us_;
+};
+
+class BenchmarkComponent : public TimerComponent {
+ public:
+  bool Init() override { return true; }
+  bool Proc() override {
+    recorder_->Record();
+    return true;
+  }
+  void set_recorder(JitterRecorder* recorder) { recorder_ = recorder; }
+
+ private:
+  JitterRecorder* recorder_ = nullptr;
+};
+
+void BenchTimer(uint32_t hz, uint32_t seconds) {
+  uint32_t period_ms = 1000 / hz;
+  JitterRecorder recorder(period_ms);
+  Timer timer(period_ms, [&recorder]() { recorder.Record(); }, false);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  timer.Stop();
+  recorder.Report("Timer@" + std::to_string(hz) + "Hz");
+}
+
+void BenchTimerComponent(uint32_t hz, uint32_t seconds) {
+  uint32_t period_ms = 1000 / hz;
+  JitterRecorder recorder(period_ms);
+  apollo::cyber::proto::TimerComponentConfig config;
+  config.set_name("timer_benchmark_" + std::to_string(hz));
+  config.set_interval(period_ms);
+
+  auto component = std::make_shared<BenchmarkComponent>();
+  component->set_recorder(&recorder);
+  if (!component->Initialize(config)) {
+    std::cout << "initialize timer component failed." << std::endl;
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  component->Shutdown();
+  recorder.Report("TimerComponent@" + std::to_string(hz) + "Hz");
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cout << "Usage: " << argv[0] << " [seconds per run, default 10]"
+              << std::endl;
+    return -1;
+  }
+  uint32_t seconds = 10;
+  if (argc == 2) {
+    seconds = static_cast<uint32_t>(std::atoi(argv[1]));
+  }
+
+  apollo::cyber::Init(argv[0]);
+  for (uint32_t hz : {10, 100, 1000}) {
+    BenchTimer(hz, seconds);
+    BenchTimerComponent(hz, seconds);
+  }
+  apollo::cyber::Clear();
+  return 0;
+}
@@ -17,23 +17,21 @@
 #ifndef CYBER_TIMER_TIMER_TASK_H_
 #define CYBER_TIMER_TIMER_TASK_H_
 
+#include <cstdint>
 #include <functional>
 #include <mutex>
 
 namespace apollo {
 namespace cyber {
 
-class TimerBucket;
-
 struct TimerTask {
   explicit TimerTask(uint64_t timer_id) : timer_id_(timer_id) {}
   uint64_t timer_id_ = 0;
   std::function<void()> callback;
   uint64_t interval_ms = 0;
-  uint64_t remainder_interval_ms = 0;
-  uint64_t next_fire_duration_ms = 0;
-  int64_t accumulated_error_ns = 0;
-  uint64_t last_execute_time_ns = 0;
+  // absolute fire time in MonoTime nanoseconds, a periodic task advances it
+  // by interval_ms each time so that errors do not accumulate
+  uint64_t next_fire_time_ns = 0;
   std::mutex mutex;
 };
 
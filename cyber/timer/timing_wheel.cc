@@ -1,5 +1,5 @@
 /******************************************************************************
- * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,15 +15,60 @@
  *****************************************************************************/
 
 #include "cyber/timer/timing_wheel.h"
+
+#include <time.h>
+
+#include "cyber/common/global_data.h"
 #include "cyber/task/task.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
+using apollo::cyber::common::GlobalData;
+
+namespace {
+constexpr uint32_t kMinResolutionUs = 50;
+}  // namespace
+
+TimingWheel::TimingWheel() {
+  uint32_t resolution_us =
+      GlobalData::Instance()->Config().timer_conf().resolution_us();
+  if (resolution_us < kMinResolutionUs) {
+    AWARN << "timer resolution " << resolution_us << "us is too fine, use "
+          << kMinResolutionUs << "us.";
+    resolution_us = kMinResolutionUs;
+  }
+  resolution_ns_ = static_cast<uint64_t>(resolution_us) * 1000;
+}
+
+TimingWheel::~TimingWheel() {
+  Shutdown();
+
+  auto node = incoming_.exchange(nullptr);
+  while (node != nullptr) {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+  for (auto& level : slots_) {
+    for (auto& slot : level) {
+      while (slot != nullptr) {
+        auto next = slot->next;
+        delete slot;
+        slot = next;
+      }
+    }
+  }
+}
+
 void TimingWheel::Start() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (!running_) {
     ADEBUG << "TimeWheel start ok";
+    // a restarted wheel carries on from the tick it stopped at
+    start_time_ns_.store(Time::MonoTime().ToNanosecond() -
+                         current_tick_ * resolution_ns_);
     running_ = true;
     tick_thread_ = std::thread([this]() { this->TickFunc(); });
     scheduler::Instance()->SetInnerThreadAttr("timer", &tick_thread_);
@@ -40,103 +85,126 @@ void TimingWheel::Shutdown() {
   }
 }
 
-void TimingWheel::Tick() {
-  auto& bucket = work_wheel_[current_work_wheel_index_];
-  {
-    std::lock_guard<std::mutex> lock(bucket.mutex());
-    auto ite = bucket.task_list().begin();
-    while (ite != bucket.task_list().end()) {
-      auto task = ite->lock();
-      if (task) {
-        ADEBUG << "index: " << current_work_wheel_index_
-               << " timer id: " << task->timer_id_;
-        auto callback = task->callback;
-        cyber::Async([this, callback] {
-          if (this->running_) {
-            callback();
-          }
-        });
-      }
-      ite = bucket.task_list().erase(ite);
-    }
-  }
+uint64_t TimingWheel::MaxIntervalMs() const {
+  return ((1ULL << (kLevelNum * kLevelBits)) - 1) * resolution_ns_ / 1000000;
 }
 
 void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
-  AddTask(task, current_work_wheel_index_);
-}
-
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task,
-                          const uint64_t current_work_wheel_index) {
   if (!running_) {
     Start();
   }
 
-  auto work_wheel_index = current_work_wheel_index +
-                          task->next_fire_duration_ms / TIMER_RESOLUTION_MS;
-  if (work_wheel_index >= WORK_WHEEL_SIZE) {
-    auto real_work_wheel_index = GetWorkWheelIndex(work_wheel_index);
-    task->remainder_interval_ms = real_work_wheel_index;
-    auto assistant_ticks = work_wheel_index / WORK_WHEEL_SIZE;
-    if (assistant_ticks == 1 &&
-        real_work_wheel_index != current_work_wheel_index_) {
-      work_wheel_[real_work_wheel_index].AddTask(task);
-      ADEBUG << "add task to work wheel. index :" << real_work_wheel_index;
-    } else {
-      auto assistant_wheel_index = 0;
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        assistant_wheel_index = GetAssistantWheelIndex(
-            current_assistant_wheel_index_ + assistant_ticks);
-        assistant_wheel_[assistant_wheel_index].AddTask(task);
+  auto node = new Node();
+  node->task = task;
+  auto start_time_ns = start_time_ns_.load();
+  if (task->next_fire_time_ns > start_time_ns) {
+    // round up, a timer must not fire early
+    node->deadline_tick = (task->next_fire_time_ns - start_time_ns +
+                           resolution_ns_ - 1) /
+                          resolution_ns_;
+  }
+
+  node->next = incoming_.load(std::memory_order_relaxed);
+  while (!incoming_.compare_exchange_weak(node->next, node,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+  }
+  ADEBUG << "add task [" << task->timer_id_ << "] at tick "
+         << node->deadline_tick;
+}
+
+void TimingWheel::Place(Node* node) {
+  if (node->deadline_tick < current_tick_) {
+    node->deadline_tick = current_tick_;
+  }
+
+  auto delta = node->deadline_tick - current_tick_;
+  uint64_t level = 0;
+  while (level < kLevelNum - 1 &&
+         delta >= (1ULL << ((level + 1) * kLevelBits))) {
+    ++level;
+  }
+  const uint64_t max_delta = (1ULL << (kLevelNum * kLevelBits)) - 1;
+  if (delta > max_delta) {
+    node->deadline_tick = current_tick_ + max_delta;
+  }
+
+  auto& slot = slots_[level][SlotIndex(node->deadline_tick, level)];
+  node->next = slot;
+  slot = node;
+}
+
+uint64_t TimingWheel::Cascade(uint64_t level) {
+  auto index = SlotIndex(current_tick_, level);
+  auto node = slots_[level][index];
+  slots_[level][index] = nullptr;
+  while (node != nullptr) {
+    auto next = node->next;
+    Place(node);
+    node = next;
+  }
+  return index;
+}
+
+void TimingWheel::Fire(Node* node) {
+  auto task = node->task.lock();
+  delete node;
+  if (task) {
+    auto callback = task->callback;
+    cyber::Async([this, callback] {
+      if (this->running_) {
+        callback();
       }
-      ADEBUG << "add task to assistant wheel. index : "
-             << assistant_wheel_index;
-    }
-  } else {
-    work_wheel_[work_wheel_index].AddTask(task);
-    ADEBUG << "add task [" << task->timer_id_
-           << "] to work wheel. index :" << work_wheel_index;
+    });
   }
 }
 
-void TimingWheel::Cascade(const uint64_t assistant_wheel_index) {
-  auto& bucket = assistant_wheel_[assistant_wheel_index];
-  std::lock_guard<std::mutex> lock(bucket.mutex());
-  auto ite = bucket.task_list().begin();
-  while (ite != bucket.task_list().end()) {
-    auto task = ite->lock();
-    if (task) {
-      work_wheel_[task->remainder_interval_ms].AddTask(task);
+void TimingWheel::Tick() {
+  auto node = incoming_.exchange(nullptr, std::memory_order_acquire);
+  while (node != nullptr) {
+    auto next = node->next;
+    Place(node);
+    node = next;
+  }
+
+  auto index = SlotIndex(current_tick_, 0);
+  if (index == 0) {
+    for (uint64_t level = 1; level < kLevelNum; ++level) {
+      if (Cascade(level) != 0) {
+        break;
+      }
     }
-    ite = bucket.task_list().erase(ite);
+  }
+
+  node = slots_[0][index];
+  slots_[0][index] = nullptr;
+  ++current_tick_;
+  tick_count_.fetch_add(1, std::memory_order_relaxed);
+
+  while (node != nullptr) {
+    auto next = node->next;
+    Fire(node);
+    node = next;
   }
 }
 
 void TimingWheel::TickFunc() {
-  Rate rate(TIMER_RESOLUTION_MS * 1000000);  // ms to ns
+  auto start_time_ns = start_time_ns_.load();
   while (running_) {
-    Tick();
-    // AINFO_EVERY(1000) << "Tick " << TickCount();
-    tick_count_++;
-    rate.Sleep();
-    {
-      std::lock_guard<std::mutex> lock(current_work_wheel_index_mutex_);
-      current_work_wheel_index_ =
-          GetWorkWheelIndex(current_work_wheel_index_ + 1);
-    }
-    if (current_work_wheel_index_ == 0) {
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        current_assistant_wheel_index_ =
-            GetAssistantWheelIndex(current_assistant_wheel_index_ + 1);
-      }
-      Cascade(current_assistant_wheel_index_);
+    auto now = Time::MonoTime().ToNanosecond();
+    while (running_ && start_time_ns + current_tick_ * resolution_ns_ <= now) {
+      Tick();
     }
+
+    // sleep until the absolute time of the next tick, so that the time spent
+    // ticking does not add up
+    auto next_tick_ns = start_time_ns + current_tick_ * resolution_ns_;
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(next_tick_ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(next_tick_ns % 1000000000);  // NOLINT
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
   }
 }
 
-TimingWheel::TimingWheel() {}
-
 }  // namespace cyber
 }  // namespace apollo
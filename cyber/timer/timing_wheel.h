@@ -1,5 +1,5 @@
 /******************************************************************************
- * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,72 +17,78 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
+#include <atomic>
 #include <future>
-#include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/scheduler/scheduler_factory.h"
-#include "cyber/time/rate.h"
-#include "cyber/timer/timer_bucket.h"
+#include "cyber/timer/timer_task.h"
 
 namespace apollo {
 namespace cyber {
 
-struct TimerTask;
-
-static const uint64_t WORK_WHEEL_SIZE = 512;
-static const uint64_t ASSISTANT_WHEEL_SIZE = 64;
-static const uint64_t TIMER_RESOLUTION_MS = 2;
-static const uint64_t TIMER_MAX_INTERVAL_MS =
-    WORK_WHEEL_SIZE * ASSISTANT_WHEEL_SIZE * TIMER_RESOLUTION_MS;
-
+/**
+ * @brief Hierarchical timing wheel driving all timers of the process.
+ *
+ * Four levels of 256 slots cover 2^32 ticks. Tasks are handed over through a
+ * lock-free list, so AddTask never blocks, and only the tick thread touches
+ * the slots. Ticks are due at absolute times derived from the start time, so
+ * a late wake up is caught up instead of pushing all later ticks back.
+ */
 class TimingWheel {
  public:
-  ~TimingWheel() {
-    if (running_) {
-      Shutdown();
-    }
-  }
+  ~TimingWheel();
 
   void Start();
 
   void Shutdown();
 
-  void Tick();
-
+  // Fires task at task->next_fire_time_ns, in MonoTime nanoseconds.
   void AddTask(const std::shared_ptr<TimerTask>& task);
 
-  void AddTask(const std::shared_ptr<TimerTask>& task,
-               const uint64_t current_work_wheel_index);
+  uint64_t TickCount() const { return tick_count_.load(); }
+  uint64_t ResolutionNs() const { return resolution_ns_; }
+  uint64_t MaxIntervalMs() const;
+
+ private:
+  static constexpr uint64_t kLevelBits = 8;
+  static constexpr uint64_t kLevelSize = 1 << kLevelBits;
+  static constexpr uint64_t kLevelNum = 4;
 
-  void Cascade(const uint64_t assistant_wheel_index);
+  struct Node {
+    std::weak_ptr<TimerTask> task;
+    uint64_t deadline_tick = 0;
+    Node* next = nullptr;
+  };
 
   void TickFunc();
+  void Tick();
+  void Place(Node* node);
+  // Moves the slot of the given level that is due now down the wheel.
+  uint64_t Cascade(uint64_t level);
+  void Fire(Node* node);
 
-  inline uint64_t TickCount() const { return tick_count_; }
-
- private:
-  inline uint64_t GetWorkWheelIndex(const uint64_t index) {
-    return index & (WORK_WHEEL_SIZE - 1);
-  }
-  inline uint64_t GetAssistantWheelIndex(const uint64_t index) {
-    return index & (ASSISTANT_WHEEL_SIZE - 1);
+  uint64_t SlotIndex(uint64_t tick, uint64_t level) const {
+    return (tick >> (level * kLevelBits)) & (kLevelSize - 1);
   }
 
-  bool running_ = false;
-  uint64_t tick_count_ = 0;
+  std::atomic<bool> running_ = {false};
   std::mutex running_mutex_;
-  TimerBucket work_wheel_[WORK_WHEEL_SIZE];
-  TimerBucket assistant_wheel_[ASSISTANT_WHEEL_SIZE];
-  uint64_t current_work_wheel_index_ = 0;
-  std::mutex current_work_wheel_index_mutex_;
-  uint64_t current_assistant_wheel_index_ = 0;
-  std::mutex current_assistant_wheel_index_mutex_;
   std::thread tick_thread_;
 
+  uint64_t resolution_ns_ = 1000000;
+  std::atomic<uint64_t> start_time_ns_ = {0};
+  std::atomic<Node*> incoming_ = {nullptr};
+
+  // owned by the tick thread
+  Node* slots_[kLevelNum][kLevelSize] = {};
+  uint64_t current_tick_ = 0;
+  std::atomic<uint64_t> tick_count_ = {0};
+
   DECLARE_SINGLETON(TimingWheel)
 };
 
@@ -16,17 +16,26 @@
 
 #include "cyber/tools/cyber_monitor/general_channel_message.h"
 
+#include <cstring>
 #include <iomanip>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "cyber/event/latency_tracer.h"
 #include "cyber/record/record_message.h"
+#include "cyber/service_discovery/topology_manager.h"
+#include "cyber/sysmo/latency_service.h"
 #include "cyber/tools/cyber_monitor/general_message.h"
 #include "cyber/tools/cyber_monitor/screen.h"
 
 namespace {
 constexpr int ReaderWriterOffset = 4;
+constexpr int LatencyColumnWidth = 11;
+using apollo::cyber::event::LatencyHistogram;
+using apollo::cyber::proto::LatencyReport;
+using apollo::cyber::proto::LatencyRequest;
 using apollo::cyber::record::kGB;
 using apollo::cyber::record::kKB;
 using apollo::cyber::record::kMB;
@@ -147,6 +156,11 @@ void GeneralChannelMessage::Render(const Screen* s, int key) {
       current_state_ = State::ShowInfo;
       break;
 
+    case 'l':
+    case 'L':
+      current_state_ = State::ShowLatency;
+      break;
+
     default: {}
   }
 
@@ -169,6 +183,9 @@ void GeneralChannelMessage::Render(const Screen* s, int key) {
       case State::ShowInfo:
         RenderInfo(s, key, lineNo);
         break;
+      case State::ShowLatency:
+        RenderLatency(s, key, lineNo);
+        break;
     }
   } else {
     s->AddStr(0, lineNo++, "Channel has been closed");
@@ -278,3 +295,119 @@ void GeneralChannelMessage::RenderDebugString(const Screen* s, int key,
     s->AddStr(0, lineNo++, "No Message Came");
   }
 }
+
+void GeneralChannelMessage::UpdateLatency(void) {
+  for (auto iter = latency_requests_.begin();
+       iter != latency_requests_.end();) {
+    if (!iter->second.valid() ||
+        iter->second.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+      ++iter;
+      continue;
+    }
+    auto report = iter->second.get();
+    if (report != nullptr) {
+      latency_reports_[iter->first] = *report;
+    }
+    iter = latency_requests_.erase(iter);
+  }
+
+  auto time_now = apollo::cyber::Time::MonoTime();
+  if ((time_now - latency_time_).ToNanosecond() < 1000000000) {
+    return;
+  }
+  latency_time_ = time_now;
+
+  std::vector<apollo::cyber::proto::RoleAttributes> servers;
+  apollo::cyber::service_discovery::TopologyManager::Instance()
+      ->service_manager()
+      ->GetServers(&servers);
+
+  const char* prefix = apollo::cyber::LatencyService::kServicePrefix;
+  auto request = std::make_shared<LatencyRequest>();
+  request->set_channel_name(GetChannelName());
+  std::set<std::string> service_names;
+  for (const auto& server : servers) {
+    const std::string& service_name = server.service_name();
+    if (service_name.compare(0, std::strlen(prefix), prefix) != 0 ||
+        !service_names.insert(service_name).second) {
+      continue;
+    }
+    auto& client = latency_clients_[service_name];
+    if (client == nullptr) {
+      client = channel_node_->CreateClient<LatencyRequest, LatencyReport>(
+          service_name);
+    }
+    if (client != nullptr) {
+      // a request that was not answered within a second is given up
+      latency_requests_[service_name] = client->AsyncSendRequest(request);
+    }
+  }
+
+  for (auto iter = latency_reports_.begin(); iter != latency_reports_.end();) {
+    if (service_names.count(iter->first) == 0) {
+      iter = latency_reports_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void GeneralChannelMessage::RenderLatency(const Screen* s, int key,
+                                          unsigned lineNo) {
+  (void)key;
+  UpdateLatency();
+
+  const std::vector<std::string> kColumns = {"Count", "Avg(us)", "P50(us)",
+                                             "P99(us)", "Max(us)"};
+  std::ostringstream outStr;
+  auto addRow = [&](int indent, const std::string& name,
+                    const apollo::cyber::proto::LatencyHistogram& histogram) {
+    s->AddStr(indent, lineNo, name.c_str());
+    std::vector<uint64_t> values = {
+        histogram.count(),
+        histogram.count() ? histogram.sum_ns() / histogram.count() / 1000 : 0,
+        LatencyHistogram::Percentile(histogram, 50) / 1000,
+        LatencyHistogram::Percentile(histogram, 99) / 1000,
+        histogram.max_ns() / 1000};
+    int x = LatencyColumnWidth + indent;
+    for (auto value : values) {
+      outStr.str("");
+      outStr << value;
+      s->AddStr(x, lineNo, outStr.str().c_str());
+      x += LatencyColumnWidth;
+    }
+    ++lineNo;
+  };
+
+  s->AddStr(0, lineNo++, "Latency: ");
+  if (latency_reports_.empty()) {
+    s->AddStr(0, lineNo++, "No Latency Service Answered");
+    return;
+  }
+  int x = LatencyColumnWidth + ReaderWriterOffset;
+  for (const auto& column : kColumns) {
+    s->AddStr(x, lineNo, column.c_str());
+    x += LatencyColumnWidth;
+  }
+  ++lineNo;
+
+  // one process per block, the transport stages of the channel first and the
+  // callback stages of each of its readers after them
+  for (const auto& item : latency_reports_) {
+    const LatencyReport& report = item.second;
+    for (const auto& channel : report.channel()) {
+      outStr.str("");
+      outStr << report.host_name() << " pid " << report.process_id();
+      s->AddStr(0, lineNo++, outStr.str().c_str());
+      addRow(ReaderWriterOffset, "publish", channel.publish());
+      addRow(ReaderWriterOffset, "transport", channel.transport());
+      for (const auto& reader : channel.reader()) {
+        s->AddStr(ReaderWriterOffset, lineNo++, reader.reader_name().c_str());
+        addRow(ReaderWriterOffset * 2, "queue", reader.queue());
+        addRow(ReaderWriterOffset * 2, "compute", reader.compute());
+        addRow(ReaderWriterOffset * 2, "end2end", reader.end_to_end());
+      }
+    }
+  }
+}
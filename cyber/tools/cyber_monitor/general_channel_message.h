@@ -18,8 +18,13 @@
 #define TOOLS_CVT_MONITOR_GENERAL_CHANNEL_MESSAGE_H_
 
 #include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cyber/message/raw_message.h"
+#include "cyber/proto/latency_trace.pb.h"
 #include "general_message_base.h"
 
 class CyberTopologyMessage;
@@ -49,6 +54,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
   }
 
   ~GeneralChannelMessage() {
+    latency_clients_.clear();
+    latency_requests_.clear();
     channel_node_.reset();
     channel_reader_.reset();
     channel_message_.reset();
@@ -88,6 +95,9 @@ class GeneralChannelMessage : public GeneralMessageBase {
   void Render(const Screen* s, int key) override;
 
   void CloseChannel(void) {
+    latency_clients_.clear();
+    latency_requests_.clear();
+
     if (channel_reader_ != nullptr) {
       channel_reader_.reset();
     }
@@ -161,10 +171,15 @@ class GeneralChannelMessage : public GeneralMessageBase {
 
   void RenderDebugString(const Screen* s, int key, unsigned lineNo);
   void RenderInfo(const Screen* s, int key, unsigned lineNo);
+  void RenderLatency(const Screen* s, int key, unsigned lineNo);
+
+  // asks the latency services of all processes for this channel, at most
+  // once a second, and keeps the answers that came in meanwhile
+  void UpdateLatency(void);
 
   void set_has_message_come(bool b) { has_message_come_ = b; }
 
-  enum class State { ShowDebugString, ShowInfo } current_state_;
+  enum class State { ShowDebugString, ShowInfo, ShowLatency } current_state_;
 
   bool has_message_come_;
   std::string message_type_;
@@ -187,6 +202,15 @@ class GeneralChannelMessage : public GeneralMessageBase {
 
   google::protobuf::Message* raw_msg_class_;
 
+  using LatencyClient =
+      apollo::cyber::Client<apollo::cyber::proto::LatencyRequest,
+                            apollo::cyber::proto::LatencyReport>;
+  // key: service name
+  std::map<std::string, std::shared_ptr<LatencyClient>> latency_clients_;
+  std::map<std::string, LatencyClient::SharedFuture> latency_requests_;
+  std::map<std::string, apollo::cyber::proto::LatencyReport> latency_reports_;
+  apollo::cyber::Time latency_time_;
+
   friend class CyberTopologyMessage;
   friend class GeneralMessage;
 };  // GeneralChannelMessage
@@ -67,6 +67,8 @@ const char Screen::InteractiveCmdStr[] =
     "Commands for Channel:\n"
     "   i | I -- show Reader and Writers of Channel\n"
     "   b | B -- show Debug String of Channel Message\n"
+    "   l | L -- show Latency of Channel Messages, processes need\n"
+    "            perf_conf.latency_trace in cyber.pb.conf\n"
     "\n"
     "Commands for Channel Repeated Datum:\n"
     "   n | N -- next repeated data item\n"
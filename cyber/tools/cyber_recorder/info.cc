@@ -72,6 +72,17 @@ bool Info::Display(const std::string& file) {
   }
   std::cout << std::endl;
 
+  // compression
+  std::cout << std::setw(w) << "compress: "
+            << proto::CompressType_Name(hdr.compress());
+  if (hdr.body_stored_size() > 0) {
+    std::cout << " (ratio: " << std::setprecision(2)
+              << static_cast<double>(hdr.body_raw_size()) /
+                     static_cast<double>(hdr.body_stored_size())
+              << ")" << std::setprecision(6);
+  }
+  std::cout << std::endl;
+
   // is_complete
   std::cout << std::setw(w) << "is_complete:";
   if (hdr.is_complete()) {
@@ -33,17 +33,19 @@
 using apollo::cyber::common::GetFileName;
 using apollo::cyber::common::StringToUnixSeconds;
 using apollo::cyber::common::UnixSecondsToString;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::record::HeaderBuilder;
 using apollo::cyber::record::Info;
 using apollo::cyber::record::Player;
+using apollo::cyber::record::PlayMode;
 using apollo::cyber::record::PlayParam;
 using apollo::cyber::record::Recorder;
 using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:i:m:h";
-const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:h";
+const char RECORD_OPTIONS[] = "o:ac:i:m:z:L:h";
+const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:M:h";
 const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
 
@@ -145,6 +147,19 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress <lz4|zstd>\t\t" << command
+                  << " with compressed chunks" << std::endl;
+        break;
+      case 'L':
+        std::cout << "\t-L, --compress-level <level>\t\t" << command
+                  << " with the given compress level" << std::endl;
+        break;
+      case 'M':
+        std::cout << "\t-M, --mode <normal|precise|fastest>\t" << command
+                  << " paced by sleeps, by deadlines or not at all"
+                  << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -170,7 +185,7 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:h";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:z:L:M:h";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -186,6 +201,9 @@ int main(int argc, char** argv) {
       {"preload", required_argument, nullptr, 'p'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", required_argument, nullptr, 'z'},
+      {"compress-level", required_argument, nullptr, 'L'},
+      {"mode", required_argument, nullptr, 'M'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
@@ -200,6 +218,7 @@ int main(int argc, char** argv) {
   uint64_t opt_start = 0;
   uint64_t opt_delay = 0;
   uint32_t opt_preload = 3;
+  PlayMode opt_play_mode = PlayMode::NORMAL;
   auto opt_header = HeaderBuilder::GetHeader();
 
   do {
@@ -346,6 +365,47 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'z': {
+        const std::string type(optarg);
+        if (type == "lz4") {
+          opt_header.set_compress(CompressType::COMPRESS_LZ4);
+        } else if (type == "zstd") {
+          opt_header.set_compress(CompressType::COMPRESS_ZSTD);
+        } else if (type == "none") {
+          opt_header.set_compress(CompressType::COMPRESS_NONE);
+        } else {
+          std::cout << "Invalid argument: -z/--compress " << type << std::endl;
+          return -1;
+        }
+        break;
+      }
+      case 'L':
+        try {
+          opt_header.set_compress_level(std::stoi(optarg));
+        } catch (std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -L/--compress-level "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -L/--compress-level "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
+      case 'M': {
+        const std::string mode(optarg);
+        if (mode == "normal") {
+          opt_play_mode = PlayMode::NORMAL;
+        } else if (mode == "precise") {
+          opt_play_mode = PlayMode::PRECISE;
+        } else if (mode == "fastest") {
+          opt_play_mode = PlayMode::FASTEST;
+        } else {
+          std::cout << "Invalid argument: -M/--mode " << mode << std::endl;
+          return -1;
+        }
+        break;
+      }
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -390,6 +450,7 @@ int main(int argc, char** argv) {
     }
     ::apollo::cyber::Init(argv[0]);
     PlayParam play_param;
+    play_param.play_mode = opt_play_mode;
     play_param.is_play_all_channels = opt_all || opt_white_channels.empty();
     play_param.is_loop_playback = opt_loop;
     play_param.play_rate = opt_rate;
@@ -25,7 +25,17 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+enum class PlayMode {
+  // sleep until each message is due
+  NORMAL = 0,
+  // sleep until shortly before each message is due, then spin
+  PRECISE = 1,
+  // publish every message as soon as the one before has been written
+  FASTEST = 2,
+};
+
 struct PlayParam {
+  PlayMode play_mode = PlayMode::NORMAL;
   bool is_play_all_channels = false;
   bool is_loop_playback = false;
   double play_rate = 1.0;
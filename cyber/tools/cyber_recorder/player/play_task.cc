@@ -31,17 +31,17 @@ PlayTask::PlayTask(const MessagePtr& msg, const WriterPtr& writer,
       msg_real_time_ns_(msg_real_time_ns),
       msg_play_time_ns_(msg_play_time_ns) {}
 
-void PlayTask::Play() {
+bool PlayTask::Play() {
   if (writer_ == nullptr) {
     AERROR << "writer is nullptr, can't write message.";
-    return;
+    return false;
   }
 
   if (!writer_->Write(msg_)) {
     AERROR << "write message failed, played num: " << played_msg_num_.load()
            << ", real time: " << msg_real_time_ns_
            << ", play time: " << msg_play_time_ns_;
-    return;
+    return false;
   }
 
   played_msg_num_.fetch_add(1);
@@ -49,6 +49,7 @@ void PlayTask::Play() {
   ADEBUG << "write message succ, played num: " << played_msg_num_.load()
          << ", real time: " << msg_real_time_ns_
          << ", play time: " << msg_play_time_ns_;
+  return true;
 }
 
 }  // namespace record
@@ -37,7 +37,7 @@ class PlayTask {
            uint64_t msg_real_time_ns, uint64_t msg_play_time_ns);
   virtual ~PlayTask() {}
 
-  void Play();
+  bool Play();
 
   uint64_t msg_real_time_ns() const { return msg_real_time_ns_; }
   uint64_t msg_play_time_ns() const { return msg_play_time_ns_; }
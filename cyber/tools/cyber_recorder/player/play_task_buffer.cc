@@ -16,7 +16,8 @@
 
 #include "cyber/tools/cyber_recorder/player/play_task_buffer.h"
 
-#include <utility>
+#include <algorithm>
+#include <chrono>
 
 namespace apollo {
 namespace cyber {
@@ -40,8 +41,22 @@ void PlayTaskBuffer::Push(const TaskPtr& task) {
   if (task == nullptr) {
     return;
   }
-  std::lock_guard<std::mutex> lck(mutex_);
-  tasks_.insert(std::make_pair(task->msg_play_time_ns(), task));
+  {
+    std::lock_guard<std::mutex> lck(mutex_);
+    auto play_time_ns = task->msg_play_time_ns();
+    if (tasks_.empty() || tasks_.back()->msg_play_time_ns() <= play_time_ns) {
+      tasks_.emplace_back(task);
+    } else {
+      // behind the tasks with the same play time, like a multimap
+      auto pos = std::upper_bound(
+          tasks_.begin(), tasks_.end(), play_time_ns,
+          [](uint64_t time, const TaskPtr& other) {
+            return time < other->msg_play_time_ns();
+          });
+      tasks_.insert(pos, task);
+    }
+  }
+  push_cv_.notify_one();
 }
 
 PlayTaskBuffer::TaskPtr PlayTaskBuffer::Front() {
@@ -49,15 +64,33 @@ PlayTaskBuffer::TaskPtr PlayTaskBuffer::Front() {
   if (tasks_.empty()) {
     return nullptr;
   }
-  auto res = tasks_.begin()->second;
-  return res;
+  return tasks_.front();
 }
 
 void PlayTaskBuffer::PopFront() {
-  std::lock_guard<std::mutex> lck(mutex_);
-  if (!tasks_.empty()) {
-    tasks_.erase(tasks_.begin());
+  {
+    std::lock_guard<std::mutex> lck(mutex_);
+    if (tasks_.empty()) {
+      return;
+    }
+    tasks_.pop_front();
   }
+  pop_cv_.notify_one();
+}
+
+PlayTaskBuffer::TaskPtr PlayTaskBuffer::WaitFront(uint64_t timeout_ns) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (!push_cv_.wait_for(lck, std::chrono::nanoseconds(timeout_ns),
+                         [this] { return !tasks_.empty(); })) {
+    return nullptr;
+  }
+  return tasks_.front();
+}
+
+bool PlayTaskBuffer::WaitSizeAtMost(size_t size, uint64_t timeout_ns) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  return pop_cv_.wait_for(lck, std::chrono::nanoseconds(timeout_ns),
+                          [this, size] { return tasks_.size() <= size; });
 }
 
 }  // namespace record
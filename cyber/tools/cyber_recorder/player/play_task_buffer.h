@@ -18,7 +18,8 @@
 #define CYBER_TOOLS_CYBER_RECORDER_PLAYER_PLAY_TASK_BUFFER_H_
 
 #include <stdint.h>
-#include <map>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 
@@ -31,8 +32,9 @@ namespace record {
 class PlayTaskBuffer {
  public:
   using TaskPtr = std::shared_ptr<PlayTask>;
-  // if all tasks are in order, we can use other container to replace this
-  using TaskMap = std::multimap<uint64_t, TaskPtr>;
+  // the producer pushes tasks in play time order, so they are appended and
+  // only a task that is out of order has to be inserted
+  using TaskQueue = std::deque<TaskPtr>;
 
   PlayTaskBuffer();
   virtual ~PlayTaskBuffer();
@@ -44,9 +46,16 @@ class PlayTaskBuffer {
   TaskPtr Front();
   void PopFront();
 
+  // Waits at most timeout_ns for a task, returns nullptr if there is none.
+  TaskPtr WaitFront(uint64_t timeout_ns);
+  // Waits at most timeout_ns until no more than size tasks are left.
+  bool WaitSizeAtMost(size_t size, uint64_t timeout_ns);
+
  private:
-  TaskMap tasks_;
+  TaskQueue tasks_;
   mutable std::mutex mutex_;
+  std::condition_variable push_cv_;
+  std::condition_variable pop_cv_;
 };
 
 }  // namespace record
@@ -16,6 +16,12 @@
 
 #include "cyber/tools/cyber_recorder/player/play_task_consumer.h"
 
+#include <time.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include "cyber/base/macros.h"
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
 
@@ -25,11 +31,14 @@ namespace record {
 
 const uint64_t PlayTaskConsumer::kPauseSleepNanoSec = 100000000UL;
 const uint64_t PlayTaskConsumer::kWaitProduceSleepNanoSec = 5000000UL;
+const uint64_t PlayTaskConsumer::kSpinNanoSec = 50000UL;
+const uint64_t PlayTaskConsumer::kErrorBucketNum = 10000UL;
 const uint64_t PlayTaskConsumer::MIN_SLEEP_DURATION_NS = 200000000UL;
 
 PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
-                                   double play_rate)
+                                   double play_rate, PlayMode play_mode)
     : play_rate_(play_rate),
+      play_mode_(play_mode),
       consume_th_(nullptr),
       task_buffer_(task_buffer),
       is_stopped_(true),
@@ -37,7 +46,8 @@ PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
       is_playonce_(false),
       base_msg_play_time_ns_(0),
       base_msg_real_time_ns_(0),
-      last_played_msg_real_time_ns_(0) {
+      last_played_msg_real_time_ns_(0),
+      error_histogram_(kErrorBucketNum + 1, 0) {
   if (play_rate_ <= 0) {
     AERROR << "invalid play rate: " << play_rate_
            << " , we will use default value(1.0).";
@@ -56,24 +66,111 @@ void PlayTaskConsumer::Start(uint64_t begin_time_ns) {
 }
 
 void PlayTaskConsumer::Stop() {
-  if (is_stopped_.exchange(true)) {
-    return;
-  }
+  is_stopped_.store(true);
+  // a second caller waits for the join of the first one too
+  std::lock_guard<std::mutex> lg(stop_mutex_);
   if (consume_th_ != nullptr && consume_th_->joinable()) {
     consume_th_->join();
     consume_th_ = nullptr;
   }
 }
 
+uint64_t PlayTaskConsumer::NowNs() const {
+  // precise deadlines are slept to on the monotonic clock
+  if (play_mode_ == PlayMode::PRECISE) {
+    return Time::MonoTime().ToNanosecond();
+  }
+  return Time::Now().ToNanosecond();
+}
+
+void PlayTaskConsumer::SleepUntil(uint64_t deadline_ns) {
+  // the kernel wakes up late by up to tens of microseconds, so sleep to
+  // shortly before the deadline on absolute time and spin the rest
+  uint64_t wake_ns =
+      deadline_ns > kSpinNanoSec ? deadline_ns - kSpinNanoSec : 0;
+  uint64_t now_ns = NowNs();
+  while (now_ns < wake_ns && !is_stopped_.load()) {
+    uint64_t sleep_to_ns = std::min(wake_ns, now_ns + MIN_SLEEP_DURATION_NS);
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(sleep_to_ns / 1000000000UL);
+    ts.tv_nsec = static_cast<long>(sleep_to_ns % 1000000000UL);  // NOLINT
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+    now_ns = NowNs();
+  }
+  while (NowNs() < deadline_ns && !is_stopped_.load()) {
+    cpu_relax();
+  }
+}
+
+void PlayTaskConsumer::Record(uint64_t deadline_ns, uint64_t play_time_ns,
+                              bool played) {
+  if (!played) {
+    ++failed_msg_num_;
+    return;
+  }
+  ++played_msg_num_;
+  if (first_play_time_ns_ == 0) {
+    first_play_time_ns_ = play_time_ns;
+  }
+  last_play_time_ns_ = play_time_ns;
+
+  uint64_t error_ns = play_time_ns > deadline_ns ? play_time_ns - deadline_ns
+                                                 : deadline_ns - play_time_ns;
+  error_sum_ns_ += error_ns;
+  max_error_ns_ = std::max(max_error_ns_, error_ns);
+  ++error_histogram_[std::min(error_ns / 1000, kErrorBucketNum)];
+}
+
+void PlayTaskConsumer::PrintStatistics() const {
+  std::cout << "played messages: " << played_msg_num_
+            << ", failed: " << failed_msg_num_ << std::endl;
+  if (played_msg_num_ == 0) {
+    return;
+  }
+
+  double played_s =
+      static_cast<double>(last_play_time_ns_ - first_play_time_ns_ -
+                          std::min(paused_time_ns_,
+                                   last_play_time_ns_ - first_play_time_ns_)) /
+      1e9;
+  double requested_s =
+      static_cast<double>(last_msg_play_time_ns_ - base_msg_play_time_ns_) /
+      play_rate_ / 1e9;
+  std::cout << "play time: " << played_s << "s, requested: " << requested_s
+            << "s";
+  if (played_s > 0) {
+    std::cout << ", throughput: "
+              << static_cast<double>(played_msg_num_) / played_s << " msg/s";
+  }
+  std::cout << std::endl;
+  if (play_mode_ == PlayMode::FASTEST) {
+    return;
+  }
+
+  auto percentile = [this](double p) {
+    uint64_t rank = static_cast<uint64_t>(p * (played_msg_num_ - 1));
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < kErrorBucketNum; ++i) {
+      count += error_histogram_[i];
+      if (count > rank) {
+        return i;
+      }
+    }
+    return kErrorBucketNum;
+  };
+  std::cout << "timing error: mean "
+            << error_sum_ns_ / played_msg_num_ / 1000 << "us, p50 "
+            << percentile(0.5) << "us, p99 " << percentile(0.99)
+            << "us, max " << max_error_ns_ / 1000 << "us" << std::endl;
+}
+
 void PlayTaskConsumer::ThreadFunc() {
   uint64_t base_real_time_ns = 0;
   uint64_t accumulated_pause_time_ns = 0;
 
   while (!is_stopped_.load()) {
-    auto task = task_buffer_->Front();
+    auto task = task_buffer_->WaitFront(kWaitProduceSleepNanoSec);
     if (task == nullptr) {
-      std::this_thread::sleep_for(
-          std::chrono::nanoseconds(kWaitProduceSleepNanoSec));
       continue;
     }
 
@@ -82,7 +179,8 @@ void PlayTaskConsumer::ThreadFunc() {
     if (base_msg_play_time_ns_ == 0) {
       base_msg_play_time_ns_ = task->msg_play_time_ns();
       base_msg_real_time_ns_ = task->msg_real_time_ns();
-      if (base_msg_play_time_ns_ > begin_time_ns_) {
+      if (base_msg_play_time_ns_ > begin_time_ns_ &&
+          play_mode_ != PlayMode::FASTEST) {
         sleep_ns = static_cast<uint64_t>(
             static_cast<double>(base_msg_play_time_ns_ - begin_time_ns_) /
             play_rate_);
@@ -98,7 +196,7 @@ void PlayTaskConsumer::ThreadFunc() {
 
         std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
       }
-      base_real_time_ns = Time::Now().ToNanosecond();
+      base_real_time_ns = NowNs();
       ADEBUG << "base_msg_play_time_ns: " << base_msg_play_time_ns_
              << "base_real_time_ns: " << base_real_time_ns;
     }
@@ -106,15 +204,31 @@ void PlayTaskConsumer::ThreadFunc() {
     uint64_t task_interval_ns = static_cast<uint64_t>(
         static_cast<double>(task->msg_play_time_ns() - base_msg_play_time_ns_) /
         play_rate_);
-    uint64_t real_time_interval_ns = Time::Now().ToNanosecond() -
-                                     base_real_time_ns -
-                                     accumulated_pause_time_ns;
-    if (task_interval_ns > real_time_interval_ns) {
-      sleep_ns = task_interval_ns - real_time_interval_ns;
-      std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+    uint64_t deadline_ns =
+        base_real_time_ns + accumulated_pause_time_ns + task_interval_ns;
+    switch (play_mode_) {
+      case PlayMode::PRECISE:
+        SleepUntil(deadline_ns);
+        break;
+      case PlayMode::FASTEST:
+        break;
+      default: {
+        uint64_t real_time_interval_ns = NowNs() - base_real_time_ns -
+                                         accumulated_pause_time_ns;
+        if (task_interval_ns > real_time_interval_ns) {
+          sleep_ns = task_interval_ns - real_time_interval_ns;
+          std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+        }
+        break;
+      }
+    }
+    if (is_stopped_.load()) {
+      break;
     }
 
-    task->Play();
+    uint64_t play_time_ns = NowNs();
+    Record(deadline_ns, play_time_ns, task->Play());
+    last_msg_play_time_ns_ = task->msg_play_time_ns();
     is_playonce_.store(false);
 
     last_played_msg_real_time_ns_ = task->msg_real_time_ns();
@@ -125,6 +239,7 @@ void PlayTaskConsumer::ThreadFunc() {
       std::this_thread::sleep_for(std::chrono::nanoseconds(kPauseSleepNanoSec));
       accumulated_pause_time_ns += kPauseSleepNanoSec;
     }
+    paused_time_ns_ = accumulated_pause_time_ns;
     task_buffer_->PopFront();
   }
 }
@@ -20,8 +20,11 @@
 #include <stdint.h>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+#include "cyber/tools/cyber_recorder/player/play_param.h"
 #include "cyber/tools/cyber_recorder/player/play_task_buffer.h"
 
 namespace apollo {
@@ -34,10 +37,12 @@ class PlayTaskConsumer {
   using TaskBufferPtr = std::shared_ptr<PlayTaskBuffer>;
 
   explicit PlayTaskConsumer(const TaskBufferPtr& task_buffer,
-                            double play_rate = 1.0);
+                            double play_rate = 1.0,
+                            PlayMode play_mode = PlayMode::NORMAL);
   virtual ~PlayTaskConsumer();
 
   void Start(uint64_t begin_time_ns);
+  // returns once the consume thread has exited, also when called again
   void Stop();
   void Pause() { is_paused_.exchange(true); }
   void PlayOnce() { is_playonce_.exchange(true); }
@@ -49,11 +54,20 @@ class PlayTaskConsumer {
     return last_played_msg_real_time_ns_;
   }
 
+  // Prints throughput and timing error of the messages played so far, call
+  // it after Stop() has returned.
+  void PrintStatistics() const;
+
  private:
   void ThreadFunc();
+  uint64_t NowNs() const;
+  void SleepUntil(uint64_t deadline_ns);
+  void Record(uint64_t deadline_ns, uint64_t play_time_ns, bool played);
 
   double play_rate_;
+  PlayMode play_mode_;
   ThreadPtr consume_th_;
+  std::mutex stop_mutex_;
   TaskBufferPtr task_buffer_;
   std::atomic<bool> is_stopped_;
   std::atomic<bool> is_paused_;
@@ -62,8 +76,23 @@ class PlayTaskConsumer {
   uint64_t base_msg_play_time_ns_;
   uint64_t base_msg_real_time_ns_;
   uint64_t last_played_msg_real_time_ns_;
+
+  // statistics, only touched by the consume thread until it is stopped
+  uint64_t played_msg_num_ = 0;
+  uint64_t failed_msg_num_ = 0;
+  uint64_t first_play_time_ns_ = 0;
+  uint64_t last_play_time_ns_ = 0;
+  uint64_t last_msg_play_time_ns_ = 0;
+  uint64_t paused_time_ns_ = 0;
+  uint64_t error_sum_ns_ = 0;
+  uint64_t max_error_ns_ = 0;
+  // timing error in microseconds, the last bucket collects the rest
+  std::vector<uint64_t> error_histogram_;
+
   static const uint64_t kPauseSleepNanoSec;
   static const uint64_t kWaitProduceSleepNanoSec;
+  static const uint64_t kSpinNanoSec;
+  static const uint64_t kErrorBucketNum;
   static const uint64_t MIN_SLEEP_DURATION_NS;
 };
 
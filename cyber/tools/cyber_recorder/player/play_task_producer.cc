@@ -31,6 +31,8 @@ namespace record {
 const uint32_t PlayTaskProducer::kMinTaskBufferSize = 500;
 const uint32_t PlayTaskProducer::kPreloadTimeSec = 3;
 const uint64_t PlayTaskProducer::kSleepIntervalNanoSec = 1000000;
+// chunks may be hundreds of MB, one ahead is enough to keep off the disk
+const uint32_t PlayTaskProducer::kPrefetchChunkNum = 1;
 
 PlayTaskProducer::PlayTaskProducer(const TaskBufferPtr& task_buffer,
                                    const PlayParam& play_param)
@@ -92,9 +94,14 @@ bool PlayTaskProducer::ReadRecordInfo() {
 
   auto pb_factory = message::ProtobufFactory::Instance();
 
+  // only complete files are played, so they can be mapped and prefetched
+  ReadOptions read_options;
+  read_options.use_mmap = true;
+  read_options.prefetch_chunks = kPrefetchChunkNum;
+
   // loop each file
   for (auto& file : play_param_.files_to_play) {
-    auto record_reader = std::make_shared<RecordReader>(file);
+    auto record_reader = std::make_shared<RecordReader>(file, read_options);
     if (!record_reader->IsValid()) {
       continue;
     }
@@ -239,6 +246,8 @@ void PlayTaskProducer::ThreadFunc() {
   auto record_viewer = std::make_shared<RecordViewer>(
       record_readers_, play_param_.begin_time_ns, play_param_.end_time_ns,
       play_param_.channels_to_play);
+  // split recordings are decoded file by file on their own threads
+  record_viewer->set_parallel_merge(record_readers_.size() > 1);
 
   uint32_t loop_num = 0;
   while (!is_stopped_.load()) {
@@ -247,9 +256,10 @@ void PlayTaskProducer::ThreadFunc() {
     auto itr_end = record_viewer->end();
 
     while (itr != itr_end && !is_stopped_.load()) {
-      while (!is_stopped_.load() && task_buffer_->Size() > preload_size) {
-        std::this_thread::sleep_for(
-            std::chrono::nanoseconds(avg_interval_time_ns));
+      // woken up as soon as the consumer makes room
+      while (!is_stopped_.load() &&
+             !task_buffer_->WaitSizeAtMost(preload_size,
+                                           avg_interval_time_ns)) {
       }
       for (; itr != itr_end && !is_stopped_.load(); ++itr) {
         if (task_buffer_->Size() > preload_size) {
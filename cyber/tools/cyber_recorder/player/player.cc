@@ -33,7 +33,8 @@ Player::Player(const PlayParam& play_param)
       producer_(nullptr),
       task_buffer_(nullptr) {
   task_buffer_ = std::make_shared<PlayTaskBuffer>();
-  consumer_.reset(new PlayTaskConsumer(task_buffer_, play_param.play_rate));
+  consumer_.reset(new PlayTaskConsumer(task_buffer_, play_param.play_rate,
+                                       play_param.play_mode));
   producer_.reset(new PlayTaskProducer(task_buffer_, play_param));
 }
 
@@ -174,7 +175,9 @@ bool Player::Start() {
         std::chrono::milliseconds(kSleepIntervalMiliSec));
   }
 
+  consumer_->Stop();
   std::cout << "\nplay finished." << std::endl;
+  consumer_->PrintStatistics();
   std::cout.flags(before);
   return true;
 }
@@ -41,6 +41,8 @@ bool Recoverer::Proc() {
 
   // open output file
   proto::Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(reader_.GetHeader().compress());
+  new_hdr.set_compress_level(reader_.GetHeader().compress_level());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
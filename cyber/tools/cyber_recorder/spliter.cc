@@ -68,6 +68,8 @@ bool Spliter::Proc() {
 
   // open output file
   Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(header.compress());
+  new_hdr.set_compress_level(header.compress_level());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
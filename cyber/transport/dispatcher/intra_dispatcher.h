@@ -27,6 +27,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
@@ -157,6 +158,9 @@ class ChannelChain {
              << GlobalData::GetChannelById(channel_id)
              << ", message type: " << message_type;
       handler.reset(new ListenerHandler<MessageT>());
+      handler->set_message_pool(
+          message::MessagePoolManager<MessageT>::Instance()->GetPool(
+              channel_id));
       (*handlers)[channel_id][message_type] = handler;
       created = true;
     } else {
@@ -335,6 +339,8 @@ std::shared_ptr<ListenerHandler<MessageT>> IntraDispatcher::GetHandler(
            << GlobalData::GetChannelById(channel_id) << " with type "
            << message::GetMessageName<MessageT>();
     handler.reset(new ListenerHandler<MessageT>());
+    handler->set_message_pool(
+        message::MessagePoolManager<MessageT>::Instance()->GetPool(channel_id));
     msg_listeners_.Set(channel_id, handler);
   }
 
@@ -25,6 +25,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
 #include "cyber/transport/rtps/attributes_filler.h"
@@ -81,10 +82,12 @@ class RtpsDispatcher : public Dispatcher {
 template <typename MessageT>
 void RtpsDispatcher::AddListener(const RoleAttributes& self_attr,
                                  const MessageListener<MessageT>& listener) {
-  auto listener_adapter = [listener](
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
                               const std::shared_ptr<std::string>& msg_str,
                               const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+    auto msg = pool->Acquire();
     RETURN_IF(!message::ParseFromString(*msg_str, msg.get()));
     listener(msg, msg_info);
   };
@@ -97,10 +100,12 @@ template <typename MessageT>
 void RtpsDispatcher::AddListener(const RoleAttributes& self_attr,
                                  const RoleAttributes& opposite_attr,
                                  const MessageListener<MessageT>& listener) {
-  auto listener_adapter = [listener](
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
                               const std::shared_ptr<std::string>& msg_str,
                               const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+    auto msg = pool->Acquire();
     RETURN_IF(!message::ParseFromString(*msg_str, msg.get()));
     listener(msg, msg_info);
   };
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/dispatcher/shm_dispatch_shards.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+const size_t ShmDispatchShards::kMaxPendingInfos = 4096;
+
+ShmDispatchShards::ShmDispatchShards(const proto::ShmConf& conf) {
+  uint32_t shard_num = std::max(conf.dispatch_shard_num(), 1U);
+  for (uint32_t i = 0; i < shard_num; ++i) {
+    shards_.emplace_back(new Shard());
+  }
+  for (auto& affinity : conf.channel_affinity()) {
+    if (affinity.shard() >= shard_num) {
+      AWARN << "shard " << affinity.shard() << " of channel "
+            << affinity.channel_name() << " is out of range, ignored.";
+      continue;
+    }
+    auto channel_id = GlobalData::RegisterChannel(affinity.channel_name());
+    channel_affinity_[channel_id] = affinity.shard();
+  }
+}
+
+uint32_t ShmDispatchShards::ShardOf(uint64_t channel_id) const {
+  auto iter = channel_affinity_.find(channel_id);
+  if (iter != channel_affinity_.end()) {
+    return iter->second;
+  }
+  return static_cast<uint32_t>(channel_id % shards_.size());
+}
+
+bool ShmDispatchShards::Push(const ReadableInfo& info) {
+  auto& shard = shards_[ShardOf(info.channel_id())];
+  bool dropped = false;
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    if (shard->infos.size() >= kMaxPendingInfos) {
+      AWARN << "shm dispatch shard is overloaded, drop message of channel: "
+            << GlobalData::GetChannelById(shard->infos.front().channel_id());
+      shard->infos.pop_front();
+      dropped = true;
+    }
+    shard->infos.emplace_back(info);
+  }
+  shard->cv.notify_one();
+  return !dropped;
+}
+
+bool ShmDispatchShards::Pop(uint32_t shard_index, uint32_t timeout_ms,
+                            ReadableInfo* info) {
+  auto& shard = shards_[shard_index];
+  std::unique_lock<std::mutex> lock(shard->mutex);
+  shard->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                     [this, &shard] {
+                       return !shard->infos.empty() || stopped_.load();
+                     });
+  if (shard->infos.empty() || stopped_.load()) {
+    return false;
+  }
+  *info = shard->infos.front();
+  shard->infos.pop_front();
+  return true;
+}
+
+void ShmDispatchShards::Stop() {
+  stopped_.store(true);
+  for (auto& shard : shards_) {
+    // taking the lock orders the store before a waiter's check
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->cv.notify_all();
+  }
+}
+
+size_t ShmDispatchShards::pending(uint32_t shard_index) const {
+  auto& shard = shards_[shard_index];
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  return shard->infos.size();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCH_SHARDS_H_
+#define CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCH_SHARDS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/transport_conf.pb.h"
+#include "cyber/transport/shm/readable_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief The queues between the notifier thread of ShmDispatcher and its
+ * shard threads.
+ *
+ * A channel always goes to the same shard, the one of its channel_affinity
+ * or else channel_id % shard_num, so that its messages keep their order.
+ */
+class ShmDispatchShards {
+ public:
+  // readable infos a shard may queue up before the oldest ones are dropped,
+  // the notifier ring does not keep more either
+  static const size_t kMaxPendingInfos;
+
+  // a dispatch_shard_num of 0 is taken as 1, affinities to shards out of
+  // range are ignored
+  explicit ShmDispatchShards(const proto::ShmConf& conf);
+
+  uint32_t shard_num() const { return static_cast<uint32_t>(shards_.size()); }
+  uint32_t ShardOf(uint64_t channel_id) const;
+
+  /**
+   * @brief Queue info for the shard of its channel. A full shard drops its
+   * oldest info first.
+   * @return false if an info was dropped
+   */
+  bool Push(const ReadableInfo& info);
+
+  /**
+   * @brief Take the oldest info of shard, waiting up to timeout_ms for one.
+   * @return false if there was none, or after Stop()
+   */
+  bool Pop(uint32_t shard, uint32_t timeout_ms, ReadableInfo* info);
+
+  // wakes the waiting Pop calls, later ones return false at once
+  void Stop();
+
+  size_t pending(uint32_t shard) const;
+
+ private:
+  struct Shard {
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<ReadableInfo> infos;
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // key: channel_id, value: shard index
+  std::unordered_map<uint64_t, uint32_t> channel_affinity_;
+  std::atomic<bool> stopped_ = {false};
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCH_SHARDS_H_
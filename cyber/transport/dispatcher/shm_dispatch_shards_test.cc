@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/dispatcher/shm_dispatch_shards.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "cyber/common/global_data.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+TEST(ShmDispatchShardsTest, shard_by_channel_id) {
+  proto::ShmConf conf;
+  ShmDispatchShards single(conf);
+  EXPECT_EQ(single.shard_num(), 1);
+  EXPECT_EQ(single.ShardOf(12345), 0);
+
+  conf.set_dispatch_shard_num(0);
+  EXPECT_EQ(ShmDispatchShards(conf).shard_num(), 1);
+
+  conf.set_dispatch_shard_num(4);
+  ShmDispatchShards shards(conf);
+  EXPECT_EQ(shards.shard_num(), 4);
+  for (uint64_t channel_id = 100; channel_id < 108; ++channel_id) {
+    EXPECT_EQ(shards.ShardOf(channel_id), channel_id % 4);
+    EXPECT_TRUE(shards.Push(ReadableInfo(0, 0, channel_id)));
+  }
+  for (uint32_t shard = 0; shard < 4; ++shard) {
+    EXPECT_EQ(shards.pending(shard), 2);
+  }
+
+  // a channel keeps its order within its shard
+  ReadableInfo info;
+  EXPECT_TRUE(shards.Push(ReadableInfo(0, 7, 101)));
+  EXPECT_TRUE(shards.Pop(1, 0, &info));
+  EXPECT_EQ(info.channel_id(), 101);
+  EXPECT_EQ(info.block_index(), 0);
+  EXPECT_TRUE(shards.Pop(1, 0, &info));
+  EXPECT_EQ(info.channel_id(), 105);
+  EXPECT_TRUE(shards.Pop(1, 0, &info));
+  EXPECT_EQ(info.block_index(), 7);
+  EXPECT_FALSE(shards.Pop(1, 0, &info));
+}
+
+TEST(ShmDispatchShardsTest, channel_affinity) {
+  proto::ShmConf conf;
+  conf.set_dispatch_shard_num(3);
+  auto affinity = conf.add_channel_affinity();
+  affinity->set_channel_name("/shards/pinned");
+  affinity->set_shard(2);
+  affinity = conf.add_channel_affinity();
+  affinity->set_channel_name("/shards/out_of_range");
+  affinity->set_shard(3);
+  ShmDispatchShards shards(conf);
+
+  auto pinned = GlobalData::RegisterChannel("/shards/pinned");
+  EXPECT_EQ(shards.ShardOf(pinned), 2);
+  auto out_of_range = GlobalData::RegisterChannel("/shards/out_of_range");
+  EXPECT_EQ(shards.ShardOf(out_of_range), out_of_range % 3);
+
+  EXPECT_TRUE(shards.Push(ReadableInfo(0, 0, pinned)));
+  EXPECT_EQ(shards.pending(2), 1);
+}
+
+TEST(ShmDispatchShardsTest, drop_oldest_when_full) {
+  proto::ShmConf conf;
+  conf.set_dispatch_shard_num(2);
+  ShmDispatchShards shards(conf);
+
+  const uint32_t max = static_cast<uint32_t>(
+      ShmDispatchShards::kMaxPendingInfos);
+  for (uint32_t i = 0; i < max; ++i) {
+    ASSERT_TRUE(shards.Push(ReadableInfo(0, i, 2)));
+  }
+  EXPECT_FALSE(shards.Push(ReadableInfo(0, max, 2)));
+  EXPECT_FALSE(shards.Push(ReadableInfo(0, max + 1, 2)));
+  EXPECT_EQ(shards.pending(0), ShmDispatchShards::kMaxPendingInfos);
+  // the other shard is not affected
+  EXPECT_TRUE(shards.Push(ReadableInfo(0, 0, 3)));
+  EXPECT_EQ(shards.pending(1), 1);
+
+  ReadableInfo info;
+  ASSERT_TRUE(shards.Pop(0, 0, &info));
+  EXPECT_EQ(info.block_index(), 2);
+}
+
+TEST(ShmDispatchShardsTest, stop_wakes_waiters) {
+  proto::ShmConf conf;
+  conf.set_dispatch_shard_num(2);
+  ShmDispatchShards shards(conf);
+
+  ReadableInfo info;
+  bool popped = true;
+  std::thread waiter([&shards, &info, &popped]() {
+    popped = shards.Pop(0, 60 * 1000, &info);
+  });
+  shards.Stop();
+  waiter.join();
+  EXPECT_FALSE(popped);
+
+  EXPECT_TRUE(shards.Push(ReadableInfo(0, 0, 2)));
+  EXPECT_FALSE(shards.Pop(0, 0, &info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
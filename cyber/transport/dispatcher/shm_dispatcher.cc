@@ -17,6 +17,7 @@
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
+#include "cyber/event/latency_tracer.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/transport/shm/readable_info.h"
 
@@ -25,6 +26,7 @@ namespace cyber {
 namespace transport {
 
 using common::GlobalData;
+using event::LatencyTracer;
 
 ShmDispatcher::ShmDispatcher() : host_id_(0) { Init(); }
 
@@ -39,8 +41,17 @@ void ShmDispatcher::Shutdown() {
     thread_.join();
   }
 
+  if (shards_ != nullptr) {
+    shards_->Stop();
+  }
+  for (auto& thread : shard_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
   {
-    ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+    WriteLockGuard<AtomicRWLock> lock(segments_lock_);
     segments_.clear();
   }
 }
@@ -53,16 +64,30 @@ void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   }
   auto segment = SegmentFactory::CreateSegment(channel_id);
   segments_[channel_id] = segment;
-  previous_indexes_[channel_id] = UINT32_MAX;
 }
 
-void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
+void ShmDispatcher::AddViewListener(const RoleAttributes& self_attr,
+                                    const MessageViewListener& listener) {
+  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
+                                     const MessageInfo& msg_info) {
+    MessageView view;
+    view.data = rb->buf;
+    view.size = rb->block->msg_size();
+    listener(view, msg_info);
+  };
+
+  Dispatcher::AddListener<ReadableBlock>(self_attr, listener_adapter);
+  AddSegment(self_attr);
+}
+
+void ShmDispatcher::ReadMessage(const SegmentPtr& segment, uint64_t channel_id,
+                                uint32_t block_index) {
   ADEBUG << "Reading sharedmem message: "
          << GlobalData::GetChannelById(channel_id)
          << " from block: " << block_index;
   auto rb = std::make_shared<ReadableBlock>();
   rb->index = block_index;
-  if (!segments_[channel_id]->AcquireBlockToRead(rb.get())) {
+  if (!segment->AcquireBlockToRead(rb.get())) {
     AWARN << "fail to acquire block, channel: "
           << GlobalData::GetChannelById(channel_id)
           << " index: " << block_index;
@@ -74,12 +99,15 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
       reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
 
   if (msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size())) {
+    if (msg_info.has_trace()) {
+      msg_info.set_dispatch_time(LatencyTracer::Now());
+    }
     OnMessage(channel_id, rb, msg_info);
   } else {
     AERROR << "error msg info of channel:"
            << GlobalData::GetChannelById(channel_id);
   }
-  segments_[channel_id]->ReleaseReadBlock(*rb);
+  segment->ReleaseReadBlock(*rb);
 }
 
 void ShmDispatcher::OnMessage(uint64_t channel_id,
@@ -99,6 +127,40 @@ void ShmDispatcher::OnMessage(uint64_t channel_id,
   }
 }
 
+void ShmDispatcher::HandleReadableInfo(const ReadableInfo& readable_info,
+                                       IndexContainer* previous_indexes) {
+  uint64_t channel_id = readable_info.channel_id();
+  uint32_t block_index = readable_info.block_index();
+
+  // shard threads share the lock, so they only look segments up and
+  // AddSegment inserts under the write lock
+  ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+  auto segment = segments_.find(channel_id);
+  if (segment == segments_.end()) {
+    return;
+  }
+  // check block index
+  if (previous_indexes->count(channel_id) == 0) {
+    (*previous_indexes)[channel_id] = UINT32_MAX;
+  }
+  uint32_t& previous_index = (*previous_indexes)[channel_id];
+  if (block_index != 0 && previous_index != UINT32_MAX) {
+    if (block_index == previous_index) {
+      ADEBUG << "Receive SAME index " << block_index << " of channel "
+             << channel_id;
+    } else if (block_index < previous_index) {
+      ADEBUG << "Receive PREVIOUS message. last: " << previous_index
+             << ", now: " << block_index;
+    } else if (block_index - previous_index > 1) {
+      ADEBUG << "Receive JUMP message. last: " << previous_index
+             << ", now: " << block_index;
+    }
+  }
+  previous_index = block_index;
+
+  ReadMessage(segment->second, channel_id, block_index);
+}
+
 void ShmDispatcher::ThreadFunc() {
   ReadableInfo readable_info;
   while (!is_shutdown_.load()) {
@@ -112,34 +174,30 @@ void ShmDispatcher::ThreadFunc() {
       continue;
     }
 
-    uint64_t channel_id = readable_info.channel_id();
-    uint32_t block_index = readable_info.block_index();
+    if (shards_ == nullptr) {
+      HandleReadableInfo(readable_info, &previous_indexes_);
+      continue;
+    }
 
+    // infos of every channel on the host come through here, keep the ones
+    // nobody in this process reads out of the shard queues
     {
       ReadLockGuard<AtomicRWLock> lock(segments_lock_);
-      if (segments_.count(channel_id) == 0) {
+      if (segments_.count(readable_info.channel_id()) == 0) {
         continue;
       }
-      // check block index
-      if (previous_indexes_.count(channel_id) == 0) {
-        previous_indexes_[channel_id] = UINT32_MAX;
-      }
-      uint32_t& previous_index = previous_indexes_[channel_id];
-      if (block_index != 0 && previous_index != UINT32_MAX) {
-        if (block_index == previous_index) {
-          ADEBUG << "Receive SAME index " << block_index << " of channel "
-                 << channel_id;
-        } else if (block_index < previous_index) {
-          ADEBUG << "Receive PREVIOUS message. last: " << previous_index
-                 << ", now: " << block_index;
-        } else if (block_index - previous_index > 1) {
-          ADEBUG << "Receive JUMP message. last: " << previous_index
-                 << ", now: " << block_index;
-        }
-      }
-      previous_index = block_index;
+    }
+    shards_->Push(readable_info);
+  }
+}
 
-      ReadMessage(channel_id, block_index);
+void ShmDispatcher::ShardThreadFunc(uint32_t shard) {
+  // the channels of a shard are only seen by its thread
+  IndexContainer previous_indexes;
+  ReadableInfo readable_info;
+  while (!is_shutdown_.load()) {
+    if (shards_->Pop(shard, 100, &readable_info)) {
+      HandleReadableInfo(readable_info, &previous_indexes);
     }
   }
 }
@@ -147,6 +205,20 @@ void ShmDispatcher::ThreadFunc() {
 bool ShmDispatcher::Init() {
   host_id_ = common::Hash(GlobalData::Instance()->HostIp());
   notifier_ = NotifierFactory::CreateNotifier();
+
+  auto& g_conf = GlobalData::Instance()->Config();
+  std::unique_ptr<ShmDispatchShards> shards(
+      new ShmDispatchShards(g_conf.transport_conf().shm_conf()));
+  // a single shard is served by the notifier thread itself
+  if (shards->shard_num() > 1) {
+    shards_ = std::move(shards);
+    for (uint32_t i = 0; i < shards_->shard_num(); ++i) {
+      shard_threads_.emplace_back(&ShmDispatcher::ShardThreadFunc, this, i);
+      scheduler::Instance()->SetInnerThreadAttr(
+          "shm_disp_" + std::to_string(i), &shard_threads_.back());
+    }
+  }
+
   thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
   scheduler::Instance()->SetInnerThreadAttr("shm_disp", &thread_);
   return true;
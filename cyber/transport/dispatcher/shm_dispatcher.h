@@ -19,17 +19,23 @@
 
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
+#include "cyber/transport/dispatcher/shm_dispatch_shards.h"
+#include "cyber/transport/message/loaned_message.h"
 #include "cyber/transport/shm/notifier_factory.h"
+#include "cyber/transport/shm/readable_info.h"
 #include "cyber/transport/shm/segment_factory.h"
 
 namespace apollo {
@@ -42,10 +48,18 @@ using apollo::cyber::base::AtomicRWLock;
 using apollo::cyber::base::ReadLockGuard;
 using apollo::cyber::base::WriteLockGuard;
 
+/**
+ * @brief Reads shared memory blocks and runs the listeners of their channels.
+ * With transport_conf.shm_conf.dispatch_shard_num > 1 the notifier thread
+ * only routes readable infos, and each channel is served by one of the shard
+ * threads, so that a slow channel does not hold up the others.
+ */
 class ShmDispatcher : public Dispatcher {
  public:
   // key: channel_id
   using SegmentContainer = std::unordered_map<uint64_t, SegmentPtr>;
+  // key: channel_id
+  using IndexContainer = std::unordered_map<uint64_t, uint32_t>;
 
   virtual ~ShmDispatcher();
 
@@ -60,20 +74,36 @@ class ShmDispatcher : public Dispatcher {
                    const RoleAttributes& opposite_attr,
                    const MessageListener<MessageT>& listener);
 
+  /**
+   * @brief Hands the listener a read-only view of each message in place of a
+   * parsed copy. The view points into the shared memory block, which is
+   * pinned only until the listener returns; remove it with
+   * RemoveListener<ReadableBlock>.
+   */
+  void AddViewListener(const RoleAttributes& self_attr,
+                       const MessageViewListener& listener);
+
  private:
   void AddSegment(const RoleAttributes& self_attr);
-  void ReadMessage(uint64_t channel_id, uint32_t block_index);
+  void ReadMessage(const SegmentPtr& segment, uint64_t channel_id,
+                   uint32_t block_index);
   void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
                  const MessageInfo& msg_info);
+  void HandleReadableInfo(const ReadableInfo& readable_info,
+                          IndexContainer* previous_indexes);
   void ThreadFunc();
+  void ShardThreadFunc(uint32_t shard);
   bool Init();
 
   uint64_t host_id_;
   SegmentContainer segments_;
-  std::unordered_map<uint64_t, uint32_t> previous_indexes_;
+  IndexContainer previous_indexes_;
   AtomicRWLock segments_lock_;
   std::thread thread_;
   NotifierPtr notifier_;
+  // null with a single shard, which the notifier thread serves itself
+  std::unique_ptr<ShmDispatchShards> shards_;
+  std::vector<std::thread> shard_threads_;
 
   DECLARE_SINGLETON(ShmDispatcher)
 };
@@ -82,9 +112,12 @@ template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = pool->Acquire();
     RETURN_IF(!message::ParseFromArray(
         rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
     listener(msg, msg_info);
@@ -99,9 +132,12 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const RoleAttributes& opposite_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = pool->Acquire();
     RETURN_IF(!message::ParseFromArray(
         rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
     listener(msg, msg_info);
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/dispatcher/udp_dispatcher.h"
+
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "cyber/event/latency_tracer.h"
+#include "cyber/transport/udp/udp_socket.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using event::LatencyTracer;
+
+namespace {
+
+// datagrams taken from the socket per recvmmsg call
+constexpr uint32_t kDatagramBatch = 32;
+
+}  // namespace
+
+UdpDispatcher::UdpDispatcher() {}
+
+UdpDispatcher::~UdpDispatcher() { Shutdown(); }
+
+void UdpDispatcher::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+void UdpDispatcher::Start() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  if (started_ || is_shutdown_.load()) {
+    return;
+  }
+
+  // a failure is retried by the next listener added
+  auto& conf = GetUdpConf();
+  fd_ = OpenReceiveSocket(conf);
+  if (fd_ == -1) {
+    AERROR << "udp dispatcher init failed, retried by the next reader.";
+    return;
+  }
+  reassembler_.reset(
+      new Reassembler(conf.max_pending_messages(), conf.max_message_size()));
+  thread_ = std::thread(&UdpDispatcher::ThreadFunc, this);
+  started_ = true;
+}
+
+void UdpDispatcher::ThreadFunc() {
+  // sized for the largest datagram, senders may use larger frames than ours
+  std::vector<char> buffers(static_cast<size_t>(kDatagramBatch) *
+                            kMaxDatagramSize);
+  struct iovec iovs[kDatagramBatch];
+  struct mmsghdr msgs[kDatagramBatch];
+  memset(msgs, 0, sizeof(msgs));
+  for (uint32_t i = 0; i < kDatagramBatch; ++i) {
+    iovs[i].iov_base = buffers.data() + static_cast<size_t>(i) *
+                                            kMaxDatagramSize;
+    iovs[i].iov_len = kMaxDatagramSize;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  struct pollfd fds;
+  fds.fd = fd_;
+  fds.events = POLLIN;
+  while (!is_shutdown_.load()) {
+    int ready_num = poll(&fds, 1, 100);
+    if (ready_num < 0 && errno != EINTR) {
+      AERROR << "fail to poll, " << strerror(errno);
+      break;
+    }
+    if (ready_num <= 0) {
+      continue;
+    }
+
+    // drain the socket before polling again
+    while (!is_shutdown_.load()) {
+      int recv_num = recvmmsg(fd_, msgs, kDatagramBatch, MSG_DONTWAIT, nullptr);
+      if (recv_num <= 0) {
+        if (recv_num < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+            errno != EINTR) {
+          AERROR << "fail to recvmmsg, " << strerror(errno);
+        }
+        break;
+      }
+      for (int i = 0; i < recv_num; ++i) {
+        HandleDatagram(static_cast<const char*>(iovs[i].iov_base),
+                       msgs[i].msg_len);
+      }
+    }
+  }
+}
+
+void UdpDispatcher::HandleDatagram(const char* data, std::size_t size) {
+  std::size_t pos = 0;
+  FrameHeader header;
+  while (pos + FrameHeader::kSize <= size) {
+    if (!header.DeserializeFrom(data + pos, size - pos)) {
+      return;
+    }
+    const char* frame = data + pos + FrameHeader::kSize;
+    pos += FrameHeader::kSize + header.length();
+    if (pos > size) {
+      AWARN << "truncated udp frame, dropped.";
+      return;
+    }
+    // frames of channels nobody reads here are skipped without a copy
+    if (!HasChannel(header.channel_id())) {
+      continue;
+    }
+    auto buffer = reassembler_->Feed(header, frame);
+    if (buffer != nullptr) {
+      OnMessage(header, buffer);
+    }
+  }
+}
+
+void UdpDispatcher::OnMessage(const FrameHeader& header,
+                              const ReassemblyBufferPtr& buffer) {
+  MessageInfo msg_info;
+  if (!msg_info.DeserializeFrom(buffer->data() + header.msg_size(),
+                                header.info_size())) {
+    AERROR << "error msg info of channel:"
+           << GlobalData::GetChannelById(header.channel_id());
+    return;
+  }
+  if (msg_info.has_trace()) {
+    msg_info.set_dispatch_time(LatencyTracer::Now());
+  }
+  buffer->set_size(header.msg_size());
+
+  ListenerHandlerBasePtr* handler_base = nullptr;
+  if (msg_listeners_.Get(header.channel_id(), &handler_base)) {
+    auto handler = std::dynamic_pointer_cast<ListenerHandler<ReassemblyBuffer>>(
+        *handler_base);
+    handler->Run(buffer, msg_info);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
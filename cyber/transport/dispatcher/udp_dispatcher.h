@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_DISPATCHER_UDP_DISPATCHER_H_
+#define CYBER_TRANSPORT_DISPATCHER_UDP_DISPATCHER_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/macros.h"
+#include "cyber/message/message_pool.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/dispatcher/dispatcher.h"
+#include "cyber/transport/udp/frame_header.h"
+#include "cyber/transport/udp/reassembler.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class UdpDispatcher;
+using UdpDispatcherPtr = UdpDispatcher*;
+
+/**
+ * @brief Receives the datagrams of the udp multicast group, puts the frames
+ * of the channels with listeners in this process back together and runs the
+ * listeners. The socket and its thread are only set up with the first
+ * listener, processes without udp readers do not join the group.
+ */
+class UdpDispatcher : public Dispatcher {
+ public:
+  virtual ~UdpDispatcher();
+
+  void Shutdown() override;
+
+  template <typename MessageT>
+  void AddListener(const RoleAttributes& self_attr,
+                   const MessageListener<MessageT>& listener);
+
+  template <typename MessageT>
+  void AddListener(const RoleAttributes& self_attr,
+                   const RoleAttributes& opposite_attr,
+                   const MessageListener<MessageT>& listener);
+
+ private:
+  void Start();
+  void ThreadFunc();
+  void HandleDatagram(const char* data, std::size_t size);
+  void OnMessage(const FrameHeader& header, const ReassemblyBufferPtr& buffer);
+
+  int fd_ = -1;
+  std::thread thread_;
+  std::mutex start_mutex_;
+  bool started_ = false;
+  std::unique_ptr<Reassembler> reassembler_;
+
+  DECLARE_SINGLETON(UdpDispatcher)
+};
+
+template <typename MessageT>
+void UdpDispatcher::AddListener(const RoleAttributes& self_attr,
+                                const MessageListener<MessageT>& listener) {
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](const ReassemblyBufferPtr& buffer,
+                                           const MessageInfo& msg_info) {
+    auto msg = pool->Acquire();
+    RETURN_IF(!message::ParseFromArray(
+        buffer->data(), static_cast<int>(buffer->size()), msg.get()));
+    listener(msg, msg_info);
+  };
+
+  Dispatcher::AddListener<ReassemblyBuffer>(self_attr, listener_adapter);
+  Start();
+}
+
+template <typename MessageT>
+void UdpDispatcher::AddListener(const RoleAttributes& self_attr,
+                                const RoleAttributes& opposite_attr,
+                                const MessageListener<MessageT>& listener) {
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](const ReassemblyBufferPtr& buffer,
+                                           const MessageInfo& msg_info) {
+    auto msg = pool->Acquire();
+    RETURN_IF(!message::ParseFromArray(
+        buffer->data(), static_cast<int>(buffer->size()), msg.get()));
+    listener(msg, msg_info);
+  };
+
+  Dispatcher::AddListener<ReassemblyBuffer>(self_attr, opposite_attr,
+                                            listener_adapter);
+  Start();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_DISPATCHER_UDP_DISPATCHER_H_
@@ -25,6 +25,7 @@
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/base/signal.h"
 #include "cyber/common/log.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/transport/message/message_info.h"
@@ -79,6 +80,12 @@ class ListenerHandler : public ListenerHandlerBase {
   void RunFromString(const std::string& str,
                      const MessageInfo& msg_info) override;
 
+  // messages parsed by RunFromString are taken from pool when it is set
+  void set_message_pool(
+      const std::shared_ptr<message::MessagePool<MessageT>>& pool) {
+    message_pool_ = pool;
+  }
+
  private:
   using SignalPtr = std::shared_ptr<MessageSignal>;
   using MessageSignalMap = std::unordered_map<uint64_t, SignalPtr>;
@@ -92,6 +99,7 @@ class ListenerHandler : public ListenerHandlerBase {
   std::unordered_map<uint64_t, ConnectionMap> signals_conns_;
 
   base::AtomicRWLock rw_lock_;
+  std::shared_ptr<message::MessagePool<MessageT>> message_pool_;
 };
 
 template <>
@@ -174,7 +182,8 @@ void ListenerHandler<MessageT>::Run(const Message& msg,
 template <typename MessageT>
 void ListenerHandler<MessageT>::RunFromString(const std::string& str,
                                               const MessageInfo& msg_info) {
-  auto msg = std::make_shared<MessageT>();
+  auto msg = message_pool_ != nullptr ? message_pool_->Acquire()
+                                      : std::make_shared<MessageT>();
   if (message::ParseFromHC(str.data(), static_cast<int>(str.size()),
                            msg.get())) {
     Run(msg, msg_info);
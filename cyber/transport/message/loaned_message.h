@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_MESSAGE_LOANED_MESSAGE_H_
+#define CYBER_TRANSPORT_MESSAGE_LOANED_MESSAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "cyber/transport/message/message_info.h"
+#include "cyber/transport/shm/segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief A buffer lent out by a transmitter, in which the caller builds the
+ * serialized form of a message of type M (for RawMessage, the payload bytes
+ * themselves). When the buffer is a shared memory block the message is
+ * published without any further copy; otherwise it lives on the heap and is
+ * parsed into M when it is published.
+ *
+ * A loan that is destroyed without being published gives its block back.
+ * While a loan is outstanding, the segment it points into is neither resized
+ * nor remapped by its writer: a write of a message larger than the blocks
+ * fails, and so does any write once another writer of the channel resized the
+ * segment. A loan published after such a resize is dropped.
+ */
+template <typename M>
+class LoanedMessage {
+ public:
+  LoanedMessage() = default;
+  ~LoanedMessage() { Reset(); }
+
+  LoanedMessage(const LoanedMessage&) = delete;
+  LoanedMessage& operator=(const LoanedMessage&) = delete;
+
+  LoanedMessage(LoanedMessage&& other) { *this = std::move(other); }
+  LoanedMessage& operator=(LoanedMessage&& other);
+
+  void Lease(const SegmentPtr& segment, const WritableBlock& block,
+             std::size_t capacity);
+  void Allocate(std::size_t capacity);
+
+  // Gives the buffer back without publishing it.
+  void Reset();
+
+  // Detaches the shared memory block, the caller takes over its write lock.
+  WritableBlock ReleaseBlock();
+
+  bool is_valid() const { return data_ != nullptr; }
+  bool is_shared() const { return segment_ != nullptr; }
+  const SegmentPtr& segment() const { return segment_; }
+
+  uint8_t* data() { return data_; }
+  const uint8_t* data() const { return data_; }
+  std::size_t capacity() const { return capacity_; }
+  std::size_t size() const { return size_; }
+
+  bool set_size(std::size_t size) {
+    if (size > capacity_) {
+      return false;
+    }
+    size_ = size;
+    return true;
+  }
+
+ private:
+  SegmentPtr segment_ = nullptr;
+  WritableBlock block_;
+  std::unique_ptr<uint8_t[]> heap_buf_ = nullptr;
+  uint8_t* data_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+};
+
+/**
+ * @brief Read-only view of a message still held in its shared memory block.
+ * It is only valid until the listener it was handed to returns.
+ */
+struct MessageView {
+  const uint8_t* data = nullptr;
+  std::size_t size = 0;
+};
+
+using MessageViewListener =
+    std::function<void(const MessageView&, const MessageInfo&)>;
+
+template <typename M>
+LoanedMessage<M>& LoanedMessage<M>::operator=(LoanedMessage&& other) {
+  if (this != &other) {
+    Reset();
+    segment_ = std::move(other.segment_);
+    block_ = other.block_;
+    heap_buf_ = std::move(other.heap_buf_);
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+
+    other.segment_ = nullptr;
+    other.block_ = WritableBlock();
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+template <typename M>
+void LoanedMessage<M>::Lease(const SegmentPtr& segment,
+                             const WritableBlock& block,
+                             std::size_t capacity) {
+  Reset();
+  segment_ = segment;
+  block_ = block;
+  data_ = block.buf;
+  capacity_ = capacity;
+}
+
+template <typename M>
+void LoanedMessage<M>::Allocate(std::size_t capacity) {
+  Reset();
+  heap_buf_.reset(new uint8_t[capacity > 0 ? capacity : 1]);
+  data_ = heap_buf_.get();
+  capacity_ = capacity;
+}
+
+template <typename M>
+void LoanedMessage<M>::Reset() {
+  if (segment_ != nullptr) {
+    segment_->ReleaseWrittenBlock(block_, false);
+  }
+  segment_ = nullptr;
+  block_ = WritableBlock();
+  heap_buf_ = nullptr;
+  data_ = nullptr;
+  capacity_ = 0;
+  size_ = 0;
+}
+
+template <typename M>
+WritableBlock LoanedMessage<M>::ReleaseBlock() {
+  WritableBlock block = block_;
+  segment_ = nullptr;
+  block_ = WritableBlock();
+  data_ = nullptr;
+  capacity_ = 0;
+  size_ = 0;
+  return block;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_LOANED_MESSAGE_H_
@@ -25,6 +25,7 @@ namespace cyber {
 namespace transport {
 
 const std::size_t MessageInfo::kSize = 2 * ID_SIZE + sizeof(uint64_t);
+const std::size_t MessageInfo::kTraceSize = 2 * sizeof(uint64_t);
 
 MessageInfo::MessageInfo() : sender_id_(false), spare_id_(false) {}
 
@@ -39,7 +40,10 @@ MessageInfo::MessageInfo(const MessageInfo& another)
     : sender_id_(another.sender_id_),
       channel_id_(another.channel_id_),
       seq_num_(another.seq_num_),
-      spare_id_(another.spare_id_) {}
+      spare_id_(another.spare_id_),
+      publish_time_(another.publish_time_),
+      transmit_time_(another.transmit_time_),
+      dispatch_time_(another.dispatch_time_) {}
 
 MessageInfo::~MessageInfo() {}
 
@@ -49,6 +53,9 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
     channel_id_ = another.channel_id_;
     seq_num_ = another.seq_num_;
     spare_id_ = another.spare_id_;
+    publish_time_ = another.publish_time_;
+    transmit_time_ = another.transmit_time_;
+    dispatch_time_ = another.dispatch_time_;
   }
   return *this;
 }
@@ -56,7 +63,10 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
 bool MessageInfo::operator==(const MessageInfo& another) const {
   return sender_id_ == another.sender_id_ &&
          channel_id_ == another.channel_id_ && seq_num_ == another.seq_num_ &&
-         spare_id_ == another.spare_id_;
+         spare_id_ == another.spare_id_ &&
+         publish_time_ == another.publish_time_ &&
+         transmit_time_ == another.transmit_time_ &&
+         dispatch_time_ == another.dispatch_time_;
 }
 
 bool MessageInfo::operator!=(const MessageInfo& another) const {
@@ -70,13 +80,19 @@ bool MessageInfo::SerializeTo(std::string* dst) const {
   dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&seq_num_)),
               sizeof(seq_num_));
   dst->append(spare_id_.data(), ID_SIZE);
+  if (has_trace()) {
+    dst->append(reinterpret_cast<const char*>(&publish_time_),
+                sizeof(publish_time_));
+    dst->append(reinterpret_cast<const char*>(&transmit_time_),
+                sizeof(transmit_time_));
+  }
 
   return true;
 }
 
 bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
   RETURN_VAL_IF_NULL(dst, false);
-  if (len < kSize) {
+  if (len < ByteSize()) {
     return false;
   }
 
@@ -87,6 +103,12 @@ bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
          sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   memcpy(ptr, spare_id_.data(), ID_SIZE);
+  if (has_trace()) {
+    ptr += ID_SIZE;
+    memcpy(ptr, &publish_time_, sizeof(publish_time_));
+    ptr += sizeof(publish_time_);
+    memcpy(ptr, &transmit_time_, sizeof(transmit_time_));
+  }
 
   return true;
 }
@@ -97,7 +119,7 @@ bool MessageInfo::DeserializeFrom(const std::string& src) {
 
 bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   RETURN_VAL_IF_NULL(src, false);
-  if (len != kSize) {
+  if (len != kSize && len != kSize + kTraceSize) {
     AWARN << "src size mismatch, given[" << len << "] target[" << kSize << "]";
     return false;
   }
@@ -108,7 +130,42 @@ bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   memcpy(reinterpret_cast<char*>(&seq_num_), ptr, sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   spare_id_.set_data(ptr);
+  ptr += ID_SIZE;
+  if (len == kSize) {
+    publish_time_ = 0;
+    transmit_time_ = 0;
+    return true;
+  }
+  return DeserializeTraceFrom(ptr, kTraceSize);
+}
+
+std::size_t MessageInfo::ByteSize() const {
+  return has_trace() ? kSize + kTraceSize : kSize;
+}
+
+bool MessageInfo::SerializeTraceTo(std::string* dst) const {
+  RETURN_VAL_IF_NULL(dst, false);
+
+  dst->clear();
+  if (!has_trace()) {
+    return true;
+  }
+  dst->append(reinterpret_cast<const char*>(&publish_time_),
+              sizeof(publish_time_));
+  dst->append(reinterpret_cast<const char*>(&transmit_time_),
+              sizeof(transmit_time_));
+  return true;
+}
+
+bool MessageInfo::DeserializeTraceFrom(const char* src, std::size_t len) {
+  publish_time_ = 0;
+  transmit_time_ = 0;
+  if (src == nullptr || len != kTraceSize) {
+    return false;
+  }
 
+  memcpy(&publish_time_, src, sizeof(publish_time_));
+  memcpy(&transmit_time_, src + sizeof(publish_time_), sizeof(transmit_time_));
   return true;
 }
 
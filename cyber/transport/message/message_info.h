@@ -58,13 +58,42 @@ class MessageInfo {
   const Identity& spare_id() const { return spare_id_; }
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
+  // Trace stamps in nanoseconds since epoch, zero when not taken. The writer
+  // stamps publish and transmit and they travel with the message, dispatch is
+  // stamped on the reading side and not serialized. A traced info is
+  // kTraceSize bytes longer, which readers built before the stamps reject.
+  uint64_t publish_time() const { return publish_time_; }
+  void set_publish_time(uint64_t publish_time) { publish_time_ = publish_time; }
+
+  uint64_t transmit_time() const { return transmit_time_; }
+  void set_transmit_time(uint64_t transmit_time) {
+    transmit_time_ = transmit_time;
+  }
+
+  uint64_t dispatch_time() const { return dispatch_time_; }
+  void set_dispatch_time(uint64_t dispatch_time) {
+    dispatch_time_ = dispatch_time;
+  }
+
+  bool has_trace() const { return publish_time_ != 0; }
+
+  // kSize, plus kTraceSize if the message is traced
+  std::size_t ByteSize() const;
+
+  bool SerializeTraceTo(std::string* dst) const;
+  bool DeserializeTraceFrom(const char* src, std::size_t len);
+
   static const std::size_t kSize;
+  static const std::size_t kTraceSize;
 
  private:
   Identity sender_id_;
   uint64_t channel_id_ = 0;
   uint64_t seq_num_ = 0;
   Identity spare_id_;
+  uint64_t publish_time_ = 0;
+  uint64_t transmit_time_ = 0;
+  uint64_t dispatch_time_ = 0;
 };
 
 }  // namespace transport
@@ -70,6 +70,53 @@ TEST(MessageInfoTest, test) {
   EXPECT_EQ(msgInfo3, msgInfo4);
 }
 
+TEST(MessageInfoTest, trace) {
+  Identity id;
+  MessageInfo msgInfo(id, 123);
+  EXPECT_FALSE(msgInfo.has_trace());
+  EXPECT_EQ(msgInfo.ByteSize(), MessageInfo::kSize);
+
+  msgInfo.set_publish_time(1000);
+  msgInfo.set_transmit_time(2000);
+  msgInfo.set_dispatch_time(3000);
+  EXPECT_TRUE(msgInfo.has_trace());
+  EXPECT_EQ(msgInfo.ByteSize(), MessageInfo::kSize + MessageInfo::kTraceSize);
+
+  std::string msgStr;
+  EXPECT_TRUE(msgInfo.SerializeTo(&msgStr));
+  EXPECT_EQ(msgStr.size(), msgInfo.ByteSize());
+  std::string msgStr2(msgInfo.ByteSize(), '\0');
+  EXPECT_FALSE(msgInfo.SerializeTo(const_cast<char*>(msgStr2.data()),
+                                   MessageInfo::kSize));
+  EXPECT_TRUE(
+      msgInfo.SerializeTo(const_cast<char*>(msgStr2.data()), msgStr2.size()));
+  EXPECT_EQ(msgStr, msgStr2);
+
+  // the dispatch time stays on the reading side
+  MessageInfo msgInfo2;
+  EXPECT_TRUE(msgInfo2.DeserializeFrom(msgStr));
+  EXPECT_EQ(msgInfo2.seq_num(), 123);
+  EXPECT_EQ(msgInfo2.publish_time(), 1000);
+  EXPECT_EQ(msgInfo2.transmit_time(), 2000);
+  EXPECT_EQ(msgInfo2.dispatch_time(), 0);
+
+  // an untraced message clears the stamps of the previous one
+  MessageInfo untraced(id, 124);
+  EXPECT_TRUE(untraced.SerializeTo(&msgStr));
+  EXPECT_TRUE(msgInfo2.DeserializeFrom(msgStr));
+  EXPECT_FALSE(msgInfo2.has_trace());
+  EXPECT_EQ(msgInfo2.transmit_time(), 0);
+
+  std::string traceStr;
+  EXPECT_TRUE(msgInfo.SerializeTraceTo(&traceStr));
+  EXPECT_EQ(traceStr.size(), MessageInfo::kTraceSize);
+  EXPECT_TRUE(msgInfo2.DeserializeTraceFrom(traceStr.data(), traceStr.size()));
+  EXPECT_EQ(msgInfo2.publish_time(), 1000);
+  EXPECT_EQ(msgInfo2.transmit_time(), 2000);
+  EXPECT_FALSE(msgInfo2.DeserializeTraceFrom(traceStr.data(), 0));
+  EXPECT_FALSE(msgInfo2.has_trace());
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
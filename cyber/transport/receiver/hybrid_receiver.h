@@ -35,7 +35,9 @@
 #include "cyber/transport/receiver/intra_receiver.h"
 #include "cyber/transport/receiver/rtps_receiver.h"
 #include "cyber/transport/receiver/shm_receiver.h"
+#include "cyber/transport/receiver/udp_receiver.h"
 #include "cyber/transport/rtps/participant.h"
+#include "cyber/transport/udp/udp_socket.h"
 
 namespace apollo {
 namespace cyber {
@@ -173,10 +175,12 @@ void HybridReceiver<M>::ObtainConfig() {
   if (!global_conf.has_transport_conf()) {
     return;
   }
-  if (!global_conf.transport_conf().has_communication_mode()) {
-    return;
+  if (global_conf.transport_conf().has_communication_mode()) {
+    mode_->CopyFrom(global_conf.transport_conf().communication_mode());
+  }
+  if (IsUdpChannel(this->attr_.channel_name())) {
+    mode_->set_diff_host(OptionalMode::UDP);
   }
-  mode_->CopyFrom(global_conf.transport_conf().communication_mode());
 
   mapping_table_[SAME_PROC] = mode_->same_proc();
   mapping_table_[DIFF_PROC] = mode_->diff_proc();
@@ -212,6 +216,10 @@ void HybridReceiver<M>::InitReceivers() {
         receivers_[mode] =
             std::make_shared<ShmReceiver<M>>(this->attr_, listener);
         break;
+      case OptionalMode::UDP:
+        receivers_[mode] =
+            std::make_shared<UdpReceiver<M>>(this->attr_, listener);
+        break;
       default:
         receivers_[mode] =
             std::make_shared<RtpsReceiver<M>>(this->attr_, listener);
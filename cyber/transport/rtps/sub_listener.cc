@@ -18,11 +18,14 @@
 
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
+#include "cyber/event/latency_tracer.h"
 
 namespace apollo {
 namespace cyber {
 namespace transport {
 
+using apollo::cyber::event::LatencyTracer;
+
 SubListener::SubListener(const NewMsgCallback& callback)
     : callback_(callback) {}
 
@@ -57,6 +60,11 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
 
+  // trace stamps of the writer, see RtpsTransmitter::Transmit
+  msg_info_.DeserializeTraceFrom(m.datatype().data(), m.datatype().size());
+  msg_info_.set_dispatch_time(msg_info_.has_trace() ? LatencyTracer::Now()
+                                                    : 0);
+
   // fetch message string
   std::shared_ptr<std::string> msg_str =
       std::make_shared<std::string>(m.data());
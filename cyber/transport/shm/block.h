@@ -50,6 +50,8 @@ class Block {
   void ReleaseReadLock();
 
   volatile std::atomic<int32_t> lock_num_ = {0};
+  // published by a writer and not read by any reader since
+  std::atomic<bool> unread_ = {false};
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
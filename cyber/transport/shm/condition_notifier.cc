@@ -16,8 +16,6 @@
 
 #include "cyber/transport/shm/condition_notifier.h"
 
-#include <sys/ipc.h>
-#include <sys/shm.h>
 #include <thread>
 
 #include "cyber/common/log.h"
@@ -29,10 +27,11 @@ namespace transport {
 
 using common::Hash;
 
-ConditionNotifier::ConditionNotifier() {
-  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/notifier"));
-  ADEBUG << "condition notifier key: " << key_;
-  shm_size_ = sizeof(Indicator);
+ConditionNotifier::ConditionNotifier()
+    : segment_(static_cast<key_t>(
+                   Hash("/apollo/cyber/transport/shm/notifier")),
+               sizeof(Indicator)) {
+  ADEBUG << "condition notifier key: " << segment_.key();
 
   if (!Init()) {
     AERROR << "fail to init condition notifier.";
@@ -105,103 +104,20 @@ bool ConditionNotifier::Listen(int timeout_ms, ReadableInfo* info) {
   return false;
 }
 
-bool ConditionNotifier::Init() { return OpenOrCreate(); }
-
-bool ConditionNotifier::OpenOrCreate() {
-  // create managed_shm_
-  int retry = 0;
-  int shmid = 0;
-  while (retry < 2) {
-    shmid = shmget(key_, shm_size_, 0644 | IPC_CREAT | IPC_EXCL);
-    if (shmid != -1) {
-      break;
-    }
-
-    if (EINVAL == errno) {
-      AINFO << "need larger space, recreate.";
-      Reset();
-      Remove();
-      ++retry;
-    } else if (EEXIST == errno) {
-      ADEBUG << "shm already exist, open only.";
-      return OpenOnly();
-    } else {
-      break;
-    }
-  }
-
-  if (shmid == -1) {
-    AERROR << "create shm failed, error code: " << strerror(errno);
+bool ConditionNotifier::Init() {
+  bool created = false;
+  void* addr = segment_.OpenOrCreate(&created);
+  if (addr == nullptr) {
     return false;
   }
-
-  // attach managed_shm_
-  managed_shm_ = shmat(shmid, nullptr, 0);
-  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
-    AERROR << "attach shm failed.";
-    shmctl(shmid, IPC_RMID, 0);
-    return false;
-  }
-
-  // create indicator_
-  indicator_ = new (managed_shm_) Indicator();
-  if (indicator_ == nullptr) {
-    AERROR << "create indicator failed.";
-    shmdt(managed_shm_);
-    managed_shm_ = nullptr;
-    shmctl(shmid, IPC_RMID, 0);
-    return false;
-  }
-
-  ADEBUG << "open or create true.";
-  return true;
-}
-
-bool ConditionNotifier::OpenOnly() {
-  // get managed_shm_
-  int shmid = shmget(key_, 0, 0644);
-  if (shmid == -1) {
-    AERROR << "get shm failed, error: " << strerror(errno);
-    return false;
-  }
-
-  // attach managed_shm_
-  managed_shm_ = shmat(shmid, nullptr, 0);
-  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
-    AERROR << "attach shm failed, error: " << strerror(errno);
-    return false;
-  }
-
-  // get indicator_
-  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
-  if (indicator_ == nullptr) {
-    AERROR << "get indicator failed.";
-    shmdt(managed_shm_);
-    managed_shm_ = nullptr;
-    return false;
-  }
-
-  ADEBUG << "open true.";
-  return true;
-}
-
-bool ConditionNotifier::Remove() {
-  int shmid = shmget(key_, 0, 0644);
-  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
-    AERROR << "remove shm failed, error code: " << strerror(errno);
-    return false;
-  }
-  ADEBUG << "remove success.";
-
+  indicator_ = created ? new (addr) Indicator()
+                       : reinterpret_cast<Indicator*>(addr);
   return true;
 }
 
 void ConditionNotifier::Reset() {
   indicator_ = nullptr;
-  if (managed_shm_ != nullptr) {
-    shmdt(managed_shm_);
-    managed_shm_ = nullptr;
-  }
+  segment_.Detach();
 }
 
 }  // namespace transport
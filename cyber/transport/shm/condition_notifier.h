@@ -23,6 +23,7 @@
 
 #include "cyber/common/macros.h"
 #include "cyber/transport/shm/notifier_base.h"
+#include "cyber/transport/shm/notifier_segment.h"
 
 namespace apollo {
 namespace cyber {
@@ -48,14 +49,9 @@ class ConditionNotifier : public NotifierBase {
 
  private:
   bool Init();
-  bool OpenOrCreate();
-  bool OpenOnly();
-  bool Remove();
   void Reset();
 
-  key_t key_ = 0;
-  void* managed_shm_ = nullptr;
-  size_t shm_size_ = 0;
+  NotifierSegment segment_;
   Indicator* indicator_ = nullptr;
   uint64_t next_seq_ = 0;
   std::atomic<bool> is_shutdown_ = {false};
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+namespace {
+
+// The word is shared between processes, so FUTEX_PRIVATE_FLAG must not be
+// used.
+int FutexWait(std::atomic<int32_t>* word, int32_t expected,
+              const struct timespec* timeout) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<int32_t*>(word),
+                                  FUTEX_WAIT, expected, timeout, nullptr, 0));
+}
+
+int FutexWake(std::atomic<int32_t>* word) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<int32_t*>(word),
+                                  FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0));
+}
+
+}  // namespace
+
+FutexNotifier::FutexNotifier()
+    : segment_(static_cast<key_t>(
+                   Hash("/apollo/cyber/transport/shm/futex_notifier")),
+               sizeof(Indicator)) {
+  ADEBUG << "futex notifier key: " << segment_.key();
+
+  if (!Init()) {
+    AERROR << "fail to init futex notifier.";
+    is_shutdown_.store(true);
+    return;
+  }
+  next_seq_ = indicator_->next_seq.load();
+  ADEBUG << "next_seq: " << next_seq_;
+}
+
+FutexNotifier::~FutexNotifier() { Shutdown(); }
+
+void FutexNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  // kick our own listeners out of the futex wait
+  Wake();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Reset();
+}
+
+bool FutexNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  uint64_t seq = indicator_->next_seq.fetch_add(1);
+  uint64_t idx = seq % kBufLength;
+  indicator_->infos[idx] = info;
+  indicator_->seqs[idx] = seq;
+
+  indicator_->futex_word.fetch_add(1);
+  if (indicator_->waiters.load() > 0) {
+    Wake();
+  }
+  return true;
+}
+
+bool FutexNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // sample the word before checking the ring, so that a notify in between
+    // makes the wait below return at once
+    int32_t word = indicator_->futex_word.load();
+    if (TryRead(info)) {
+      return true;
+    }
+
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining <= std::chrono::nanoseconds(0)) {
+      return false;
+    }
+    auto remaining_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)
+            .count();
+    struct timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(remaining_ns / 1000000000);
+    timeout.tv_nsec = static_cast<long>(remaining_ns % 1000000000);  // NOLINT
+
+    indicator_->waiters.fetch_add(1);
+    if (FutexWait(&indicator_->futex_word, word, &timeout) == -1 &&
+        errno != EAGAIN && errno != ETIMEDOUT && errno != EINTR) {
+      AERROR << "futex wait failed, error: " << strerror(errno);
+    }
+    indicator_->waiters.fetch_sub(1);
+  }
+  return false;
+}
+
+bool FutexNotifier::TryRead(ReadableInfo* info) {
+  uint64_t seq = indicator_->next_seq.load();
+  if (seq == next_seq_) {
+    return false;
+  }
+
+  auto idx = next_seq_ % kBufLength;
+  auto actual_seq = indicator_->seqs[idx];
+  if (actual_seq < next_seq_) {
+    ADEBUG << "seq[" << next_seq_ << "] is writing, can not read now.";
+    return false;
+  }
+  next_seq_ = actual_seq;
+  *info = indicator_->infos[idx];
+  ++next_seq_;
+  return true;
+}
+
+void FutexNotifier::Wake() {
+  if (indicator_ == nullptr) {
+    return;
+  }
+  if (FutexWake(&indicator_->futex_word) == -1) {
+    AERROR << "futex wake failed, error: " << strerror(errno);
+  }
+}
+
+bool FutexNotifier::Init() {
+  bool created = false;
+  void* addr = segment_.OpenOrCreate(&created);
+  if (addr == nullptr) {
+    return false;
+  }
+  indicator_ = created ? new (addr) Indicator()
+                       : reinterpret_cast<Indicator*>(addr);
+  return true;
+}
+
+void FutexNotifier::Reset() {
+  indicator_ = nullptr;
+  segment_.Detach();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
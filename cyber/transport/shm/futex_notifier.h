@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+#define CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <atomic>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/shm/notifier_base.h"
+#include "cyber/transport/shm/notifier_segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Same ReadableInfo ring as ConditionNotifier, but idle listeners
+ * block on a futex word in the shared segment instead of polling it, and
+ * writers wake them up only when someone is actually waiting.
+ *
+ * All processes on a host must agree on the notifier type, as the futex
+ * notifier lives in its own segment.
+ */
+class FutexNotifier : public NotifierBase {
+  struct Indicator {
+    std::atomic<uint64_t> next_seq = {0};
+    // bumped after every notify, listeners sleep on it
+    std::atomic<int32_t> futex_word = {0};
+    std::atomic<int32_t> waiters = {0};
+    ReadableInfo infos[kBufLength];
+    uint64_t seqs[kBufLength] = {0};
+  };
+
+ public:
+  virtual ~FutexNotifier();
+
+  void Shutdown() override;
+  bool Notify(const ReadableInfo& info) override;
+  bool Listen(int timeout_ms, ReadableInfo* info) override;
+
+  static const char* Type() { return "futex"; }
+
+ private:
+  bool Init();
+  void Reset();
+  bool TryRead(ReadableInfo* info);
+  void Wake();
+
+  NotifierSegment segment_;
+  Indicator* indicator_ = nullptr;
+  uint64_t next_seq_ = 0;
+  std::atomic<bool> is_shutdown_ = {false};
+
+  DECLARE_SINGLETON(FutexNotifier)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
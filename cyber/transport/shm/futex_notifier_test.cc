@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <gtest/gtest.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+
+#include "cyber/transport/shm/condition_notifier.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+uint64_t ThreadCpuNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// CPU time a listener burns waiting 500ms with nothing to read.
+double IdleCpuMs(NotifierBase* notifier) {
+  ReadableInfo info;
+  while (notifier->Listen(10, &info)) {
+  }
+
+  double idle_cpu_ms = 0.0;
+  std::thread idle([notifier, &idle_cpu_ms]() {
+    ReadableInfo received;
+    uint64_t start = ThreadCpuNs();
+    notifier->Listen(500, &received);
+    idle_cpu_ms = static_cast<double>(ThreadCpuNs() - start) / 1e6;
+  });
+  idle.join();
+  return idle_cpu_ms;
+}
+
+}  // namespace
+
+TEST(FutexNotifierTest, constructor) {
+  auto notifier = FutexNotifier::Instance();
+  EXPECT_NE(notifier, nullptr);
+}
+
+TEST(FutexNotifierTest, notify_listen) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo readable_info;
+  while (notifier->Listen(100, &readable_info)) {
+  }
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Notify(readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+TEST(FutexNotifierTest, wake_blocked_listener) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo readable_info;
+  while (notifier->Listen(10, &readable_info)) {
+  }
+
+  bool received = false;
+  std::thread listener([notifier, &received]() {
+    ReadableInfo info;
+    received = notifier->Listen(1000, &info);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto begin = std::chrono::steady_clock::now();
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(1, 2, 3)));
+  listener.join();
+  EXPECT_TRUE(received);
+  EXPECT_LT(std::chrono::steady_clock::now() - begin,
+            std::chrono::milliseconds(500));
+}
+
+TEST(FutexNotifierTest, idle_listener_sleeps) {
+  auto condition = IdleCpuMs(ConditionNotifier::Instance());
+  auto futex = IdleCpuMs(FutexNotifier::Instance());
+
+  // an idle futex listener sleeps in the kernel instead of polling
+  EXPECT_LT(futex, condition);
+}
+
+TEST(FutexNotifierTest, shutdown) {
+  auto notifier = FutexNotifier::Instance();
+  notifier->Shutdown();
+  ReadableInfo readable_info;
+  EXPECT_FALSE(notifier->Notify(readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
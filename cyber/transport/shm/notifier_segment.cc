@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/notifier_segment.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+void* NotifierSegment::OpenOrCreate(bool* created) {
+  *created = false;
+  // create the segment
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, size_, 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Detach();
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return nullptr;
+  }
+
+  // attach the segment
+  addr_ = shmat(shmid, nullptr, 0);
+  if (addr_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    addr_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return nullptr;
+  }
+
+  ADEBUG << "open or create true.";
+  *created = true;
+  return addr_;
+}
+
+void* NotifierSegment::OpenOnly() {
+  // get the segment
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed, error: " << strerror(errno);
+    return nullptr;
+  }
+
+  // attach the segment
+  addr_ = shmat(shmid, nullptr, 0);
+  if (addr_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    addr_ = nullptr;
+    return nullptr;
+  }
+
+  ADEBUG << "open true.";
+  return addr_;
+}
+
+bool NotifierSegment::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  ADEBUG << "remove success.";
+
+  return true;
+}
+
+void NotifierSegment::Detach() {
+  if (addr_ != nullptr) {
+    shmdt(addr_);
+    addr_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
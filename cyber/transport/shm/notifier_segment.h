@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_NOTIFIER_SEGMENT_H_
+#define CYBER_TRANSPORT_SHM_NOTIFIER_SEGMENT_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief The XSI shared memory segment a notifier keeps its indicator in.
+ * It only creates, attaches and detaches the raw memory, constructing the
+ * indicator is left to the notifier.
+ */
+class NotifierSegment {
+ public:
+  NotifierSegment(key_t key, size_t size) : key_(key), size_(size) {}
+  ~NotifierSegment() { Detach(); }
+
+  /**
+   * @brief Attach the segment, creating it when it is missing and
+   * recreating it when it is smaller than size.
+   *
+   * @param created set when the segment was created by this call, so the
+   * caller has to construct its contents in place
+   * @return the attached address, nullptr on failure
+   */
+  void* OpenOrCreate(bool* created);
+  void Detach();
+
+  key_t key() const { return key_; }
+
+ private:
+  void* OpenOnly();
+  bool Remove();
+
+  key_t key_ = 0;
+  size_t size_ = 0;
+  void* addr_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(NotifierSegment)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_NOTIFIER_SEGMENT_H_
@@ -43,14 +43,18 @@ bool PosixSegment::OpenOrCreate() {
 
   // create managed_shm_
   int fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
-  if (fd < 0) {
-    if (EEXIST == errno) {
-      ADEBUG << "shm already exist, open only.";
-      return OpenOnly();
-    } else {
-      AERROR << "create shm failed, error: " << strerror(errno);
-      return false;
+  if (fd < 0 && EEXIST == errno) {
+    ADEBUG << "shm already exist, open only.";
+    if (OpenOnly() || !stale_) {
+      return init_;
     }
+    AWARN << "recreate shm " << shm_name_ << " left by another build.";
+    Remove();
+    fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  }
+  if (fd < 0) {
+    AERROR << "create shm failed, error: " << strerror(errno);
+    return false;
   }
 
   if (ftruncate(fd, conf_.managed_shm_size()) < 0) {
@@ -72,7 +76,8 @@ bool PosixSegment::OpenOrCreate() {
   close(fd);
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_)
+      State(conf_.ceiling_msg_size(), conf_.block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
     munmap(managed_shm_, conf_.managed_shm_size());
@@ -81,7 +86,7 @@ bool PosixSegment::OpenOrCreate() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
@@ -136,6 +141,7 @@ bool PosixSegment::OpenOnly() {
   if (init_) {
     return true;
   }
+  stale_ = false;
 
   // get managed_shm_
   int fd = shm_open(shm_name_.c_str(), O_RDWR, 0644);
@@ -163,15 +169,14 @@ bool PosixSegment::OpenOnly() {
   close(fd);
   // get field state_
   state_ = reinterpret_cast<State*>(managed_shm_);
-  if (state_ == nullptr) {
+  if (state_ == nullptr || !AdoptState(file_attr.st_size)) {
     AERROR << "get state failed.";
+    state_ = nullptr;
     munmap(managed_shm_, file_attr.st_size);
     managed_shm_ = nullptr;
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
-
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
                                      sizeof(State));
@@ -16,6 +16,8 @@
 
 #include "cyber/transport/shm/segment.h"
 
+#include <memory>
+
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -32,7 +34,28 @@ Segment::Segment(uint64_t channel_id)
       blocks_(nullptr),
       managed_shm_(nullptr),
       block_buf_lock_(),
-      block_buf_addrs_() {}
+      block_buf_addrs_(),
+      policy_(ShmSizingPolicy::ForChannel(channel_id)),
+      stats_(MutableStats(channel_id)) {
+  conf_.Update(policy_.initial_ceiling_msg_size(), policy_.block_num());
+}
+
+const SegmentStats& Segment::Stats(uint64_t channel_id) {
+  return *MutableStats(channel_id);
+}
+
+SegmentStats* Segment::MutableStats(uint64_t channel_id) {
+  static std::mutex mutex;
+  // never freed, the stats outlive the segments
+  static auto* stats =
+      new std::unordered_map<uint64_t, std::unique_ptr<SegmentStats>>();
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& channel_stats = (*stats)[channel_id];
+  if (channel_stats == nullptr) {
+    channel_stats.reset(new SegmentStats());
+  }
+  return channel_stats.get();
+}
 
 bool Segment::AcquireBlockToWrite(std::size_t msg_size,
                                   WritableBlock* writable_block) {
@@ -42,16 +65,36 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
+  // the blocks lent out point into the current mapping
+  const bool writing = writing_block_num_.load() > 0;
   bool result = true;
   if (state_->need_remap()) {
+    if (writing) {
+      AERROR << "segment resized by another writer while "
+             << writing_block_num_.load() << " blocks are lent out.";
+      return false;
+    }
     result = Remap();
   }
 
-  if (msg_size > conf_.ceiling_msg_size()) {
-    AINFO << "msg_size: " << msg_size
-          << " larger than current shm_buffer_size: "
-          << conf_.ceiling_msg_size() << " , need recreate.";
-    result = Recreate(msg_size);
+  uint64_t ceiling_msg_size = 0;
+  uint32_t block_num = 0;
+  if (policy_.Observe(msg_size, conf_.ceiling_msg_size(), &ceiling_msg_size,
+                      &block_num)) {
+    if (!writing) {
+      AINFO << "msg_size: " << msg_size
+            << " current shm_buffer_size: " << conf_.ceiling_msg_size()
+            << " , need recreate with " << ceiling_msg_size << ", recreated "
+            << stats_->recreate_count.load() << " times, remapped "
+            << stats_->remap_count.load() << " times.";
+      result = Recreate(ceiling_msg_size, block_num);
+    } else if (msg_size > conf_.ceiling_msg_size()) {
+      AERROR << "msg_size: " << msg_size
+             << " does not fit shm_buffer_size: " << conf_.ceiling_msg_size()
+             << ", which can not grow while " << writing_block_num_.load()
+             << " blocks are lent out.";
+      return false;
+    }
   }
 
   if (!result) {
@@ -60,18 +103,23 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
   }
 
   uint32_t index = GetNextWritableBlockIndex();
+  writing_block_num_.fetch_add(1);
   writable_block->index = index;
   writable_block->block = &blocks_[index];
   writable_block->buf = block_buf_addrs_[index];
   return true;
 }
 
-void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
+bool Segment::ReleaseWrittenBlock(const WritableBlock& writable_block,
+                                  bool published) {
   auto index = writable_block.index;
   if (index >= conf_.block_num()) {
-    return;
+    return false;
   }
+  blocks_[index].unread_.store(published);
   blocks_[index].ReleaseWriteLock();
+  writing_block_num_.fetch_sub(1);
+  return !state_->need_remap();
 }
 
 bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
@@ -98,8 +146,10 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
   }
 
   if (!blocks_[index].TryLockForRead()) {
+    stats_->drop_count.fetch_add(1);
     return false;
   }
+  blocks_[index].unread_.store(false);
   readable_block->block = blocks_ + index;
   readable_block->buf = block_buf_addrs_[index];
   return true;
@@ -119,6 +169,14 @@ bool Segment::Destroy() {
   }
   init_ = false;
 
+  if (stats_->drop_count.load() > 0 || stats_->overwrite_count.load() > 0) {
+    AINFO << "channel " << channel_id_ << " dropped "
+          << stats_->drop_count.load() << " blocks, overwrote "
+          << stats_->overwrite_count.load() << " unread blocks, recreated "
+          << stats_->recreate_count.load() << " times, remapped "
+          << stats_->remap_count.load() << " times.";
+  }
+
   try {
     state_->DecreaseReferenceCounts();
     uint32_t reference_counts = state_->reference_counts();
@@ -133,7 +191,27 @@ bool Segment::Destroy() {
   return true;
 }
 
+bool Segment::AdoptState(uint64_t mapped_size) {
+  stale_ = true;
+  if (mapped_size < sizeof(State) || !state_->layout_matches()) {
+    AWARN << "shm of channel " << channel_id_
+          << " was laid out by another build.";
+    return false;
+  }
+  ShmConf conf(conf_);
+  conf.Update(state_->ceiling_msg_size(), state_->block_num());
+  if (conf.managed_shm_size() > mapped_size) {
+    AWARN << "shm of channel " << channel_id_ << " has " << mapped_size
+          << " bytes, its state needs " << conf.managed_shm_size() << ".";
+    return false;
+  }
+  conf_ = conf;
+  stale_ = false;
+  return true;
+}
+
 bool Segment::Remap() {
+  stats_->remap_count.fetch_add(1);
   init_ = false;
   ADEBUG << "before reset.";
   Reset();
@@ -141,12 +219,14 @@ bool Segment::Remap() {
   return OpenOnly();
 }
 
-bool Segment::Recreate(const uint64_t& msg_size) {
+bool Segment::Recreate(const uint64_t& ceiling_msg_size,
+                       const uint32_t& block_num) {
+  stats_->recreate_count.fetch_add(1);
   init_ = false;
   state_->set_need_remap(true);
   Reset();
   Remove();
-  conf_.Update(msg_size);
+  conf_.Update(ceiling_msg_size, block_num);
   return OpenOrCreate();
 }
 
@@ -155,6 +235,9 @@ uint32_t Segment::GetNextWritableBlockIndex() {
   while (1) {
     uint32_t try_idx = state_->FetchAddSeq(1) % block_num;
     if (blocks_[try_idx].TryLockForWrite()) {
+      if (blocks_[try_idx].unread_.exchange(false)) {
+        stats_->overwrite_count.fetch_add(1);
+      }
       return try_idx;
     }
   }
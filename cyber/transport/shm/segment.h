@@ -17,6 +17,7 @@
 #ifndef CYBER_TRANSPORT_SHM_SEGMENT_H_
 #define CYBER_TRANSPORT_SHM_SEGMENT_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -24,6 +25,7 @@
 
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/shm_conf.h"
+#include "cyber/transport/shm/shm_sizing_policy.h"
 #include "cyber/transport/shm/state.h"
 
 namespace apollo {
@@ -40,17 +42,50 @@ struct WritableBlock {
 };
 using ReadableBlock = WritableBlock;
 
+/**
+ * @brief What the segments of a channel counted in this process, kept after
+ * they are destroyed so that they can be read while the process runs.
+ */
+struct SegmentStats {
+  // times a writer recreated (resized) the segment, or a writer or reader
+  // remapped it after another one resized it
+  std::atomic<uint64_t> recreate_count = {0};
+  std::atomic<uint64_t> remap_count = {0};
+  // blocks a reader could not read because they were being rewritten
+  std::atomic<uint64_t> drop_count = {0};
+  // blocks a writer reused before any reader read them
+  std::atomic<uint64_t> overwrite_count = {0};
+};
+
 class Segment {
  public:
   explicit Segment(uint64_t channel_id);
   virtual ~Segment() {}
 
+  /**
+   * @brief Write locks a block for a message of msg_size. While a block of
+   * this segment is write locked, the segment is neither resized nor
+   * remapped, so that the block stays valid: a message that does not fit the
+   * current blocks, or a segment resized by another writer, fails.
+   */
   bool AcquireBlockToWrite(std::size_t msg_size, WritableBlock* writable_block);
-  void ReleaseWrittenBlock(const WritableBlock& writable_block);
+
+  /**
+   * @brief Gives a written block back, to be read if published. Returns
+   * false if another writer resized the segment meanwhile, the block is then
+   * not the one readers find at its index and must not be published.
+   */
+  bool ReleaseWrittenBlock(const WritableBlock& writable_block,
+                           bool published = true);
 
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  const SegmentStats& stats() const { return *stats_; }
+
+  // the stats of a channel in this process, zero if it has no segment yet
+  static const SegmentStats& Stats(uint64_t channel_id);
+
  protected:
   virtual bool Destroy();
   virtual void Reset() = 0;
@@ -58,6 +93,13 @@ class Segment {
   virtual bool OpenOnly() = 0;
   virtual bool OpenOrCreate() = 0;
 
+  /**
+   * @brief Takes the sizes of a segment attached by OpenOnly from its state.
+   * @return false, setting stale_, if the segment was laid out by another
+   * build or is smaller than its state says.
+   */
+  bool AdoptState(uint64_t mapped_size);
+
   bool init_;
   ShmConf conf_;
   uint64_t channel_id_;
@@ -67,11 +109,21 @@ class Segment {
   void* managed_shm_;
   std::mutex block_buf_lock_;
   std::unordered_map<uint32_t, uint8_t*> block_buf_addrs_;
+  // the last OpenOnly found a segment it can not use, a writer removes it
+  // and creates a new one
+  bool stale_ = false;
 
  private:
   bool Remap();
-  bool Recreate(const uint64_t& msg_size);
+  bool Recreate(const uint64_t& ceiling_msg_size, const uint32_t& block_num);
   uint32_t GetNextWritableBlockIndex();
+
+  static SegmentStats* MutableStats(uint64_t channel_id);
+
+  ShmSizingPolicy policy_;
+  // blocks write locked by this segment and not released yet
+  std::atomic<uint32_t> writing_block_num_ = {0};
+  SegmentStats* stats_;
 };
 
 }  // namespace transport
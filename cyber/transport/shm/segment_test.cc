@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/segment.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "cyber/transport/shm/posix_segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+const uint64_t kSmallMsgSize = 1024;
+const uint64_t kLargeMsgSize = 200 * 1024;
+}  // namespace
+
+TEST(SegmentTest, count_overwrites_of_unread_blocks) {
+  const uint64_t channel_id = 0x5e6e700000000001;
+  const uint32_t block_num = ShmConf().block_num();
+  PosixSegment writer(channel_id);
+  PosixSegment reader(channel_id);
+  const auto& stats = Segment::Stats(channel_id);
+
+  // every block read before it is written again
+  for (uint32_t i = 0; i < 2 * block_num; ++i) {
+    WritableBlock wb;
+    ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+    ASSERT_TRUE(writer.ReleaseWrittenBlock(wb));
+    ReadableBlock rb;
+    rb.index = wb.index;
+    ASSERT_TRUE(reader.AcquireBlockToRead(&rb));
+    reader.ReleaseReadBlock(rb);
+  }
+  EXPECT_EQ(stats.overwrite_count.load(), 0);
+
+  // blocks given back unpublished are not waiting for a reader
+  for (uint32_t i = 0; i < 2 * block_num; ++i) {
+    WritableBlock wb;
+    ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+    ASSERT_TRUE(writer.ReleaseWrittenBlock(wb, false));
+  }
+  EXPECT_EQ(stats.overwrite_count.load(), 0);
+
+  for (uint32_t i = 0; i < 2 * block_num; ++i) {
+    WritableBlock wb;
+    ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+    ASSERT_TRUE(writer.ReleaseWrittenBlock(wb));
+  }
+  EXPECT_EQ(stats.overwrite_count.load(), block_num);
+  EXPECT_EQ(writer.stats().overwrite_count.load(), block_num);
+}
+
+TEST(SegmentTest, keep_size_while_blocks_are_lent_out) {
+  const uint64_t channel_id = 0x5e6e700000000002;
+  PosixSegment writer(channel_id);
+  const auto& stats = Segment::Stats(channel_id);
+
+  WritableBlock loan;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &loan));
+  WritableBlock wb;
+  EXPECT_FALSE(writer.AcquireBlockToWrite(kLargeMsgSize, &wb));
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(wb));
+  EXPECT_EQ(stats.recreate_count.load(), 0);
+
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(loan));
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kLargeMsgSize, &wb));
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(wb));
+  EXPECT_EQ(stats.recreate_count.load(), 1);
+}
+
+TEST(SegmentTest, drop_blocks_lent_out_across_a_resize) {
+  const uint64_t channel_id = 0x5e6e700000000003;
+  PosixSegment writer(channel_id);
+  PosixSegment other_writer(channel_id);
+  const auto& stats = Segment::Stats(channel_id);
+
+  WritableBlock loan;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &loan));
+  WritableBlock wb;
+  ASSERT_TRUE(other_writer.AcquireBlockToWrite(kLargeMsgSize, &wb));
+  EXPECT_TRUE(other_writer.ReleaseWrittenBlock(wb));
+  EXPECT_EQ(stats.recreate_count.load(), 1);
+
+  // the loan still points into the old segment, which is not remapped
+  EXPECT_FALSE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+  EXPECT_FALSE(writer.ReleaseWrittenBlock(loan));
+
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(wb));
+  EXPECT_EQ(stats.remap_count.load(), 1);
+}
+
+TEST(SegmentTest, recreate_segment_of_another_layout) {
+  const uint64_t channel_id = 0x5e6e700000000004;
+  const std::string shm_name = std::to_string(channel_id);
+  // what a crashed process of a build without the layout magic left behind
+  shm_unlink(shm_name.c_str());
+  int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, sizeof(State)), 0);
+  close(fd);
+
+  ReadableBlock rb;
+  {
+    PosixSegment reader(channel_id);
+    EXPECT_FALSE(reader.AcquireBlockToRead(&rb));
+  }
+
+  PosixSegment writer(channel_id);
+  WritableBlock wb;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(wb));
+  PosixSegment reader(channel_id);
+  rb.index = wb.index;
+  ASSERT_TRUE(reader.AcquireBlockToRead(&rb));
+  reader.ReleaseReadBlock(rb);
+}
+
+TEST(SegmentTest, refuse_segment_smaller_than_its_state) {
+  const uint64_t channel_id = 0x5e6e700000000005;
+  PosixSegment writer(channel_id);
+  WritableBlock wb;
+  ASSERT_TRUE(writer.AcquireBlockToWrite(kSmallMsgSize, &wb));
+  EXPECT_TRUE(writer.ReleaseWrittenBlock(wb));
+
+  int fd = shm_open(std::to_string(channel_id).c_str(), O_RDWR, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, 4096), 0);
+  close(fd);
+
+  PosixSegment reader(channel_id);
+  ReadableBlock rb;
+  rb.index = wb.index;
+  EXPECT_FALSE(reader.AcquireBlockToRead(&rb));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -35,6 +35,17 @@ void ShmConf::Update(const uint64_t& real_msg_size) {
       EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
 }
 
+void ShmConf::Update(const uint64_t& ceiling_msg_size,
+                     const uint32_t& block_num) {
+  ceiling_msg_size_ = ceiling_msg_size;
+  block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
+  block_num_ = block_num > 0
+                   ? block_num
+                   : GetBlockNum(GetCeilingMessageSize(ceiling_msg_size_));
+  managed_shm_size_ =
+      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
+}
+
 const uint64_t ShmConf::EXTRA_SIZE = 1024 * 4;
 const uint64_t ShmConf::STATE_SIZE = 1024;
 const uint64_t ShmConf::BLOCK_SIZE = 1024;
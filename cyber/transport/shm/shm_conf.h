@@ -31,6 +31,8 @@ class ShmConf {
   virtual ~ShmConf();
 
   void Update(const uint64_t& real_msg_size);
+  // block_num 0 takes the count of the tier ceiling_msg_size falls into
+  void Update(const uint64_t& ceiling_msg_size, const uint32_t& block_num);
 
   const uint64_t& ceiling_msg_size() { return ceiling_msg_size_; }
   const uint64_t& block_buf_size() { return block_buf_size_; }
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_sizing_policy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/global_data.h"
+#include "cyber/transport/shm/shm_conf.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+const uint64_t ShmSizingPolicy::kPageSize = 4096;
+
+void MessageSizeHistogram::Add(uint64_t size) {
+  ++buckets_[BucketIndex(size)];
+  ++count_;
+  max_ = std::max(max_, size);
+}
+
+void MessageSizeHistogram::Reset() {
+  buckets_.fill(0);
+  count_ = 0;
+  max_ = 0;
+}
+
+uint64_t MessageSizeHistogram::Quantile(double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_)));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < kBucketNum; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+uint32_t MessageSizeHistogram::BucketIndex(uint64_t size) {
+  if (size < 4) {
+    return static_cast<uint32_t>(size);
+  }
+  uint32_t msb = 63 - __builtin_clzll(size);
+  uint32_t sub = static_cast<uint32_t>((size >> (msb - 2)) & 3);
+  return 4 * (msb - 1) + sub;
+}
+
+uint64_t MessageSizeHistogram::BucketUpperBound(uint32_t index) {
+  if (index < 4) {
+    return index;
+  }
+  uint32_t msb = index / 4 + 1;
+  uint64_t sub = index % 4;
+  uint64_t width = 1ULL << (msb - 2);
+  return ((4 + sub) << (msb - 2)) + width - 1;
+}
+
+ShmSizingPolicy::ShmSizingPolicy()
+    : initial_ceiling_(ShmConf().ceiling_msg_size()) {}
+
+ShmSizingPolicy::ShmSizingPolicy(const proto::ShmChannelPolicy& conf)
+    : adaptive_(conf.adaptive()),
+      block_num_(conf.block_num()),
+      headroom_(std::max(conf.headroom(), 0.0)),
+      window_size_(std::max<uint32_t>(conf.window_size(), 1)),
+      shrink_threshold_(conf.shrink_threshold()) {
+  if (conf.block_size() == 0) {
+    initial_ceiling_ = ShmConf().ceiling_msg_size();
+  } else if (adaptive_) {
+    initial_ceiling_ = WithHeadroom(conf.block_size());
+  } else {
+    initial_ceiling_ = ShmConf(conf.block_size()).ceiling_msg_size();
+  }
+}
+
+ShmSizingPolicy ShmSizingPolicy::ForChannel(uint64_t channel_id) {
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf()) {
+    for (auto& policy : g_conf.transport_conf().shm_conf().channel_policy()) {
+      if (GlobalData::RegisterChannel(policy.channel_name()) == channel_id) {
+        return ShmSizingPolicy(policy);
+      }
+    }
+  }
+  return ShmSizingPolicy();
+}
+
+bool ShmSizingPolicy::Observe(uint64_t msg_size, uint64_t ceiling_msg_size,
+                              uint64_t* new_ceiling_msg_size,
+                              uint32_t* new_block_num) {
+  *new_block_num = block_num_;
+  if (!adaptive_) {
+    if (msg_size <= ceiling_msg_size) {
+      return false;
+    }
+    *new_ceiling_msg_size = ShmConf(msg_size).ceiling_msg_size();
+    return true;
+  }
+
+  histogram_.Add(msg_size);
+  if (msg_size > ceiling_msg_size) {
+    *new_ceiling_msg_size =
+        WithHeadroom(std::max(msg_size, histogram_.Quantile(0.99)));
+    return true;
+  }
+
+  if (histogram_.count() < window_size_) {
+    return false;
+  }
+  uint64_t needed = WithHeadroom(histogram_.max());
+  histogram_.Reset();
+  if (static_cast<double>(needed) >=
+      static_cast<double>(ceiling_msg_size) * shrink_threshold_) {
+    return false;
+  }
+  *new_ceiling_msg_size = needed;
+  return true;
+}
+
+uint64_t ShmSizingPolicy::WithHeadroom(uint64_t size) const {
+  auto padded = static_cast<uint64_t>(
+      std::ceil(static_cast<double>(size) * (1.0 + headroom_)));
+  padded = std::max(padded, kPageSize);
+  return (padded + kPageSize - 1) / kPageSize * kPageSize;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_SHM_SIZING_POLICY_H_
+#define CYBER_TRANSPORT_SHM_SHM_SIZING_POLICY_H_
+
+#include <stdint.h>
+#include <array>
+
+#include "cyber/proto/transport_conf.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Histogram of message sizes with four buckets per power of two, so
+ * that a quantile is known to within 25%.
+ */
+class MessageSizeHistogram {
+ public:
+  void Add(uint64_t size);
+  void Reset();
+
+  // upper bound of the bucket holding the q-quantile, 0 when empty
+  uint64_t Quantile(double q) const;
+
+  uint64_t count() const { return count_; }
+  uint64_t max() const { return max_; }
+
+ private:
+  static uint32_t BucketIndex(uint64_t size);
+  static uint64_t BucketUpperBound(uint32_t index);
+
+  static const uint32_t kBucketNum = 252;
+  std::array<uint64_t, kBucketNum> buckets_ = {};
+  uint64_t count_ = 0;
+  uint64_t max_ = 0;
+};
+
+/**
+ * @brief Decides how large the blocks of a channel's segment are, and how
+ * many of them there are.
+ *
+ * Channels without a ShmChannelPolicy, or with adaptive off, follow the
+ * fixed size tiers of ShmConf and only ever grow. Adaptive channels grow to
+ * the larger of the new message and the p99 of the current window, plus
+ * headroom. With a shrink_threshold, they also shrink at the end of a window
+ * when its largest message would fit in well under the current block size.
+ */
+class ShmSizingPolicy {
+ public:
+  ShmSizingPolicy();
+  explicit ShmSizingPolicy(const proto::ShmChannelPolicy& conf);
+
+  // looks the channel up in transport_conf.shm_conf.channel_policy
+  static ShmSizingPolicy ForChannel(uint64_t channel_id);
+
+  uint64_t initial_ceiling_msg_size() const { return initial_ceiling_; }
+  uint32_t block_num() const { return block_num_; }
+
+  // Records a message about to be written. Returns true if the segment has
+  // to be recreated with the ceiling message size and block number given.
+  bool Observe(uint64_t msg_size, uint64_t ceiling_msg_size,
+               uint64_t* new_ceiling_msg_size, uint32_t* new_block_num);
+
+  static const uint64_t kPageSize;
+
+ private:
+  uint64_t WithHeadroom(uint64_t size) const;
+
+  bool adaptive_ = false;
+  uint32_t block_num_ = 0;
+  uint64_t initial_ceiling_ = 0;
+  double headroom_ = 0.0;
+  uint32_t window_size_ = 0;
+  double shrink_threshold_ = 0.0;
+  MessageSizeHistogram histogram_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_SHM_SIZING_POLICY_H_
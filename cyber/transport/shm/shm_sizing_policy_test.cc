@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_sizing_policy.h"
+
+#include <gtest/gtest.h>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(MessageSizeHistogramTest, quantile) {
+  MessageSizeHistogram histogram;
+  EXPECT_EQ(histogram.Quantile(0.5), 0);
+
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.Add(i * 1000);
+  }
+  EXPECT_EQ(histogram.count(), 100);
+  EXPECT_EQ(histogram.max(), 100000);
+  EXPECT_EQ(histogram.Quantile(1.0), 100000);
+
+  // buckets are at most a quarter of their lower bound wide
+  auto median = histogram.Quantile(0.5);
+  EXPECT_GE(median, 50000);
+  EXPECT_LE(median, 50000 * 5 / 4);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.Quantile(0.99), 0);
+}
+
+TEST(ShmSizingPolicyTest, fixed_tiers) {
+  ShmSizingPolicy policy;
+  EXPECT_EQ(policy.initial_ceiling_msg_size(), 16 * 1024);
+
+  uint64_t ceiling = 0;
+  uint32_t block_num = 0;
+  EXPECT_FALSE(policy.Observe(1024, 16 * 1024, &ceiling, &block_num));
+  EXPECT_TRUE(policy.Observe(200 * 1024, 16 * 1024, &ceiling, &block_num));
+  EXPECT_EQ(ceiling, 1024 * 1024);
+  EXPECT_EQ(block_num, 0);
+
+  // the tiers never shrink
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_FALSE(policy.Observe(1024, 1024 * 1024, &ceiling, &block_num));
+  }
+}
+
+TEST(ShmSizingPolicyTest, adaptive_grow_and_shrink) {
+  proto::ShmChannelPolicy conf;
+  conf.set_channel_name("image");
+  conf.set_block_num(24);
+  conf.set_block_size(100 * 1000);
+  conf.set_headroom(0.25);
+  conf.set_window_size(10);
+  conf.set_shrink_threshold(0.5);
+  ShmSizingPolicy policy(conf);
+  EXPECT_EQ(policy.initial_ceiling_msg_size() % ShmSizingPolicy::kPageSize, 0);
+  EXPECT_GE(policy.initial_ceiling_msg_size(), 125 * 1000);
+  EXPECT_EQ(policy.block_num(), 24);
+
+  uint64_t ceiling = policy.initial_ceiling_msg_size();
+  uint64_t new_ceiling = 0;
+  uint32_t block_num = 0;
+  EXPECT_FALSE(policy.Observe(110 * 1000, ceiling, &new_ceiling, &block_num));
+
+  // grow with headroom, not to the next fixed tier
+  EXPECT_TRUE(policy.Observe(200 * 1000, ceiling, &new_ceiling, &block_num));
+  EXPECT_GE(new_ceiling, 250 * 1000);
+  EXPECT_LT(new_ceiling, 1024 * 1024);
+  EXPECT_EQ(block_num, 24);
+  ceiling = new_ceiling;
+
+  // sizes staying within the hysteresis band keep the segment
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_FALSE(policy.Observe(120 * 1000, ceiling, &new_ceiling, &block_num));
+  }
+
+  // a full window of much smaller messages shrinks it
+  bool shrunk = false;
+  for (int i = 0; i < 20 && !shrunk; ++i) {
+    shrunk = policy.Observe(10 * 1000, ceiling, &new_ceiling, &block_num);
+  }
+  EXPECT_TRUE(shrunk);
+  EXPECT_LT(new_ceiling, ceiling / 2);
+  EXPECT_GE(new_ceiling, 12500);
+}
+
+TEST(ShmSizingPolicyTest, adaptive_shrink_is_opt_in) {
+  proto::ShmChannelPolicy conf;
+  conf.set_channel_name("image");
+  conf.set_block_size(100 * 1000);
+  conf.set_window_size(10);
+  ShmSizingPolicy policy(conf);
+
+  uint64_t ceiling = policy.initial_ceiling_msg_size();
+  uint64_t new_ceiling = 0;
+  uint32_t block_num = 0;
+  EXPECT_TRUE(policy.Observe(400 * 1000, ceiling, &new_ceiling, &block_num));
+  ceiling = new_ceiling;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(policy.Observe(1000, ceiling, &new_ceiling, &block_num));
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -28,7 +28,11 @@ namespace transport {
 
 class State {
  public:
-  explicit State(const uint64_t& ceiling_msg_size);
+  // written by the constructor, a segment holding another value was laid out
+  // by another build and its fields can not be read
+  static constexpr uint32_t kLayoutMagic = 0x53544132;  // "STA2"
+
+  State(const uint64_t& ceiling_msg_size, const uint32_t& block_num);
   virtual ~State();
 
   void DecreaseReferenceCounts() {
@@ -50,13 +54,18 @@ class State {
   bool need_remap() { return need_remap_; }
 
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
+  uint32_t block_num() { return block_num_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
+  bool layout_matches() { return layout_magic_.load() == kLayoutMagic; }
 
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
+  // in the padding older builds left before ceiling_msg_size_
+  std::atomic<uint32_t> layout_magic_ = {kLayoutMagic};
   std::atomic<uint64_t> ceiling_msg_size_;
+  std::atomic<uint32_t> block_num_;
 };
 
 }  // namespace transport
@@ -56,7 +56,12 @@ bool XsiSegment::OpenOrCreate() {
       ++retry;
     } else if (EEXIST == errno) {
       ADEBUG << "shm already exist, open only.";
-      return OpenOnly();
+      if (OpenOnly() || !stale_) {
+        return init_;
+      }
+      AWARN << "recreate shm " << key_ << " left by another build.";
+      Remove();
+      ++retry;
     } else {
       break;
     }
@@ -76,7 +81,8 @@ bool XsiSegment::OpenOrCreate() {
   }
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_)
+      State(conf_.ceiling_msg_size(), conf_.block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
     shmdt(managed_shm_);
@@ -85,7 +91,7 @@ bool XsiSegment::OpenOrCreate() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
@@ -137,6 +143,7 @@ bool XsiSegment::OpenOnly() {
   if (init_) {
     return true;
   }
+  stale_ = false;
 
   // get managed_shm_
   int shmid = shmget(key_, 0, 0644);
@@ -145,6 +152,12 @@ bool XsiSegment::OpenOnly() {
     return false;
   }
 
+  struct shmid_ds shm_attr;
+  if (shmctl(shmid, IPC_STAT, &shm_attr) == -1) {
+    AERROR << "stat shm failed, error: " << strerror(errno);
+    return false;
+  }
+
   // attach managed_shm_
   managed_shm_ = shmat(shmid, nullptr, 0);
   if (managed_shm_ == reinterpret_cast<void*>(-1)) {
@@ -154,15 +167,14 @@ bool XsiSegment::OpenOnly() {
 
   // get field state_
   state_ = reinterpret_cast<State*>(managed_shm_);
-  if (state_ == nullptr) {
+  if (state_ == nullptr || !AdoptState(shm_attr.shm_segsz)) {
     AERROR << "get state failed.";
+    state_ = nullptr;
     shmdt(managed_shm_);
     managed_shm_ = nullptr;
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
-
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
                                      sizeof(State));
@@ -23,6 +23,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/init.h"
+#include "cyber/message/raw_message.h"
 #include "cyber/proto/unit_test.pb.h"
 #include "cyber/transport/receiver/shm_receiver.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
@@ -149,6 +150,56 @@ TEST_F(ShmTransceiverTest, enable_and_disable) {
   EXPECT_EQ(msgs.size(), 0);
 }
 
+TEST_F(ShmTransceiverTest, loan_and_view) {
+  RoleAttributes attr;
+  attr.set_host_name(common::GlobalData::Instance()->HostName());
+  attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  attr.set_channel_name("shm_loan_channel");
+  attr.set_channel_id(common::Hash("shm_loan_channel"));
+  std::shared_ptr<Transmitter<message::RawMessage>> transmitter =
+      std::make_shared<ShmTransmitter<message::RawMessage>>(attr);
+
+  LoanedMessage<message::RawMessage> loaned;
+  EXPECT_FALSE(transmitter->AcquireLoan(16, &loaned));
+  transmitter->Enable();
+  EXPECT_TRUE(transmitter->AcquireLoan(16, &loaned));
+  EXPECT_TRUE(loaned.is_shared());
+  EXPECT_EQ(loaned.capacity(), 16);
+  EXPECT_FALSE(loaned.set_size(17));
+
+  std::vector<std::string> views;
+  RoleAttributes reader_attr(attr);
+  reader_attr.set_id(common::Hash("shm_loan_reader"));
+  ShmDispatcher::Instance()->AddViewListener(
+      reader_attr,
+      [&views](const MessageView& view, const MessageInfo& msg_info) {
+        (void)msg_info;
+        views.emplace_back(reinterpret_cast<const char*>(view.data),
+                           view.size);
+      });
+
+  const std::string payload = "loaned";
+  memcpy(loaned.data(), payload.data(), payload.size());
+  EXPECT_TRUE(loaned.set_size(payload.size()));
+  EXPECT_TRUE(transmitter->Transmit(&loaned));
+  EXPECT_FALSE(loaned.is_valid());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(views.size(), 1);
+  EXPECT_EQ(views[0], payload);
+
+  // a heap backed loan is parsed and sent the regular way
+  LoanedMessage<message::RawMessage> heap_loaned;
+  heap_loaned.Allocate(payload.size());
+  memcpy(heap_loaned.data(), payload.data(), payload.size());
+  heap_loaned.set_size(payload.size());
+  EXPECT_TRUE(transmitter->Transmit(&heap_loaned));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(views.size(), 2);
+  EXPECT_EQ(views[1], payload);
+
+  ShmDispatcher::Instance()->RemoveListener<ReadableBlock>(reader_attr);
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
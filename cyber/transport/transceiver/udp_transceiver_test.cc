@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/transmitter/udp_transmitter.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/util.h"
+#include "cyber/init.h"
+#include "cyber/proto/unit_test.pb.h"
+#include "cyber/transport/receiver/udp_receiver.h"
+#include "cyber/transport/transport.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class UdpTransceiverTest : public ::testing::Test {
+ protected:
+  using TransmitterPtr = std::shared_ptr<Transmitter<proto::UnitTest>>;
+  using ReceiverPtr = std::shared_ptr<Receiver<proto::UnitTest>>;
+
+  UdpTransceiverTest() : channel_name_("udp_channel") {}
+
+  virtual ~UdpTransceiverTest() {}
+
+  virtual void SetUp() {
+    RoleAttributes attr;
+    attr.set_channel_name(channel_name_);
+    attr.set_channel_id(common::Hash(channel_name_));
+    transmitter_a_ = std::make_shared<UdpTransmitter<proto::UnitTest>>(attr);
+    transmitter_b_ = std::make_shared<UdpTransmitter<proto::UnitTest>>(attr);
+
+    transmitter_a_->Enable();
+    transmitter_b_->Enable();
+  }
+
+  virtual void TearDown() {
+    transmitter_a_ = nullptr;
+    transmitter_b_ = nullptr;
+  }
+
+  std::string channel_name_;
+  TransmitterPtr transmitter_a_ = nullptr;
+  TransmitterPtr transmitter_b_ = nullptr;
+};
+
+TEST_F(UdpTransceiverTest, constructor) {
+  RoleAttributes attr;
+  TransmitterPtr transmitter =
+      std::make_shared<UdpTransmitter<proto::UnitTest>>(attr);
+  ReceiverPtr receiver =
+      std::make_shared<UdpReceiver<proto::UnitTest>>(attr, nullptr);
+
+  EXPECT_EQ(transmitter->seq_num(), 0);
+
+  auto& transmitter_id = transmitter->id();
+  auto& receiver_id = receiver->id();
+
+  EXPECT_NE(transmitter_id.ToString(), receiver_id.ToString());
+}
+
+TEST_F(UdpTransceiverTest, enable_and_disable) {
+  // repeated call
+  transmitter_a_->Enable();
+
+  std::vector<proto::UnitTest> msgs;
+  RoleAttributes attr;
+  attr.set_channel_name(channel_name_);
+  attr.set_channel_id(common::Hash(channel_name_));
+  ReceiverPtr receiver = std::make_shared<UdpReceiver<proto::UnitTest>>(
+      attr, [&msgs](const std::shared_ptr<proto::UnitTest>& msg,
+                    const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        msgs.emplace_back(*msg);
+      });
+
+  receiver->Enable();
+  // repeated call
+  receiver->Enable();
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("UdpTransceiverTest");
+  msg->set_case_name("enable_and_disable");
+
+  EXPECT_TRUE(transmitter_a_->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(msgs.size(), 1);
+
+  EXPECT_TRUE(transmitter_b_->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(msgs.size(), 2);
+
+  for (auto& item : msgs) {
+    EXPECT_EQ(item.class_name(), "UdpTransceiverTest");
+    EXPECT_EQ(item.case_name(), "enable_and_disable");
+  }
+
+  transmitter_b_->Disable(receiver->attributes());
+  EXPECT_FALSE(transmitter_b_->Transmit(msg));
+
+  transmitter_b_->Enable(receiver->attributes());
+  auto& transmitter_b_attr = transmitter_b_->attributes();
+
+  receiver->Disable();
+  receiver->Enable(transmitter_b_attr);
+
+  msgs.clear();
+  EXPECT_TRUE(transmitter_a_->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(msgs.size(), 0);
+
+  EXPECT_TRUE(transmitter_b_->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(msgs.size(), 1);
+
+  receiver->Disable(transmitter_b_attr);
+  msgs.clear();
+  EXPECT_TRUE(transmitter_b_->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(msgs.size(), 0);
+}
+
+TEST_F(UdpTransceiverTest, fragmented_message) {
+  std::vector<proto::UnitTest> msgs;
+  RoleAttributes attr;
+  attr.set_channel_name(channel_name_);
+  attr.set_channel_id(common::Hash(channel_name_));
+  ReceiverPtr receiver = std::make_shared<UdpReceiver<proto::UnitTest>>(
+      attr, [&msgs](const std::shared_ptr<proto::UnitTest>& msg,
+                    const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        msgs.emplace_back(*msg);
+      });
+  receiver->Enable();
+
+  // hundreds of frames at the default fragment size
+  std::string content(512 * 1024, 'x');
+  for (size_t i = 0; i < content.size(); i += 4096) {
+    content[i] = static_cast<char>('a' + i / 4096 % 26);
+  }
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("UdpTransceiverTest");
+  msg->set_case_name(content);
+
+  const int msg_num = 3;
+  for (int i = 0; i < msg_num; ++i) {
+    EXPECT_TRUE(transmitter_a_->Transmit(msg));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_EQ(msgs.size(), msg_num);
+  for (auto& item : msgs) {
+    EXPECT_EQ(item.class_name(), "UdpTransceiverTest");
+    EXPECT_EQ(item.case_name(), content);
+  }
+  receiver->Disable();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  apollo::cyber::transport::Transport::Instance();
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::transport::Transport::Instance()->Shutdown();
+  return res;
+}
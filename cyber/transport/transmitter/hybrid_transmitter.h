@@ -37,6 +37,8 @@
 #include "cyber/transport/transmitter/rtps_transmitter.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
 #include "cyber/transport/transmitter/transmitter.h"
+#include "cyber/transport/transmitter/udp_transmitter.h"
+#include "cyber/transport/udp/udp_socket.h"
 
 namespace apollo {
 namespace cyber {
@@ -71,6 +73,9 @@ class HybridTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool AcquireLoan(std::size_t size, LoanedMessage<M>* loaned) override;
+  bool Transmit(LoanedMessage<M>* loaned, const MessageInfo& msg_info) override;
+
  private:
   void InitMode();
   void ObtainConfig();
@@ -171,6 +176,59 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
   return true;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::AcquireLoan(std::size_t size,
+                                       LoanedMessage<M>* loaned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter == transmitters_.end()) {
+    return false;
+  }
+  return iter->second->AcquireLoan(size, loaned);
+}
+
+template <typename M>
+bool HybridTransmitter<M>::Transmit(LoanedMessage<M>* loaned,
+                                    const MessageInfo& msg_info) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  if (!loaned->is_shared()) {
+    return Transmitter<M>::Transmit(loaned, msg_info);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto shm_iter = transmitters_.find(OptionalMode::SHM);
+  if (shm_iter == transmitters_.end()) {
+    loaned->Reset();
+    return false;
+  }
+
+  // only readers outside shared memory and the history need a real message
+  bool need_msg = this->attr_.qos_profile().durability() ==
+                  QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL;
+  for (auto& item : receivers_) {
+    if (item.first != OptionalMode::SHM && !item.second.empty()) {
+      need_msg = true;
+    }
+  }
+
+  if (need_msg) {
+    auto msg = std::make_shared<M>();
+    if (message::ParseFromArray(loaned->data(),
+                                static_cast<int>(loaned->size()), msg.get())) {
+      history_->Add(msg, msg_info);
+      for (auto& item : transmitters_) {
+        if (item.first != OptionalMode::SHM) {
+          item.second->Transmit(msg, msg_info);
+        }
+      }
+    } else {
+      AERROR << "parse loaned message failed.";
+    }
+  }
+  shm_iter->second->Transmit(loaned, msg_info);
+  return true;
+}
+
 template <typename M>
 void HybridTransmitter<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -185,10 +243,12 @@ void HybridTransmitter<M>::ObtainConfig() {
   if (!global_conf.has_transport_conf()) {
     return;
   }
-  if (!global_conf.transport_conf().has_communication_mode()) {
-    return;
+  if (global_conf.transport_conf().has_communication_mode()) {
+    mode_->CopyFrom(global_conf.transport_conf().communication_mode());
+  }
+  if (IsUdpChannel(this->attr_.channel_name())) {
+    mode_->set_diff_host(OptionalMode::UDP);
   }
-  mode_->CopyFrom(global_conf.transport_conf().communication_mode());
 
   mapping_table_[SAME_PROC] = mode_->same_proc();
   mapping_table_[DIFF_PROC] = mode_->diff_proc();
@@ -221,6 +281,9 @@ void HybridTransmitter<M>::InitTransmitters() {
       case OptionalMode::SHM:
         transmitters_[mode] = std::make_shared<ShmTransmitter<M>>(this->attr_);
         break;
+      case OptionalMode::UDP:
+        transmitters_[mode] = std::make_shared<UdpTransmitter<M>>(this->attr_);
+        break;
       default:
         transmitters_[mode] =
             std::make_shared<RtpsTransmitter<M>>(this->attr_, participant_);
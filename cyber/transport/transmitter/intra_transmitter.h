@@ -81,7 +81,9 @@ bool IntraTransmitter<M>::Transmit(const MessagePtr& msg,
     return false;
   }
 
-  dispatcher_->OnMessage(channel_id_, msg, msg_info);
+  MessageInfo traced;
+  dispatcher_->OnMessage(channel_id_, msg,
+                         this->StampTransmit(msg_info, &traced));
   return true;
 }
 
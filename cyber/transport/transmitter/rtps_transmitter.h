@@ -119,6 +119,12 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   wparams.related_sample_identity().sequence_number().low =
       (int32_t)(msg_info.seq_num() & 0xFFFFFFFF);
 
+  // the trace stamps ride in the datatype field, which cyber does not use
+  if (msg_info.has_trace()) {
+    MessageInfo traced;
+    this->StampTransmit(msg_info, &traced).SerializeTraceTo(&m.datatype());
+  }
+
   if (participant_->is_shutdown()) {
     return false;
   }
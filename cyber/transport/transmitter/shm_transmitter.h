@@ -48,8 +48,13 @@ class ShmTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool AcquireLoan(std::size_t size, LoanedMessage<M>* loaned) override;
+  bool Transmit(LoanedMessage<M>* loaned, const MessageInfo& msg_info) override;
+
  private:
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Publish(const WritableBlock& wb, std::size_t msg_size,
+               const MessageInfo& msg_info);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -114,19 +119,64 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   ADEBUG << "block index: " << wb.index;
   if (!message::SerializeToArray(msg, wb.buf, static_cast<int>(msg_size))) {
     AERROR << "serialize to array failed.";
-    segment_->ReleaseWrittenBlock(wb);
+    segment_->ReleaseWrittenBlock(wb, false);
+    return false;
+  }
+  return Publish(wb, msg_size, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::AcquireLoan(std::size_t size,
+                                    LoanedMessage<M>* loaned) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  WritableBlock wb;
+  if (!segment_->AcquireBlockToWrite(size, &wb)) {
+    AERROR << "acquire block failed.";
     return false;
   }
+  loaned->Lease(segment_, wb, size);
+  return true;
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Transmit(LoanedMessage<M>* loaned,
+                                 const MessageInfo& msg_info) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  if (!this->enabled_ || !loaned->is_shared() ||
+      loaned->segment() != segment_) {
+    // not lent by us, fall back to parsing and copying it
+    return Transmitter<M>::Transmit(loaned, msg_info);
+  }
+
+  std::size_t msg_size = loaned->size();
+  WritableBlock wb = loaned->ReleaseBlock();
+  ADEBUG << "loaned block index: " << wb.index;
+  return Publish(wb, msg_size, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Publish(const WritableBlock& wb, std::size_t msg_size,
+                                const MessageInfo& msg_info) {
   wb.block->set_msg_size(msg_size);
 
+  MessageInfo traced;
+  const auto& info = this->StampTransmit(msg_info, &traced);
   char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-  if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+  if (!info.SerializeTo(msg_info_addr, info.ByteSize())) {
     AERROR << "serialize message info failed.";
-    segment_->ReleaseWrittenBlock(wb);
+    segment_->ReleaseWrittenBlock(wb, false);
+    return false;
+  }
+  wb.block->set_msg_info_size(info.ByteSize());
+  if (!segment_->ReleaseWrittenBlock(wb)) {
+    AERROR << "segment resized while the block was written, drop it.";
     return false;
   }
-  wb.block->set_msg_info_size(MessageInfo::kSize);
-  segment_->ReleaseWrittenBlock(wb);
 
   ReadableInfo readable_info(host_id_, wb.index, channel_id_);
 
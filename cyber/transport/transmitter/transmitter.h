@@ -21,14 +21,19 @@
 #include <memory>
 #include <string>
 
+#include "cyber/common/log.h"
+#include "cyber/event/latency_tracer.h"
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/message/message_traits.h"
 #include "cyber/transport/common/endpoint.h"
+#include "cyber/transport/message/loaned_message.h"
 #include "cyber/transport/message/message_info.h"
 
 namespace apollo {
 namespace cyber {
 namespace transport {
 
+using apollo::cyber::event::LatencyTracer;
 using apollo::cyber::event::PerfEventCache;
 using apollo::cyber::event::TransPerf;
 
@@ -49,13 +54,25 @@ class Transmitter : public Endpoint {
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
 
+  // Lends out a transport-owned buffer of `size` bytes, only transmitters
+  // backed by shared memory can do so.
+  virtual bool AcquireLoan(std::size_t size, LoanedMessage<M>* loaned);
+  bool Transmit(LoanedMessage<M>* loaned);
+  virtual bool Transmit(LoanedMessage<M>* loaned, const MessageInfo& msg_info);
+
   uint64_t NextSeqNum() { return ++seq_num_; }
 
   uint64_t seq_num() const { return seq_num_; }
 
  protected:
+  // returns msg_info, or a copy stamped with the transmit time in traced if
+  // the message is traced
+  static const MessageInfo& StampTransmit(const MessageInfo& msg_info,
+                                          MessageInfo* traced);
+
   uint64_t seq_num_;
   MessageInfo msg_info_;
+  bool trace_ = false;
 };
 
 template <typename M>
@@ -63,6 +80,7 @@ Transmitter<M>::Transmitter(const RoleAttributes& attr)
     : Endpoint(attr), seq_num_(0) {
   msg_info_.set_sender_id(this->id_);
   msg_info_.set_seq_num(this->seq_num_);
+  trace_ = LatencyTracer::Instance()->enabled();
 }
 
 template <typename M>
@@ -71,11 +89,58 @@ Transmitter<M>::~Transmitter() {}
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
+  if (trace_) {
+    msg_info_.set_publish_time(LatencyTracer::Now());
+  }
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
   return Transmit(msg, msg_info_);
 }
 
+template <typename M>
+bool Transmitter<M>::AcquireLoan(std::size_t size, LoanedMessage<M>* loaned) {
+  (void)size;
+  (void)loaned;
+  return false;
+}
+
+template <typename M>
+bool Transmitter<M>::Transmit(LoanedMessage<M>* loaned) {
+  msg_info_.set_seq_num(NextSeqNum());
+  if (trace_) {
+    msg_info_.set_publish_time(LatencyTracer::Now());
+  }
+  PerfEventCache::Instance()->AddTransportEvent(
+      TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
+  return Transmit(loaned, msg_info_);
+}
+
+template <typename M>
+bool Transmitter<M>::Transmit(LoanedMessage<M>* loaned,
+                              const MessageInfo& msg_info) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  auto msg = std::make_shared<M>();
+  bool parsed = message::ParseFromArray(
+      loaned->data(), static_cast<int>(loaned->size()), msg.get());
+  loaned->Reset();
+  if (!parsed) {
+    AERROR << "parse loaned message failed.";
+    return false;
+  }
+  return Transmit(msg, msg_info);
+}
+
+template <typename M>
+const MessageInfo& Transmitter<M>::StampTransmit(const MessageInfo& msg_info,
+                                                 MessageInfo* traced) {
+  if (!msg_info.has_trace()) {
+    return msg_info;
+  }
+  *traced = msg_info;
+  traced->set_transmit_time(LatencyTracer::Now());
+  return *traced;
+}
+
 template <typename M>
 void Transmitter<M>::Enable(const RoleAttributes& opposite_attr) {
   (void)opposite_attr;
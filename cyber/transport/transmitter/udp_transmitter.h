@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_TRANSMITTER_UDP_TRANSMITTER_H_
+#define CYBER_TRANSPORT_TRANSMITTER_UDP_TRANSMITTER_H_
+
+#include <memory>
+#include <string>
+
+#include "cyber/common/log.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/transmitter/transmitter.h"
+#include "cyber/transport/udp/udp_sender.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+template <typename M>
+class UdpTransmitter : public Transmitter<M> {
+ public:
+  using MessagePtr = std::shared_ptr<M>;
+
+  explicit UdpTransmitter(const RoleAttributes& attr);
+  virtual ~UdpTransmitter();
+
+  void Enable() override;
+  void Disable() override;
+
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+
+ private:
+  bool Transmit(const M& msg, const MessageInfo& msg_info);
+
+  uint64_t channel_id_;
+  UdpSenderPtr sender_;
+};
+
+template <typename M>
+UdpTransmitter<M>::UdpTransmitter(const RoleAttributes& attr)
+    : Transmitter<M>(attr), channel_id_(attr.channel_id()), sender_(nullptr) {}
+
+template <typename M>
+UdpTransmitter<M>::~UdpTransmitter() {
+  Disable();
+}
+
+template <typename M>
+void UdpTransmitter<M>::Enable() {
+  if (this->enabled_) {
+    return;
+  }
+
+  sender_ = UdpSender::Instance();
+  RETURN_IF_NULL(sender_);
+  this->enabled_ = true;
+}
+
+template <typename M>
+void UdpTransmitter<M>::Disable() {
+  if (this->enabled_) {
+    sender_ = nullptr;
+    this->enabled_ = false;
+  }
+}
+
+template <typename M>
+bool UdpTransmitter<M>::Transmit(const MessagePtr& msg,
+                                 const MessageInfo& msg_info) {
+  return Transmit(*msg, msg_info);
+}
+
+template <typename M>
+bool UdpTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  // kept per thread, so that large messages do not allocate it every time
+  static thread_local std::string serialized;
+  RETURN_VAL_IF(!message::SerializeToString(msg, &serialized), false);
+
+  MessageInfo traced;
+  const auto& info = this->StampTransmit(msg_info, &traced);
+  return sender_->Send(channel_id_, serialized.data(), serialized.size(),
+                       info);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_TRANSMITTER_UDP_TRANSMITTER_H_
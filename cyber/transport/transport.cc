@@ -29,6 +29,7 @@ Transport::Transport() {
   shm_dispatcher_ = ShmDispatcher::Instance();
   rtps_dispatcher_ = RtpsDispatcher::Instance();
   rtps_dispatcher_->set_participant(participant_);
+  udp_dispatcher_ = UdpDispatcher::Instance();
 }
 
 Transport::~Transport() { Shutdown(); }
@@ -41,6 +42,8 @@ void Transport::Shutdown() {
   intra_dispatcher_->Shutdown();
   shm_dispatcher_->Shutdown();
   rtps_dispatcher_->Shutdown();
+  udp_dispatcher_->Shutdown();
+  UdpSender::CleanUp();
   notifier_->Shutdown();
 
   if (participant_ != nullptr) {
@@ -26,12 +26,14 @@
 #include "cyber/transport/dispatcher/intra_dispatcher.h"
 #include "cyber/transport/dispatcher/rtps_dispatcher.h"
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
+#include "cyber/transport/dispatcher/udp_dispatcher.h"
 #include "cyber/transport/qos/qos_profile_conf.h"
 #include "cyber/transport/receiver/hybrid_receiver.h"
 #include "cyber/transport/receiver/intra_receiver.h"
 #include "cyber/transport/receiver/receiver.h"
 #include "cyber/transport/receiver/rtps_receiver.h"
 #include "cyber/transport/receiver/shm_receiver.h"
+#include "cyber/transport/receiver/udp_receiver.h"
 #include "cyber/transport/rtps/participant.h"
 #include "cyber/transport/shm/notifier_factory.h"
 #include "cyber/transport/transmitter/hybrid_transmitter.h"
@@ -39,6 +41,7 @@
 #include "cyber/transport/transmitter/rtps_transmitter.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
 #include "cyber/transport/transmitter/transmitter.h"
+#include "cyber/transport/transmitter/udp_transmitter.h"
 
 namespace apollo {
 namespace cyber {
@@ -74,6 +77,7 @@ class Transport {
   IntraDispatcherPtr intra_dispatcher_ = nullptr;
   ShmDispatcherPtr shm_dispatcher_ = nullptr;
   RtpsDispatcherPtr rtps_dispatcher_ = nullptr;
+  UdpDispatcherPtr udp_dispatcher_ = nullptr;
 
   DECLARE_SINGLETON(Transport)
 };
@@ -108,6 +112,10 @@ auto Transport::CreateTransmitter(const RoleAttributes& attr,
           std::make_shared<RtpsTransmitter<M>>(modified_attr, participant());
       break;
 
+    case OptionalMode::UDP:
+      transmitter = std::make_shared<UdpTransmitter<M>>(modified_attr);
+      break;
+
     default:
       transmitter =
           std::make_shared<HybridTransmitter<M>>(modified_attr, participant());
@@ -152,6 +160,10 @@ auto Transport::CreateReceiver(
       receiver = std::make_shared<RtpsReceiver<M>>(modified_attr, msg_listener);
       break;
 
+    case OptionalMode::UDP:
+      receiver = std::make_shared<UdpReceiver<M>>(modified_attr, msg_listener);
+      break;
+
     default:
       receiver = std::make_shared<HybridReceiver<M>>(
           modified_attr, msg_listener, participant());
@@ -0,0 +1,720 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Measures throughput, latency percentiles and cpu per message of the
+// transmitters and receivers of every OptionalMode, with the readers in the
+// writing process or in processes of their own on the same host. Every
+// configuration prints one json object per line, so that runs before and
+// after a transport change can be compared by a script.
+//
+// A reader process is this binary started with --reader_process, it prints
+// "ready" once its receiver is enabled and a "result" line when the writer
+// stopped.
+
+#include <getopt.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/util.h"
+#include "cyber/init.h"
+#include "cyber/proto/unit_test.pb.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/qos/qos_profile_conf.h"
+#include "cyber/transport/transport.h"
+
+extern char** environ;
+
+namespace {
+
+using apollo::cyber::Time;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::proto::Chatter;
+using apollo::cyber::proto::OptionalMode;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::QosProfileConf;
+using apollo::cyber::transport::Receiver;
+using apollo::cyber::transport::Transmitter;
+using apollo::cyber::transport::Transport;
+
+// seq of the messages that are not measured
+const uint64_t kWarmupSeq = 0;
+const uint64_t kStopSeq = std::numeric_limits<uint64_t>::max();
+
+// a reader that got nothing for this long stops waiting
+const auto kIdleTimeout = std::chrono::seconds(2);
+// how long a reader process waits for the writer to start
+const auto kStartTimeout = std::chrono::seconds(60);
+
+struct Options {
+  std::vector<OptionalMode> modes = {OptionalMode::INTRA, OptionalMode::SHM,
+                                     OptionalMode::RTPS, OptionalMode::UDP,
+                                     OptionalMode::HYBRID};
+  std::vector<uint64_t> sizes = {64,       1024,      16384,    262144,
+                                 1 << 20, 4 << 20, 32 << 20};
+  std::vector<uint32_t> readers = {1, 4, 16};
+  uint32_t messages = 1000;
+  // caps the messages of a configuration to this many bytes per reader
+  uint64_t max_bytes = 1ULL << 30;
+  uint32_t interval_us = 1000;
+  uint32_t warmup_ms = 1000;
+  bool in_process = true;
+  bool cross_process = true;
+  std::string output;
+
+  // reader process only
+  bool reader_process = false;
+  std::string channel;
+  int writer_pid = 0;
+};
+
+struct Result {
+  std::string mode;
+  std::string scope;
+  uint64_t size = 0;
+  uint32_t readers = 0;
+  uint64_t sent = 0;
+  uint64_t received = 0;
+  double seconds = 0.0;
+  double cpu_us = 0.0;
+  std::vector<uint64_t> latencies_ns;
+};
+
+std::string ModeName(OptionalMode mode) {
+  switch (mode) {
+    case OptionalMode::INTRA:
+      return "intra";
+    case OptionalMode::SHM:
+      return "shm";
+    case OptionalMode::RTPS:
+      return "rtps";
+    case OptionalMode::UDP:
+      return "udp";
+    default:
+      return "hybrid";
+  }
+}
+
+bool ParseMode(const std::string& name, OptionalMode* mode) {
+  for (auto candidate : {OptionalMode::INTRA, OptionalMode::SHM,
+                         OptionalMode::RTPS, OptionalMode::UDP,
+                         OptionalMode::HYBRID}) {
+    if (ModeName(candidate) == name) {
+      *mode = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+std::vector<T> ParseList(const std::string& str) {
+  std::vector<T> values;
+  std::istringstream in(str);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    if (!item.empty()) {
+      values.push_back(static_cast<T>(std::stoull(item)));
+    }
+  }
+  return values;
+}
+
+double CpuMicroseconds() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             1e6 +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+RoleAttributes MakeAttr(const std::string& channel, int process_id) {
+  RoleAttributes attr;
+  attr.set_host_name(GlobalData::Instance()->HostName());
+  attr.set_host_ip(GlobalData::Instance()->HostIp());
+  attr.set_process_id(process_id);
+  attr.set_channel_name(channel);
+  attr.set_channel_id(apollo::cyber::common::Hash(channel));
+  attr.mutable_qos_profile()->CopyFrom(QosProfileConf::QOS_PROFILE_DEFAULT);
+  return attr;
+}
+
+// Latencies of the messages one receiver got.
+class Sink {
+ public:
+  explicit Sink(uint64_t expected) { latencies_ns_.reserve(expected); }
+
+  void OnMessage(const std::shared_ptr<Chatter>& msg) {
+    auto now = Time::Now().ToNanosecond();
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_time_ = std::chrono::steady_clock::now();
+    started_ = true;
+    if (msg->seq() == kWarmupSeq) {
+      warm_ = true;
+      return;
+    }
+    if (msg->seq() == kStopSeq) {
+      stopped_ = true;
+      return;
+    }
+    latencies_ns_.push_back(now > msg->timestamp() ? now - msg->timestamp()
+                                                   : 0);
+    last_receive_ns_ = now;
+  }
+
+  bool started() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return started_;
+  }
+
+  bool warm() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return warm_;
+  }
+
+  // true once expected messages or the stop message came in, or nothing came
+  // in for a while
+  bool Done(uint64_t expected) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stopped_ || latencies_ns_.size() >= expected ||
+           std::chrono::steady_clock::now() - last_time_ > kIdleTimeout;
+  }
+
+  // Time::Now() of the last measured message, comparable across processes
+  uint64_t last_receive_ns() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_receive_ns_;
+  }
+
+  std::vector<uint64_t> latencies_ns() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latencies_ns_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint64_t> latencies_ns_;
+  std::chrono::steady_clock::time_point last_time_ =
+      std::chrono::steady_clock::now();
+  uint64_t last_receive_ns_ = 0;
+  bool started_ = false;
+  bool warm_ = false;
+  bool stopped_ = false;
+};
+
+std::shared_ptr<Receiver<Chatter>> CreateReceiver(
+    const RoleAttributes& attr, OptionalMode mode,
+    const std::shared_ptr<Sink>& sink) {
+  return Transport::Instance()->CreateReceiver<Chatter>(
+      attr,
+      [sink](const std::shared_ptr<Chatter>& msg, const MessageInfo& msg_info,
+             const RoleAttributes& reader_attr) {
+        (void)msg_info;
+        (void)reader_attr;
+        sink->OnMessage(msg);
+      },
+      mode);
+}
+
+void Transmit(const std::shared_ptr<Transmitter<Chatter>>& transmitter,
+              const std::shared_ptr<Chatter>& msg, uint64_t seq) {
+  msg->set_seq(seq);
+  msg->set_timestamp(Time::Now().ToNanosecond());
+  transmitter->Transmit(msg);
+}
+
+// Sends warmup messages until all_warm returns true or warmup_ms passed.
+template <typename F>
+void Warmup(const std::shared_ptr<Transmitter<Chatter>>& transmitter,
+            const std::shared_ptr<Chatter>& msg, uint32_t warmup_ms,
+            F&& all_warm) {
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(warmup_ms);
+  while (std::chrono::steady_clock::now() < deadline && !all_warm()) {
+    Transmit(transmitter, msg, kWarmupSeq);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+// Sends count measured messages, interval_us apart, and returns the
+// Time::Now() of the first one.
+uint64_t Send(
+    const std::shared_ptr<Transmitter<Chatter>>& transmitter,
+    const std::shared_ptr<Chatter>& msg, uint64_t count,
+    uint32_t interval_us) {
+  auto start_ns = Time::Now().ToNanosecond();
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t seq = 1; seq <= count; ++seq) {
+    if (interval_us > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds(interval_us * (seq - 1)));
+    }
+    Transmit(transmitter, msg, seq);
+  }
+  return start_ns;
+}
+
+void SendStop(const std::shared_ptr<Transmitter<Chatter>>& transmitter,
+              const std::shared_ptr<Chatter>& msg) {
+  // a few times, shm may drop one while a reader is behind
+  for (int i = 0; i < 5; ++i) {
+    Transmit(transmitter, msg, kStopSeq);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+}
+
+uint64_t MessageCount(const Options& options, uint64_t size) {
+  return std::max<uint64_t>(
+      10, std::min<uint64_t>(options.messages, options.max_bytes / size));
+}
+
+Result RunInProcess(const Options& options, OptionalMode mode, uint64_t size,
+                    uint32_t reader_num) {
+  Result result;
+  result.mode = ModeName(mode);
+  result.scope = "in_process";
+  result.size = size;
+  result.readers = reader_num;
+  result.sent = MessageCount(options, size);
+
+  auto pid = GlobalData::Instance()->ProcessId();
+  std::ostringstream channel;
+  channel << "/benchmark/transport/" << pid << "/" << result.mode << "_"
+          << size << "_" << reader_num;
+  auto attr = MakeAttr(channel.str(), pid);
+  auto transmitter = Transport::Instance()->CreateTransmitter<Chatter>(attr,
+                                                                       mode);
+
+  std::vector<std::shared_ptr<Sink>> sinks;
+  std::vector<std::shared_ptr<Receiver<Chatter>>> receivers;
+  for (uint32_t i = 0; i < reader_num; ++i) {
+    sinks.emplace_back(std::make_shared<Sink>(result.sent));
+    receivers.emplace_back(CreateReceiver(attr, mode, sinks.back()));
+    if (mode == OptionalMode::HYBRID) {
+      transmitter->Enable(receivers.back()->attributes());
+      receivers.back()->Enable(transmitter->attributes());
+    }
+  }
+
+  auto msg = std::make_shared<Chatter>();
+  msg->set_content(std::string(size, 'x'));
+  Warmup(transmitter, msg, options.warmup_ms, [&sinks]() {
+    return std::all_of(
+        sinks.begin(), sinks.end(),
+        [](const std::shared_ptr<Sink>& sink) { return sink->warm(); });
+  });
+
+  auto cpu_start = CpuMicroseconds();
+  auto start_ns = Send(transmitter, msg, result.sent, options.interval_us);
+  auto end_ns = Time::Now().ToNanosecond();
+  for (auto& sink : sinks) {
+    while (!sink->Done(result.sent)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto latencies = sink->latencies_ns();
+    end_ns = std::max(end_ns, sink->last_receive_ns());
+    result.received += latencies.size();
+    result.latencies_ns.insert(result.latencies_ns.end(), latencies.begin(),
+                               latencies.end());
+  }
+  result.cpu_us = CpuMicroseconds() - cpu_start;
+  result.seconds = static_cast<double>(end_ns - start_ns) / 1e9;
+
+  for (auto& receiver : receivers) {
+    if (mode == OptionalMode::HYBRID) {
+      transmitter->Disable(receiver->attributes());
+    }
+    receiver->Disable();
+  }
+  transmitter->Disable();
+  return result;
+}
+
+struct ReaderProcess {
+  pid_t pid = 0;
+  FILE* out = nullptr;
+};
+
+bool SpawnReader(const std::string& binary, const std::string& channel,
+                 OptionalMode mode, uint64_t count, ReaderProcess* reader) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+  posix_spawn_file_actions_addclose(&actions, fds[0]);
+  posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+  std::vector<std::string> args = {
+      binary,
+      "--reader_process",
+      "--channel=" + channel,
+      "--modes=" + ModeName(mode),
+      "--messages=" + std::to_string(count),
+      "--writer_pid=" + std::to_string(GlobalData::Instance()->ProcessId())};
+  std::vector<char*> argv;
+  for (auto& arg : args) {
+    argv.push_back(&arg[0]);
+  }
+  argv.push_back(nullptr);
+
+  int ret = posix_spawn(&reader->pid, binary.c_str(), &actions, nullptr,
+                        argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  close(fds[1]);
+  if (ret != 0) {
+    close(fds[0]);
+    return false;
+  }
+  reader->out = fdopen(fds[0], "r");
+  return reader->out != nullptr;
+}
+
+std::string ReadLine(FILE* in) {
+  std::string line;
+  int c;
+  while ((c = fgetc(in)) != EOF && c != '\n') {
+    line.push_back(static_cast<char>(c));
+  }
+  return line;
+}
+
+Result RunCrossProcess(const Options& options, const std::string& binary,
+                       OptionalMode mode, uint64_t size, uint32_t reader_num) {
+  Result result;
+  result.mode = ModeName(mode);
+  result.scope = "cross_process";
+  result.size = size;
+  result.readers = reader_num;
+  result.sent = MessageCount(options, size);
+
+  auto pid = GlobalData::Instance()->ProcessId();
+  std::ostringstream channel;
+  channel << "/benchmark/transport/" << pid << "/" << result.mode << "_"
+          << size << "_" << reader_num << "_cross";
+  auto attr = MakeAttr(channel.str(), pid);
+  auto transmitter = Transport::Instance()->CreateTransmitter<Chatter>(attr,
+                                                                       mode);
+
+  std::vector<ReaderProcess> readers(reader_num);
+  for (auto& reader : readers) {
+    if (!SpawnReader(binary, channel.str(), mode, result.sent, &reader)) {
+      std::cerr << "spawn reader process failed." << std::endl;
+      continue;
+    }
+    if (mode == OptionalMode::HYBRID) {
+      auto reader_attr = MakeAttr(channel.str(), reader.pid);
+      reader_attr.set_id(reader.pid);
+      transmitter->Enable(reader_attr);
+    }
+  }
+  for (auto& reader : readers) {
+    if (reader.out != nullptr && ReadLine(reader.out) != "ready") {
+      std::cerr << "reader process " << reader.pid << " is not ready."
+                << std::endl;
+    }
+  }
+
+  auto msg = std::make_shared<Chatter>();
+  msg->set_content(std::string(size, 'x'));
+  // the readers can not tell when they are warm, rtps needs the time to match
+  Warmup(transmitter, msg, options.warmup_ms, []() { return false; });
+
+  auto cpu_start = CpuMicroseconds();
+  auto start_ns = Send(transmitter, msg, result.sent, options.interval_us);
+  auto end_ns = Time::Now().ToNanosecond();
+  result.cpu_us = CpuMicroseconds() - cpu_start;
+  SendStop(transmitter, msg);
+
+  // result <received> <cpu_us> <last_receive_ns> <latencies...>
+  for (auto& reader : readers) {
+    if (reader.out == nullptr) {
+      continue;
+    }
+    std::istringstream line(ReadLine(reader.out));
+    std::string tag;
+    uint64_t received = 0;
+    double cpu_us = 0.0;
+    uint64_t last_receive_ns = 0;
+    if (line >> tag >> received >> cpu_us >> last_receive_ns &&
+        tag == "result") {
+      result.received += received;
+      result.cpu_us += cpu_us;
+      end_ns = std::max(end_ns, last_receive_ns);
+      uint64_t latency = 0;
+      while (line >> latency) {
+        result.latencies_ns.push_back(latency);
+      }
+    }
+    fclose(reader.out);
+    waitpid(reader.pid, nullptr, 0);
+  }
+  result.seconds = static_cast<double>(end_ns - start_ns) / 1e9;
+  transmitter->Disable();
+  return result;
+}
+
+int RunReaderProcess(const Options& options) {
+  auto mode = options.modes.front();
+  auto pid = GlobalData::Instance()->ProcessId();
+  auto attr = MakeAttr(options.channel, pid);
+  auto sink = std::make_shared<Sink>(options.messages);
+  auto receiver = CreateReceiver(attr, mode, sink);
+  if (mode == OptionalMode::HYBRID) {
+    auto writer_attr = MakeAttr(options.channel, options.writer_pid);
+    writer_attr.set_id(options.writer_pid);
+    receiver->Enable(writer_attr);
+  }
+  std::cout << "ready" << std::endl;
+
+  // wait for the first message, then for the stop message or silence
+  auto deadline = std::chrono::steady_clock::now() + kStartTimeout;
+  while (!sink->started() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto cpu_start = CpuMicroseconds();
+  while (!sink->Done(std::numeric_limits<uint64_t>::max())) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto cpu_us = CpuMicroseconds() - cpu_start;
+  receiver->Disable();
+
+  auto latencies = sink->latencies_ns();
+  std::cout << "result " << latencies.size() << " " << cpu_us << " "
+            << sink->last_receive_ns();
+  for (auto latency : latencies) {
+    std::cout << " " << latency;
+  }
+  std::cout << std::endl;
+  return 0;
+}
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto index = static_cast<size_t>(percentile / 100.0 *
+                                   static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+std::string ToJson(Result* result) {
+  auto& latencies = result->latencies_ns;
+  std::sort(latencies.begin(), latencies.end());
+  uint64_t expected = result->sent * result->readers;
+  std::ostringstream out;
+  out << "{\"mode\":\"" << result->mode << "\",\"scope\":\"" << result->scope
+      << "\",\"size\":" << result->size << ",\"readers\":" << result->readers
+      << ",\"sent\":" << result->sent << ",\"received\":" << result->received
+      << ",\"loss\":"
+      << (expected > 0
+              ? 1.0 - static_cast<double>(result->received) / expected
+              : 0.0)
+      << ",\"seconds\":" << result->seconds << ",\"msgs_per_sec\":"
+      << (result->seconds > 0 ? result->received / result->seconds : 0.0)
+      << ",\"mb_per_sec\":"
+      << (result->seconds > 0
+              ? result->received * result->size / result->seconds / 1e6
+              : 0.0)
+      << ",\"p50_us\":" << Percentile(latencies, 50) / 1e3
+      << ",\"p99_us\":" << Percentile(latencies, 99) / 1e3
+      << ",\"p999_us\":" << Percentile(latencies, 99.9) / 1e3
+      << ",\"max_us\":" << (latencies.empty() ? 0 : latencies.back()) / 1e3
+      << ",\"cpu_us_per_msg\":"
+      << (result->sent > 0 ? result->cpu_us / result->sent : 0.0) << "}";
+  return out.str();
+}
+
+void Usage(const char* binary) {
+  std::cout
+      << "usage: " << binary << " [options]\n"
+      << "\t--modes=intra,shm,rtps,udp,hybrid\tmodes to measure\n"
+      << "\t--sizes=64,1024,...\t\tmessage sizes in bytes, 64B to 32MB by "
+         "default\n"
+      << "\t--readers=1,4,16\t\treaders per writer\n"
+      << "\t--messages=1000\t\t\tmessages per configuration\n"
+      << "\t--max_bytes=1073741824\t\tcaps the messages of large sizes\n"
+      << "\t--interval_us=1000\t\tpause between messages, 0 to send "
+         "back to back\n"
+      << "\t--warmup_ms=1000\t\twarmup before measuring\n"
+      << "\t--scope=in_process,cross_process\treaders in this process, in "
+         "processes of their own or both\n"
+      << "\t--output=file\t\t\tjson lines to a file instead of stdout\n"
+      << std::endl;
+}
+
+bool ParseOptions(int argc, char* argv[], Options* options) {
+  enum {
+    kModes = 1,
+    kSizes,
+    kReaders,
+    kMessages,
+    kMaxBytes,
+    kIntervalUs,
+    kWarmupMs,
+    kScope,
+    kOutput,
+    kReaderProcess,
+    kChannel,
+    kWriterPid,
+    kHelp
+  };
+  const struct option long_options[] = {
+      {"modes", required_argument, nullptr, kModes},
+      {"sizes", required_argument, nullptr, kSizes},
+      {"readers", required_argument, nullptr, kReaders},
+      {"messages", required_argument, nullptr, kMessages},
+      {"max_bytes", required_argument, nullptr, kMaxBytes},
+      {"interval_us", required_argument, nullptr, kIntervalUs},
+      {"warmup_ms", required_argument, nullptr, kWarmupMs},
+      {"scope", required_argument, nullptr, kScope},
+      {"output", required_argument, nullptr, kOutput},
+      {"reader_process", no_argument, nullptr, kReaderProcess},
+      {"channel", required_argument, nullptr, kChannel},
+      {"writer_pid", required_argument, nullptr, kWriterPid},
+      {"help", no_argument, nullptr, kHelp},
+      {nullptr, 0, nullptr, 0}};
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+    std::string arg = optarg == nullptr ? "" : optarg;
+    switch (opt) {
+      case kModes: {
+        options->modes.clear();
+        std::istringstream in(arg);
+        std::string name;
+        while (std::getline(in, name, ',')) {
+          OptionalMode mode;
+          if (!ParseMode(name, &mode)) {
+            std::cerr << "unknown mode: " << name << std::endl;
+            return false;
+          }
+          options->modes.push_back(mode);
+        }
+        break;
+      }
+      case kSizes:
+        options->sizes = ParseList<uint64_t>(arg);
+        break;
+      case kReaders:
+        options->readers = ParseList<uint32_t>(arg);
+        break;
+      case kMessages:
+        options->messages = static_cast<uint32_t>(std::stoul(arg));
+        break;
+      case kMaxBytes:
+        options->max_bytes = std::stoull(arg);
+        break;
+      case kIntervalUs:
+        options->interval_us = static_cast<uint32_t>(std::stoul(arg));
+        break;
+      case kWarmupMs:
+        options->warmup_ms = static_cast<uint32_t>(std::stoul(arg));
+        break;
+      case kScope:
+        options->in_process = arg.find("in_process") != std::string::npos;
+        options->cross_process =
+            arg.find("cross_process") != std::string::npos;
+        break;
+      case kOutput:
+        options->output = arg;
+        break;
+      case kReaderProcess:
+        options->reader_process = true;
+        break;
+      case kChannel:
+        options->channel = arg;
+        break;
+      case kWriterPid:
+        options->writer_pid = std::stoi(arg);
+        break;
+      default:
+        return false;
+    }
+  }
+  return !options->modes.empty() && !options->sizes.empty() &&
+         !options->readers.empty() &&
+         std::find(options->sizes.begin(), options->sizes.end(), 0) ==
+             options->sizes.end();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    Usage(argv[0]);
+    return -1;
+  }
+
+  apollo::cyber::Init(argv[0]);
+  if (options.reader_process) {
+    int ret = RunReaderProcess(options);
+    apollo::cyber::Clear();
+    return ret;
+  }
+
+  std::ofstream file;
+  if (!options.output.empty()) {
+    file.open(options.output);
+  }
+  std::ostream& out = options.output.empty() ? std::cout : file;
+
+  // the readers are started from the same binary
+  char binary[4096] = {0};
+  if (readlink("/proc/self/exe", binary, sizeof(binary) - 1) < 0) {
+    options.cross_process = false;
+  }
+
+  for (auto mode : options.modes) {
+    for (auto size : options.sizes) {
+      for (auto reader_num : options.readers) {
+        if (options.in_process) {
+          auto result = RunInProcess(options, mode, size, reader_num);
+          out << ToJson(&result) << std::endl;
+        }
+        // intra does not cross processes
+        if (options.cross_process && mode != OptionalMode::INTRA) {
+          auto result =
+              RunCrossProcess(options, binary, mode, size, reader_num);
+          out << ToJson(&result) << std::endl;
+        }
+      }
+    }
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/udp/frame_header.h"
+
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+const std::size_t FrameHeader::kSize =
+    sizeof(uint32_t) + sizeof(uint64_t) * 3 + sizeof(uint32_t) * 4;
+// "CYUD"
+const uint32_t FrameHeader::kMagic = 0x44555943;
+
+FrameHeader::FrameHeader() : FrameHeader(0, 0, 0, 0, 0) {}
+
+FrameHeader::FrameHeader(uint64_t sender, uint64_t channel_id,
+                         uint64_t msg_seq, uint32_t msg_size,
+                         uint32_t info_size)
+    : sender_(sender),
+      channel_id_(channel_id),
+      msg_seq_(msg_seq),
+      msg_size_(msg_size),
+      info_size_(info_size),
+      offset_(0),
+      length_(0) {}
+
+bool FrameHeader::SerializeTo(char* dst, std::size_t len) const {
+  RETURN_VAL_IF_NULL(dst, false);
+  if (len < kSize) {
+    AWARN << "dst size[" << len << "] too small.";
+    return false;
+  }
+
+  char* ptr = dst;
+  memcpy(ptr, &kMagic, sizeof(kMagic));
+  ptr += sizeof(kMagic);
+  memcpy(ptr, &sender_, sizeof(sender_));
+  ptr += sizeof(sender_);
+  memcpy(ptr, &channel_id_, sizeof(channel_id_));
+  ptr += sizeof(channel_id_);
+  memcpy(ptr, &msg_seq_, sizeof(msg_seq_));
+  ptr += sizeof(msg_seq_);
+  memcpy(ptr, &msg_size_, sizeof(msg_size_));
+  ptr += sizeof(msg_size_);
+  memcpy(ptr, &info_size_, sizeof(info_size_));
+  ptr += sizeof(info_size_);
+  memcpy(ptr, &offset_, sizeof(offset_));
+  ptr += sizeof(offset_);
+  memcpy(ptr, &length_, sizeof(length_));
+  return true;
+}
+
+bool FrameHeader::DeserializeFrom(const char* src, std::size_t len) {
+  RETURN_VAL_IF_NULL(src, false);
+  if (len < kSize) {
+    ADEBUG << "src size[" << len << "] too small.";
+    return false;
+  }
+
+  uint32_t magic = 0;
+  const char* ptr = src;
+  memcpy(&magic, ptr, sizeof(magic));
+  if (magic != kMagic) {
+    ADEBUG << "not a cyber udp frame.";
+    return false;
+  }
+  ptr += sizeof(magic);
+  memcpy(&sender_, ptr, sizeof(sender_));
+  ptr += sizeof(sender_);
+  memcpy(&channel_id_, ptr, sizeof(channel_id_));
+  ptr += sizeof(channel_id_);
+  memcpy(&msg_seq_, ptr, sizeof(msg_seq_));
+  ptr += sizeof(msg_seq_);
+  memcpy(&msg_size_, ptr, sizeof(msg_size_));
+  ptr += sizeof(msg_size_);
+  memcpy(&info_size_, ptr, sizeof(info_size_));
+  ptr += sizeof(info_size_);
+  memcpy(&offset_, ptr, sizeof(offset_));
+  ptr += sizeof(offset_);
+  memcpy(&length_, ptr, sizeof(length_));
+  return static_cast<uint64_t>(offset_) + length_ <= payload_size();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
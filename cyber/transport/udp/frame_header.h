@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_UDP_FRAME_HEADER_H_
+#define CYBER_TRANSPORT_UDP_FRAME_HEADER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Header of one frame of a udp datagram.
+ *
+ * A message travels as its serialized bytes followed by its MessageInfo, the
+ * payload, which is cut into frames of at most fragment_size bytes. A frame
+ * covers [offset, offset + length) of the payload. Small messages fit one
+ * frame and several of them may share a datagram, so a datagram is a
+ * sequence of header and frame payload pairs.
+ */
+class FrameHeader {
+ public:
+  FrameHeader();
+  FrameHeader(uint64_t sender, uint64_t channel_id, uint64_t msg_seq,
+              uint32_t msg_size, uint32_t info_size);
+
+  bool SerializeTo(char* dst, std::size_t len) const;
+  bool DeserializeFrom(const char* src, std::size_t len);
+
+  // unique per sending process
+  uint64_t sender() const { return sender_; }
+  void set_sender(uint64_t sender) { sender_ = sender; }
+
+  uint64_t channel_id() const { return channel_id_; }
+  void set_channel_id(uint64_t channel_id) { channel_id_ = channel_id; }
+
+  // sequence of the message among all messages of the sender
+  uint64_t msg_seq() const { return msg_seq_; }
+  void set_msg_seq(uint64_t msg_seq) { msg_seq_ = msg_seq; }
+
+  uint32_t msg_size() const { return msg_size_; }
+  void set_msg_size(uint32_t msg_size) { msg_size_ = msg_size; }
+
+  uint32_t info_size() const { return info_size_; }
+  void set_info_size(uint32_t info_size) { info_size_ = info_size; }
+
+  uint32_t offset() const { return offset_; }
+  void set_offset(uint32_t offset) { offset_ = offset; }
+
+  uint32_t length() const { return length_; }
+  void set_length(uint32_t length) { length_ = length; }
+
+  uint64_t payload_size() const {
+    return static_cast<uint64_t>(msg_size_) + info_size_;
+  }
+
+  static const std::size_t kSize;
+  static const uint32_t kMagic;
+
+ private:
+  uint64_t sender_;
+  uint64_t channel_id_;
+  uint64_t msg_seq_;
+  uint32_t msg_size_;
+  uint32_t info_size_;
+  uint32_t offset_;
+  uint32_t length_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_UDP_FRAME_HEADER_H_
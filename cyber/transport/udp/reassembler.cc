@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/udp/reassembler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+ReassemblyBufferPool::ReassemblyBufferPool(std::size_t capacity)
+    : state_(std::make_shared<State>()) {
+  state_->capacity = capacity;
+}
+
+ReassemblyBufferPtr ReassemblyBufferPool::Acquire(std::size_t size) {
+  std::unique_ptr<ReassemblyBuffer> buffer;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto& free = state_->free;
+    auto iter = std::find_if(
+        free.begin(), free.end(),
+        [size](const std::unique_ptr<ReassemblyBuffer>& candidate) {
+          return candidate->capacity() >= size;
+        });
+    if (iter != free.end()) {
+      buffer = std::move(*iter);
+      free.erase(iter);
+    }
+  }
+  if (buffer == nullptr) {
+    buffer.reset(new ReassemblyBuffer(size));
+  }
+  buffer->set_size(size);
+
+  std::weak_ptr<State> state = state_;
+  return ReassemblyBufferPtr(buffer.release(),
+                             [state](ReassemblyBuffer* released) {
+                               Release(state, released);
+                             });
+}
+
+std::size_t ReassemblyBufferPool::free_num() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->free.size();
+}
+
+void ReassemblyBufferPool::Release(const std::weak_ptr<State>& state,
+                                   ReassemblyBuffer* buffer) {
+  std::unique_ptr<ReassemblyBuffer> owned(buffer);
+  auto pool = state.lock();
+  if (pool == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pool->mutex);
+  if (pool->free.size() < pool->capacity) {
+    pool->free.emplace_back(std::move(owned));
+  }
+}
+
+uint64_t Reassembler::Pending::Receive(uint64_t begin, uint64_t end) {
+  uint64_t new_bytes = end - begin;
+  // the first range that may touch [begin, end)
+  auto iter = ranges.upper_bound(begin);
+  if (iter != ranges.begin() && std::prev(iter)->second >= begin) {
+    --iter;
+  }
+  while (iter != ranges.end() && iter->first <= end) {
+    auto overlap_begin = std::max(begin, iter->first);
+    auto overlap_end = std::min(end, iter->second);
+    if (overlap_end > overlap_begin) {
+      new_bytes -= overlap_end - overlap_begin;
+    }
+    begin = std::min(begin, iter->first);
+    end = std::max(end, iter->second);
+    iter = ranges.erase(iter);
+  }
+  ranges.emplace(begin, end);
+  return new_bytes;
+}
+
+Reassembler::Reassembler(uint32_t max_pending, uint64_t max_message_size)
+    : max_pending_(std::max<uint32_t>(max_pending, 1)),
+      max_message_size_(max_message_size),
+      pool_(max_pending_) {}
+
+ReassemblyBufferPtr Reassembler::Feed(const FrameHeader& header,
+                                      const char* data) {
+  RETURN_VAL_IF_NULL(data, nullptr);
+  auto payload_size = header.payload_size();
+  if (static_cast<uint64_t>(header.offset()) + header.length() >
+      payload_size) {
+    AWARN << "frame out of the payload, dropped.";
+    return nullptr;
+  }
+  if (payload_size > max_message_size_) {
+    AWARN_EVERY(100) << "message of " << payload_size
+                     << " bytes is larger than max_message_size "
+                     << max_message_size_ << ", dropped.";
+    return nullptr;
+  }
+
+  // the common case of a message in one frame skips the bookkeeping
+  if (header.offset() == 0 && header.length() == payload_size) {
+    auto buffer = pool_.Acquire(payload_size);
+    memcpy(buffer->data(), data, header.length());
+    return buffer;
+  }
+
+  Key key(header.sender(), header.msg_seq());
+  auto iter = pending_.find(key);
+  if (iter == pending_.end()) {
+    if (pending_.size() >= max_pending_) {
+      DropOldest();
+    }
+    Pending pending;
+    pending.buffer = pool_.Acquire(payload_size);
+    pending.age = next_age_++;
+    iter = pending_.emplace(key, std::move(pending)).first;
+  }
+
+  auto& pending = iter->second;
+  if (pending.buffer->size() != payload_size) {
+    AWARN << "frames of one message disagree on its size, dropped.";
+    pending_.erase(iter);
+    ++dropped_num_;
+    return nullptr;
+  }
+  auto new_bytes =
+      pending.Receive(header.offset(),
+                      static_cast<uint64_t>(header.offset()) + header.length());
+  if (new_bytes == 0) {
+    return nullptr;
+  }
+  memcpy(pending.buffer->data() + header.offset(), data, header.length());
+  pending.received += new_bytes;
+  if (pending.received < payload_size) {
+    return nullptr;
+  }
+
+  auto buffer = std::move(pending.buffer);
+  pending_.erase(iter);
+  return buffer;
+}
+
+void Reassembler::DropOldest() {
+  auto oldest = std::min_element(
+      pending_.begin(), pending_.end(),
+      [](const std::pair<const Key, Pending>& a,
+         const std::pair<const Key, Pending>& b) {
+        return a.second.age < b.second.age;
+      });
+  if (oldest == pending_.end()) {
+    return;
+  }
+  AWARN_EVERY(100) << "message[" << oldest->first.second << "] of sender["
+                   << oldest->first.first << "] lost a frame, dropped.";
+  pending_.erase(oldest);
+  ++dropped_num_;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_UDP_REASSEMBLER_H_
+#define CYBER_TRANSPORT_UDP_REASSEMBLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "cyber/transport/udp/frame_header.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Payload of one message received over udp. The memory is not
+ * initialized, only [0, size) is valid.
+ */
+class ReassemblyBuffer {
+ public:
+  ReassemblyBuffer() : capacity_(0) {}
+  explicit ReassemblyBuffer(std::size_t capacity)
+      : data_(new char[capacity]), capacity_(capacity) {}
+
+  char* data() { return data_.get(); }
+  const char* data() const { return data_.get(); }
+  std::size_t capacity() const { return capacity_; }
+
+  std::size_t size() const { return size_; }
+  void set_size(std::size_t size) { size_ = size; }
+
+ private:
+  std::unique_ptr<char[]> data_;
+  std::size_t capacity_;
+  std::size_t size_ = 0;
+};
+using ReassemblyBufferPtr = std::shared_ptr<ReassemblyBuffer>;
+
+/**
+ * @brief Keeps up to capacity released buffers for reuse, so that a channel
+ * of large messages does not allocate one per message.
+ */
+class ReassemblyBufferPool {
+ public:
+  explicit ReassemblyBufferPool(std::size_t capacity);
+
+  /**
+   * @brief A buffer of at least size bytes, it goes back to the pool when the
+   * last reference is dropped, on any thread.
+   */
+  ReassemblyBufferPtr Acquire(std::size_t size);
+
+  std::size_t free_num() const;
+
+ private:
+  struct State {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ReassemblyBuffer>> free;
+    std::size_t capacity = 0;
+  };
+
+  static void Release(const std::weak_ptr<State>& state,
+                      ReassemblyBuffer* buffer);
+
+  std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Puts the frames of the messages of all senders back together.
+ *
+ * Frames may come in any order, a message is complete once frames covering
+ * its whole payload arrived. A frame received twice counts once. Messages
+ * that lose a frame are never completed and are dropped, oldest first, once
+ * more than max_pending messages are incomplete. Frames of messages larger
+ * than max_message_size are dropped before anything is allocated. Not thread
+ * safe, it is fed by one receiving thread.
+ */
+class Reassembler {
+ public:
+  Reassembler(uint32_t max_pending, uint64_t max_message_size);
+
+  /**
+   * @brief Adds the frame described by header whose bytes start at data.
+   * Returns the payload of the message once its last frame arrived, nullptr
+   * otherwise.
+   */
+  ReassemblyBufferPtr Feed(const FrameHeader& header, const char* data);
+
+  std::size_t pending_num() const { return pending_.size(); }
+  uint64_t dropped_num() const { return dropped_num_; }
+
+ private:
+  struct Pending {
+    // Marks [begin, end) as received, returns how many of its bytes were
+    // not received before.
+    uint64_t Receive(uint64_t begin, uint64_t end);
+
+    ReassemblyBufferPtr buffer;
+    // disjoint received ranges of the payload, begin to end
+    std::map<uint64_t, uint64_t> ranges;
+    uint64_t received = 0;
+    uint64_t age = 0;
+  };
+  // key: sender and msg_seq
+  using Key = std::pair<uint64_t, uint64_t>;
+
+  void DropOldest();
+
+  uint32_t max_pending_;
+  uint64_t max_message_size_;
+  std::map<Key, Pending> pending_;
+  uint64_t next_age_ = 0;
+  uint64_t dropped_num_ = 0;
+  ReassemblyBufferPool pool_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_UDP_REASSEMBLER_H_
@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/udp/reassembler.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+constexpr uint64_t kMaxMessageSize = 1 << 20;
+
+// frames of payload of at most chunk bytes each
+std::vector<FrameHeader> Split(const FrameHeader& message, uint32_t chunk) {
+  std::vector<FrameHeader> frames;
+  for (uint32_t offset = 0; offset < message.payload_size(); offset += chunk) {
+    FrameHeader frame(message);
+    frame.set_offset(offset);
+    frame.set_length(std::min<uint32_t>(
+        chunk, static_cast<uint32_t>(message.payload_size()) - offset));
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(FrameHeaderTest, serialize_and_deserialize) {
+  FrameHeader header(1, 2, 3, 100, 20);
+  header.set_offset(64);
+  header.set_length(56);
+  EXPECT_EQ(header.payload_size(), 120);
+
+  char buf[64];
+  EXPECT_FALSE(header.SerializeTo(buf, FrameHeader::kSize - 1));
+  EXPECT_TRUE(header.SerializeTo(buf, sizeof(buf)));
+
+  FrameHeader parsed;
+  EXPECT_FALSE(parsed.DeserializeFrom(buf, FrameHeader::kSize - 1));
+  EXPECT_TRUE(parsed.DeserializeFrom(buf, FrameHeader::kSize));
+  EXPECT_EQ(parsed.sender(), 1);
+  EXPECT_EQ(parsed.channel_id(), 2);
+  EXPECT_EQ(parsed.msg_seq(), 3);
+  EXPECT_EQ(parsed.msg_size(), 100);
+  EXPECT_EQ(parsed.info_size(), 20);
+  EXPECT_EQ(parsed.offset(), 64);
+  EXPECT_EQ(parsed.length(), 56);
+
+  // not a frame
+  buf[0] = 0;
+  EXPECT_FALSE(parsed.DeserializeFrom(buf, FrameHeader::kSize));
+
+  // a frame beyond its payload
+  header.set_length(57);
+  EXPECT_TRUE(header.SerializeTo(buf, sizeof(buf)));
+  EXPECT_FALSE(parsed.DeserializeFrom(buf, FrameHeader::kSize));
+}
+
+TEST(ReassemblerTest, single_frame) {
+  Reassembler reassembler(4, kMaxMessageSize);
+  std::string payload = "message and info";
+  FrameHeader header(1, 2, 0, 11, 5);
+  header.set_length(static_cast<uint32_t>(payload.size()));
+
+  auto buffer = reassembler.Feed(header, payload.data());
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(std::string(buffer->data(), buffer->size()), payload);
+  EXPECT_EQ(reassembler.pending_num(), 0);
+}
+
+TEST(ReassemblerTest, frames_out_of_order) {
+  Reassembler reassembler(4, kMaxMessageSize);
+  std::string payload(1000, 'x');
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<char>('a' + i % 26);
+  }
+  FrameHeader message(1, 2, 7, 990, 10);
+  auto frames = Split(message, 128);
+  ASSERT_EQ(frames.size(), 8);
+
+  // the last frame first, then the others backwards
+  for (size_t i = frames.size() - 1; i > 0; --i) {
+    EXPECT_EQ(reassembler.Feed(frames[i], payload.data() + frames[i].offset()),
+              nullptr);
+    EXPECT_EQ(reassembler.pending_num(), 1);
+  }
+  auto buffer = reassembler.Feed(frames[0], payload.data());
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(std::string(buffer->data(), buffer->size()), payload);
+  EXPECT_EQ(reassembler.pending_num(), 0);
+}
+
+TEST(ReassemblerTest, interleaved_senders) {
+  Reassembler reassembler(4, kMaxMessageSize);
+  std::string payload_a(300, 'a');
+  std::string payload_b(300, 'b');
+  auto frames_a = Split(FrameHeader(1, 2, 0, 290, 10), 100);
+  auto frames_b = Split(FrameHeader(3, 2, 0, 290, 10), 100);
+
+  ReassemblyBufferPtr done_a;
+  ReassemblyBufferPtr done_b;
+  for (size_t i = 0; i < frames_a.size(); ++i) {
+    done_a = reassembler.Feed(frames_a[i], payload_a.data());
+    done_b = reassembler.Feed(frames_b[i], payload_b.data());
+  }
+  ASSERT_NE(done_a, nullptr);
+  ASSERT_NE(done_b, nullptr);
+  EXPECT_EQ(std::string(done_a->data(), done_a->size()), payload_a);
+  EXPECT_EQ(std::string(done_b->data(), done_b->size()), payload_b);
+}
+
+TEST(ReassemblerTest, drop_oldest_incomplete) {
+  Reassembler reassembler(2, kMaxMessageSize);
+  std::string payload(200, 'x');
+  // the first frame of three messages, the first one is evicted
+  for (uint64_t seq = 0; seq < 3; ++seq) {
+    auto frames = Split(FrameHeader(1, 2, seq, 190, 10), 100);
+    EXPECT_EQ(reassembler.Feed(frames[0], payload.data()), nullptr);
+  }
+  EXPECT_EQ(reassembler.pending_num(), 2);
+  EXPECT_EQ(reassembler.dropped_num(), 1);
+
+  // the rest of the first message starts it over instead of completing it
+  auto first = Split(FrameHeader(1, 2, 0, 190, 10), 100);
+  EXPECT_EQ(reassembler.Feed(first[1], payload.data()), nullptr);
+  EXPECT_EQ(reassembler.dropped_num(), 2);
+
+  auto last = Split(FrameHeader(1, 2, 2, 190, 10), 100);
+  EXPECT_NE(reassembler.Feed(last[1], payload.data()), nullptr);
+}
+
+TEST(ReassemblerTest, repeated_frames) {
+  Reassembler reassembler(4, kMaxMessageSize);
+  std::string payload(400, 'x');
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<char>('a' + i % 26);
+  }
+  auto frames = Split(FrameHeader(1, 2, 0, 390, 10), 100);
+  ASSERT_EQ(frames.size(), 4);
+
+  // repeats of the first three frames do not make up for the last one
+  for (int repeat = 0; repeat < 2; ++repeat) {
+    for (size_t i = 0; i + 1 < frames.size(); ++i) {
+      EXPECT_EQ(
+          reassembler.Feed(frames[i], payload.data() + frames[i].offset()),
+          nullptr);
+    }
+  }
+
+  // a frame overlapping received ones only counts its new bytes
+  FrameHeader overlapping(frames[0]);
+  overlapping.set_offset(250);
+  overlapping.set_length(100);
+  EXPECT_EQ(reassembler.Feed(overlapping, payload.data() + 250), nullptr);
+  EXPECT_EQ(reassembler.pending_num(), 1);
+
+  auto buffer = reassembler.Feed(frames[3], payload.data() + 300);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(std::string(buffer->data(), buffer->size()), payload);
+  EXPECT_EQ(reassembler.pending_num(), 0);
+}
+
+TEST(ReassemblerTest, too_large_message) {
+  Reassembler reassembler(4, 1000);
+  std::string payload(1001, 'x');
+
+  FrameHeader single(1, 2, 0, 1000, 1);
+  single.set_length(1001);
+  EXPECT_EQ(reassembler.Feed(single, payload.data()), nullptr);
+
+  // a huge size off the network allocates nothing
+  FrameHeader huge(1, 2, 1, 0xffffffff, 0xffffffff);
+  huge.set_length(100);
+  EXPECT_EQ(reassembler.Feed(huge, payload.data()), nullptr);
+  EXPECT_EQ(reassembler.pending_num(), 0);
+
+  FrameHeader fits(1, 2, 2, 990, 10);
+  fits.set_length(1000);
+  EXPECT_NE(reassembler.Feed(fits, payload.data()), nullptr);
+}
+
+TEST(ReassemblyBufferPoolTest, reuse) {
+  ReassemblyBufferPool pool(1);
+  const char* data = nullptr;
+  {
+    auto buffer = pool.Acquire(1024);
+    EXPECT_EQ(buffer->size(), 1024);
+    data = buffer->data();
+  }
+  EXPECT_EQ(pool.free_num(), 1);
+
+  // a smaller message reuses the buffer
+  auto buffer = pool.Acquire(512);
+  EXPECT_EQ(buffer->data(), data);
+  EXPECT_EQ(buffer->size(), 512);
+  EXPECT_EQ(buffer->capacity(), 1024);
+  EXPECT_EQ(pool.free_num(), 0);
+
+  // a larger one does not fit it
+  auto larger = pool.Acquire(2048);
+  EXPECT_NE(larger->data(), data);
+
+  buffer = nullptr;
+  larger = nullptr;
+  EXPECT_EQ(pool.free_num(), 1);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
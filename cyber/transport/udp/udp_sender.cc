@@ -0,0 +1,225 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/udp/udp_sender.h"
+
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/udp/udp_socket.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// frames handed to one sendmmsg call
+constexpr uint32_t kFrameBatch = 64;
+
+}  // namespace
+
+UdpSender::UdpSender() {
+  memset(&group_addr_, 0, sizeof(group_addr_));
+  if (!Init()) {
+    Shutdown();
+  }
+}
+
+UdpSender::~UdpSender() { Shutdown(); }
+
+void UdpSender::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  batch_cv_.notify_all();
+  if (flush_thread_.joinable()) {
+    flush_thread_.join();
+  }
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    FlushBatchLocked();
+  }
+
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool UdpSender::Init() {
+  auto& conf = GetUdpConf();
+  fragment_size_ = GetFragmentSize(conf);
+  batch_delay_us_ = conf.batch_delay_us();
+  sender_ = Identity().HashValue();
+
+  fd_ = OpenSendSocket(conf, &group_addr_);
+  if (fd_ == -1) {
+    return false;
+  }
+
+  if (batch_delay_us_ > 0) {
+    batch_.reserve(fragment_size_);
+    flush_thread_ = std::thread(&UdpSender::FlushThreadFunc, this);
+  }
+  return true;
+}
+
+bool UdpSender::Send(uint64_t channel_id, const char* msg,
+                     std::size_t msg_size, const MessageInfo& msg_info) {
+  if (is_shutdown_.load()) {
+    return false;
+  }
+  if (msg_size > std::numeric_limits<uint32_t>::max() - MessageInfo::kSize -
+                     MessageInfo::kTraceSize) {
+    AERROR << "message of " << msg_size << " bytes is too large for udp.";
+    return false;
+  }
+
+  std::string info;
+  RETURN_VAL_IF(!msg_info.SerializeTo(&info), false);
+  FrameHeader header(sender_, channel_id, next_msg_seq_.fetch_add(1),
+                     static_cast<uint32_t>(msg_size),
+                     static_cast<uint32_t>(info.size()));
+  if (batch_delay_us_ > 0 &&
+      FrameHeader::kSize + header.payload_size() <= fragment_size_) {
+    return Batch(&header, msg, info);
+  }
+  return SendFrames(&header, msg, info);
+}
+
+bool UdpSender::SendFrames(FrameHeader* header, const char* msg,
+                           const std::string& info) {
+  const uint64_t chunk = fragment_size_ - FrameHeader::kSize;
+  const uint64_t payload_size = header->payload_size();
+  const uint64_t msg_size = header->msg_size();
+
+  char headers[kFrameBatch][FrameHeader::kSize];
+  // header, slice of the message, slice of the info
+  struct iovec iovs[kFrameBatch][3];
+  struct mmsghdr msgs[kFrameBatch];
+
+  uint64_t offset = 0;
+  while (offset < payload_size) {
+    uint32_t frame_num = 0;
+    for (; frame_num < kFrameBatch && offset < payload_size; ++frame_num) {
+      uint64_t end = std::min(offset + chunk, payload_size);
+      header->set_offset(static_cast<uint32_t>(offset));
+      header->set_length(static_cast<uint32_t>(end - offset));
+      header->SerializeTo(headers[frame_num], FrameHeader::kSize);
+
+      auto iov = iovs[frame_num];
+      size_t iov_num = 0;
+      iov[iov_num].iov_base = headers[frame_num];
+      iov[iov_num++].iov_len = FrameHeader::kSize;
+      if (offset < msg_size) {
+        iov[iov_num].iov_base = const_cast<char*>(msg + offset);
+        iov[iov_num++].iov_len = std::min(end, msg_size) - offset;
+      }
+      if (end > msg_size) {
+        uint64_t info_begin = std::max(offset, msg_size) - msg_size;
+        iov[iov_num].iov_base = const_cast<char*>(info.data() + info_begin);
+        iov[iov_num++].iov_len = end - msg_size - info_begin;
+      }
+
+      memset(&msgs[frame_num], 0, sizeof(msgs[frame_num]));
+      msgs[frame_num].msg_hdr.msg_name = &group_addr_;
+      msgs[frame_num].msg_hdr.msg_namelen = sizeof(group_addr_);
+      msgs[frame_num].msg_hdr.msg_iov = iov;
+      msgs[frame_num].msg_hdr.msg_iovlen = iov_num;
+      offset = end;
+    }
+
+    uint32_t sent = 0;
+    while (sent < frame_num) {
+      int ret = sendmmsg(fd_, msgs + sent, frame_num - sent, 0);
+      if (ret < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        AERROR << "fail to sendmmsg, " << strerror(errno);
+        return false;
+      }
+      sent += static_cast<uint32_t>(ret);
+    }
+  }
+  return true;
+}
+
+bool UdpSender::Batch(FrameHeader* header, const char* msg,
+                      const std::string& info) {
+  header->set_offset(0);
+  header->set_length(static_cast<uint32_t>(header->payload_size()));
+  std::size_t frame_size = FrameHeader::kSize + header->length();
+
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (batch_.size() + frame_size > fragment_size_) {
+    FlushBatchLocked();
+  }
+  std::size_t pos = batch_.size();
+  batch_.resize(pos + FrameHeader::kSize);
+  header->SerializeTo(&batch_[pos], FrameHeader::kSize);
+  batch_.append(msg, header->msg_size());
+  batch_.append(info);
+  if (pos == 0) {
+    batch_deadline_ = std::chrono::steady_clock::now() +
+                      std::chrono::microseconds(batch_delay_us_);
+    batch_cv_.notify_one();
+  }
+  return true;
+}
+
+void UdpSender::FlushBatchLocked() {
+  if (batch_.empty() || fd_ == -1) {
+    return;
+  }
+  ssize_t nbytes =
+      sendto(fd_, batch_.data(), batch_.size(), 0,
+             (struct sockaddr*)&group_addr_, sizeof(group_addr_));
+  if (nbytes < 0) {
+    AERROR << "fail to send udp batch, " << strerror(errno);
+  }
+  batch_.clear();
+}
+
+void UdpSender::FlushThreadFunc() {
+  std::unique_lock<std::mutex> lock(batch_mutex_);
+  while (!is_shutdown_.load()) {
+    if (batch_.empty()) {
+      batch_cv_.wait(lock, [this]() {
+        return !batch_.empty() || is_shutdown_.load();
+      });
+      continue;
+    }
+    if (std::chrono::steady_clock::now() < batch_deadline_) {
+      batch_cv_.wait_until(lock, batch_deadline_);
+      continue;
+    }
+    FlushBatchLocked();
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
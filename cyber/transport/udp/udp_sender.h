@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_UDP_UDP_SENDER_H_
+#define CYBER_TRANSPORT_UDP_UDP_SENDER_H_
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/message/message_info.h"
+#include "cyber/transport/udp/frame_header.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class UdpSender;
+using UdpSenderPtr = UdpSender*;
+
+/**
+ * @brief Sends the messages of all udp transmitters of the process to the
+ * multicast group of transport_conf.udp_conf.
+ *
+ * A message goes out as frames of at most fragment_size bytes, with one
+ * sendmmsg call per batch of frames. Each frame gathers its header and its
+ * slices of the serialized message and of the MessageInfo, so the payload is
+ * not copied on the way to the socket. With batch_delay_us set, messages that
+ * fit one frame are packed into a shared datagram instead, which is sent when
+ * it is full or batch_delay_us after its first message. A large message may
+ * then overtake a small one sent before it.
+ */
+class UdpSender {
+ public:
+  virtual ~UdpSender();
+
+  void Shutdown();
+
+  bool Send(uint64_t channel_id, const char* msg, std::size_t msg_size,
+            const MessageInfo& msg_info);
+
+  uint32_t fragment_size() const { return fragment_size_; }
+
+ private:
+  bool Init();
+  bool SendFrames(FrameHeader* header, const char* msg,
+                  const std::string& info);
+  bool Batch(FrameHeader* header, const char* msg, const std::string& info);
+  void FlushBatchLocked();
+  void FlushThreadFunc();
+
+  std::atomic<bool> is_shutdown_ = {false};
+  int fd_ = -1;
+  struct sockaddr_in group_addr_;
+  uint64_t sender_ = 0;
+  std::atomic<uint64_t> next_msg_seq_ = {0};
+  uint32_t fragment_size_ = 0;
+  uint32_t batch_delay_us_ = 0;
+
+  std::mutex batch_mutex_;
+  std::condition_variable batch_cv_;
+  std::string batch_;
+  std::chrono::steady_clock::time_point batch_deadline_;
+  std::thread flush_thread_;
+
+  DECLARE_SINGLETON(UdpSender)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_UDP_UDP_SENDER_H_
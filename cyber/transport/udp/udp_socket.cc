@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/udp/udp_socket.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/transport/udp/frame_header.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+namespace {
+
+in_addr_t InterfaceAddr(const proto::UdpConf& conf) {
+  if (conf.interface_ip().empty()) {
+    return htonl(INADDR_ANY);
+  }
+  return inet_addr(conf.interface_ip().c_str());
+}
+
+void SetBufferSize(int fd, int option, int force_option,
+                   const proto::UdpConf& conf) {
+  int size = static_cast<int>(conf.socket_buffer_size());
+  // the forced option goes past net.core.[rw]mem_max, it needs CAP_NET_ADMIN
+  if (setsockopt(fd, SOL_SOCKET, force_option, &size, sizeof(size)) == 0) {
+    return;
+  }
+  if (setsockopt(fd, SOL_SOCKET, option, &size, sizeof(size)) < 0) {
+    AWARN << "fail to set socket buffer size, " << strerror(errno);
+  }
+}
+
+}  // namespace
+
+const proto::UdpConf& GetUdpConf() {
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf()) {
+    return g_conf.transport_conf().udp_conf();
+  }
+  return proto::UdpConf::default_instance();
+}
+
+uint32_t GetFragmentSize(const proto::UdpConf& conf) {
+  // leave room for a useful amount of payload after the header
+  return std::min(
+      std::max(conf.fragment_size(),
+               static_cast<uint32_t>(FrameHeader::kSize) + 64),
+      kMaxDatagramSize);
+}
+
+bool IsUdpChannel(const std::string& channel_name) {
+  auto& g_conf = GlobalData::Instance()->Config();
+  if (!g_conf.has_transport_conf()) {
+    return false;
+  }
+  auto& transport_conf = g_conf.transport_conf();
+  if (transport_conf.communication_mode().diff_host() ==
+      proto::OptionalMode::UDP) {
+    return true;
+  }
+  auto& channels = transport_conf.udp_conf().channel_name();
+  return std::find(channels.begin(), channels.end(), channel_name) !=
+         channels.end();
+}
+
+int OpenSendSocket(const proto::UdpConf& conf,
+                   struct sockaddr_in* group_addr) {
+  RETURN_VAL_IF_NULL(group_addr, -1);
+  ADEBUG << "udp group ip: " << conf.group_ip() << " port: " << conf.port();
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd == -1) {
+    AERROR << "fail to create udp send fd, " << strerror(errno);
+    return -1;
+  }
+
+  memset(group_addr, 0, sizeof(*group_addr));
+  group_addr->sin_family = AF_INET;
+  group_addr->sin_addr.s_addr = inet_addr(conf.group_ip().c_str());
+  group_addr->sin_port = htons(static_cast<uint16_t>(conf.port()));
+
+  SetBufferSize(fd, SO_SNDBUF, SO_SNDBUFFORCE, conf);
+
+  int ttl = static_cast<int>(conf.multicast_ttl());
+  if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
+    AERROR << "fail to setsockopt IP_MULTICAST_TTL, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+
+  // readers of this host get the datagrams too
+  int loop = 1;
+  if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) <
+      0) {
+    AERROR << "fail to setsockopt IP_MULTICAST_LOOP, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+
+  if (!conf.interface_ip().empty()) {
+    struct in_addr interface_addr;
+    interface_addr.s_addr = InterfaceAddr(conf);
+    if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface_addr,
+                   sizeof(interface_addr)) < 0) {
+      AERROR << "fail to setsockopt IP_MULTICAST_IF, " << strerror(errno);
+      close(fd);
+      return -1;
+    }
+  }
+  return fd;
+}
+
+int OpenReceiveSocket(const proto::UdpConf& conf) {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd == -1) {
+    AERROR << "fail to create udp receive fd, " << strerror(errno);
+    return -1;
+  }
+
+  if (fcntl(fd, F_SETFL, O_NONBLOCK) == -1) {
+    AERROR << "fail to set udp receive fd nonblock, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+
+  int yes = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) < 0) {
+    AERROR << "fail to setsockopt SO_REUSEADDR, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+
+  // large messages arrive as bursts of datagrams, a small buffer drops them
+  SetBufferSize(fd, SO_RCVBUF, SO_RCVBUFFORCE, conf);
+
+  struct sockaddr_in listen_addr;
+  memset(&listen_addr, 0, sizeof(listen_addr));
+  listen_addr.sin_family = AF_INET;
+  listen_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  listen_addr.sin_port = htons(static_cast<uint16_t>(conf.port()));
+  if (bind(fd, (struct sockaddr*)&listen_addr, sizeof(listen_addr)) < 0) {
+    AERROR << "fail to bind udp addr, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+
+  struct ip_mreq mreq;
+  mreq.imr_multiaddr.s_addr = inet_addr(conf.group_ip().c_str());
+  mreq.imr_interface.s_addr = InterfaceAddr(conf);
+  if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) <
+      0) {
+    AERROR << "fail to setsockopt IP_ADD_MEMBERSHIP, " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
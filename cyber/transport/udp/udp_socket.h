@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_UDP_UDP_SOCKET_H_
+#define CYBER_TRANSPORT_UDP_UDP_SOCKET_H_
+
+#include <netinet/in.h>
+
+#include <cstdint>
+#include <string>
+
+#include "cyber/proto/transport_conf.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// largest udp payload of an ipv4 datagram
+constexpr uint32_t kMaxDatagramSize = 65507;
+
+/**
+ * @brief transport_conf.udp_conf of the global config, the defaults if it
+ * is not set.
+ */
+const proto::UdpConf& GetUdpConf();
+
+/**
+ * @brief fragment_size of conf, clamped to what a datagram can carry.
+ */
+uint32_t GetFragmentSize(const proto::UdpConf& conf);
+
+/**
+ * @brief Whether the hybrid endpoints of the channel go over udp to other
+ * hosts, because diff_host is UDP or the channel is listed in udp_conf.
+ */
+bool IsUdpChannel(const std::string& channel_name);
+
+/**
+ * @brief A socket sending to the multicast group of conf, -1 on failure.
+ */
+int OpenSendSocket(const proto::UdpConf& conf, struct sockaddr_in* group_addr);
+
+/**
+ * @brief A nonblocking socket joined to the multicast group of conf, -1 on
+ * failure. Every process of a host may open one, each gets all datagrams.
+ */
+int OpenReceiveSocket(const proto::UdpConf& conf);
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_UDP_UDP_SOCKET_H_
@@ -269,6 +269,36 @@ void MpcOsqp::FreeData(OSQPData *data) {
   c_free(data);
 }
 
+void MpcOsqp::Cleanup(OSQPWorkspace *osqp_workspace, OSQPData *data,
+                      OSQPSettings *settings) {
+  // a kept workspace is cleaned up by its solver
+  if (osqp_solver_ == nullptr) {
+    osqp_cleanup(osqp_workspace);
+  }
+  FreeData(data);
+  c_free(settings);
+}
+
+std::vector<c_float> MpcOsqp::ShiftedSolution() const {
+  const std::vector<c_float> &last_solution = osqp_solver_->solution();
+  if (horizon_ == 0 || last_solution.size() != num_param_) {
+    return {};
+  }
+  // states x(0)...x(N) then controls u(0)...u(N-1), each moved one step
+  // ahead and the last one repeated, x(0) is the measured state
+  std::vector<c_float> shifted_solution(last_solution);
+  const size_t state_total_dim = state_dim_ * (horizon_ + 1);
+  std::copy(last_solution.begin() + 2 * state_dim_,
+            last_solution.begin() + state_total_dim,
+            shifted_solution.begin() + state_dim_);
+  for (size_t i = 0; i < state_dim_; ++i) {
+    shifted_solution[i] = matrix_initial_x_(i, 0);
+  }
+  std::copy(last_solution.begin() + state_total_dim + control_dim_,
+            last_solution.end(), shifted_solution.begin() + state_total_dim);
+  return shifted_solution;
+}
+
 bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   ADEBUG << "Before Calc Gradient";
   CalculateGradient();
@@ -294,24 +324,36 @@ bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
 
   OSQPSettings *settings = Settings();
   ADEBUG << "OSQP setting done";
-  OSQPWorkspace *osqp_workspace = osqp_setup(data, settings);
-  ADEBUG << "OSQP workspace ready";
-  osqp_solve(osqp_workspace);
+  OSQPWorkspace *osqp_workspace = nullptr;
+  if (osqp_solver_ == nullptr) {
+    osqp_workspace = osqp_setup(data, settings);
+    ADEBUG << "OSQP workspace ready";
+    osqp_solve(osqp_workspace);
+  } else {
+    osqp_workspace = osqp_solver_->Solve(*data, *settings, ShiftedSolution());
+    if (osqp_workspace == nullptr) {
+      FreeData(data);
+      c_free(settings);
+      return false;
+    }
+    const auto &stats = osqp_solver_->stats();
+    ADEBUG << "OSQP setup time [ms]: " << stats.setup_time_ms
+           << ", solve time [ms]: " << stats.solve_time_ms
+           << ", iterations: " << stats.iterations
+           << ", reused workspace: " << stats.reused_workspace
+           << ", warm started: " << stats.warm_started;
+  }
 
   auto status = osqp_workspace->info->status_val;
   ADEBUG << "status:" << status;
   // check status
   if (status < 0 || (status != 1 && status != 2)) {
     AERROR << "failed optimization status:\t" << osqp_workspace->info->status;
-    osqp_cleanup(osqp_workspace);
-    FreeData(data);
-    c_free(settings);
+    Cleanup(osqp_workspace, data, settings);
     return false;
   } else if (osqp_workspace->solution == nullptr) {
     AERROR << "The solution from OSQP is nullptr";
-    osqp_cleanup(osqp_workspace);
-    FreeData(data);
-    c_free(settings);
+    Cleanup(osqp_workspace, data, settings);
     return false;
   }
 
@@ -322,9 +364,7 @@ bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   }
 
   // Cleanup
-  osqp_cleanup(osqp_workspace);
-  FreeData(data);
-  c_free(settings);
+  Cleanup(osqp_workspace, data, settings);
   return true;
 }
 
@@ -24,6 +24,7 @@
 
 #include "Eigen/Eigen"
 #include "cyber/common/log.h"
+#include "modules/common/math/persistent_osqp_solver.h"
 #include "osqp/include/osqp.h"
 
 namespace apollo {
@@ -54,6 +55,15 @@ class MpcOsqp {
   // control vector
   bool Solve(std::vector<double> *control_cmd);
 
+  /**
+   * @brief Solves with the kept workspace of solver instead of setting up a
+   * new one, starting from its last solution shifted by one step. The solver
+   * is not owned and must outlive the solve.
+   */
+  void set_osqp_solver(PersistentOsqpSolver *osqp_solver) {
+    osqp_solver_ = osqp_solver;
+  }
+
  private:
   void CalculateKernel(std::vector<c_float> *P_data,
                        std::vector<c_int> *P_indices,
@@ -66,6 +76,9 @@ class MpcOsqp {
   OSQPSettings *Settings();
   OSQPData *Data();
   void FreeData(OSQPData *data);
+  void Cleanup(OSQPWorkspace *osqp_workspace, OSQPData *data,
+               OSQPSettings *settings);
+  std::vector<c_float> ShiftedSolution() const;
 
   template <typename T>
   T *CopyData(const std::vector<T> &vec) {
@@ -95,6 +108,7 @@ class MpcOsqp {
   Eigen::VectorXd gradient_;
   Eigen::VectorXd lowerBound_;
   Eigen::VectorXd upperBound_;
+  PersistentOsqpSolver *osqp_solver_ = nullptr;
 };
 }  // namespace math
 }  // namespace common
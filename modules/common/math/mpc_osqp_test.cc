@@ -201,6 +201,67 @@ TEST(MPCOSQPSolverTest, NullMatrix) {
   EXPECT_NEAR(0.0, control_cmd[0], 1e-7);
 }
 
+TEST(MPCOSQPSolverTest, PersistentSolver) {
+  const int states = 2;
+  const int controls = 1;
+  const int horizon = 10;
+  const int max_iter = 4000;
+  const double eps = 1e-5;
+  const double max = std::numeric_limits<double>::max();
+
+  Eigen::MatrixXd A(states, states);
+  A << 1, 0.1, 0, 1;
+
+  Eigen::MatrixXd B(states, controls);
+  B << 0.005, 0.1;
+
+  Eigen::MatrixXd Q(states, states);
+  Q << 1, 0, 0, 1;
+
+  Eigen::MatrixXd R(controls, controls);
+  R << 0.1;
+
+  Eigen::MatrixXd lower_bound(controls, 1);
+  lower_bound << -1;
+
+  Eigen::MatrixXd upper_bound(controls, 1);
+  upper_bound << 1;
+
+  Eigen::MatrixXd reference_state(states, 1);
+  reference_state << 0, 0;
+
+  Eigen::MatrixXd state_lower_bound(states, 1);
+  state_lower_bound << -max, -max;
+
+  Eigen::MatrixXd state_upper_bound(states, 1);
+  state_upper_bound << max, max;
+
+  Eigen::MatrixXd state(states, 1);
+  state << 1, 0;
+
+  // the kept workspace gives the controls of a new one in every cycle
+  PersistentOsqpSolver osqp_solver;
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    std::vector<double> control_cmd(controls, 0);
+    MpcOsqp mpc_osqp_solver(A, B, Q, R, state, lower_bound, upper_bound,
+                            state_lower_bound, state_upper_bound,
+                            reference_state, max_iter, horizon, eps);
+    mpc_osqp_solver.set_osqp_solver(&osqp_solver);
+    EXPECT_TRUE(mpc_osqp_solver.Solve(&control_cmd));
+    EXPECT_EQ(cycle > 0, osqp_solver.stats().reused_workspace);
+    EXPECT_EQ(cycle > 0, osqp_solver.stats().warm_started);
+
+    std::vector<double> expected_control_cmd(controls, 0);
+    MpcOsqp expected_mpc_osqp_solver(
+        A, B, Q, R, state, lower_bound, upper_bound, state_lower_bound,
+        state_upper_bound, reference_state, max_iter, horizon, eps);
+    EXPECT_TRUE(expected_mpc_osqp_solver.Solve(&expected_control_cmd));
+    EXPECT_NEAR(expected_control_cmd[0], control_cmd[0], 1e-3);
+
+    state = A * state + B * control_cmd[0];
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/common/math/persistent_osqp_solver.h"
+
+#include <chrono>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename T>
+bool SameValues(const T* values, const std::vector<T>& stored) {
+  for (size_t i = 0; i < stored.size(); ++i) {
+    if (values[i] != stored[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SamePattern(const csc& matrix, const std::vector<c_int>& indptr,
+                 const std::vector<c_int>& indices) {
+  if (indptr.size() != static_cast<size_t>(matrix.n + 1) ||
+      !SameValues(matrix.p, indptr)) {
+    return false;
+  }
+  return indices.size() == static_cast<size_t>(indptr.back()) &&
+         SameValues(matrix.i, indices);
+}
+
+// index in the given entries of the entry at row and col, -1 if none
+c_int FindEntry(const std::vector<c_int>& indptr,
+                const std::vector<c_int>& indices, const c_int row,
+                const c_int col) {
+  for (c_int k = indptr[col]; k < indptr[col + 1]; ++k) {
+    if (indices[k] == row) {
+      return k;
+    }
+  }
+  return -1;
+}
+
+// Maps every value of the stored matrix to the given entry at the same
+// position, or at the transposed one for a symmetric matrix.
+bool MapEntries(const csc& stored, const std::vector<c_int>& indptr,
+                const std::vector<c_int>& indices, const bool symmetric,
+                std::vector<c_int>* map) {
+  map->clear();
+  for (c_int col = 0; col < stored.n; ++col) {
+    for (c_int k = stored.p[col]; k < stored.p[col + 1]; ++k) {
+      const c_int row = stored.i[k];
+      c_int index = FindEntry(indptr, indices, row, col);
+      if (index < 0 && symmetric) {
+        index = FindEntry(indptr, indices, col, row);
+      }
+      if (index < 0) {
+        return false;
+      }
+      map->push_back(index);
+    }
+  }
+  return true;
+}
+
+std::vector<c_float> MappedValues(const c_float* values,
+                                  const std::vector<c_int>& map) {
+  std::vector<c_float> mapped_values(map.size());
+  for (size_t k = 0; k < map.size(); ++k) {
+    mapped_values[k] = values[map[k]];
+  }
+  return mapped_values;
+}
+
+}  // namespace
+
+PersistentOsqpSolver::~PersistentOsqpSolver() { Reset(); }
+
+void PersistentOsqpSolver::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  last_solved_ = false;
+  solution_.clear();
+}
+
+OSQPWorkspace* PersistentOsqpSolver::Solve(
+    const OSQPData& data, const OSQPSettings& settings,
+    const std::vector<c_float>& warm_start_x) {
+  stats_ = Stats();
+  const auto setup_start = std::chrono::steady_clock::now();
+  stats_.reused_workspace = CanReuse(data, settings) && Update(data, settings);
+  if (!stats_.reused_workspace && !Setup(data, settings)) {
+    AERROR << "failed to set up the osqp workspace";
+    return nullptr;
+  }
+
+  bool has_start = stats_.reused_workspace;
+  if (has_start && !last_solved_) {
+    // do not start from a failed solve
+    const std::vector<c_float> zero_x(static_cast<size_t>(data.n), 0.0);
+    const std::vector<c_float> zero_y(static_cast<size_t>(data.m), 0.0);
+    osqp_warm_start(work_, zero_x.data(), zero_y.data());
+    has_start = false;
+  }
+  if (warm_start_x.size() == static_cast<size_t>(data.n)) {
+    osqp_warm_start_x(work_, warm_start_x.data());
+    has_start = true;
+  }
+  stats_.warm_started = has_start && settings.warm_start != 0;
+  stats_.setup_time_ms = ElapsedMs(setup_start);
+
+  const auto solve_start = std::chrono::steady_clock::now();
+  osqp_solve(work_);
+  stats_.solve_time_ms = ElapsedMs(solve_start);
+  stats_.iterations = static_cast<int>(work_->info->iter);
+
+  const auto status = work_->info->status_val;
+  last_solved_ = (status == 1 || status == 2) && work_->solution != nullptr;
+  if (last_solved_) {
+    solution_.assign(work_->solution->x, work_->solution->x + data.n);
+  } else {
+    solution_.clear();
+  }
+  return work_;
+}
+
+bool PersistentOsqpSolver::CanReuse(const OSQPData& data,
+                                    const OSQPSettings& settings) const {
+  if (work_ == nullptr || data.n != n_ || data.m != m_ ||
+      !SamePattern(*data.P, P_indptr_, P_indices_) ||
+      !SamePattern(*data.A, A_indptr_, A_indices_)) {
+    return false;
+  }
+  // the settings osqp_update_* can not change
+  if (settings.rho != settings_.rho || settings.sigma != settings_.sigma ||
+      settings.scaling != settings_.scaling ||
+      settings.adaptive_rho != settings_.adaptive_rho ||
+      settings.adaptive_rho_interval != settings_.adaptive_rho_interval ||
+      settings.adaptive_rho_tolerance != settings_.adaptive_rho_tolerance ||
+      settings.eps_prim_inf != settings_.eps_prim_inf ||
+      settings.eps_dual_inf != settings_.eps_dual_inf ||
+      settings.alpha != settings_.alpha ||
+      settings.linsys_solver != settings_.linsys_solver ||
+      settings.delta != settings_.delta ||
+      settings.polish_refine_iter != settings_.polish_refine_iter ||
+      settings.check_termination != settings_.check_termination ||
+      settings.time_limit != settings_.time_limit) {
+    return false;
+  }
+  return matrices_mapped_ || (SameValues(data.P->x, P_data_) &&
+                              SameValues(data.A->x, A_data_));
+}
+
+bool PersistentOsqpSolver::Update(const OSQPData& data,
+                                  const OSQPSettings& settings) {
+  if (!SameValues(data.P->x, P_data_) || !SameValues(data.A->x, A_data_)) {
+    // new numeric factorization, the symbolic one is kept
+    const auto P_values = MappedValues(data.P->x, P_map_);
+    const auto A_values = MappedValues(data.A->x, A_map_);
+    if (osqp_update_P_A(work_, P_values.data(), nullptr,
+                        static_cast<c_int>(P_values.size()), A_values.data(),
+                        nullptr, static_cast<c_int>(A_values.size())) != 0) {
+      AWARN << "failed to update the osqp matrices, set up again";
+      return false;
+    }
+    P_data_.assign(data.P->x, data.P->x + P_data_.size());
+    A_data_.assign(data.A->x, data.A->x + A_data_.size());
+  }
+  if (osqp_update_lin_cost(work_, data.q) != 0 ||
+      osqp_update_bounds(work_, data.l, data.u) != 0) {
+    AWARN << "failed to update the osqp vectors, set up again";
+    return false;
+  }
+  osqp_update_max_iter(work_, settings.max_iter);
+  osqp_update_eps_abs(work_, settings.eps_abs);
+  osqp_update_eps_rel(work_, settings.eps_rel);
+  osqp_update_polish(work_, settings.polish);
+  osqp_update_verbose(work_, settings.verbose);
+  osqp_update_scaled_termination(work_, settings.scaled_termination);
+  osqp_update_warm_start(work_, settings.warm_start);
+  settings_ = settings;
+  return true;
+}
+
+bool PersistentOsqpSolver::Setup(const OSQPData& data,
+                                 const OSQPSettings& settings) {
+  Reset();
+  settings_ = settings;
+  work_ = osqp_setup(&data, &settings_);
+  if (work_ == nullptr) {
+    return false;
+  }
+
+  n_ = data.n;
+  m_ = data.m;
+  const c_int P_nnz = data.P->p[data.P->n];
+  P_indptr_.assign(data.P->p, data.P->p + data.P->n + 1);
+  P_indices_.assign(data.P->i, data.P->i + P_nnz);
+  P_data_.assign(data.P->x, data.P->x + P_nnz);
+  const c_int A_nnz = data.A->p[data.A->n];
+  A_indptr_.assign(data.A->p, data.A->p + data.A->n + 1);
+  A_indices_.assign(data.A->i, data.A->i + A_nnz);
+  A_data_.assign(data.A->x, data.A->x + A_nnz);
+
+  matrices_mapped_ =
+      MapEntries(*work_->data->P, P_indptr_, P_indices_, true, &P_map_) &&
+      MapEntries(*work_->data->A, A_indptr_, A_indices_, false, &A_map_);
+  return true;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "osqp/include/osqp.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class PersistentOsqpSolver
+ * @brief Keeps the osqp workspace between solves of problems with the same
+ * structure, as from one planning or control cycle to the next.
+ *
+ * The values of a new problem are copied into the kept workspace, which skips
+ * the allocations and the symbolic factorization of osqp_setup, and also the
+ * numeric factorization when the matrix values did not change. A new
+ * workspace is set up when the dimensions, the sparsity pattern or a setting
+ * that osqp can not update changes.
+ */
+class PersistentOsqpSolver {
+ public:
+  struct Stats {
+    // time of osqp_setup, or of updating the kept workspace
+    double setup_time_ms = 0.0;
+    double solve_time_ms = 0.0;
+    int iterations = 0;
+    bool reused_workspace = false;
+    bool warm_started = false;
+  };
+
+  PersistentOsqpSolver() = default;
+
+  ~PersistentOsqpSolver();
+
+  /**
+   * @brief Solves the problem of data with settings.
+   * @param warm_start_x primal start, used if it has data.n values. Without
+   *        it a kept workspace starts from its last solution when
+   *        settings.warm_start is set.
+   * @return the workspace with the solution and the info, valid until the
+   *         next call, or nullptr if osqp could not be set up.
+   */
+  OSQPWorkspace* Solve(const OSQPData& data, const OSQPSettings& settings,
+                       const std::vector<c_float>& warm_start_x);
+
+  /**
+   * @brief Drops the workspace, the next solve sets up a new one.
+   */
+  void Reset();
+
+  const Stats& stats() const { return stats_; }
+
+  /**
+   * @brief Primal solution of the last solve, empty if it failed.
+   */
+  const std::vector<c_float>& solution() const { return solution_; }
+
+ private:
+  bool CanReuse(const OSQPData& data, const OSQPSettings& settings) const;
+
+  bool Update(const OSQPData& data, const OSQPSettings& settings);
+
+  bool Setup(const OSQPData& data, const OSQPSettings& settings);
+
+  PersistentOsqpSolver(const PersistentOsqpSolver&) = delete;
+  PersistentOsqpSolver& operator=(const PersistentOsqpSolver&) = delete;
+
+  OSQPWorkspace* work_ = nullptr;
+  OSQPSettings settings_;
+  bool last_solved_ = false;
+  std::vector<c_float> solution_;
+
+  // structure and matrix values of the problem in the workspace
+  c_int n_ = 0;
+  c_int m_ = 0;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> P_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> A_data_;
+
+  // index in the problem of each matrix value of the workspace, osqp may
+  // store P in another order than it was given
+  bool matrices_mapped_ = false;
+  std::vector<c_int> P_map_;
+  std::vector<c_int> A_map_;
+
+  Stats stats_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
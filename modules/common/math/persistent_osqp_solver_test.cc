@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/common/math/persistent_osqp_solver.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// min 0.5 x'Px + q'x  s.t.  l <= Ax <= u, with two variables
+class SmallProblem {
+ public:
+  SmallProblem() {
+    osqp_set_default_settings(&settings_);
+    settings_.eps_abs = 1e-6;
+    settings_.eps_rel = 1e-6;
+    settings_.polish = true;
+    settings_.verbose = false;
+  }
+
+  // the matrices only wrap the vectors, rebuild them as those may have
+  // been reassigned
+  OSQPData* data() {
+    c_free(P_);
+    c_free(A_);
+    P_ = csc_matrix(2, 2, static_cast<c_int>(P_data_.size()), P_data_.data(),
+                    P_indices_.data(), P_indptr_.data());
+    A_ = csc_matrix(static_cast<c_int>(l_.size()), 2,
+                    static_cast<c_int>(A_data_.size()), A_data_.data(),
+                    A_indices_.data(), A_indptr_.data());
+    data_.n = 2;
+    data_.m = static_cast<c_int>(l_.size());
+    data_.P = P_;
+    data_.A = A_;
+    data_.q = q_.data();
+    data_.l = l_.data();
+    data_.u = u_.data();
+    return &data_;
+  }
+
+  ~SmallProblem() {
+    c_free(P_);
+    c_free(A_);
+  }
+
+  // upper triangular P
+  std::vector<c_float> P_data_ = {4.0, 1.0, 2.0};
+  std::vector<c_int> P_indices_ = {0, 0, 1};
+  std::vector<c_int> P_indptr_ = {0, 1, 3};
+  std::vector<c_float> q_ = {1.0, 1.0};
+  std::vector<c_float> A_data_ = {1.0, 1.0, 1.0, 1.0};
+  std::vector<c_int> A_indices_ = {0, 1, 0, 2};
+  std::vector<c_int> A_indptr_ = {0, 2, 4};
+  std::vector<c_float> l_ = {1.0, 0.0, 0.0};
+  std::vector<c_float> u_ = {1.0, 0.7, 0.7};
+  OSQPSettings settings_;
+
+ private:
+  csc* P_ = nullptr;
+  csc* A_ = nullptr;
+  OSQPData data_;
+};
+
+void ExpectSolution(const PersistentOsqpSolver& solver, const double x0,
+                    const double x1) {
+  ASSERT_EQ(solver.solution().size(), 2);
+  EXPECT_NEAR(solver.solution()[0], x0, 1e-4);
+  EXPECT_NEAR(solver.solution()[1], x1, 1e-4);
+}
+
+}  // namespace
+
+TEST(PersistentOsqpSolverTest, ReuseWorkspace) {
+  PersistentOsqpSolver solver;
+  SmallProblem problem;
+  OSQPWorkspace* work = solver.Solve(*problem.data(), problem.settings_, {});
+  ASSERT_NE(work, nullptr);
+  EXPECT_EQ(work->info->status_val, OSQP_SOLVED);
+  EXPECT_FALSE(solver.stats().reused_workspace);
+  EXPECT_FALSE(solver.stats().warm_started);
+  ExpectSolution(solver, 0.3, 0.7);
+
+  // new vectors, the workspace is kept and starts from the last solution
+  problem.q_ = {2.0, 3.0};
+  problem.l_ = {2.0, -1.0, -1.0};
+  problem.u_ = {2.0, 2.5, 2.5};
+  work = solver.Solve(*problem.data(), problem.settings_, {});
+  ASSERT_NE(work, nullptr);
+  EXPECT_EQ(work->info->status_val, OSQP_SOLVED);
+  EXPECT_TRUE(solver.stats().reused_workspace);
+  EXPECT_TRUE(solver.stats().warm_started);
+  ExpectSolution(solver, 0.75, 1.25);
+
+  // new matrix values with the same pattern
+  problem.P_data_ = {1.0, 0.5, 4.0};
+  problem.q_ = {1.0, 1.0};
+  problem.l_ = {1.0, 0.0, 0.0};
+  problem.u_ = {1.0, 0.7, 0.7};
+  work = solver.Solve(*problem.data(), problem.settings_, {0.5, 0.5});
+  ASSERT_NE(work, nullptr);
+  EXPECT_EQ(work->info->status_val, OSQP_SOLVED);
+  EXPECT_TRUE(solver.stats().reused_workspace);
+  EXPECT_TRUE(solver.stats().warm_started);
+  ExpectSolution(solver, 0.7, 0.3);
+
+  // the same problem solved from scratch
+  PersistentOsqpSolver fresh_solver;
+  work = fresh_solver.Solve(*problem.data(), problem.settings_, {});
+  ASSERT_NE(work, nullptr);
+  EXPECT_FALSE(fresh_solver.stats().reused_workspace);
+  ExpectSolution(fresh_solver, 0.7, 0.3);
+}
+
+TEST(PersistentOsqpSolverTest, SetupOnNewStructure) {
+  PersistentOsqpSolver solver;
+  SmallProblem problem;
+  ASSERT_NE(solver.Solve(*problem.data(), problem.settings_, {}), nullptr);
+
+  // diagonal P, another sparsity pattern
+  problem.P_data_ = {4.0, 2.0};
+  problem.P_indices_ = {0, 1};
+  problem.P_indptr_ = {0, 1, 2};
+  ASSERT_NE(solver.Solve(*problem.data(), problem.settings_, {}), nullptr);
+  EXPECT_FALSE(solver.stats().reused_workspace);
+  ExpectSolution(solver, 1.0 / 3.0, 2.0 / 3.0);
+
+  // a setting osqp can not update
+  problem.settings_.rho = 0.2;
+  ASSERT_NE(solver.Solve(*problem.data(), problem.settings_, {}), nullptr);
+  EXPECT_FALSE(solver.stats().reused_workspace);
+
+  // one more constraint
+  problem.A_data_ = {1.0, 1.0, 1.0, 1.0, 1.0};
+  problem.A_indices_ = {0, 1, 0, 2, 3};
+  problem.A_indptr_ = {0, 2, 5};
+  problem.l_ = {1.0, 0.0, 0.0, 0.0};
+  problem.u_ = {1.0, 0.7, 0.7, 0.6};
+  ASSERT_NE(solver.Solve(*problem.data(), problem.settings_, {}), nullptr);
+  EXPECT_FALSE(solver.stats().reused_workspace);
+  ExpectSolution(solver, 0.4, 0.6);
+
+  solver.Reset();
+  EXPECT_TRUE(solver.solution().empty());
+  ASSERT_NE(solver.Solve(*problem.data(), problem.settings_, {}), nullptr);
+  EXPECT_FALSE(solver.stats().reused_workspace);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -116,5 +116,9 @@ DEFINE_bool(
 
 DEFINE_bool(use_osqp_solver, false, "use OSQP solver for MPC controller");
 
+DEFINE_bool(enable_mpc_persistent_osqp_solver, false,
+            "keep the OSQP workspace of the MPC controller between cycles and "
+            "warm start it from the shifted last solution");
+
 DEFINE_bool(use_control_submodules, false,
             "use control submodules instead of controller agent");
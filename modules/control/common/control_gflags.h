@@ -79,4 +79,6 @@ DECLARE_bool(enable_gear_drive_negative_speed_protection);
 
 DECLARE_bool(use_osqp_solver);
 
+DECLARE_bool(enable_mpc_persistent_osqp_solver);
+
 DECLARE_bool(use_control_submodules);
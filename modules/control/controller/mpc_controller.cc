@@ -394,6 +394,9 @@ Status MPCController::ComputeControlCommand(
         matrix_state_, lower_bound, upper_bound, lower_state_bound,
         upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
         mpc_eps_);
+    if (FLAGS_enable_mpc_persistent_osqp_solver) {
+      mpc_osqp.set_osqp_solver(&osqp_solver_);
+    }
     if (!mpc_osqp.Solve(&control_cmd)) {
       AERROR << "MPC OSQP solver failed";
     } else {
@@ -543,6 +546,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  osqp_solver_.Reset();
   return Status::OK();
 }
 
@@ -280,6 +280,9 @@ class MPCController : public Controller {
   // Limitation for judging if the unconstrained analytical control is close
   // enough to the solver's output with constraint
   double unconstrained_control_diff_limit_ = 5.0;
+
+  // OSQP workspace kept between cycles
+  common::math::PersistentOsqpSolver osqp_solver_;
 };
 
 }  // namespace control
@@ -388,6 +388,7 @@ void Path::InitPoints() {
   CHECK_EQ(accumulated_s_.size(), num_points_);
   CHECK_EQ(unit_directions_.size(), num_points_);
   CHECK_EQ(segments_.size(), num_segments_);
+  segment_arrays_ = SegmentArrays(segments_);
 }
 
 void Path::InitLaneSegments() {
@@ -747,36 +748,13 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
   int end_interpolation_index = static_cast<int>(
       std::fmin(num_segments_, GetIndexFromS(hueristic_end_s).id + 1));
   int min_index = start_interpolation_index;
-  for (int i = start_interpolation_index; i < end_interpolation_index; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
-    }
+  if (start_interpolation_index < end_interpolation_index) {
+    min_index = segment_arrays_.NearestSegment(
+        point, start_interpolation_index, end_interpolation_index,
+        min_distance);
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  ProjectOntoSegment(point, min_index, *min_distance, accumulate_s, lateral);
   return true;
 }
 
@@ -794,16 +772,50 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
-  int min_index = 0;
-  for (int i = 0; i < num_segments_; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
+  const int min_index = segment_arrays_.NearestSegment(point, min_distance);
+  *min_distance = std::sqrt(*min_distance);
+  ProjectOntoSegment(point, min_index, *min_distance, accumulate_s, lateral);
+  return true;
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral,
+                          std::vector<double>* min_distance) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr ||
+      min_distance == nullptr) {
+    return false;
+  }
+  const size_t num_points = points.size();
+  accumulate_s->resize(num_points);
+  lateral->resize(num_points);
+  min_distance->resize(num_points);
+  if (use_path_approximation_) {
+    for (size_t k = 0; k < num_points; ++k) {
+      if (!approximation_.GetProjection(*this, points[k], &(*accumulate_s)[k],
+                                        &(*lateral)[k], &(*min_distance)[k])) {
+        return false;
+      }
     }
+    return true;
   }
-  *min_distance = std::sqrt(*min_distance);
+  CHECK_GE(num_points_, 2);
+  std::vector<int> min_indices;
+  segment_arrays_.NearestSegments(points, true, &min_indices, min_distance);
+  for (size_t k = 0; k < num_points; ++k) {
+    (*min_distance)[k] = std::sqrt((*min_distance)[k]);
+    ProjectOntoSegment(points[k], min_indices[k], (*min_distance)[k],
+                       &(*accumulate_s)[k], &(*lateral)[k]);
+  }
+  return true;
+}
+
+void Path::ProjectOntoSegment(const Vec2d& point, const int min_index,
+                              const double min_distance, double* accumulate_s,
+                              double* lateral) const {
   const auto& nearest_seg = segments_[min_index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
@@ -812,21 +824,20 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
   } else if (min_index == num_segments_ - 1) {
     *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
   } else {
     *accumulate_s = accumulated_s_[min_index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
@@ -1004,6 +1015,7 @@ void PathApproximation::InitDilute(const Path& path) {
     segments_.emplace_back(path.path_points()[original_ids_[i]],
                            path.path_points()[original_ids_[i + 1]]);
   }
+  segment_arrays_ = SegmentArrays(segments_);
   max_error_per_segment_.clear();
   max_error_per_segment_.reserve(num_points_ - 1);
   for (int i = 0; i < num_points_ - 1; ++i) {
@@ -1095,19 +1107,15 @@ bool PathApproximation::GetProjection(const Path& path,
       min_distance == nullptr) {
     return false;
   }
-  double min_distance_sqr = std::numeric_limits<double>::infinity();
-  int estimate_nearest_segment_idx = -1;
-  std::vector<double> distance_sqr_to_segments;
-  distance_sqr_to_segments.reserve(segments_.size());
-  for (size_t i = 0; i < segments_.size(); ++i) {
-    const double distance_sqr = segments_[i].DistanceSquareTo(point);
-    distance_sqr_to_segments.push_back(distance_sqr);
-    if (distance_sqr < min_distance_sqr) {
-      min_distance_sqr = distance_sqr;
-      estimate_nearest_segment_idx = static_cast<int>(i);
-    }
+  if (segments_.empty()) {
+    return false;
   }
-  if (estimate_nearest_segment_idx < 0) {
+  std::vector<double> distance_sqr_to_segments;
+  const int estimate_nearest_segment_idx =
+      segment_arrays_.DistanceSquares(point, &distance_sqr_to_segments);
+  const double min_distance_sqr =
+      distance_sqr_to_segments[estimate_nearest_segment_idx];
+  if (!(min_distance_sqr < std::numeric_limits<double>::infinity())) {
     return false;
   }
   const auto& original_segments = path.segments();
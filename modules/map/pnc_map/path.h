@@ -29,6 +29,7 @@
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/pnc_map/segment_arrays.h"
 
 namespace apollo {
 namespace hdmap {
@@ -186,6 +187,7 @@ class PathApproximation {
   int num_points_ = 0;
   std::vector<int> original_ids_;
   std::vector<common::math::LineSegment2d> segments_;
+  SegmentArrays segment_arrays_;
   std::vector<double> max_error_per_segment_;
 
   // TODO(All): use direction change checks to early stop.
@@ -261,6 +263,13 @@ class Path {
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
 
+  // Projects each of points as GetProjection does for one, finding the
+  // nearest segments of all of them before computing their s and l.
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral,
+                      std::vector<double>* distance) const;
+
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
 
@@ -341,6 +350,12 @@ class Path {
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
+  // The s and l of point on the segment min_index nearest to it, at
+  // min_distance.
+  void ProjectOntoSegment(const common::math::Vec2d& point, const int min_index,
+                          const double min_distance, double* accumulate_s,
+                          double* lateral) const;
+
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
   void GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
@@ -357,6 +372,7 @@ class Path {
   double length_ = 0.0;
   std::vector<double> accumulated_s_;
   std::vector<common::math::LineSegment2d> segments_;
+  SegmentArrays segment_arrays_;
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
 
@@ -16,6 +16,11 @@
 
 #include "modules/map/pnc_map/path.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
 #include <string>
 
 #include "absl/strings/str_cat.h"
@@ -572,6 +577,141 @@ TEST(TestSuite, hdmap_jerky_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_get_projections) {
+  // a winding path crossing itself, with a repeated point
+  const int kNumSegments = 1000;
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double t = 0.02 * static_cast<double>(i);
+    points.push_back(MakeMapPathPoint(20.0 * sin(t) + RandomDouble(-0.5, 0.5),
+                                      10.0 * sin(2.0 * t) + 0.1 * t));
+    if (i == kNumSegments / 2) {
+      points.push_back(points.back());
+    }
+  }
+  const Path path(points, {});
+  const Path path_approximation(points, {}, 2.0);
+
+  std::vector<Vec2d> xy_points;
+  for (int k = 0; k < 2000; ++k) {
+    xy_points.emplace_back(RandomDouble(-30.0, 30.0),
+                           RandomDouble(-20.0, 20.0));
+  }
+  xy_points.push_back(points[kNumSegments / 2]);
+  xy_points.push_back(points.back());
+
+  std::vector<double> accumulate_s;
+  std::vector<double> lateral;
+  std::vector<double> distance;
+  EXPECT_TRUE(path.GetProjections(xy_points, &accumulate_s, &lateral,
+                                  &distance));
+  ASSERT_EQ(distance.size(), xy_points.size());
+  for (size_t k = 0; k < xy_points.size(); ++k) {
+    double min_distance_sqr = std::numeric_limits<double>::infinity();
+    for (const auto& segment : path.segments()) {
+      min_distance_sqr =
+          std::min(min_distance_sqr, segment.DistanceSquareTo(xy_points[k]));
+    }
+    EXPECT_EQ(distance[k], std::sqrt(min_distance_sqr));
+
+    double expected_s;
+    double expected_l;
+    double expected_distance;
+    EXPECT_TRUE(path.GetProjection(xy_points[k], &expected_s, &expected_l,
+                                   &expected_distance));
+    EXPECT_EQ(accumulate_s[k], expected_s);
+    EXPECT_EQ(lateral[k], expected_l);
+    EXPECT_EQ(distance[k], expected_distance);
+  }
+
+  EXPECT_TRUE(path_approximation.GetProjections(xy_points, &accumulate_s,
+                                                &lateral, &distance));
+  for (size_t k = 0; k < xy_points.size(); ++k) {
+    double expected_s;
+    double expected_l;
+    double expected_distance;
+    EXPECT_TRUE(path_approximation.GetProjection(
+        xy_points[k], &expected_s, &expected_l, &expected_distance));
+    EXPECT_EQ(accumulate_s[k], expected_s);
+    EXPECT_EQ(lateral[k], expected_l);
+    EXPECT_EQ(distance[k], expected_distance);
+  }
+}
+
+TEST(TestSuite, hdmap_path_projection_benchmark) {
+  // a reference line of 500m sampled every 0.5m, and obstacle points near it
+  const int kNumSegments = 1000;
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double x = 0.5 * static_cast<double>(i);
+    points.push_back(MakeMapPathPoint(x, 20.0 * sin(x / 80.0)));
+  }
+  const Path path(points, {});
+  std::vector<Vec2d> xy_points;
+  for (int k = 0; k < 1000; ++k) {
+    const double x = RandomDouble(0.0, 500.0);
+    xy_points.emplace_back(x, 20.0 * sin(x / 80.0) + RandomDouble(-8.0, 8.0));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const int kRepeats = 20;
+  const auto ns_per_point = [&](const Clock::time_point start) {
+    const std::chrono::duration<double, std::nano> elapsed =
+        Clock::now() - start;
+    return elapsed.count() / static_cast<double>(kRepeats * xy_points.size());
+  };
+
+  // the linear scan of the segments GetProjection did before
+  double scan_checksum = 0.0;
+  auto start = Clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    for (const auto& point : xy_points) {
+      double min_distance_sqr = std::numeric_limits<double>::infinity();
+      for (const auto& segment : path.segments()) {
+        min_distance_sqr =
+            std::min(min_distance_sqr, segment.DistanceSquareTo(point));
+      }
+      scan_checksum += std::sqrt(min_distance_sqr);
+    }
+  }
+  const double scan_ns = ns_per_point(start);
+
+  double single_checksum = 0.0;
+  double accumulate_s;
+  double lateral;
+  double distance;
+  start = Clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    for (const auto& point : xy_points) {
+      EXPECT_TRUE(path.GetProjection(point, &accumulate_s, &lateral, &distance));
+      single_checksum += distance;
+    }
+  }
+  const double single_ns = ns_per_point(start);
+
+  double batch_checksum = 0.0;
+  std::vector<double> accumulate_s_list;
+  std::vector<double> lateral_list;
+  std::vector<double> distance_list;
+  start = Clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    EXPECT_TRUE(path.GetProjections(xy_points, &accumulate_s_list,
+                                    &lateral_list, &distance_list));
+    for (const double d : distance_list) {
+      batch_checksum += d;
+    }
+  }
+  const double batch_ns = ns_per_point(start);
+
+  EXPECT_EQ(scan_checksum, single_checksum);
+  EXPECT_EQ(scan_checksum, batch_checksum);
+  std::printf(
+      "{\"segments\": %d, \"points\": %zu, \"scan_ns_per_point\": %.1f, "
+      "\"get_projection_ns_per_point\": %.1f, "
+      "\"get_projections_ns_per_point\": %.1f}\n",
+      kNumSegments, xy_points.size(), scan_ns, single_ns, batch_ns);
+}
+
 TEST(TestSuite, hdmap_s_path) {
   std::vector<MapPathPoint> points;
   const double kRadius = 50.0;
@@ -0,0 +1,400 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/pnc_map/segment_arrays.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SEGMENT_ARRAYS_X86
+#endif
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+constexpr int kBlockSize = 16;
+
+// The bounding boxes are grown by this much, far more than the rounding
+// error of a distance, so a box is never found farther than a segment in it.
+constexpr double kBlockMargin = 1.0e-6;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The arrays of SegmentArrays, as the kernels read them.
+struct Columns {
+  const double* start_x;
+  const double* start_y;
+  const double* end_x;
+  const double* end_y;
+  const double* unit_x;
+  const double* unit_y;
+  const double* length;
+};
+
+// The first nearest segment so far, index -1 if there is none.
+struct Nearest {
+  double distance_sqr = kInfinity;
+  int index = -1;
+};
+
+// The kernels take the operations of LineSegment2d::DistanceSquareTo, so the
+// distances are the same as long as the build does not contract them into
+// fused multiply-adds. The vector kernels keep the first nearest segment of
+// every lane, reduce the lanes to the first nearest of all and leave the
+// remainder to the scalar kernel.
+
+// Scans the segments [i, end), starting from nearest.
+void ScanScalar(const Columns& c, const double x, const double y, int i,
+                const int end, double* distance_sqrs, Nearest* nearest) {
+  for (; i < end; ++i) {
+    const double x0 = x - c.start_x[i];
+    const double y0 = y - c.start_y[i];
+    const double proj = x0 * c.unit_x[i] + y0 * c.unit_y[i];
+    double distance = 0.0;
+    if (proj <= 0.0) {
+      distance = x0 * x0 + y0 * y0;
+    } else if (proj >= c.length[i]) {
+      const double x1 = x - c.end_x[i];
+      const double y1 = y - c.end_y[i];
+      distance = x1 * x1 + y1 * y1;
+    } else {
+      const double prod = x0 * c.unit_y[i] - y0 * c.unit_x[i];
+      distance = prod * prod;
+    }
+    if (distance_sqrs != nullptr) {
+      distance_sqrs[i] = distance;
+    }
+    if (distance < nearest->distance_sqr) {
+      nearest->distance_sqr = distance;
+      nearest->index = i;
+    }
+  }
+}
+
+void ReduceLanes(const double* lane_bests, const double* lane_indices,
+                 const int num_lanes, Nearest* nearest) {
+  for (int lane = 0; lane < num_lanes; ++lane) {
+    const int lane_index = static_cast<int>(lane_indices[lane]);
+    if (lane_bests[lane] < nearest->distance_sqr ||
+        (lane_bests[lane] == nearest->distance_sqr &&
+         lane_index < nearest->index)) {
+      nearest->distance_sqr = lane_bests[lane];
+      nearest->index = lane_index;
+    }
+  }
+}
+
+#ifdef SEGMENT_ARRAYS_X86
+
+__attribute__((target("avx2"))) void ScanAvx2(const Columns& c,
+                                              const double x, const double y,
+                                              int i, const int end,
+                                              double* distance_sqrs,
+                                              Nearest* nearest) {
+  if (end - i >= 4) {
+    const __m256d px = _mm256_set1_pd(x);
+    const __m256d py = _mm256_set1_pd(y);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d step = _mm256_set1_pd(4.0);
+    __m256d index = _mm256_setr_pd(i, i + 1, i + 2, i + 3);
+    __m256d lane_best = _mm256_set1_pd(kInfinity);
+    __m256d lane_index = _mm256_set1_pd(-1.0);
+    for (; i + 4 <= end; i += 4) {
+      const __m256d x0 = _mm256_sub_pd(px, _mm256_loadu_pd(c.start_x + i));
+      const __m256d y0 = _mm256_sub_pd(py, _mm256_loadu_pd(c.start_y + i));
+      const __m256d x1 = _mm256_sub_pd(px, _mm256_loadu_pd(c.end_x + i));
+      const __m256d y1 = _mm256_sub_pd(py, _mm256_loadu_pd(c.end_y + i));
+      const __m256d ux = _mm256_loadu_pd(c.unit_x + i);
+      const __m256d uy = _mm256_loadu_pd(c.unit_y + i);
+      const __m256d proj =
+          _mm256_add_pd(_mm256_mul_pd(x0, ux), _mm256_mul_pd(y0, uy));
+      const __m256d prod =
+          _mm256_sub_pd(_mm256_mul_pd(x0, uy), _mm256_mul_pd(y0, ux));
+      const __m256d to_start =
+          _mm256_add_pd(_mm256_mul_pd(x0, x0), _mm256_mul_pd(y0, y0));
+      const __m256d to_end =
+          _mm256_add_pd(_mm256_mul_pd(x1, x1), _mm256_mul_pd(y1, y1));
+      const __m256d to_line = _mm256_mul_pd(prod, prod);
+      const __m256d beyond_end =
+          _mm256_cmp_pd(proj, _mm256_loadu_pd(c.length + i), _CMP_GE_OQ);
+      const __m256d before_start = _mm256_cmp_pd(proj, zero, _CMP_LE_OQ);
+      const __m256d distance = _mm256_blendv_pd(
+          _mm256_blendv_pd(to_line, to_end, beyond_end), to_start,
+          before_start);
+      if (distance_sqrs != nullptr) {
+        _mm256_storeu_pd(distance_sqrs + i, distance);
+      }
+      const __m256d nearer = _mm256_cmp_pd(distance, lane_best, _CMP_LT_OQ);
+      lane_best = _mm256_blendv_pd(lane_best, distance, nearer);
+      lane_index = _mm256_blendv_pd(lane_index, index, nearer);
+      index = _mm256_add_pd(index, step);
+    }
+    double lane_bests[4];
+    double lane_indices[4];
+    _mm256_storeu_pd(lane_bests, lane_best);
+    _mm256_storeu_pd(lane_indices, lane_index);
+    ReduceLanes(lane_bests, lane_indices, 4, nearest);
+  }
+  ScanScalar(c, x, y, i, end, distance_sqrs, nearest);
+}
+
+__attribute__((target("sse4.1"))) void ScanSse41(const Columns& c,
+                                                 const double x,
+                                                 const double y, int i,
+                                                 const int end,
+                                                 double* distance_sqrs,
+                                                 Nearest* nearest) {
+  if (end - i >= 2) {
+    const __m128d px = _mm_set1_pd(x);
+    const __m128d py = _mm_set1_pd(y);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d step = _mm_set1_pd(2.0);
+    __m128d index = _mm_setr_pd(i, i + 1);
+    __m128d lane_best = _mm_set1_pd(kInfinity);
+    __m128d lane_index = _mm_set1_pd(-1.0);
+    for (; i + 2 <= end; i += 2) {
+      const __m128d x0 = _mm_sub_pd(px, _mm_loadu_pd(c.start_x + i));
+      const __m128d y0 = _mm_sub_pd(py, _mm_loadu_pd(c.start_y + i));
+      const __m128d x1 = _mm_sub_pd(px, _mm_loadu_pd(c.end_x + i));
+      const __m128d y1 = _mm_sub_pd(py, _mm_loadu_pd(c.end_y + i));
+      const __m128d ux = _mm_loadu_pd(c.unit_x + i);
+      const __m128d uy = _mm_loadu_pd(c.unit_y + i);
+      const __m128d proj = _mm_add_pd(_mm_mul_pd(x0, ux), _mm_mul_pd(y0, uy));
+      const __m128d prod = _mm_sub_pd(_mm_mul_pd(x0, uy), _mm_mul_pd(y0, ux));
+      const __m128d to_start =
+          _mm_add_pd(_mm_mul_pd(x0, x0), _mm_mul_pd(y0, y0));
+      const __m128d to_end = _mm_add_pd(_mm_mul_pd(x1, x1), _mm_mul_pd(y1, y1));
+      const __m128d to_line = _mm_mul_pd(prod, prod);
+      const __m128d beyond_end = _mm_cmpge_pd(proj, _mm_loadu_pd(c.length + i));
+      const __m128d before_start = _mm_cmple_pd(proj, zero);
+      const __m128d distance = _mm_blendv_pd(
+          _mm_blendv_pd(to_line, to_end, beyond_end), to_start, before_start);
+      if (distance_sqrs != nullptr) {
+        _mm_storeu_pd(distance_sqrs + i, distance);
+      }
+      const __m128d nearer = _mm_cmplt_pd(distance, lane_best);
+      lane_best = _mm_blendv_pd(lane_best, distance, nearer);
+      lane_index = _mm_blendv_pd(lane_index, index, nearer);
+      index = _mm_add_pd(index, step);
+    }
+    double lane_bests[2];
+    double lane_indices[2];
+    _mm_storeu_pd(lane_bests, lane_best);
+    _mm_storeu_pd(lane_indices, lane_index);
+    ReduceLanes(lane_bests, lane_indices, 2, nearest);
+  }
+  ScanScalar(c, x, y, i, end, distance_sqrs, nearest);
+}
+
+#endif  // SEGMENT_ARRAYS_X86
+
+SegmentArrays::Kernel SelectKernel() {
+#ifdef SEGMENT_ARRAYS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SegmentArrays::Kernel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SegmentArrays::Kernel::kSse41;
+  }
+#endif
+  return SegmentArrays::Kernel::kScalar;
+}
+
+}  // namespace
+
+SegmentArrays::Kernel SegmentArrays::BestKernel() {
+  static const Kernel kernel = SelectKernel();
+  return kernel;
+}
+
+bool SegmentArrays::IsSupported(const Kernel kernel) {
+  return kernel <= BestKernel();
+}
+
+bool SegmentArrays::set_kernel(const Kernel kernel) {
+  if (!IsSupported(kernel)) {
+    return false;
+  }
+  kernel_ = kernel;
+  return true;
+}
+
+SegmentArrays::SegmentArrays(const std::vector<LineSegment2d>& segments) {
+  const size_t num_segments = segments.size();
+  start_x_.reserve(num_segments);
+  start_y_.reserve(num_segments);
+  end_x_.reserve(num_segments);
+  end_y_.reserve(num_segments);
+  unit_x_.reserve(num_segments);
+  unit_y_.reserve(num_segments);
+  length_.reserve(num_segments);
+  for (const auto& segment : segments) {
+    start_x_.push_back(segment.start().x());
+    start_y_.push_back(segment.start().y());
+    end_x_.push_back(segment.end().x());
+    end_y_.push_back(segment.end().y());
+    unit_x_.push_back(segment.unit_direction().x());
+    unit_y_.push_back(segment.unit_direction().y());
+    length_.push_back(segment.length());
+  }
+  InitBlocks();
+}
+
+void SegmentArrays::InitBlocks() {
+  const int num_blocks = (size() + kBlockSize - 1) / kBlockSize;
+  block_min_x_.assign(num_blocks, kInfinity);
+  block_min_y_.assign(num_blocks, kInfinity);
+  block_max_x_.assign(num_blocks, -kInfinity);
+  block_max_y_.assign(num_blocks, -kInfinity);
+  for (int i = 0; i < size(); ++i) {
+    const int block = i / kBlockSize;
+    block_min_x_[block] =
+        std::min({block_min_x_[block], start_x_[i], end_x_[i]});
+    block_min_y_[block] =
+        std::min({block_min_y_[block], start_y_[i], end_y_[i]});
+    block_max_x_[block] =
+        std::max({block_max_x_[block], start_x_[i], end_x_[i]});
+    block_max_y_[block] =
+        std::max({block_max_y_[block], start_y_[i], end_y_[i]});
+  }
+  for (int block = 0; block < num_blocks; ++block) {
+    block_min_x_[block] -= kBlockMargin;
+    block_min_y_[block] -= kBlockMargin;
+    block_max_x_[block] += kBlockMargin;
+    block_max_y_[block] += kBlockMargin;
+  }
+}
+
+int SegmentArrays::Scan(const double x, const double y, const int begin,
+                        const int end, double* distance_sqrs,
+                        double* min_distance_sqr) const {
+  const Columns columns = {start_x_.data(), start_y_.data(), end_x_.data(),
+                           end_y_.data(),   unit_x_.data(),  unit_y_.data(),
+                           length_.data()};
+  Nearest nearest;
+  switch (kernel_) {
+#ifdef SEGMENT_ARRAYS_X86
+    case Kernel::kAvx2:
+      ScanAvx2(columns, x, y, begin, end, distance_sqrs, &nearest);
+      break;
+    case Kernel::kSse41:
+      ScanSse41(columns, x, y, begin, end, distance_sqrs, &nearest);
+      break;
+#endif
+    default:
+      ScanScalar(columns, x, y, begin, end, distance_sqrs, &nearest);
+      break;
+  }
+  *min_distance_sqr = nearest.distance_sqr;
+  return nearest.index < 0 ? begin : nearest.index;
+}
+
+int SegmentArrays::DistanceSquares(const Vec2d& point,
+                                   std::vector<double>* distance_sqrs) const {
+  CHECK_NOTNULL(distance_sqrs);
+  distance_sqrs->resize(size());
+  double min_distance_sqr = 0.0;
+  return Scan(point.x(), point.y(), 0, size(), distance_sqrs->data(),
+              &min_distance_sqr);
+}
+
+int SegmentArrays::NearestSegment(const Vec2d& point, const int begin,
+                                  const int end,
+                                  double* min_distance_sqr) const {
+  CHECK_NOTNULL(min_distance_sqr);
+  CHECK_GE(begin, 0);
+  CHECK_LE(end, size());
+  return Scan(point.x(), point.y(), begin, end, nullptr, min_distance_sqr);
+}
+
+int SegmentArrays::NearestSegment(const Vec2d& point,
+                                  double* min_distance_sqr) const {
+  CHECK_NOTNULL(min_distance_sqr);
+  const int num_blocks = static_cast<int>(block_min_x_.size());
+  const double x = point.x();
+  const double y = point.y();
+  // the square distance to the box of a block, no more than to its segments
+  const auto block_distance_sqr = [&](const int block) {
+    const double dx = std::max(
+        {block_min_x_[block] - x, x - block_max_x_[block], 0.0});
+    const double dy = std::max(
+        {block_min_y_[block] - y, y - block_max_y_[block], 0.0});
+    return dx * dx + dy * dy;
+  };
+
+  // the segments of the nearest block first, then of the other blocks not
+  // farther than the nearest segment so far
+  int first_block = 0;
+  double first_block_distance_sqr = kInfinity;
+  for (int block = 0; block < num_blocks; ++block) {
+    const double distance_sqr = block_distance_sqr(block);
+    if (distance_sqr < first_block_distance_sqr) {
+      first_block_distance_sqr = distance_sqr;
+      first_block = block;
+    }
+  }
+  int nearest = Scan(x, y, first_block * kBlockSize,
+                     std::min(size(), (first_block + 1) * kBlockSize),
+                     nullptr, min_distance_sqr);
+  for (int block = 0; block < num_blocks; ++block) {
+    if (block == first_block ||
+        block_distance_sqr(block) > *min_distance_sqr) {
+      continue;
+    }
+    double distance_sqr = 0.0;
+    const int index = Scan(x, y, block * kBlockSize,
+                           std::min(size(), (block + 1) * kBlockSize),
+                           nullptr, &distance_sqr);
+    if (distance_sqr < *min_distance_sqr ||
+        (distance_sqr == *min_distance_sqr && index < nearest)) {
+      *min_distance_sqr = distance_sqr;
+      nearest = index;
+    }
+  }
+  return nearest;
+}
+
+void SegmentArrays::NearestSegments(const std::vector<Vec2d>& points,
+                                    const bool use_blocks,
+                                    std::vector<int>* indices,
+                                    std::vector<double>* min_distance_sqrs)
+    const {
+  CHECK_NOTNULL(indices);
+  CHECK_NOTNULL(min_distance_sqrs);
+  const size_t num_points = points.size();
+  indices->resize(num_points);
+  min_distance_sqrs->resize(num_points);
+  for (size_t k = 0; k < num_points; ++k) {
+    (*indices)[k] =
+        use_blocks
+            ? NearestSegment(points[k], &(*min_distance_sqrs)[k])
+            : Scan(points[k].x(), points[k].y(), 0, size(), nullptr,
+                   &(*min_distance_sqrs)[k]);
+  }
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The line segments of a path as one array per field.
+ *
+ * Finding the segment nearest to a point is the inner loop of projecting onto
+ * a path. Here the distances to the segments are computed four at a time with
+ * AVX2, two at a time with SSE4.1, or one at a time on CPUs with neither, and
+ * all of them give the values of LineSegment2d::DistanceSquareTo. The kernel
+ * is chosen at run time, the build targets the baseline CPU. The segments are
+ * also grouped in blocks with a bounding box, so that a point far from a block
+ * does not visit its segments.
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace hdmap {
+
+class SegmentArrays {
+ public:
+  /**
+   * @brief The kernels computing the distances, from the narrowest.
+   */
+  enum class Kernel { kScalar, kSse41, kAvx2 };
+
+  SegmentArrays() = default;
+  explicit SegmentArrays(
+      const std::vector<common::math::LineSegment2d>& segments);
+
+  int size() const { return static_cast<int>(length_.size()); }
+
+  /**
+   * @brief The widest kernel the CPU supports, found once per process. It is
+   * the kernel of a new object.
+   */
+  static Kernel BestKernel();
+  static bool IsSupported(const Kernel kernel);
+
+  Kernel kernel() const { return kernel_; }
+
+  /**
+   * @brief Computes the distances with kernel, for tests and benchmarks.
+   * @return false, keeping the kernel, if the CPU does not support it.
+   */
+  bool set_kernel(const Kernel kernel);
+
+  /**
+   * @brief Computes the square distance of point to every segment.
+   * @return the index of the first nearest segment, or 0 if there is none.
+   */
+  int DistanceSquares(const common::math::Vec2d& point,
+                      std::vector<double>* distance_sqrs) const;
+
+  /**
+   * @brief Finds the first nearest segment to point among the segments
+   * [begin, end), by visiting them all.
+   * @return the index of the segment, or begin if there is none.
+   */
+  int NearestSegment(const common::math::Vec2d& point, const int begin,
+                     const int end, double* min_distance_sqr) const;
+
+  /**
+   * @brief Finds the first nearest segment to point, visiting only the blocks
+   * whose bounding box is not farther than the nearest segment found so far.
+   * It finds the segment that visiting them all would.
+   * @return the index of the segment, or 0 if there is none.
+   */
+  int NearestSegment(const common::math::Vec2d& point,
+                     double* min_distance_sqr) const;
+
+  /**
+   * @brief Finds the first nearest segment to each of points.
+   * @param use_blocks whether to skip the blocks far from a point, as the
+   * NearestSegment without a range does.
+   */
+  void NearestSegments(const std::vector<common::math::Vec2d>& points,
+                       const bool use_blocks, std::vector<int>* indices,
+                       std::vector<double>* min_distance_sqrs) const;
+
+ private:
+  // The nearest of the segments [begin, end) as NearestSegment, also storing
+  // the square distance of segment i at distance_sqrs[i] if it is not null.
+  int Scan(const double x, const double y, const int begin, const int end,
+           double* distance_sqrs, double* min_distance_sqr) const;
+
+  void InitBlocks();
+
+  Kernel kernel_ = BestKernel();
+
+  // A degenerate segment has a unit direction of zero, which makes its
+  // distance the one to its start.
+  std::vector<double> start_x_;
+  std::vector<double> start_y_;
+  std::vector<double> end_x_;
+  std::vector<double> end_y_;
+  std::vector<double> unit_x_;
+  std::vector<double> unit_y_;
+  std::vector<double> length_;
+
+  // The bounding box of the segments of each block.
+  std::vector<double> block_min_x_;
+  std::vector<double> block_min_y_;
+  std::vector<double> block_max_x_;
+  std::vector<double> block_max_y_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
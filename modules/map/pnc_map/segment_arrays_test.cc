@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/pnc_map/segment_arrays.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+double RandomDouble(double s, double t) {
+  return s + (t - s) / 16383.0 * (rand() & 16383);  // NOLINT
+}
+
+// a polyline of random steps, with a few steps of zero length
+std::vector<LineSegment2d> RandomSegments(const int num_segments) {
+  std::vector<LineSegment2d> segments;
+  Vec2d start(0.0, 0.0);
+  for (int i = 0; i < num_segments; ++i) {
+    const Vec2d end = i % 7 == 3 ? start
+                                 : start + Vec2d(RandomDouble(-1.0, 3.0),
+                                                 RandomDouble(-2.0, 2.0));
+    segments.emplace_back(start, end);
+    start = end;
+  }
+  return segments;
+}
+
+// the first nearest segment of [begin, end), as path.cc used to find it
+int NearestByScan(const std::vector<LineSegment2d>& segments,
+                  const Vec2d& point, const int begin, const int end,
+                  double* min_distance_sqr) {
+  *min_distance_sqr = std::numeric_limits<double>::infinity();
+  int nearest = begin;
+  for (int i = begin; i < end; ++i) {
+    const double distance_sqr = segments[i].DistanceSquareTo(point);
+    if (distance_sqr < *min_distance_sqr) {
+      *min_distance_sqr = distance_sqr;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+// the kernels this CPU runs
+std::vector<SegmentArrays::Kernel> SupportedKernels() {
+  std::vector<SegmentArrays::Kernel> kernels;
+  for (const auto kernel :
+       {SegmentArrays::Kernel::kScalar, SegmentArrays::Kernel::kSse41,
+        SegmentArrays::Kernel::kAvx2}) {
+    if (SegmentArrays::IsSupported(kernel)) {
+      kernels.push_back(kernel);
+    }
+  }
+  return kernels;
+}
+
+}  // namespace
+
+TEST(SegmentArraysTest, Kernels) {
+  EXPECT_TRUE(SegmentArrays::IsSupported(SegmentArrays::Kernel::kScalar));
+  EXPECT_TRUE(SegmentArrays::IsSupported(SegmentArrays::BestKernel()));
+  SegmentArrays segment_arrays;
+  EXPECT_EQ(segment_arrays.kernel(), SegmentArrays::BestKernel());
+  EXPECT_TRUE(segment_arrays.set_kernel(SegmentArrays::Kernel::kScalar));
+  EXPECT_EQ(segment_arrays.kernel(), SegmentArrays::Kernel::kScalar);
+}
+
+TEST(SegmentArraysTest, DistanceSquares) {
+  const auto segments = RandomSegments(101);
+  SegmentArrays segment_arrays(segments);
+  ASSERT_EQ(segment_arrays.size(), 101);
+
+  std::vector<Vec2d> points = {segments[0].start(), segments[3].end(),
+                               segments[100].end()};
+  for (int k = 0; k < 200; ++k) {
+    points.emplace_back(RandomDouble(-10.0, 200.0), RandomDouble(-50.0, 50.0));
+  }
+  std::vector<double> distance_sqrs;
+  for (const auto kernel : SupportedKernels()) {
+    ASSERT_TRUE(segment_arrays.set_kernel(kernel));
+    for (const auto& point : points) {
+      const int nearest =
+          segment_arrays.DistanceSquares(point, &distance_sqrs);
+      ASSERT_EQ(distance_sqrs.size(), segments.size());
+      for (size_t i = 0; i < segments.size(); ++i) {
+        EXPECT_EQ(distance_sqrs[i], segments[i].DistanceSquareTo(point));
+      }
+      double min_distance_sqr = 0.0;
+      EXPECT_EQ(nearest, NearestByScan(segments, point, 0, 101,
+                                       &min_distance_sqr));
+    }
+  }
+}
+
+TEST(SegmentArraysTest, NearestSegment) {
+  // the segments twice, so that every distance is tied
+  auto segments = RandomSegments(150);
+  const auto twice = segments;
+  segments.insert(segments.end(), twice.begin(), twice.end());
+  SegmentArrays segment_arrays(segments);
+
+  for (int k = 0; k < 500; ++k) {
+    ASSERT_TRUE(segment_arrays.set_kernel(
+        SupportedKernels()[k % SupportedKernels().size()]));
+    const Vec2d point(RandomDouble(-10.0, 300.0), RandomDouble(-80.0, 80.0));
+    double expected_distance_sqr = 0.0;
+    const int expected = NearestByScan(segments, point, 0, 300,
+                                       &expected_distance_sqr);
+    EXPECT_LT(expected, 150);
+
+    double min_distance_sqr = 0.0;
+    EXPECT_EQ(segment_arrays.NearestSegment(point, &min_distance_sqr),
+              expected);
+    EXPECT_EQ(min_distance_sqr, expected_distance_sqr);
+    EXPECT_EQ(segment_arrays.NearestSegment(point, 0, 300, &min_distance_sqr),
+              expected);
+    EXPECT_EQ(min_distance_sqr, expected_distance_sqr);
+
+    const int begin = k % 50;
+    const int end = 301 - k % 70;
+    EXPECT_EQ(
+        segment_arrays.NearestSegment(point, begin, end, &min_distance_sqr),
+        NearestByScan(segments, point, begin, end, &expected_distance_sqr));
+    EXPECT_EQ(min_distance_sqr, expected_distance_sqr);
+  }
+
+  double min_distance_sqr = 0.0;
+  EXPECT_EQ(segment_arrays.NearestSegment({0.0, 0.0}, 7, 7, &min_distance_sqr),
+            7);
+  EXPECT_EQ(SegmentArrays().NearestSegment({0.0, 0.0}, &min_distance_sqr), 0);
+}
+
+TEST(SegmentArraysTest, NearestSegments) {
+  const auto segments = RandomSegments(333);
+  const SegmentArrays segment_arrays(segments);
+  std::vector<Vec2d> points;
+  for (int k = 0; k < 300; ++k) {
+    points.emplace_back(RandomDouble(-10.0, 400.0), RandomDouble(-80.0, 80.0));
+  }
+
+  for (const bool use_blocks : {false, true}) {
+    std::vector<int> indices;
+    std::vector<double> min_distance_sqrs;
+    segment_arrays.NearestSegments(points, use_blocks, &indices,
+                                   &min_distance_sqrs);
+    ASSERT_EQ(indices.size(), points.size());
+    ASSERT_EQ(min_distance_sqrs.size(), points.size());
+    for (size_t k = 0; k < points.size(); ++k) {
+      double expected_distance_sqr = 0.0;
+      EXPECT_EQ(indices[k], NearestByScan(segments, points[k], 0, 333,
+                                          &expected_distance_sqr));
+      EXPECT_EQ(min_distance_sqrs[k], expected_distance_sqr);
+    }
+  }
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -57,6 +57,12 @@ namespace planning {
  * @class Frame
  *
  * @brief Frame holds all data for one planning cycle.
+ *
+ * While the reference lines are planned at the same time (see
+ * FLAGS_enable_parallel_reference_line_planning), the frame is read only to
+ * the tasks and each of them only changes the ReferenceLineInfo it runs on.
+ * Tasks that change the frame, such as reordering the reference lines, are
+ * not reference line local and run while no other line is planned.
  */
 
 class Frame {
@@ -92,6 +98,10 @@ class Frame {
   void RecordInputDebug(planning_internal::Debug *debug);
 
   const std::list<ReferenceLineInfo> &reference_line_info() const;
+  /**
+   * @brief The list may be reordered but its elements are never moved, so
+   * the address of a ReferenceLineInfo is stable for the whole cycle.
+   */
   std::list<ReferenceLineInfo> *mutable_reference_line_info();
 
   Obstacle *Find(const std::string &id);
@@ -16,9 +16,54 @@
 
 #include "modules/planning/common/planning_context.h"
 
+#include "cyber/croutine/croutine.h"
+
 namespace apollo {
 namespace planning {
 
+using apollo::cyber::croutine::CRoutine;
+
+PlanningContext::ScopedStatus::ScopedStatus(PlanningStatus* status)
+    : owner_(CurrentOwner()), previous_(nullptr) {
+  auto* context = PlanningContext::Instance();
+  std::lock_guard<std::mutex> lock(context->scoped_mutex_);
+  auto& scoped = context->scoped_status_[owner_];
+  previous_ = scoped;
+  scoped = status;
+  ++context->scoped_num_;
+}
+
+PlanningContext::ScopedStatus::~ScopedStatus() {
+  auto* context = PlanningContext::Instance();
+  std::lock_guard<std::mutex> lock(context->scoped_mutex_);
+  if (previous_ == nullptr) {
+    context->scoped_status_.erase(owner_);
+  } else {
+    context->scoped_status_[owner_] = previous_;
+  }
+  --context->scoped_num_;
+}
+
+const void* PlanningContext::CurrentOwner() {
+  // a croutine may resume on another thread, so it is the owner when there is
+  // one
+  const void* routine = CRoutine::GetCurrentRoutine();
+  if (routine != nullptr) {
+    return routine;
+  }
+  static thread_local char thread_owner = 0;
+  return &thread_owner;
+}
+
+PlanningStatus* PlanningContext::CurrentStatus() {
+  if (scoped_num_.load(std::memory_order_acquire) == 0) {
+    return &planning_status_;
+  }
+  std::lock_guard<std::mutex> lock(scoped_mutex_);
+  auto iter = scoped_status_.find(CurrentOwner());
+  return iter == scoped_status_.end() ? &planning_status_ : iter->second;
+}
+
 PlanningContext::PlanningContext() {}
 
 void PlanningContext::Init() {}
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include "cyber/common/macros.h"
 
 #include "modules/planning/proto/planning_status.pb.h"
@@ -33,6 +37,26 @@ namespace planning {
 
 class PlanningContext {
  public:
+  /**
+   * @brief While alive, planning_status() and mutable_planning_status() return
+   * status instead of the shared status in the croutine, or the thread if it
+   * is not a croutine, that created it. This is how reference lines planned at
+   * the same time keep their own status. Jobs that the owner hands to other
+   * threads still see the shared status.
+   */
+  class ScopedStatus {
+   public:
+    explicit ScopedStatus(PlanningStatus* status);
+    ~ScopedStatus();
+
+   private:
+    const void* owner_;
+    PlanningStatus* previous_;
+
+    ScopedStatus(const ScopedStatus&) = delete;
+    ScopedStatus& operator=(const ScopedStatus&) = delete;
+  };
+
   void Clear();
   void Init();
 
@@ -40,12 +64,20 @@ class PlanningContext {
    * please put all status info inside PlanningStatus for easy maintenance.
    * do NOT create new struct at this level.
    * */
-  const PlanningStatus& planning_status() { return planning_status_; }
-  PlanningStatus* mutable_planning_status() { return &planning_status_; }
+  const PlanningStatus& planning_status() { return *CurrentStatus(); }
+  PlanningStatus* mutable_planning_status() { return CurrentStatus(); }
 
  private:
+  static const void* CurrentOwner();
+  PlanningStatus* CurrentStatus();
+
   PlanningStatus planning_status_;
 
+  // scoped status of each owner, scoped_num_ skips the lookup when empty
+  std::atomic<int> scoped_num_{0};
+  std::mutex scoped_mutex_;
+  std::unordered_map<const void*, PlanningStatus*> scoped_status_;
+
   // this is a singleton class
   DECLARE_SINGLETON(PlanningContext)
 };
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_context.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+int LaneChangeFailures() {
+  return PlanningContext::Instance()
+      ->planning_status()
+      .path_reuse_decider()
+      .lane_change_failure_counter();
+}
+
+void SetLaneChangeFailures(int value) {
+  PlanningContext::Instance()
+      ->mutable_planning_status()
+      ->mutable_path_reuse_decider()
+      ->set_lane_change_failure_counter(value);
+}
+
+}  // namespace
+
+TEST(PlanningContextTest, ScopedStatus) {
+  PlanningContext::Instance()->Clear();
+  SetLaneChangeFailures(1);
+
+  PlanningStatus status;
+  {
+    PlanningContext::ScopedStatus scoped_status(&status);
+    EXPECT_EQ(LaneChangeFailures(), 0);
+    SetLaneChangeFailures(2);
+
+    PlanningStatus inner_status;
+    {
+      PlanningContext::ScopedStatus inner_scoped_status(&inner_status);
+      SetLaneChangeFailures(3);
+    }
+    EXPECT_EQ(LaneChangeFailures(), 2);
+    EXPECT_EQ(inner_status.path_reuse_decider().lane_change_failure_counter(),
+              3);
+  }
+  EXPECT_EQ(LaneChangeFailures(), 1);
+  EXPECT_EQ(status.path_reuse_decider().lane_change_failure_counter(), 2);
+}
+
+TEST(PlanningContextTest, ScopedStatusOfEachThread) {
+  PlanningContext::Instance()->Clear();
+  SetLaneChangeFailures(-1);
+
+  const int thread_num = 4;
+  std::vector<PlanningStatus> statuses(thread_num);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_num; ++i) {
+    threads.emplace_back([i, &statuses]() {
+      PlanningContext::ScopedStatus scoped_status(&statuses[i]);
+      for (int j = 0; j < 1000; ++j) {
+        SetLaneChangeFailures(LaneChangeFailures() + i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(LaneChangeFailures(), -1);
+  for (int i = 0; i < thread_num; ++i) {
+    EXPECT_EQ(statuses[i].path_reuse_decider().lane_change_failure_counter(),
+              1000 * i);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -154,6 +154,7 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_parallel_reference_line_planning);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
@@ -229,6 +230,7 @@ DECLARE_bool(enable_parallel_trajectory_smoothing);
 
 DECLARE_bool(use_osqp_optimizer_for_reference_line);
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_persistent_osqp_solver);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
 
@@ -32,6 +32,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 
 namespace apollo {
 namespace planning {
@@ -409,13 +410,15 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
   if (FLAGS_use_multi_thread_to_add_obstacles) {
-    std::vector<std::future<Obstacle*>> results;
-    for (const auto* obstacle : obstacles) {
-      results.push_back(
-          cyber::Async(&ReferenceLineInfo::AddObstacle, this, obstacle));
-    }
-    for (auto& result : results) {
-      if (!result.get()) {
+    std::vector<Obstacle*> results(obstacles.size(), nullptr);
+    // a static obstacle takes a few microseconds and a predicted one more,
+    // pairs keep the claims cheap and still spread the predicted ones
+    cyber::ParallelFor(size_t(0), obstacles.size(), size_t(2),
+                       [this, &obstacles, &results](size_t i) {
+                         results[i] = AddObstacle(obstacles[i]);
+                       });
+    for (const auto* result : results) {
+      if (!result) {
         AERROR << "Fail to add obstacles.";
         return false;
       }
@@ -515,29 +518,42 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     return false;
   }
 
+  std::vector<double> relative_times;
   for (double cur_rel_time = 0.0; cur_rel_time < speed_data_.TotalTime();
        cur_rel_time += (cur_rel_time < kDenseTimeSec ? kDenseTimeResoltuion
                                                      : kSparseTimeResolution)) {
-    common::SpeedPoint speed_point;
-    if (!speed_data_.EvaluateByTime(cur_rel_time, &speed_point)) {
-      AERROR << "Fail to get speed point with relative time " << cur_rel_time;
-      return false;
-    }
+    relative_times.push_back(cur_rel_time);
+  }
 
-    if (speed_point.s() > path_data_.discretized_path().Length()) {
-      break;
-    }
-    common::PathPoint path_point =
-        path_data_.GetPathPointWithPathS(speed_point.s());
-    path_point.set_s(path_point.s() + start_s);
+  // the profile and the path are evaluated as arrays, only the trajectory
+  // points are built as protobuf messages
+  SpeedArrays speed_points;
+  if (!SpeedArrays(speed_data_).EvaluateByTime(relative_times, &speed_points)) {
+    AERROR << "Fail to get speed points up to relative time "
+           << relative_times.back();
+    return false;
+  }
 
-    common::TrajectoryPoint trajectory_point;
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(speed_point.v());
-    trajectory_point.set_a(speed_point.a());
-    trajectory_point.set_relative_time(speed_point.t() + relative_time);
-    ptr_discretized_trajectory->AppendTrajectoryPoint(trajectory_point);
+  const double path_length = path_data_.discretized_path().Length();
+  const auto path_end = std::find_if(
+      speed_points.s.begin(), speed_points.s.end(),
+      [path_length](const double s) { return s > path_length; });
+  const std::vector<double> path_s(speed_points.s.begin(), path_end);
+
+  TrajectoryArrays trajectory;
+  PathArrays(path_data_.discretized_path()).Evaluate(path_s, &trajectory.path);
+  for (auto& s : trajectory.path.s) {
+    s += start_s;
+  }
+  trajectory.v.assign(speed_points.v.begin(),
+                      speed_points.v.begin() + path_s.size());
+  trajectory.a.assign(speed_points.a.begin(),
+                      speed_points.a.begin() + path_s.size());
+  trajectory.relative_time.resize(path_s.size());
+  for (size_t i = 0; i < path_s.size(); ++i) {
+    trajectory.relative_time[i] = speed_points.t[i] + relative_time;
   }
+  trajectory.AppendTo(ptr_discretized_trajectory);
   return true;
 }
 
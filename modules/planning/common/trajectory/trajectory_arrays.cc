@@ -0,0 +1,316 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/linear_interpolation.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::SpeedPoint;
+using apollo::common::TrajectoryPoint;
+
+namespace {
+
+// below this span of time common::math::lerp takes the first value
+constexpr double kMinTimeSpan = 1.0e-6;
+
+// The segment of each query in sorted keys: the value at query k is
+// interpolated between the points lower[k] and upper[k], with the weight
+// weight[k] of the upper one. Out of the keys both are the nearest point.
+struct Segments {
+  std::vector<size_t> lower;
+  std::vector<size_t> upper;
+  std::vector<double> weight;
+};
+
+// Finds the std::lower_bound of every query by one forward sweep over the
+// keys, a query smaller than the one before it is searched for again.
+void FindSegments(const std::vector<double>& keys,
+                  const std::vector<double>& queries, const double min_span,
+                  Segments* segments) {
+  const size_t num_keys = keys.size();
+  const size_t num_queries = queries.size();
+  segments->lower.resize(num_queries);
+  segments->upper.resize(num_queries);
+  segments->weight.resize(num_queries);
+
+  size_t bound = 0;
+  for (size_t k = 0; k < num_queries; ++k) {
+    const double query = queries[k];
+    if (k > 0 && query < queries[k - 1]) {
+      bound = std::lower_bound(keys.begin(), keys.end(), query) - keys.begin();
+    } else {
+      while (bound < num_keys && keys[bound] < query) {
+        ++bound;
+      }
+    }
+
+    if (bound == 0 || bound == num_keys) {
+      const size_t nearest = bound == 0 ? 0 : num_keys - 1;
+      segments->lower[k] = nearest;
+      segments->upper[k] = nearest;
+      segments->weight[k] = 0.0;
+      continue;
+    }
+    const double span = keys[bound] - keys[bound - 1];
+    segments->lower[k] = bound - 1;
+    segments->upper[k] = bound;
+    segments->weight[k] =
+        span <= min_span ? 0.0 : (query - keys[bound - 1]) / span;
+  }
+}
+
+// the values at the segments as x0 + w * (x1 - x0), as common::math::lerp
+void Lerp(const std::vector<double>& values, const Segments& segments,
+          std::vector<double>* result) {
+  const size_t size = segments.weight.size();
+  result->resize(size);
+  const size_t* lower = segments.lower.data();
+  const size_t* upper = segments.upper.data();
+  const double* weight = segments.weight.data();
+  double* out = result->data();
+  for (size_t k = 0; k < size; ++k) {
+    const double x0 = values[lower[k]];
+    out[k] = x0 + weight[k] * (values[upper[k]] - x0);
+  }
+}
+
+// the values at the segments as (1 - w) * x0 + w * x1, as
+// common::math::InterpolateUsingLinearApproximation does for path points
+void WeightedSum(const std::vector<double>& values, const Segments& segments,
+                 std::vector<double>* result) {
+  const size_t size = segments.weight.size();
+  result->resize(size);
+  const size_t* lower = segments.lower.data();
+  const size_t* upper = segments.upper.data();
+  const double* weight = segments.weight.data();
+  double* out = result->data();
+  for (size_t k = 0; k < size; ++k) {
+    out[k] =
+        (1.0 - weight[k]) * values[lower[k]] + weight[k] * values[upper[k]];
+  }
+}
+
+// the query inside the keys, the key of the nearest point out of them
+void Keys(const std::vector<double>& keys, const std::vector<double>& queries,
+          const Segments& segments, std::vector<double>* result) {
+  const size_t size = queries.size();
+  result->resize(size);
+  for (size_t k = 0; k < size; ++k) {
+    (*result)[k] = segments.lower[k] == segments.upper[k]
+                       ? keys[segments.lower[k]]
+                       : queries[k];
+  }
+}
+
+void Angles(const std::vector<double>& angles, const std::vector<double>& keys,
+            const std::vector<double>& queries, const Segments& segments,
+            std::vector<double>* result) {
+  const size_t size = queries.size();
+  result->resize(size);
+  for (size_t k = 0; k < size; ++k) {
+    const size_t lower = segments.lower[k];
+    const size_t upper = segments.upper[k];
+    (*result)[k] = lower == upper
+                       ? angles[lower]
+                       : common::math::slerp(angles[lower], keys[lower],
+                                             angles[upper], keys[upper],
+                                             queries[k]);
+  }
+}
+
+}  // namespace
+
+PathArrays::PathArrays(const std::vector<PathPoint>& path_points) {
+  resize(path_points.size());
+  for (size_t i = 0; i < path_points.size(); ++i) {
+    const auto& point = path_points[i];
+    s[i] = point.s();
+    x[i] = point.x();
+    y[i] = point.y();
+    theta[i] = point.theta();
+    kappa[i] = point.kappa();
+    dkappa[i] = point.dkappa();
+    ddkappa[i] = point.ddkappa();
+  }
+}
+
+void PathArrays::clear() { resize(0); }
+
+void PathArrays::resize(const size_t size) {
+  s.resize(size);
+  x.resize(size);
+  y.resize(size);
+  theta.resize(size);
+  kappa.resize(size);
+  dkappa.resize(size);
+  ddkappa.resize(size);
+}
+
+void PathArrays::Evaluate(const std::vector<double>& path_s,
+                          PathArrays* path) const {
+  CHECK_GT(size(), 0U);
+  CHECK_NOTNULL(path);
+  Segments segments;
+  FindSegments(s, path_s, 0.0, &segments);
+  Keys(s, path_s, segments, &path->s);
+  WeightedSum(x, segments, &path->x);
+  WeightedSum(y, segments, &path->y);
+  Angles(theta, s, path_s, segments, &path->theta);
+  WeightedSum(kappa, segments, &path->kappa);
+  WeightedSum(dkappa, segments, &path->dkappa);
+  WeightedSum(ddkappa, segments, &path->ddkappa);
+}
+
+SpeedArrays::SpeedArrays(const std::vector<SpeedPoint>& speed_points) {
+  resize(speed_points.size());
+  for (size_t i = 0; i < speed_points.size(); ++i) {
+    const auto& point = speed_points[i];
+    t[i] = point.t();
+    s[i] = point.s();
+    v[i] = point.v();
+    a[i] = point.a();
+    da[i] = point.da();
+  }
+}
+
+void SpeedArrays::clear() { resize(0); }
+
+void SpeedArrays::resize(const size_t size) {
+  t.resize(size);
+  s.resize(size);
+  v.resize(size);
+  a.resize(size);
+  da.resize(size);
+}
+
+bool SpeedArrays::EvaluateByTime(const std::vector<double>& times,
+                                 SpeedArrays* speed) const {
+  CHECK_NOTNULL(speed);
+  if (size() < 2) {
+    speed->clear();
+    speed->resize(times.size());
+    return times.empty();
+  }
+
+  Segments segments;
+  FindSegments(t, times, kMinTimeSpan, &segments);
+  Keys(t, times, segments, &speed->t);
+  Lerp(s, segments, &speed->s);
+  Lerp(v, segments, &speed->v);
+  Lerp(a, segments, &speed->a);
+  Lerp(da, segments, &speed->da);
+
+  bool evaluated = true;
+  for (size_t k = 0; k < times.size(); ++k) {
+    if (t.front() < times[k] + 1.0e-6 && times[k] - 1.0e-6 < t.back()) {
+      continue;
+    }
+    speed->t[k] = 0.0;
+    speed->s[k] = 0.0;
+    speed->v[k] = 0.0;
+    speed->a[k] = 0.0;
+    speed->da[k] = 0.0;
+    evaluated = false;
+  }
+  return evaluated;
+}
+
+TrajectoryArrays::TrajectoryArrays(
+    const std::vector<TrajectoryPoint>& trajectory_points) {
+  resize(trajectory_points.size());
+  for (size_t i = 0; i < trajectory_points.size(); ++i) {
+    const auto& point = trajectory_points[i];
+    const auto& path_point = point.path_point();
+    relative_time[i] = point.relative_time();
+    path.s[i] = path_point.s();
+    path.x[i] = path_point.x();
+    path.y[i] = path_point.y();
+    path.theta[i] = path_point.theta();
+    path.kappa[i] = path_point.kappa();
+    path.dkappa[i] = path_point.dkappa();
+    path.ddkappa[i] = path_point.ddkappa();
+    v[i] = point.v();
+    a[i] = point.a();
+  }
+}
+
+void TrajectoryArrays::clear() { resize(0); }
+
+void TrajectoryArrays::resize(const size_t size) {
+  relative_time.resize(size);
+  path.resize(size);
+  v.resize(size);
+  a.resize(size);
+}
+
+void TrajectoryArrays::Evaluate(const std::vector<double>& relative_times,
+                                TrajectoryArrays* trajectory) const {
+  CHECK_GT(size(), 0U);
+  CHECK_NOTNULL(trajectory);
+  Segments segments;
+  FindSegments(relative_time, relative_times, kMinTimeSpan, &segments);
+  Keys(relative_time, relative_times, segments, &trajectory->relative_time);
+  Lerp(path.s, segments, &trajectory->path.s);
+  Lerp(path.x, segments, &trajectory->path.x);
+  Lerp(path.y, segments, &trajectory->path.y);
+  Angles(path.theta, relative_time, relative_times, segments,
+         &trajectory->path.theta);
+  Lerp(path.kappa, segments, &trajectory->path.kappa);
+  Lerp(path.dkappa, segments, &trajectory->path.dkappa);
+  Lerp(path.ddkappa, segments, &trajectory->path.ddkappa);
+  Lerp(v, segments, &trajectory->v);
+  Lerp(a, segments, &trajectory->a);
+}
+
+void TrajectoryArrays::AppendTo(DiscretizedTrajectory* trajectory) const {
+  CHECK_NOTNULL(trajectory);
+  trajectory->reserve(trajectory->size() + size());
+  for (size_t i = 0; i < size(); ++i) {
+    TrajectoryPoint point;
+    auto* path_point = point.mutable_path_point();
+    path_point->set_s(path.s[i]);
+    path_point->set_x(path.x[i]);
+    path_point->set_y(path.y[i]);
+    path_point->set_theta(path.theta[i]);
+    path_point->set_kappa(path.kappa[i]);
+    path_point->set_dkappa(path.dkappa[i]);
+    path_point->set_ddkappa(path.ddkappa[i]);
+    point.set_v(v[i]);
+    point.set_a(a[i]);
+    point.set_relative_time(relative_time[i]);
+    trajectory->AppendTrajectoryPoint(point);
+  }
+}
+
+DiscretizedTrajectory TrajectoryArrays::ToDiscretizedTrajectory() const {
+  DiscretizedTrajectory trajectory;
+  AppendTo(&trajectory);
+  return trajectory;
+}
+
+}  // namespace planning
+}  // namespace apollo
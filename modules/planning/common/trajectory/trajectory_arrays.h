@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Paths, speed profiles and trajectories as one array per field.
+ *
+ * DiscretizedPath, SpeedData and DiscretizedTrajectory hold protobuf
+ * messages, so each evaluation builds a message. The arrays here are
+ * evaluated at many queries at once: the segments of all the queries are
+ * found in one sweep, then each field is interpolated by a loop of its own.
+ * They are meant for the inner loops of planning and are converted from and
+ * to the protobuf containers once, outside of those loops.
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @brief Path points sorted by s, as in DiscretizedPath.
+ */
+struct PathArrays {
+  PathArrays() = default;
+  explicit PathArrays(const std::vector<common::PathPoint>& path_points);
+
+  size_t size() const { return s.size(); }
+  void clear();
+  void resize(const size_t size);
+
+  /**
+   * @brief Evaluates the path at each of path_s, as DiscretizedPath::Evaluate
+   * does for one. The queries are found fastest in increasing order.
+   */
+  void Evaluate(const std::vector<double>& path_s, PathArrays* path) const;
+
+  std::vector<double> s;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> theta;
+  std::vector<double> kappa;
+  std::vector<double> dkappa;
+  std::vector<double> ddkappa;
+};
+
+/**
+ * @brief Speed points sorted by t, as in SpeedData.
+ */
+struct SpeedArrays {
+  SpeedArrays() = default;
+  explicit SpeedArrays(const std::vector<common::SpeedPoint>& speed_points);
+
+  size_t size() const { return t.size(); }
+  void clear();
+  void resize(const size_t size);
+
+  /**
+   * @brief Evaluates the profile at each of times, as SpeedData::EvaluateByTime
+   * does for one. A time it fails at gets a point of zeros. v, a and da are
+   * interpolated also when a protobuf point did not have them.
+   * @return false if the profile could not be evaluated at one of the times.
+   */
+  bool EvaluateByTime(const std::vector<double>& times,
+                      SpeedArrays* speed) const;
+
+  std::vector<double> t;
+  std::vector<double> s;
+  std::vector<double> v;
+  std::vector<double> a;
+  std::vector<double> da;
+};
+
+/**
+ * @brief Trajectory points sorted by relative time, as in
+ * DiscretizedTrajectory. The steer and da of the points are not kept.
+ */
+struct TrajectoryArrays {
+  TrajectoryArrays() = default;
+  explicit TrajectoryArrays(
+      const std::vector<common::TrajectoryPoint>& trajectory_points);
+
+  size_t size() const { return relative_time.size(); }
+  void clear();
+  void resize(const size_t size);
+
+  /**
+   * @brief Evaluates the trajectory at each of relative_times, as
+   * DiscretizedTrajectory::Evaluate does for one. The queries are found
+   * fastest in increasing order.
+   */
+  void Evaluate(const std::vector<double>& relative_times,
+                TrajectoryArrays* trajectory) const;
+
+  /**
+   * @brief Appends the points to trajectory as protobuf messages.
+   */
+  void AppendTo(DiscretizedTrajectory* trajectory) const;
+
+  DiscretizedTrajectory ToDiscretizedTrajectory() const;
+
+  std::vector<double> relative_time;
+  PathArrays path;
+  std::vector<double> v;
+  std::vector<double> a;
+};
+
+}  // namespace planning
+}  // namespace apollo
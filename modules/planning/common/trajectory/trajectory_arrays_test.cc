@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/point_factory.h"
+#include "modules/planning/common/path/discretized_path.h"
+#include "modules/planning/common/speed/speed_data.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::SpeedPoint;
+using apollo::common::TrajectoryPoint;
+using apollo::common::util::PointFactory;
+
+namespace {
+
+// an arc, with the heading crossing pi between two points
+DiscretizedPath ArcPath() {
+  std::vector<PathPoint> path_points;
+  for (int i = 0; i < 20; ++i) {
+    const double s = 0.5 * i;
+    PathPoint point = PointFactory::ToPathPoint(
+        std::cos(0.1 * s), std::sin(0.1 * s), 0.0, s);
+    point.set_theta(std::remainder(M_PI - 0.5 + 0.1 * s, 2.0 * M_PI));
+    point.set_kappa(0.1 + 0.01 * i);
+    point.set_dkappa(0.02 * i);
+    point.set_ddkappa(-0.001 * i);
+    path_points.push_back(point);
+  }
+  return DiscretizedPath(path_points);
+}
+
+SpeedData Profile() {
+  SpeedData speed_data;
+  for (int i = 0; i < 30; ++i) {
+    const double t = 0.1 * i;
+    speed_data.AppendSpeedPoint(2.0 * t + 0.25 * t * t, t, 2.0 + 0.5 * t, 0.5,
+                                0.01 * i);
+  }
+  return speed_data;
+}
+
+DiscretizedTrajectory Trajectory() {
+  const auto path = ArcPath();
+  DiscretizedTrajectory trajectory;
+  for (size_t i = 0; i < path.size(); ++i) {
+    TrajectoryPoint point;
+    point.mutable_path_point()->CopyFrom(path[i]);
+    point.set_v(1.0 + 0.1 * static_cast<double>(i));
+    point.set_a(-0.05 * static_cast<double>(i));
+    point.set_relative_time(0.2 * static_cast<double>(i) - 1.0);
+    trajectory.AppendTrajectoryPoint(point);
+  }
+  return trajectory;
+}
+
+// sorted queries, a few out of the points and a few going back
+std::vector<double> Queries(const double start, const double end) {
+  std::vector<double> queries;
+  const double step = (end - start) / 40.0;
+  for (double query = start - 3.0 * step; query < end + 3.0 * step;
+       query += step) {
+    queries.push_back(query);
+  }
+  queries.push_back(start + 0.5 * (end - start));
+  queries.push_back(start);
+  queries.push_back(end);
+  return queries;
+}
+
+}  // namespace
+
+TEST(TrajectoryArraysTest, PathEvaluate) {
+  const auto discretized_path = ArcPath();
+  const PathArrays path_arrays(discretized_path);
+  ASSERT_EQ(path_arrays.size(), discretized_path.size());
+
+  const auto path_s =
+      Queries(discretized_path.front().s(), discretized_path.back().s());
+  PathArrays path;
+  path_arrays.Evaluate(path_s, &path);
+  ASSERT_EQ(path.size(), path_s.size());
+  for (size_t k = 0; k < path_s.size(); ++k) {
+    const auto expected = discretized_path.Evaluate(path_s[k]);
+    EXPECT_DOUBLE_EQ(path.s[k], expected.s());
+    EXPECT_DOUBLE_EQ(path.x[k], expected.x());
+    EXPECT_DOUBLE_EQ(path.y[k], expected.y());
+    EXPECT_DOUBLE_EQ(path.theta[k], expected.theta());
+    EXPECT_DOUBLE_EQ(path.kappa[k], expected.kappa());
+    EXPECT_DOUBLE_EQ(path.dkappa[k], expected.dkappa());
+    EXPECT_DOUBLE_EQ(path.ddkappa[k], expected.ddkappa());
+  }
+}
+
+TEST(TrajectoryArraysTest, SpeedEvaluateByTime) {
+  const auto speed_data = Profile();
+  const SpeedArrays speed_arrays(speed_data);
+
+  const auto times = Queries(speed_data.front().t(), speed_data.back().t());
+  SpeedArrays speed;
+  EXPECT_FALSE(speed_arrays.EvaluateByTime(times, &speed));
+  ASSERT_EQ(speed.size(), times.size());
+  for (size_t k = 0; k < times.size(); ++k) {
+    SpeedPoint expected;
+    speed_data.EvaluateByTime(times[k], &expected);
+    EXPECT_DOUBLE_EQ(speed.t[k], expected.t());
+    EXPECT_DOUBLE_EQ(speed.s[k], expected.s());
+    EXPECT_DOUBLE_EQ(speed.v[k], expected.v());
+    EXPECT_DOUBLE_EQ(speed.a[k], expected.a());
+    EXPECT_DOUBLE_EQ(speed.da[k], expected.da());
+  }
+
+  EXPECT_TRUE(speed_arrays.EvaluateByTime({0.0, 0.05, 2.9}, &speed));
+  EXPECT_DOUBLE_EQ(speed.s[1], 0.5 * (speed_data[0].s() + speed_data[1].s()));
+  EXPECT_FALSE(SpeedArrays().EvaluateByTime({0.0}, &speed));
+  EXPECT_DOUBLE_EQ(speed.s[0], 0.0);
+}
+
+TEST(TrajectoryArraysTest, TrajectoryEvaluate) {
+  const auto discretized_trajectory = Trajectory();
+  const TrajectoryArrays trajectory_arrays(discretized_trajectory);
+
+  const auto relative_times =
+      Queries(discretized_trajectory.front().relative_time(),
+              discretized_trajectory.back().relative_time());
+  TrajectoryArrays trajectory;
+  trajectory_arrays.Evaluate(relative_times, &trajectory);
+  ASSERT_EQ(trajectory.size(), relative_times.size());
+  for (size_t k = 0; k < relative_times.size(); ++k) {
+    const auto expected = discretized_trajectory.Evaluate(relative_times[k]);
+    EXPECT_DOUBLE_EQ(trajectory.relative_time[k], expected.relative_time());
+    EXPECT_DOUBLE_EQ(trajectory.path.s[k], expected.path_point().s());
+    EXPECT_DOUBLE_EQ(trajectory.path.x[k], expected.path_point().x());
+    EXPECT_DOUBLE_EQ(trajectory.path.y[k], expected.path_point().y());
+    EXPECT_DOUBLE_EQ(trajectory.path.theta[k], expected.path_point().theta());
+    EXPECT_DOUBLE_EQ(trajectory.path.kappa[k], expected.path_point().kappa());
+    EXPECT_DOUBLE_EQ(trajectory.v[k], expected.v());
+    EXPECT_DOUBLE_EQ(trajectory.a[k], expected.a());
+  }
+}
+
+TEST(TrajectoryArraysTest, ToDiscretizedTrajectory) {
+  const auto discretized_trajectory = Trajectory();
+  const auto converted =
+      TrajectoryArrays(discretized_trajectory).ToDiscretizedTrajectory();
+  ASSERT_EQ(converted.size(), discretized_trajectory.size());
+  for (size_t i = 0; i < converted.size(); ++i) {
+    // z is not kept
+    auto expected = discretized_trajectory[i];
+    expected.mutable_path_point()->clear_z();
+    EXPECT_EQ(converted[i].ShortDebugString(), expected.ShortDebugString());
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Measures the evaluation of trajectories, speed profiles and paths at many
+// sorted times, point by point on the protobuf containers and at once on the
+// arrays of trajectory_arrays.h. Every case prints one json object per line
+// with the nanoseconds per query of both, and a checksum of the results so
+// the two can not be optimized away.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/planning/common/path/discretized_path.h"
+#include "modules/planning/common/speed/speed_data.h"
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
+
+DEFINE_int32(points, 200, "points of the trajectory, profile and path");
+DEFINE_int32(queries, 100, "sorted queries per evaluation");
+DEFINE_int32(repeats, 20000, "evaluations per measurement");
+
+namespace {
+
+using apollo::common::PathPoint;
+using apollo::common::SpeedPoint;
+using apollo::common::TrajectoryPoint;
+using apollo::planning::DiscretizedPath;
+using apollo::planning::DiscretizedTrajectory;
+using apollo::planning::PathArrays;
+using apollo::planning::SpeedArrays;
+using apollo::planning::SpeedData;
+using apollo::planning::TrajectoryArrays;
+
+// a curve at 0.1s, 1m apart
+DiscretizedTrajectory MakeTrajectory(const int num_points) {
+  DiscretizedTrajectory trajectory;
+  for (int i = 0; i < num_points; ++i) {
+    const double s = static_cast<double>(i);
+    TrajectoryPoint point;
+    auto* path_point = point.mutable_path_point();
+    path_point->set_s(s);
+    path_point->set_x(50.0 * std::sin(s / 50.0));
+    path_point->set_y(50.0 - 50.0 * std::cos(s / 50.0));
+    path_point->set_theta(s / 50.0);
+    path_point->set_kappa(0.02);
+    point.set_v(10.0);
+    point.set_a(0.1 * std::sin(s));
+    point.set_relative_time(0.1 * s);
+    trajectory.AppendTrajectoryPoint(point);
+  }
+  return trajectory;
+}
+
+SpeedData MakeSpeedData(const DiscretizedTrajectory& trajectory) {
+  SpeedData speed_data;
+  for (const auto& point : trajectory) {
+    speed_data.AppendSpeedPoint(point.path_point().s(), point.relative_time(),
+                                point.v(), point.a(), 0.0);
+  }
+  return speed_data;
+}
+
+DiscretizedPath MakePath(const DiscretizedTrajectory& trajectory) {
+  std::vector<PathPoint> path_points;
+  for (const auto& point : trajectory) {
+    path_points.push_back(point.path_point());
+  }
+  return DiscretizedPath(path_points);
+}
+
+std::vector<double> SortedQueries(const double start, const double end,
+                                  const int num_queries) {
+  std::vector<double> queries;
+  for (int k = 0; k < num_queries; ++k) {
+    queries.push_back(start + (end - start) * k / num_queries);
+  }
+  return queries;
+}
+
+// nanoseconds per query of evaluate, which returns a checksum
+double Measure(const std::function<double()>& evaluate, double* checksum) {
+  *checksum = evaluate();
+  const auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < FLAGS_repeats; ++r) {
+    *checksum += evaluate();
+  }
+  const double elapsed_ns = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+  return elapsed_ns / FLAGS_repeats / FLAGS_queries;
+}
+
+void Report(const char* name, const double proto_ns,
+            const double proto_checksum, const double arrays_ns,
+            const double arrays_checksum) {
+  std::printf(
+      "{\"case\": \"%s\", \"points\": %d, \"queries\": %d, "
+      "\"proto_ns_per_query\": %.2f, \"arrays_ns_per_query\": %.2f, "
+      "\"speedup\": %.2f, \"proto_checksum\": %.6g, "
+      "\"arrays_checksum\": %.6g}\n",
+      name, FLAGS_points, FLAGS_queries, proto_ns, arrays_ns,
+      proto_ns / arrays_ns, proto_checksum, arrays_checksum);
+}
+
+void TrajectoryCase(const DiscretizedTrajectory& trajectory) {
+  const auto times =
+      SortedQueries(trajectory.front().relative_time(),
+                    trajectory.back().relative_time(), FLAGS_queries);
+  double proto_checksum = 0.0;
+  const double proto_ns = Measure(
+      [&]() {
+        double sum = 0.0;
+        for (const double t : times) {
+          const auto point = trajectory.Evaluate(t);
+          sum += point.path_point().x() + point.v();
+        }
+        return sum;
+      },
+      &proto_checksum);
+
+  const TrajectoryArrays trajectory_arrays(trajectory);
+  TrajectoryArrays evaluated;
+  double arrays_checksum = 0.0;
+  const double arrays_ns = Measure(
+      [&]() {
+        trajectory_arrays.Evaluate(times, &evaluated);
+        double sum = 0.0;
+        for (size_t k = 0; k < times.size(); ++k) {
+          sum += evaluated.path.x[k] + evaluated.v[k];
+        }
+        return sum;
+      },
+      &arrays_checksum);
+  Report("trajectory_evaluate", proto_ns, proto_checksum, arrays_ns,
+         arrays_checksum);
+}
+
+// the lookups of ReferenceLineInfo::CombinePathAndSpeedProfile
+void PathAndSpeedCase(const SpeedData& speed_data,
+                      const DiscretizedPath& path) {
+  const auto times = SortedQueries(speed_data.front().t(),
+                                   speed_data.back().t(), FLAGS_queries);
+  double proto_checksum = 0.0;
+  const double proto_ns = Measure(
+      [&]() {
+        double sum = 0.0;
+        for (const double t : times) {
+          SpeedPoint speed_point;
+          speed_data.EvaluateByTime(t, &speed_point);
+          const auto path_point = path.Evaluate(speed_point.s());
+          sum += path_point.x() + speed_point.v();
+        }
+        return sum;
+      },
+      &proto_checksum);
+
+  const SpeedArrays speed_arrays(speed_data);
+  const PathArrays path_arrays(path);
+  SpeedArrays speed_points;
+  PathArrays path_points;
+  double arrays_checksum = 0.0;
+  const double arrays_ns = Measure(
+      [&]() {
+        speed_arrays.EvaluateByTime(times, &speed_points);
+        path_arrays.Evaluate(speed_points.s, &path_points);
+        double sum = 0.0;
+        for (size_t k = 0; k < times.size(); ++k) {
+          sum += path_points.x[k] + speed_points.v[k];
+        }
+        return sum;
+      },
+      &arrays_checksum);
+  Report("path_and_speed_evaluate", proto_ns, proto_checksum, arrays_ns,
+         arrays_checksum);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_points < 2 || FLAGS_queries < 1 || FLAGS_repeats < 1) {
+    std::fprintf(stderr, "--points must be 2 or more, --queries and "
+                         "--repeats 1 or more\n");
+    return 1;
+  }
+  const auto trajectory = MakeTrajectory(FLAGS_points);
+  TrajectoryCase(trajectory);
+  PathAndSpeedCase(MakeSpeedData(trajectory), MakePath(trajectory));
+  return 0;
+}
@@ -84,20 +84,20 @@ bool CollisionChecker::InCollision(
 
 bool CollisionChecker::InCollision(
     const DiscretizedTrajectory& discretized_trajectory) {
-  CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+  return InCollision(TrajectoryArrays(discretized_trajectory));
+}
+
+bool CollisionChecker::InCollision(const TrajectoryArrays& trajectory) {
+  CHECK_LE(trajectory.size(), predicted_bounding_rectangles_.size());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
   double ego_width = vehicle_config.vehicle_param().width();
 
-  for (size_t i = 0; i < discretized_trajectory.NumOfPoints(); ++i) {
-    const auto& trajectory_point =
-        discretized_trajectory.TrajectoryPointAt(static_cast<std::uint32_t>(i));
-    double ego_theta = trajectory_point.path_point().theta();
-    Box2d ego_box(
-        {trajectory_point.path_point().x(), trajectory_point.path_point().y()},
-        ego_theta, ego_length, ego_width);
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    double ego_theta = trajectory.path.theta[i];
+    Box2d ego_box({trajectory.path.x[i], trajectory.path.y[i]}, ego_theta,
+                  ego_length, ego_width);
     double shift_distance =
         ego_length / 2.0 - vehicle_config.vehicle_param().back_edge_to_center();
     Vec2d shift_vec{shift_distance * std::cos(ego_theta),
@@ -27,6 +27,7 @@
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
 
 namespace apollo {
@@ -43,6 +44,8 @@ class CollisionChecker {
 
   bool InCollision(const DiscretizedTrajectory& discretized_trajectory);
 
+  bool InCollision(const TrajectoryArrays& trajectory);
+
   static bool InCollision(const std::vector<const Obstacle*>& obstacles,
                           const DiscretizedTrajectory& ego_trajectory,
                           const double ego_length, const double ego_width,
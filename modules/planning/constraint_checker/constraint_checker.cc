@@ -35,13 +35,19 @@ bool WithinRange(const T v, const T lower, const T upper) {
 
 ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
     const DiscretizedTrajectory& trajectory) {
+  return ValidTrajectory(TrajectoryArrays(trajectory));
+}
+
+ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
+    const TrajectoryArrays& trajectory) {
   const double kMaxCheckRelativeTime = FLAGS_trajectory_time_length;
-  for (const auto& p : trajectory) {
-    double t = p.relative_time();
+  const auto& kappas = trajectory.path.kappa;
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    double t = trajectory.relative_time[i];
     if (t > kMaxCheckRelativeTime) {
       break;
     }
-    double lon_v = p.v();
+    double lon_v = trajectory.v[i];
     if (!WithinRange(lon_v, FLAGS_speed_lower_bound, FLAGS_speed_upper_bound)) {
       ADEBUG << "Velocity at relative time " << t
              << " exceeds bound, value: " << lon_v << ", bound ["
@@ -50,7 +56,7 @@ ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
       return Result::LON_VELOCITY_OUT_OF_BOUND;
     }
 
-    double lon_a = p.a();
+    double lon_a = trajectory.a[i];
     if (!WithinRange(lon_a, FLAGS_longitudinal_acceleration_lower_bound,
                      FLAGS_longitudinal_acceleration_upper_bound)) {
       ADEBUG << "Longitudinal acceleration at relative time " << t
@@ -60,7 +66,7 @@ ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
       return Result::LON_ACCELERATION_OUT_OF_BOUND;
     }
 
-    double kappa = p.path_point().kappa();
+    double kappa = kappas[i];
     if (!WithinRange(kappa, -FLAGS_kappa_bound, FLAGS_kappa_bound)) {
       ADEBUG << "Kappa at relative time " << t
              << " exceeds bound, value: " << kappa << ", bound ["
@@ -69,18 +75,18 @@ ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
     }
   }
 
-  for (size_t i = 1; i < trajectory.NumOfPoints(); ++i) {
-    const auto& p0 = trajectory.TrajectoryPointAt(static_cast<uint32_t>(i - 1));
-    const auto& p1 = trajectory.TrajectoryPointAt(static_cast<uint32_t>(i));
+  for (size_t i = 1; i < trajectory.size(); ++i) {
+    const double t0 = trajectory.relative_time[i - 1];
+    const double t1 = trajectory.relative_time[i];
 
-    if (p1.relative_time() > kMaxCheckRelativeTime) {
+    if (t1 > kMaxCheckRelativeTime) {
       break;
     }
 
-    double t = p0.relative_time();
+    double t = t0;
 
-    double dt = p1.relative_time() - p0.relative_time();
-    double d_lon_a = p1.a() - p0.a();
+    double dt = t1 - t0;
+    double d_lon_a = trajectory.a[i] - trajectory.a[i - 1];
     double lon_jerk = d_lon_a / dt;
     if (!WithinRange(lon_jerk, FLAGS_longitudinal_jerk_lower_bound,
                      FLAGS_longitudinal_jerk_upper_bound)) {
@@ -91,7 +97,7 @@ ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
       return Result::LON_JERK_OUT_OF_BOUND;
     }
 
-    double lat_a = p1.v() * p1.v() * p1.path_point().kappa();
+    double lat_a = trajectory.v[i] * trajectory.v[i] * kappas[i];
     if (!WithinRange(lat_a, -FLAGS_lateral_acceleration_bound,
                      FLAGS_lateral_acceleration_bound)) {
       ADEBUG << "Lateral acceleration at relative time " << t
@@ -104,8 +110,8 @@ ConstraintChecker::Result ConstraintChecker::ValidTrajectory(
     // TODO(zhangyajia): this is temporarily disabled
     // due to low quality reference line.
     /**
-    double d_lat_a = p1.v() * p1.v() * p1.path_point().kappa() -
-                     p0.v() * p0.v() * p0.path_point().kappa();
+    double d_lat_a = lat_a - trajectory.v[i - 1] * trajectory.v[i - 1] *
+                                 kappas[i - 1];
     double lat_jerk = d_lat_a / dt;
     if (!WithinRange(lat_jerk, -FLAGS_lateral_jerk_bound,
                      FLAGS_lateral_jerk_bound)) {
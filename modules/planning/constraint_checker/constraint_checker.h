@@ -21,6 +21,7 @@
 #pragma once
 
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 
 namespace apollo {
 namespace planning {
@@ -39,6 +40,7 @@ class ConstraintChecker {
   };
   ConstraintChecker() = delete;
   static Result ValidTrajectory(const DiscretizedTrajectory& trajectory);
+  static Result ValidTrajectory(const TrajectoryArrays& trajectory);
 };
 
 }  // namespace planning
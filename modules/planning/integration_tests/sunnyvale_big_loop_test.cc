@@ -55,6 +55,7 @@ class SunnyvaleBigLoopTest : public PlanningTestBase {
     FLAGS_enable_scenario_stop_sign = false;
     FLAGS_enable_scenario_traffic_light = false;
     FLAGS_enable_rss_info = false;
+    FLAGS_enable_parallel_reference_line_planning = false;
 
     ENABLE_RULE(TrafficRuleConfig::CROSSWALK, false);
     ENABLE_RULE(TrafficRuleConfig::DESTINATION, false);
@@ -306,6 +307,30 @@ TEST_F(SunnyvaleBigLoopTest, change_lane_abort_for_fast_back_vehicle) {
   RUN_GOLDEN_TEST_DECISION(0);
 }
 
+/*
+ * change lane with the reference lines planned at the same time, the decision
+ * is the same as when they are planned one by one
+ */
+TEST_F(SunnyvaleBigLoopTest, change_lane_abort_for_fast_back_vehicle_parallel) {
+  ENABLE_RULE(TrafficRuleConfig::CROSSWALK, false);
+  ENABLE_RULE(TrafficRuleConfig::KEEP_CLEAR, false);
+  ENABLE_RULE(TrafficRuleConfig::TRAFFIC_LIGHT, true);
+  FLAGS_enable_parallel_reference_line_planning = true;
+
+  std::string seq_num = "400";
+  FLAGS_test_routing_response_file = seq_num + "_routing.pb.txt";
+  FLAGS_test_localization_file = seq_num + "_localization.pb.txt";
+  FLAGS_test_chassis_file = seq_num + "_chassis.pb.txt";
+  FLAGS_test_prediction_file = seq_num + "_prediction.pb.txt";
+  PlanningTestBase::SetUp();
+
+  // reuses the golden file of the sequential case
+  bool no_trajectory_point = true;
+  bool run_planning_success = RunPlanning(
+      "change_lane_abort_for_fast_back_vehicle", 0, no_trajectory_point);
+  EXPECT_TRUE(run_planning_success);
+}
+
 /*
  * destination: stop on arriving destination when pull-over is disabled
  * bag: 2018-05-16-10-00-32/2018-05-16-10-00-32_10.bag
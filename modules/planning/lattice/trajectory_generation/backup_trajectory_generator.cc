@@ -56,19 +56,23 @@ void BackupTrajectoryGenerator::GenerateTrajectory1dPairs(const State& init_s,
 
 DiscretizedTrajectory BackupTrajectoryGenerator::GenerateTrajectory(
     const std::vector<PathPoint>& discretized_ref_points) {
+  const PathArrays reference_line(discretized_ref_points);
+  TrajectoryArrays trajectory;
   while (trajectory_pair_pqueue_.size() > 1) {
     auto top_pair = trajectory_pair_pqueue_.top();
     trajectory_pair_pqueue_.pop();
-    DiscretizedTrajectory trajectory =
-        TrajectoryCombiner::Combine(discretized_ref_points, *top_pair.first,
-                                    *top_pair.second, init_relative_time_);
+    TrajectoryCombiner::Combine(reference_line, *top_pair.first,
+                                *top_pair.second, init_relative_time_,
+                                &trajectory);
     if (!ptr_collision_checker_->InCollision(trajectory)) {
-      return trajectory;
+      return trajectory.ToDiscretizedTrajectory();
     }
   }
   auto top_pair = trajectory_pair_pqueue_.top();
-  return TrajectoryCombiner::Combine(discretized_ref_points, *top_pair.first,
-                                     *top_pair.second, init_relative_time_);
+  TrajectoryCombiner::Combine(reference_line, *top_pair.first,
+                              *top_pair.second, init_relative_time_,
+                              &trajectory);
+  return trajectory.ToDiscretizedTrajectory();
 }
 
 }  // namespace planning
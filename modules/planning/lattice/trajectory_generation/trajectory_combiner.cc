@@ -17,29 +17,42 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 
 #include <algorithm>
+#include <array>
 
+#include "cyber/common/log.h"
 #include "modules/common/math/cartesian_frenet_conversion.h"
-#include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
 namespace planning {
 
 using apollo::common::PathPoint;
-using apollo::common::TrajectoryPoint;
 using apollo::common::math::CartesianFrenetConverter;
-using apollo::common::math::PathMatcher;
 
 DiscretizedTrajectory TrajectoryCombiner::Combine(
     const std::vector<PathPoint>& reference_line, const Curve1d& lon_trajectory,
     const Curve1d& lat_trajectory, const double init_relative_time) {
-  DiscretizedTrajectory combined_trajectory;
+  TrajectoryArrays combined_trajectory;
+  Combine(PathArrays(reference_line), lon_trajectory, lat_trajectory,
+          init_relative_time, &combined_trajectory);
+  return combined_trajectory.ToDiscretizedTrajectory();
+}
+
+void TrajectoryCombiner::Combine(const PathArrays& reference_line,
+                                 const Curve1d& lon_trajectory,
+                                 const Curve1d& lat_trajectory,
+                                 const double init_relative_time,
+                                 TrajectoryArrays* combined_trajectory) {
+  CHECK_NOTNULL(combined_trajectory);
+  combined_trajectory->clear();
 
   double s0 = lon_trajectory.Evaluate(0, 0.0);
-  double s_ref_max = reference_line.back().s();
-  double accumulated_trajectory_s = 0.0;
-  PathPoint prev_trajectory_point;
+  double s_ref_max = reference_line.s.back();
 
+  // longitudinal states up to the end of the reference line
+  std::vector<double> lon_s;
+  std::vector<double> lon_s_dot;
+  std::vector<double> lon_s_ddot;
   double last_s = -FLAGS_numerical_epsilon;
   double t_param = 0.0;
   while (t_param < FLAGS_trajectory_time_length) {
@@ -50,67 +63,55 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
       s = std::max(last_s, s);
     }
     last_s = s;
-
-    double s_dot =
-        std::max(FLAGS_numerical_epsilon, lon_trajectory.Evaluate(1, t_param));
-    double s_ddot = lon_trajectory.Evaluate(2, t_param);
     if (s > s_ref_max) {
       break;
     }
 
-    double relative_s = s - s0;
+    lon_s.push_back(s);
+    lon_s_dot.push_back(
+        std::max(FLAGS_numerical_epsilon, lon_trajectory.Evaluate(1, t_param)));
+    lon_s_ddot.push_back(lon_trajectory.Evaluate(2, t_param));
+    combined_trajectory->relative_time.push_back(t_param + init_relative_time);
+
+    t_param = t_param + FLAGS_trajectory_time_resolution;
+  }
+
+  // the s of the states only go forward, so one sweep matches them all
+  PathArrays matched_ref_points;
+  reference_line.Evaluate(lon_s, &matched_ref_points);
+
+  const size_t num_points = lon_s.size();
+  auto& path = combined_trajectory->path;
+  path.resize(num_points);
+  combined_trajectory->v.resize(num_points);
+  combined_trajectory->a.resize(num_points);
+  double accumulated_trajectory_s = 0.0;
+  for (size_t i = 0; i < num_points; ++i) {
+    double relative_s = lon_s[i] - s0;
     // linear extrapolation is handled internally in LatticeTrajectory1d;
     // no worry about s_param > lat_trajectory.ParamLength() situation
     double d = lat_trajectory.Evaluate(0, relative_s);
     double d_prime = lat_trajectory.Evaluate(1, relative_s);
     double d_pprime = lat_trajectory.Evaluate(2, relative_s);
 
-    PathPoint matched_ref_point = PathMatcher::MatchToPath(reference_line, s);
-
-    double x = 0.0;
-    double y = 0.0;
-    double theta = 0.0;
-    double kappa = 0.0;
-    double v = 0.0;
-    double a = 0.0;
-
-    const double rs = matched_ref_point.s();
-    const double rx = matched_ref_point.x();
-    const double ry = matched_ref_point.y();
-    const double rtheta = matched_ref_point.theta();
-    const double rkappa = matched_ref_point.kappa();
-    const double rdkappa = matched_ref_point.dkappa();
-
-    std::array<double, 3> s_conditions = {rs, s_dot, s_ddot};
+    const double rs = matched_ref_points.s[i];
+    std::array<double, 3> s_conditions = {rs, lon_s_dot[i], lon_s_ddot[i]};
     std::array<double, 3> d_conditions = {d, d_prime, d_pprime};
     CartesianFrenetConverter::frenet_to_cartesian(
-        rs, rx, ry, rtheta, rkappa, rdkappa, s_conditions, d_conditions, &x, &y,
-        &theta, &kappa, &v, &a);
-
-    if (prev_trajectory_point.has_x() && prev_trajectory_point.has_y()) {
-      double delta_x = x - prev_trajectory_point.x();
-      double delta_y = y - prev_trajectory_point.y();
-      double delta_s = std::hypot(delta_x, delta_y);
-      accumulated_trajectory_s += delta_s;
+        rs, matched_ref_points.x[i], matched_ref_points.y[i],
+        matched_ref_points.theta[i], matched_ref_points.kappa[i],
+        matched_ref_points.dkappa[i], s_conditions, d_conditions, &path.x[i],
+        &path.y[i], &path.theta[i], &path.kappa[i], &combined_trajectory->v[i],
+        &combined_trajectory->a[i]);
+
+    if (i > 0) {
+      accumulated_trajectory_s +=
+          std::hypot(path.x[i] - path.x[i - 1], path.y[i] - path.y[i - 1]);
     }
-
-    TrajectoryPoint trajectory_point;
-    trajectory_point.mutable_path_point()->set_x(x);
-    trajectory_point.mutable_path_point()->set_y(y);
-    trajectory_point.mutable_path_point()->set_s(accumulated_trajectory_s);
-    trajectory_point.mutable_path_point()->set_theta(theta);
-    trajectory_point.mutable_path_point()->set_kappa(kappa);
-    trajectory_point.set_v(v);
-    trajectory_point.set_a(a);
-    trajectory_point.set_relative_time(t_param + init_relative_time);
-
-    combined_trajectory.AppendTrajectoryPoint(trajectory_point);
-
-    t_param = t_param + FLAGS_trajectory_time_resolution;
-
-    prev_trajectory_point = trajectory_point.path_point();
+    path.s[i] = accumulated_trajectory_s;
+    path.dkappa[i] = 0.0;
+    path.ddkappa[i] = 0.0;
   }
-  return combined_trajectory;
 }
 
 }  // namespace planning
@@ -24,6 +24,7 @@
 
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -35,6 +36,16 @@ class TrajectoryCombiner {
       const std::vector<common::PathPoint>& reference_line,
       const Curve1d& lon_trajectory, const Curve1d& lat_trajectory,
       const double init_relative_time);
+
+  /**
+   * @brief Combines as above into arrays, which keep their capacity when
+   * the same arrays are combined into for each candidate.
+   */
+  static void Combine(const PathArrays& reference_line,
+                      const Curve1d& lon_trajectory,
+                      const Curve1d& lat_trajectory,
+                      const double init_relative_time,
+                      TrajectoryArrays* combined_trajectory);
 };
 
 }  // namespace planning
@@ -98,7 +98,9 @@ bool FemPosDeviationOsqpInterface::Solve() {
   if (res == false || work == nullptr || work->solution == nullptr) {
     AERROR << "Failed to find solution.";
     // Cleanup
-    osqp_cleanup(work);
+    if (osqp_solver_ == nullptr) {
+      osqp_cleanup(work);
+    }
     c_free(data->A);
     c_free(data->P);
     c_free(data);
@@ -117,7 +119,9 @@ bool FemPosDeviationOsqpInterface::Solve() {
   }
 
   // Cleanup
-  osqp_cleanup(work);
+  if (osqp_solver_ == nullptr) {
+    osqp_cleanup(work);
+  }
   c_free(data->A);
   c_free(data->P);
   c_free(data);
@@ -283,12 +287,26 @@ bool FemPosDeviationOsqpInterface::OptimizeWithOsqp(
   data->l = lower_bounds->data();
   data->u = upper_bounds->data();
 
-  *work = osqp_setup(data, settings);
-
-  osqp_warm_start_x(*work, primal_warm_start->data());
-
-  // Solve Problem
-  osqp_solve(*work);
+  if (osqp_solver_ != nullptr) {
+    // the kept workspace only takes the new vectors, the kernel and the
+    // constraint matrix depend on the number of points only
+    *work = osqp_solver_->Solve(*data, *settings, *primal_warm_start);
+    if (*work == nullptr) {
+      return false;
+    }
+    const auto& stats = osqp_solver_->stats();
+    ADEBUG << "OSQP setup time [ms]: " << stats.setup_time_ms
+           << ", solve time [ms]: " << stats.solve_time_ms
+           << ", iterations: " << stats.iterations
+           << ", reused workspace: " << stats.reused_workspace;
+  } else {
+    *work = osqp_setup(data, settings);
+
+    osqp_warm_start_x(*work, primal_warm_start->data());
+
+    // Solve Problem
+    osqp_solve(*work);
+  }
 
   auto status = (*work)->info->status_val;
 
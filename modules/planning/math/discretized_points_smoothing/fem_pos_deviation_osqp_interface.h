@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/persistent_osqp_solver.h"
 #include "osqp/include/osqp.h"
 
 namespace apollo {
@@ -67,6 +68,11 @@ class FemPosDeviationOsqpInterface {
 
   void set_warm_start(const bool warm_start) { warm_start_ = warm_start; }
 
+  // solves with the kept workspace of osqp_solver, which is not owned
+  void set_osqp_solver(common::math::PersistentOsqpSolver* osqp_solver) {
+    osqp_solver_ = osqp_solver;
+  }
+
   bool Solve();
 
   const std::vector<double>& opt_x() const { return x_; }
@@ -113,6 +119,7 @@ class FemPosDeviationOsqpInterface {
   bool verbose_ = false;
   bool scaled_termination_ = true;
   bool warm_start_ = true;
+  common::math::PersistentOsqpSolver* osqp_solver_ = nullptr;
 
   // Optimization problem definitions
   int num_of_points_ = 0;
@@ -72,6 +72,7 @@ bool FemPosDeviationSmoother::QpWithOsqp(
   solver.set_verbose(config_.verbose());
   solver.set_scaled_termination(config_.scaled_termination());
   solver.set_warm_start(config_.warm_start());
+  solver.set_osqp_solver(osqp_solver_);
 
   solver.set_ref_points(raw_point2d);
   solver.set_bounds_around_refs(bounds);
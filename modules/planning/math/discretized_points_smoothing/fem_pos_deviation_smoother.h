@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/persistent_osqp_solver.h"
 #include "modules/planning/proto/fem_pos_deviation_smoother_config.pb.h"
 
 namespace apollo {
@@ -64,8 +65,17 @@ class FemPosDeviationSmoother {
                    const std::vector<double>& bounds,
                    std::vector<double>* opt_x, std::vector<double>* opt_y);
 
+  /**
+   * @brief Solves QpWithOsqp with the kept workspace of osqp_solver, which is
+   * not owned.
+   */
+  void set_osqp_solver(common::math::PersistentOsqpSolver* osqp_solver) {
+    osqp_solver_ = osqp_solver;
+  }
+
  private:
   FemPosDeviationSmootherConfig config_;
+  common::math::PersistentOsqpSolver* osqp_solver_ = nullptr;
 };
 }  // namespace planning
 }  // namespace apollo
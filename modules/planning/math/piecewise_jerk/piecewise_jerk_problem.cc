@@ -17,6 +17,7 @@
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "cyber/common/log.h"
 
@@ -94,23 +95,38 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   OSQPSettings* settings = SolverDefaultSettings();
   settings->max_iter = max_iter;
 
-  OSQPWorkspace* osqp_work = osqp_setup(data, settings);
-
-  osqp_solve(osqp_work);
+  OSQPWorkspace* osqp_work = nullptr;
+  if (osqp_solver_ == nullptr) {
+    osqp_work = osqp_setup(data, settings);
+    const auto warm_start = ScaledWarmStart();
+    if (!warm_start.empty()) {
+      osqp_warm_start_x(osqp_work, warm_start.data());
+    }
+    osqp_solve(osqp_work);
+  } else {
+    osqp_work = osqp_solver_->Solve(*data, *settings, ScaledWarmStart());
+    if (osqp_work == nullptr) {
+      FreeData(data);
+      c_free(settings);
+      return false;
+    }
+    const auto& stats = osqp_solver_->stats();
+    ADEBUG << "OSQP setup time [ms]: " << stats.setup_time_ms
+           << ", solve time [ms]: " << stats.solve_time_ms
+           << ", iterations: " << stats.iterations
+           << ", reused workspace: " << stats.reused_workspace
+           << ", warm started: " << stats.warm_started;
+  }
 
   auto status = osqp_work->info->status_val;
 
   if (status < 0 || (status != 1 && status != 2)) {
     AERROR << "failed optimization status:\t" << osqp_work->info->status;
-    osqp_cleanup(osqp_work);
-    FreeData(data);
-    c_free(settings);
+    Cleanup(osqp_work, data, settings);
     return false;
   } else if (osqp_work->solution == nullptr) {
     AERROR << "The solution from OSQP is nullptr";
-    osqp_cleanup(osqp_work);
-    FreeData(data);
-    c_free(settings);
+    Cleanup(osqp_work, data, settings);
     return false;
   }
 
@@ -126,12 +142,56 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   }
 
   // Cleanup
-  osqp_cleanup(osqp_work);
-  FreeData(data);
-  c_free(settings);
+  Cleanup(osqp_work, data, settings);
   return true;
 }
 
+void PiecewiseJerkProblem::set_warm_start(std::vector<double> x,
+                                          std::vector<double> dx,
+                                          std::vector<double> ddx) {
+  x_warm_start_ = std::move(x);
+  dx_warm_start_ = std::move(dx);
+  ddx_warm_start_ = std::move(ddx);
+}
+
+std::vector<c_float> PiecewiseJerkProblem::ScaledWarmStart() const {
+  if (x_warm_start_.size() != num_of_knots_ ||
+      dx_warm_start_.size() != num_of_knots_ ||
+      ddx_warm_start_.size() != num_of_knots_) {
+    return {};
+  }
+  std::vector<c_float> warm_start(3 * num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    warm_start[i] = x_warm_start_[i] * scale_factor_[0];
+    warm_start[i + num_of_knots_] = dx_warm_start_[i] * scale_factor_[1];
+    warm_start[i + 2 * num_of_knots_] = ddx_warm_start_[i] * scale_factor_[2];
+  }
+  return warm_start;
+}
+
+std::vector<double> PiecewiseJerkProblem::ShiftedKnots(
+    const std::vector<double>& values, const double shift,
+    const size_t num_of_knots) {
+  std::vector<double> shifted_values;
+  if (values.empty()) {
+    return shifted_values;
+  }
+  const double last_index = static_cast<double>(values.size() - 1);
+  shifted_values.reserve(num_of_knots);
+  for (size_t i = 0; i < num_of_knots; ++i) {
+    const double index =
+        std::fmin(std::fmax(static_cast<double>(i) + shift, 0.0), last_index);
+    const size_t lower_index = static_cast<size_t>(index);
+    const size_t upper_index =
+        std::min(lower_index + 1, static_cast<size_t>(last_index));
+    const double ratio = index - static_cast<double>(lower_index);
+    shifted_values.push_back(
+        values[lower_index] +
+        ratio * (values[upper_index] - values[lower_index]));
+  }
+  return shifted_values;
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -325,6 +385,16 @@ void PiecewiseJerkProblem::set_end_state_ref(
   has_end_state_ref_ = true;
 }
 
+void PiecewiseJerkProblem::Cleanup(OSQPWorkspace* osqp_work, OSQPData* data,
+                                   OSQPSettings* settings) {
+  // a kept workspace is cleaned up by its solver
+  if (osqp_solver_ == nullptr) {
+    osqp_cleanup(osqp_work);
+  }
+  FreeData(data);
+  c_free(settings);
+}
+
 void PiecewiseJerkProblem::FreeData(OSQPData* data) {
   delete[] data->q;
   delete[] data->l;
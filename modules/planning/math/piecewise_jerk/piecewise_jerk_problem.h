@@ -20,10 +20,12 @@
 
 #pragma once
 
+#include <array>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/persistent_osqp_solver.h"
 #include "osqp/include/osqp.h"
 
 namespace apollo {
@@ -93,8 +95,31 @@ class PiecewiseJerkProblem {
   void set_end_state_ref(const std::array<double, 3>& weight_end_state,
                          const std::array<double, 3>& end_state_ref);
 
+  /**
+   * @brief Solves with the kept workspace of osqp_solver instead of setting
+   * up a new one. The solver is not owned and must outlive Optimize.
+   */
+  void set_osqp_solver(common::math::PersistentOsqpSolver* osqp_solver) {
+    osqp_solver_ = osqp_solver;
+  }
+
+  /**
+   * @brief Starts the solver from x, dx and ddx, e.g. the last solution
+   * shifted to the new knots, instead of from zero.
+   */
+  void set_warm_start(std::vector<double> x, std::vector<double> dx,
+                      std::vector<double> ddx);
+
   virtual bool Optimize(const int max_iter = 4000);
 
+  /**
+   * @brief Values of the knots moved by shift knots towards the end, linearly
+   * interpolated and continued with the last value.
+   */
+  static std::vector<double> ShiftedKnots(const std::vector<double>& values,
+                                          const double shift,
+                                          const size_t num_of_knots);
+
   const std::vector<double>& opt_x() const { return x_; }
 
   const std::vector<double>& opt_dx() const { return dx_; }
@@ -121,6 +146,11 @@ class PiecewiseJerkProblem {
 
   void FreeData(OSQPData* data);
 
+  void Cleanup(OSQPWorkspace* osqp_work, OSQPData* data,
+               OSQPSettings* settings);
+
+  std::vector<c_float> ScaledWarmStart() const;
+
   template <typename T>
   T* CopyData(const std::vector<T>& vec) {
     T* data = new T[vec.size()];
@@ -158,6 +188,11 @@ class PiecewiseJerkProblem {
   bool has_end_state_ref_ = false;
   std::array<double, 3> weight_end_state_ = {{0.0, 0.0, 0.0}};
   std::array<double, 3> end_state_ref_;
+
+  common::math::PersistentOsqpSolver* osqp_solver_ = nullptr;
+  std::vector<double> x_warm_start_;
+  std::vector<double> dx_warm_start_;
+  std::vector<double> ddx_warm_start_;
 };
 
 }  // namespace planning
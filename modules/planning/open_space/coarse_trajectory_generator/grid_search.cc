@@ -23,6 +23,21 @@
 namespace apollo {
 namespace planning {
 
+namespace {
+
+struct GridMotion {
+  int dx;
+  int dy;
+  double cost;
+};
+
+// up, up right, right, down right, down, down left, left and up left
+const GridMotion kGridMotions[] = {
+    {0, 1, 1.0},  {1, 1, M_SQRT2},   {1, 0, 1.0},  {1, -1, M_SQRT2},
+    {0, -1, 1.0}, {-1, -1, M_SQRT2}, {-1, 0, 1.0}, {-1, 1, M_SQRT2}};
+
+}  // namespace
+
 GridSearch::GridSearch(const PlannerOpenSpaceConfig& open_space_conf) {
   xy_grid_resolution_ =
       open_space_conf.warm_start_config().grid_a_star_xy_resolution();
@@ -30,25 +45,58 @@ GridSearch::GridSearch(const PlannerOpenSpaceConfig& open_space_conf) {
 }
 
 double GridSearch::EuclidDistance(const double x1, const double y1,
-                                  const double x2, const double y2) {
+                                  const double x2, const double y2) const {
   return std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
-bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
-  const double node_grid_x = node->GetGridX();
-  const double node_grid_y = node->GetGridY();
-  if (node_grid_x > max_grid_x_ || node_grid_x < 0 ||
-      node_grid_y > max_grid_y_ || node_grid_y < 0) {
+void GridSearch::ResetGrid(const std::vector<double>& XYbounds) {
+  XYbounds_ = XYbounds;
+  max_grid_x_ = static_cast<int>(
+      std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_));
+  max_grid_y_ = static_cast<int>(
+      std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_));
+  grid_width_ = max_grid_x_ + 1;
+  const size_t grid_size =
+      static_cast<size_t>(grid_width_) * static_cast<size_t>(max_grid_y_ + 1);
+  // the storage is kept across searches, only the node states are reset
+  nodes_.resize(grid_size);
+  for (int grid_y = 0; grid_y <= max_grid_y_; ++grid_y) {
+    for (int grid_x = 0; grid_x <= max_grid_x_; ++grid_x) {
+      nodes_[CalcIndex(grid_x, grid_y)] = Node2d(grid_x, grid_y);
+    }
+  }
+  node_states_.assign(grid_size, kUnknown);
+  open_pq_.Reset(grid_size);
+}
+
+int GridSearch::CalcIndex(const double x, const double y) const {
+  if (XYbounds_.size() != 4) {
+    return -1;
+  }
+  const int grid_x =
+      static_cast<int>((x - XYbounds_[0]) / xy_grid_resolution_);
+  const int grid_y =
+      static_cast<int>((y - XYbounds_[2]) / xy_grid_resolution_);
+  if (grid_x > max_grid_x_ || grid_x < 0 || grid_y > max_grid_y_ ||
+      grid_y < 0) {
+    return -1;
+  }
+  return CalcIndex(grid_x, grid_y);
+}
+
+bool GridSearch::CheckConstraints(const int grid_x, const int grid_y) const {
+  if (grid_x > max_grid_x_ || grid_x < 0 || grid_y > max_grid_y_ ||
+      grid_y < 0) {
     return false;
   }
   if (obstacles_linesegments_vec_.empty()) {
     return true;
   }
+  const common::math::Vec2d point(grid_x, grid_y);
   for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
     for (const common::math::LineSegment2d& linesegment :
          obstacle_linesegments) {
-      if (linesegment.DistanceTo({node->GetGridX(), node->GetGridY()}) <
-          node_radius_) {
+      if (linesegment.DistanceTo(point) < node_radius_) {
         return false;
       }
     }
@@ -56,47 +104,46 @@ bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
   return true;
 }
 
-std::vector<std::shared_ptr<Node2d>> GridSearch::GenerateNextNodes(
-    std::shared_ptr<Node2d> current_node) {
-  double current_node_x = current_node->GetGridX();
-  double current_node_y = current_node->GetGridY();
-  double current_node_path_cost = current_node->GetPathCost();
-  double diagonal_distance = std::sqrt(2.0);
-  std::vector<std::shared_ptr<Node2d>> next_nodes;
-  std::shared_ptr<Node2d> up =
-      std::make_shared<Node2d>(current_node_x, current_node_y + 1.0, XYbounds_);
-  up->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y + 1.0, XYbounds_);
-  up_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> right =
-      std::make_shared<Node2d>(current_node_x + 1.0, current_node_y, XYbounds_);
-  right->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y - 1.0, XYbounds_);
-  down_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> down =
-      std::make_shared<Node2d>(current_node_x, current_node_y - 1.0, XYbounds_);
-  down->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y - 1.0, XYbounds_);
-  down_left->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> left =
-      std::make_shared<Node2d>(current_node_x - 1.0, current_node_y, XYbounds_);
-  left->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y + 1.0, XYbounds_);
-  up_left->SetPathCost(current_node_path_cost + diagonal_distance);
-
-  next_nodes.emplace_back(up);
-  next_nodes.emplace_back(up_right);
-  next_nodes.emplace_back(right);
-  next_nodes.emplace_back(down_right);
-  next_nodes.emplace_back(down);
-  next_nodes.emplace_back(down_left);
-  next_nodes.emplace_back(left);
-  next_nodes.emplace_back(up_left);
-  return next_nodes;
+size_t GridSearch::ExpandNode(const int current_index, const int end_index) {
+  size_t explored_node_num = 0;
+  const Node2d& current_node = nodes_[current_index];
+  node_states_[current_index] = kClosed;
+  for (const GridMotion& motion : kGridMotions) {
+    const int next_x = current_node.GetGridX() + motion.dx;
+    const int next_y = current_node.GetGridY() + motion.dy;
+    if (next_x > max_grid_x_ || next_x < 0 || next_y > max_grid_y_ ||
+        next_y < 0) {
+      continue;
+    }
+    const int next_index = CalcIndex(next_x, next_y);
+    NodeState& next_state = node_states_[next_index];
+    if (next_state == kClosed || next_state == kBlocked) {
+      continue;
+    }
+    // a cell is checked against the obstacles once per search
+    if (next_state == kUnknown && !CheckConstraints(next_x, next_y)) {
+      next_state = kBlocked;
+      continue;
+    }
+    const double path_cost = current_node.GetPathCost() + motion.cost;
+    Node2d& next_node = nodes_[next_index];
+    if (next_state == kUnknown) {
+      ++explored_node_num;
+      next_state = kOpen;
+      if (end_index >= 0) {
+        const Node2d& end_node = nodes_[end_index];
+        next_node.SetHeuristic(
+            EuclidDistance(next_x, next_y, end_node.GetGridX(),
+                           end_node.GetGridY()));
+      }
+    } else if (path_cost >= next_node.GetPathCost()) {
+      continue;
+    }
+    next_node.SetPathCost(path_cost);
+    next_node.SetPreNode(current_index);
+    open_pq_.Push(next_index, next_node.GetCost());
+  }
+  return explored_node_num;
 }
 
 bool GridSearch::GenerateAStarPath(
@@ -105,59 +152,35 @@ bool GridSearch::GenerateAStarPath(
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
-  XYbounds_ = XYbounds;
-  std::shared_ptr<Node2d> start_node =
-      std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> final_node_ = nullptr;
+  ResetGrid(XYbounds);
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(start_node->GetIndex(), start_node);
-  open_pq.emplace(start_node->GetIndex(), start_node->GetCost());
+  const int start_index = CalcIndex(sx, sy);
+  const int end_index = CalcIndex(ex, ey);
+  if (start_index < 0 || end_index < 0) {
+    AERROR << "Grid A start or end point out of XYbounds";
+    return false;
+  }
+  node_states_[start_index] = kOpen;
+  open_pq_.Push(start_index, nodes_[start_index].GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
+  int final_index = -1;
+  while (!open_pq_.Empty()) {
+    const int current_index = static_cast<int>(open_pq_.Pop());
     // Check destination
-    if (*(current_node) == *(end_node)) {
-      final_node_ = current_node;
+    if (current_index == end_index) {
+      final_index = current_index;
       break;
     }
-    close_set.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
-        continue;
-      }
-      if (close_set.find(next_node->GetIndex()) != close_set.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetHeuristic(
-            EuclidDistance(next_node->GetGridX(), next_node->GetGridY(),
-                           end_node->GetGridX(), end_node->GetGridY()));
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      }
-    }
+    explored_node_num += ExpandNode(current_index, end_index);
   }
 
-  if (final_node_ == nullptr) {
+  if (final_index < 0) {
     AERROR << "Grid A searching return null ptr(open_set ran out)";
     return false;
   }
-  LoadGridAStarResult(result);
+  LoadGridAStarResult(final_index, result);
   ADEBUG << "explored node num is " << explored_node_num;
   return true;
 }
@@ -166,74 +189,49 @@ bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
-  XYbounds_ = XYbounds;
-  // XYbounds with xmin, xmax, ymin, ymax
-  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
-  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
+  ResetGrid(XYbounds);
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(end_node->GetIndex(), end_node);
-  open_pq.emplace(end_node->GetIndex(), end_node->GetCost());
+  dp_map_.assign(nodes_.size(), std::numeric_limits<double>::infinity());
+  const int end_index = CalcIndex(ex, ey);
+  if (end_index < 0) {
+    AERROR << "Grid A end point out of XYbounds";
+    return false;
+  }
+  node_states_[end_index] = kOpen;
+  open_pq_.Push(end_index, nodes_[end_index].GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
-        continue;
-      }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
-      }
-    }
+  while (!open_pq_.Empty()) {
+    const int current_index = static_cast<int>(open_pq_.Pop());
+    dp_map_[current_index] = nodes_[current_index].GetCost();
+    explored_node_num += ExpandNode(current_index, -1);
   }
   ADEBUG << "explored node num is " << explored_node_num;
   return true;
 }
 
-double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
-  } else {
+double GridSearch::CheckDpMap(const double sx, const double sy) const {
+  const int index = CalcIndex(sx, sy);
+  if (index < 0 || static_cast<size_t>(index) >= dp_map_.size()) {
     return std::numeric_limits<double>::infinity();
   }
+  return dp_map_[index] * xy_grid_resolution_;
 }
 
-void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
-  (*result).path_cost = final_node_->GetPathCost() * xy_grid_resolution_;
-  std::shared_ptr<Node2d> current_node = final_node_;
+void GridSearch::LoadGridAStarResult(const int final_index,
+                                     GridAStartResult* result) {
+  (*result).path_cost = nodes_[final_index].GetPathCost() * xy_grid_resolution_;
+  int current_index = final_index;
   std::vector<double> grid_a_x;
   std::vector<double> grid_a_y;
-  while (current_node->GetPreNode() != nullptr) {
-    grid_a_x.push_back(current_node->GetGridX() * xy_grid_resolution_ +
+  while (nodes_[current_index].GetPreNode() >= 0) {
+    const Node2d& current_node = nodes_[current_index];
+    grid_a_x.push_back(current_node.GetGridX() * xy_grid_resolution_ +
                        XYbounds_[0]);
-    grid_a_y.push_back(current_node->GetGridY() * xy_grid_resolution_ +
+    grid_a_y.push_back(current_node.GetGridY() * xy_grid_resolution_ +
                        XYbounds_[2]);
-    current_node = current_node->GetPreNode();
+    current_index = current_node.GetPreNode();
   }
   std::reverse(grid_a_x.begin(), grid_a_x.end());
   std::reverse(grid_a_y.begin(), grid_a_y.end());
@@ -21,17 +21,15 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
-#include <memory>
-#include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_heap.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
 
 namespace apollo {
@@ -39,19 +37,9 @@ namespace planning {
 
 class Node2d {
  public:
-  Node2d(const double x, const double y, const double xy_resolution,
-         const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
-  Node2d(const int grid_x, const int grid_y,
-         const std::vector<double>& XYbounds) {
-    grid_x_ = grid_x;
-    grid_y_ = grid_y;
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
+  Node2d() = default;
+  Node2d(const int grid_x, const int grid_y)
+      : grid_x_(grid_x), grid_y_(grid_y) {}
   void SetPathCost(const double path_cost) {
     path_cost_ = path_cost;
     cost_ = path_cost_ + heuristic_;
@@ -60,31 +48,14 @@ class Node2d {
     heuristic_ = heuristic;
     cost_ = path_cost_ + heuristic_;
   }
-  void SetCost(const double cost) { cost_ = cost; }
-  void SetPreNode(std::shared_ptr<Node2d> pre_node) { pre_node_ = pre_node; }
-  double GetGridX() const { return grid_x_; }
-  double GetGridY() const { return grid_y_; }
+  void SetPreNode(const int pre_node) { pre_node_ = pre_node; }
+  int GetGridX() const { return grid_x_; }
+  int GetGridY() const { return grid_y_; }
   double GetPathCost() const { return path_cost_; }
   double GetHeuCost() const { return heuristic_; }
   double GetCost() const { return cost_; }
-  const std::string& GetIndex() const { return index_; }
-  std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
-                               const double xy_resolution,
-                               const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
-  }
-  bool operator==(const Node2d& right) const {
-    return right.GetIndex() == index_;
-  }
-
- private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return absl::StrCat(x_grid, "_", y_grid);
-  }
+  // index of the previous node in the grid, -1 for the first one
+  int GetPreNode() const { return pre_node_; }
 
  private:
   int grid_x_ = 0;
@@ -92,8 +63,7 @@ class Node2d {
   double path_cost_ = 0.0;
   double heuristic_ = 0.0;
   double cost_ = 0.0;
-  std::string index_;
-  std::shared_ptr<Node2d> pre_node_ = nullptr;
+  int pre_node_ = -1;
 };
 
 struct GridAStartResult {
@@ -102,6 +72,10 @@ struct GridAStartResult {
   double path_cost = 0.0;
 };
 
+/**
+ * @brief A* and dynamic programming over a dense xy grid. Nodes live in one
+ * array indexed by grid cell, which is reused by every search.
+ */
 class GridSearch {
  public:
   explicit GridSearch(const PlannerOpenSpaceConfig& open_space_conf);
@@ -116,35 +90,42 @@ class GridSearch {
       const double ex, const double ey, const std::vector<double>& XYbounds,
       const std::vector<std::vector<common::math::LineSegment2d>>&
           obstacles_linesegments_vec);
-  double CheckDpMap(const double sx, const double sy);
+  double CheckDpMap(const double sx, const double sy) const;
 
  private:
   double EuclidDistance(const double x1, const double y1, const double x2,
-                        const double y2);
-  std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
-      std::shared_ptr<Node2d> node);
-  bool CheckConstraints(std::shared_ptr<Node2d> node);
-  void LoadGridAStarResult(GridAStartResult* result);
+                        const double y2) const;
+  // XYbounds with xmin, xmax, ymin, ymax
+  void ResetGrid(const std::vector<double>& XYbounds);
+  // grid index of a point, -1 if it is outside of the grid
+  int CalcIndex(const double x, const double y) const;
+  int CalcIndex(const int grid_x, const int grid_y) const {
+    return grid_y * grid_width_ + grid_x;
+  }
+  bool CheckConstraints(const int grid_x, const int grid_y) const;
+  // relaxes the neighbors of a node just taken out of the open set, toward
+  // end_index if it is not -1
+  size_t ExpandNode(const int current_index, const int end_index);
+  void LoadGridAStarResult(const int final_index, GridAStartResult* result);
 
  private:
   double xy_grid_resolution_ = 0.0;
   double node_radius_ = 0.0;
   std::vector<double> XYbounds_;
-  double max_grid_x_ = 0.0;
-  double max_grid_y_ = 0.0;
-  std::shared_ptr<Node2d> start_node_;
-  std::shared_ptr<Node2d> end_node_;
-  std::shared_ptr<Node2d> final_node_;
+  int max_grid_x_ = 0;
+  int max_grid_y_ = 0;
+  int grid_width_ = 0;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
-  struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
-      return left.second >= right.second;
-    }
-  };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  enum NodeState : uint8_t { kUnknown = 0, kOpen, kClosed, kBlocked };
+
+  // one node per grid cell
+  std::vector<Node2d> nodes_;
+  std::vector<NodeState> node_states_;
+  IndexedHeap open_pq_;
+  // cost to the end point of each cell, infinity for the unreachable ones
+  std::vector<double> dp_map_;
 };
 }  // namespace planning
 }  // namespace apollo
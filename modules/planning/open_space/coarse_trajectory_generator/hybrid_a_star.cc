@@ -132,7 +132,10 @@ std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
       XYbounds_, planner_open_space_config_));
   end_node->SetPre(current_node);
-  close_set_.emplace(end_node->GetIndex(), end_node);
+  // never queued, so it counts as closed
+  if (node_positions_.emplace(end_node->GetIndex(), nodes_.size()).second) {
+    nodes_.push_back(end_node);
+  }
   return end_node;
 }
 
@@ -636,9 +639,9 @@ bool HybridAStar::Plan(
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
   // clear containers
-  open_set_.clear();
-  close_set_.clear();
-  open_pq_ = decltype(open_pq_)();
+  nodes_.clear();
+  node_positions_.clear();
+  open_pq_.Reset(0);
   final_node_ = nullptr;
 
   std::vector<std::vector<common::math::LineSegment2d>>
@@ -675,19 +678,18 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   ADEBUG << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.emplace(start_node_->GetIndex(), start_node_);
-  open_pq_.emplace(start_node_->GetIndex(), start_node_->GetCost());
+  node_positions_.emplace(start_node_->GetIndex(), nodes_.size());
+  open_pq_.Push(nodes_.size(), start_node_->GetCost());
+  nodes_.push_back(start_node_);
 
   // Hybrid A* begins
   size_t explored_node_num = 0;
   double astar_start_time = Clock::NowInSeconds();
   double heuristic_time = 0.0;
   double rs_time = 0.0;
-  while (!open_pq_.empty()) {
+  while (!open_pq_.Empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
-    open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
+    std::shared_ptr<Node3d> current_node = nodes_[open_pq_.Pop()];
     // check if an analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
@@ -697,7 +699,6 @@ bool HybridAStar::Plan(
     }
     const double rs_end_time = Clock::NowInSeconds();
     rs_time += rs_end_time - rs_start_time;
-    close_set_.emplace(current_node->GetIndex(), current_node);
     for (size_t i = 0; i < next_node_num_; ++i) {
       std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
       // boundary check failure handle
@@ -705,21 +706,27 @@ bool HybridAStar::Plan(
         continue;
       }
       // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      const auto position = node_positions_.find(next_node->GetIndex());
+      const bool is_new = position == node_positions_.end();
+      if (!is_new && !open_pq_.Contains(position->second)) {
         continue;
       }
       // collision check
       if (!ValidityCheck(next_node)) {
         continue;
       }
-      if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
+      const double start_time = Clock::NowInSeconds();
+      CalculateNodeCost(current_node, next_node);
+      const double end_time = Clock::NowInSeconds();
+      heuristic_time += end_time - start_time;
+      if (is_new) {
         explored_node_num++;
-        const double start_time = Clock::NowInSeconds();
-        CalculateNodeCost(current_node, next_node);
-        const double end_time = Clock::NowInSeconds();
-        heuristic_time += end_time - start_time;
-        open_set_.emplace(next_node->GetIndex(), next_node);
-        open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
+        node_positions_.emplace(next_node->GetIndex(), nodes_.size());
+        open_pq_.Push(nodes_.size(), next_node->GetCost());
+        nodes_.push_back(next_node);
+      } else if (open_pq_.Push(position->second, next_node->GetCost())) {
+        // a cheaper way into a grid cell still in the open set replaces it
+        nodes_[position->second] = next_node;
       }
     }
   }
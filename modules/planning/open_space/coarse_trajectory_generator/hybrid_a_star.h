@@ -23,7 +23,6 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
-#include <queue>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -31,6 +30,7 @@
 #include <vector>
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_heap.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
@@ -120,17 +120,12 @@ class HybridAStar {
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
-  struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
-      return left.second >= right.second;
-    }
-  };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  // every node kept by the search, the open set queues their positions and
+  // the ones taken out of it form the close set
+  std::vector<std::shared_ptr<Node3d>> nodes_;
+  // packed grid index of a node to its position in nodes_
+  std::unordered_map<uint64_t, size_t> node_positions_;
+  IndexedHeap open_pq_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
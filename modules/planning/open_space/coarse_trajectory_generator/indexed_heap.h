@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @brief Min binary heap of dense integer ids keyed by cost. It keeps the
+ * heap position of every id, so that the cost of a queued id can be lowered
+ * in place instead of pushing a duplicate entry.
+ */
+class IndexedHeap {
+ public:
+  /**
+   * @brief Empties the heap and prepares it for ids in [0, capacity), larger
+   * ids are still accepted, the position table grows for them.
+   */
+  void Reset(const size_t capacity) {
+    heap_.clear();
+    positions_.assign(capacity, 0);
+  }
+
+  bool Empty() const { return heap_.empty(); }
+  size_t Size() const { return heap_.size(); }
+
+  bool Contains(const size_t id) const {
+    return id < positions_.size() && positions_[id] != 0;
+  }
+
+  /**
+   * @brief Queues id with cost, or lowers its cost if it is queued already.
+   * Returns false if id is queued with a cost not larger than cost.
+   */
+  bool Push(const size_t id, const double cost) {
+    if (id >= positions_.size()) {
+      positions_.resize(id + 1, 0);
+    }
+    size_t position = 0;
+    if (positions_[id] == 0) {
+      position = heap_.size();
+      heap_.emplace_back(cost, id);
+    } else if (cost < heap_[positions_[id] - 1].first) {
+      position = positions_[id] - 1;
+      heap_[position].first = cost;
+    } else {
+      return false;
+    }
+    SiftUp(position);
+    return true;
+  }
+
+  double TopCost() const { return heap_.front().first; }
+  size_t Top() const { return heap_.front().second; }
+
+  /**
+   * @brief Removes and returns the id of the lowest cost, the heap must not
+   * be empty.
+   */
+  size_t Pop() {
+    const size_t id = heap_.front().second;
+    positions_[id] = 0;
+    if (heap_.size() > 1) {
+      heap_.front() = heap_.back();
+      heap_.pop_back();
+      SiftDown(0);
+    } else {
+      heap_.pop_back();
+    }
+    return id;
+  }
+
+ private:
+  void SiftUp(size_t position) {
+    const auto entry = heap_[position];
+    while (position > 0) {
+      const size_t parent = (position - 1) / 2;
+      if (!(entry.first < heap_[parent].first)) {
+        break;
+      }
+      Place(position, heap_[parent]);
+      position = parent;
+    }
+    Place(position, entry);
+  }
+
+  void SiftDown(size_t position) {
+    const auto entry = heap_[position];
+    const size_t size = heap_.size();
+    while (true) {
+      size_t child = 2 * position + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size && heap_[child + 1].first < heap_[child].first) {
+        ++child;
+      }
+      if (!(heap_[child].first < entry.first)) {
+        break;
+      }
+      Place(position, heap_[child]);
+      position = child;
+    }
+    Place(position, entry);
+  }
+
+  void Place(const size_t position, const std::pair<double, size_t>& entry) {
+    heap_[position] = entry;
+    positions_[entry.second] = position + 1;
+  }
+
+  // cost and id
+  std::vector<std::pair<double, size_t>> heap_;
+  // heap position plus one of each id, 0 for the ids not queued
+  std::vector<size_t> positions_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_heap.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(IndexedHeapTest, PopInCostOrder) {
+  IndexedHeap heap;
+  heap.Reset(8);
+  EXPECT_TRUE(heap.Empty());
+
+  const std::vector<double> costs = {5.0, 3.0, 7.0, 1.0, 4.0, 6.0, 2.0, 0.5};
+  for (size_t id = 0; id < costs.size(); ++id) {
+    EXPECT_TRUE(heap.Push(id, costs[id]));
+  }
+  EXPECT_EQ(heap.Size(), costs.size());
+  EXPECT_EQ(heap.Top(), 7);
+  EXPECT_DOUBLE_EQ(heap.TopCost(), 0.5);
+
+  std::vector<size_t> order;
+  while (!heap.Empty()) {
+    order.push_back(heap.Pop());
+  }
+  EXPECT_EQ(order, std::vector<size_t>({7, 3, 6, 1, 4, 0, 5, 2}));
+}
+
+TEST(IndexedHeapTest, DecreaseKey) {
+  IndexedHeap heap;
+  heap.Reset(4);
+  heap.Push(0, 1.0);
+  heap.Push(1, 2.0);
+  heap.Push(2, 3.0);
+
+  // a higher cost is ignored, a lower one moves the id up
+  EXPECT_FALSE(heap.Push(2, 4.0));
+  EXPECT_EQ(heap.Size(), 3);
+  EXPECT_TRUE(heap.Push(2, 0.5));
+  EXPECT_EQ(heap.Size(), 3);
+  EXPECT_EQ(heap.Top(), 2);
+
+  EXPECT_TRUE(heap.Contains(2));
+  EXPECT_EQ(heap.Pop(), 2);
+  EXPECT_FALSE(heap.Contains(2));
+  EXPECT_FALSE(heap.Contains(3));
+
+  // an id may be queued again once popped
+  EXPECT_TRUE(heap.Push(2, 1.5));
+  EXPECT_EQ(heap.Pop(), 0);
+  EXPECT_EQ(heap.Pop(), 2);
+  EXPECT_EQ(heap.Pop(), 1);
+  EXPECT_TRUE(heap.Empty());
+}
+
+TEST(IndexedHeapTest, GrowsBeyondCapacity) {
+  IndexedHeap heap;
+  heap.Reset(0);
+  heap.Push(100, 2.0);
+  heap.Push(5, 1.0);
+  EXPECT_TRUE(heap.Contains(100));
+  EXPECT_EQ(heap.Pop(), 5);
+  EXPECT_EQ(heap.Pop(), 100);
+
+  heap.Push(1, 1.0);
+  heap.Reset(2);
+  EXPECT_TRUE(heap.Empty());
+  EXPECT_FALSE(heap.Contains(1));
+}
+
+TEST(IndexedHeapTest, RandomUpdates) {
+  const size_t id_num = 500;
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<double> distribution(0.0, 100.0);
+
+  IndexedHeap heap;
+  heap.Reset(id_num);
+  std::vector<double> costs(id_num);
+  for (size_t id = 0; id < id_num; ++id) {
+    costs[id] = distribution(generator);
+    heap.Push(id, costs[id]);
+  }
+  for (size_t i = 0; i < 2 * id_num; ++i) {
+    const size_t id = generator() % id_num;
+    const double cost = distribution(generator);
+    EXPECT_EQ(heap.Push(id, cost), cost < costs[id]);
+    costs[id] = std::min(costs[id], cost);
+  }
+
+  double last_cost = -1.0;
+  while (!heap.Empty()) {
+    const double cost = heap.TopCost();
+    const size_t id = heap.Pop();
+    EXPECT_DOUBLE_EQ(cost, costs[id]);
+    EXPECT_GE(cost, last_cost);
+    last_cost = cost;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
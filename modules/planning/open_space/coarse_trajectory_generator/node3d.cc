@@ -20,8 +20,6 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 
-#include "absl/strings/str_cat.h"
-
 namespace apollo {
 namespace planning {
 
@@ -55,7 +53,7 @@ Node3d::Node3d(double x, double y, double phi,
   traversed_y_.push_back(y);
   traversed_phi_.push_back(phi);
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
 }
 
 Node3d::Node3d(const std::vector<double>& traversed_x,
@@ -87,7 +85,7 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
   traversed_y_ = traversed_y;
   traversed_phi_ = traversed_phi;
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
   step_size_ = traversed_x.size();
 }
 
@@ -107,8 +105,11 @@ bool Node3d::operator==(const Node3d& right) const {
   return right.GetIndex() == index_;
 }
 
-std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
-  return absl::StrCat(x_grid, "_", y_grid, "_", phi_grid);
+uint64_t Node3d::ComputeIndex(int x_grid, int y_grid, int phi_grid) {
+  // 24 bits for x and y and 16 bits for phi, far beyond any open space grid
+  return (static_cast<uint64_t>(x_grid & 0xFFFFFF) << 40) |
+         (static_cast<uint64_t>(y_grid & 0xFFFFFF) << 16) |
+         static_cast<uint64_t>(phi_grid & 0xFFFF);
 }
 
 }  // namespace planning
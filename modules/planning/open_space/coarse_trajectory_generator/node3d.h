@@ -20,8 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <string>
 #include <vector>
 
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -59,7 +59,7 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
@@ -74,7 +74,7 @@ class Node3d {
   void SetSteer(double steering) { steering_ = steering; }
 
  private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid, int phi_grid);
+  static uint64_t ComputeIndex(int x_grid, int y_grid, int phi_grid);
 
  private:
   double x_ = 0.0;
@@ -87,7 +87,7 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
@@ -31,6 +31,7 @@
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 #include "modules/planning/constraint_checker/collision_checker.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
@@ -233,15 +234,20 @@ Status LatticePlanner::PlanOnReferenceLine(
 
   size_t num_lattice_traj = 0;
 
+  // the candidates are combined into the same arrays, and only the chosen one
+  // is converted to protobuf points
+  const PathArrays reference_line_arrays(*ptr_reference_line);
+  TrajectoryArrays combined_trajectory;
   while (trajectory_evaluator.has_more_trajectory_pairs()) {
     double trajectory_pair_cost =
         trajectory_evaluator.top_trajectory_pair_cost();
     auto trajectory_pair = trajectory_evaluator.next_top_trajectory_pair();
 
     // combine two 1d trajectories to one 2d trajectory
-    auto combined_trajectory = TrajectoryCombiner::Combine(
-        *ptr_reference_line, *trajectory_pair.first, *trajectory_pair.second,
-        planning_init_point.relative_time());
+    TrajectoryCombiner::Combine(reference_line_arrays, *trajectory_pair.first,
+                                *trajectory_pair.second,
+                                planning_init_point.relative_time(),
+                                &combined_trajectory);
 
     // check longitudinal and lateral acceleration
     // considering trajectory curvatures
@@ -283,9 +289,10 @@ Status LatticePlanner::PlanOnReferenceLine(
     }
 
     // put combine trajectory into debug data
-    const auto& combined_trajectory_points = combined_trajectory;
     num_lattice_traj += 1;
-    reference_line_info->SetTrajectory(combined_trajectory);
+    reference_line_info->SetTrajectory(
+        combined_trajectory.ToDiscretizedTrajectory());
+    const auto& combined_trajectory_points = reference_line_info->trajectory();
     reference_line_info->SetCost(reference_line_info->PriorityCost() +
                                  trajectory_pair_cost);
     reference_line_info->SetDrivable(true);
@@ -30,8 +30,13 @@
 namespace apollo {
 namespace planning {
 
+using apollo::common::math::PersistentOsqpSolver;
 using apollo::common::time::Clock;
 
+namespace {
+constexpr size_t kMaxFemPosOsqpSolvers = 4;
+}  // namespace
+
 DiscretePointsReferenceLineSmoother::DiscretePointsReferenceLineSmoother(
     const ReferenceLineSmootherConfig& config)
     : ReferenceLineSmoother(config) {}
@@ -159,6 +164,19 @@ bool DiscretePointsReferenceLineSmoother::FemPosSmooth(
       config_.discrete_points().fem_pos_deviation_smoothing();
 
   FemPosDeviationSmoother smoother(fem_pos_config);
+  if (FLAGS_enable_persistent_osqp_solver) {
+    if (fem_pos_osqp_solvers_.size() >= kMaxFemPosOsqpSolvers &&
+        fem_pos_osqp_solvers_.count(raw_point2d.size()) == 0) {
+      fem_pos_osqp_solvers_.clear();
+    }
+    auto& osqp_solver = fem_pos_osqp_solvers_[raw_point2d.size()];
+    if (osqp_solver == nullptr) {
+      osqp_solver.reset(new PersistentOsqpSolver());
+    }
+    smoother.set_osqp_solver(osqp_solver.get());
+  } else {
+    fem_pos_osqp_solvers_.clear();
+  }
 
   // box contraints on pos are used in fem pos smoother, thus shrink the
   // bounds by 1.0 / sqrt(2.0)
@@ -18,9 +18,11 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/persistent_osqp_solver.h"
 #include "modules/planning/proto/reference_line_smoother_config.pb.h"
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/reference_line/reference_line_smoother.h"
@@ -66,6 +68,12 @@ class DiscretePointsReferenceLineSmoother : public ReferenceLineSmoother {
   double zero_x_ = 0.0;
 
   double zero_y_ = 0.0;
+
+  // kept osqp workspaces of the fem pos smoother by number of points, its
+  // kernel and constraint matrix only depend on the number of points
+  std::unordered_map<size_t,
+                     std::unique_ptr<common::math::PersistentOsqpSolver>>
+      fem_pos_osqp_solvers_;
 };
 
 }  // namespace planning
@@ -404,6 +404,24 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+                           std::vector<SLPoint>* const sl_points) const {
+  DCHECK_NOTNULL(sl_points);
+  std::vector<double> s;
+  std::vector<double> l;
+  std::vector<double> distance;
+  if (!map_path_.GetProjections(xy_points, &s, &l, &distance)) {
+    AERROR << "Cannot get nearest points from path.";
+    return false;
+  }
+  sl_points->resize(xy_points.size());
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    (*sl_points)[i].set_s(s[i]);
+    (*sl_points)[i].set_l(l[i]);
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -641,40 +659,33 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   double end_l(std::numeric_limits<double>::lowest());
   std::vector<common::math::Vec2d> corners;
   box.GetAllCorners(&corners);
-
-  // The order must be counter-clockwise
-  std::vector<SLPoint> sl_corners;
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "Failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
-    sl_corners.push_back(std::move(sl_point));
+  const size_t num_corners = corners.size();
+
+  // The order must be counter-clockwise. The corners and the middles of the
+  // edges are projected together.
+  std::vector<common::math::Vec2d> points = corners;
+  for (size_t i = 0; i < num_corners; ++i) {
+    points.push_back((corners[i] + corners[(i + 1) % num_corners]) * 0.5);
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "Failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
   }
 
-  for (size_t i = 0; i < corners.size(); ++i) {
+  for (size_t i = 0; i < num_corners; ++i) {
     auto index0 = i;
-    auto index1 = (i + 1) % corners.size();
-    const auto& p0 = corners[index0];
-    const auto& p1 = corners[index1];
-
-    const auto p_mid = (p0 + p1) * 0.5;
-    SLPoint sl_point_mid;
-    if (!XYToSL(p_mid, &sl_point_mid)) {
-      AERROR << "Failed to get projection for point: " << p_mid.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    auto index1 = (i + 1) % num_corners;
+    const SLPoint& sl_point_mid = sl_points[num_corners + i];
 
-    Vec2d v0(sl_corners[index1].s() - sl_corners[index0].s(),
-             sl_corners[index1].l() - sl_corners[index0].l());
+    Vec2d v0(sl_points[index1].s() - sl_points[index0].s(),
+             sl_points[index1].l() - sl_points[index0].l());
 
-    Vec2d v1(sl_point_mid.s() - sl_corners[index0].s(),
-             sl_point_mid.l() - sl_corners[index0].l());
+    Vec2d v1(sl_point_mid.s() - sl_points[index0].s(),
+             sl_point_mid.l() - sl_points[index0].l());
 
-    *sl_boundary->add_boundary_point() = sl_corners[index0];
+    *sl_boundary->add_boundary_point() = sl_points[index0];
 
     // sl_point is outside of polygon; add to the vertex list
     if (v0.CrossProd(v1) < 0.0) {
@@ -707,13 +718,18 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  std::vector<common::math::Vec2d> points;
+  points.reserve(polygon.point_size());
   for (const auto& point : polygon.point()) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "Failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    points.emplace_back(point.x(), point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "Failed to get projection for polygon: "
+           << polygon.ShortDebugString() << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_points) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
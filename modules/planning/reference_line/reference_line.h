@@ -118,6 +118,11 @@ class ReferenceLine {
   bool XYToSL(const XYPoint& xy, common::SLPoint* const sl_point) const {
     return XYToSL(common::math::Vec2d(xy.x(), xy.y()), sl_point);
   }
+  /**
+   * @brief Projects all of xy_points at once, as XYToSL does for each.
+   */
+  bool XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+              std::vector<common::SLPoint>* const sl_points) const;
 
   bool GetLaneWidth(const double s, double* const lane_left_width,
                     double* const lane_right_width) const;
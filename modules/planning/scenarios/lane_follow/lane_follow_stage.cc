@@ -22,7 +22,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/math_utils.h"
@@ -34,6 +36,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/deciders/lane_change_decider/lane_change_decider.h"
@@ -116,6 +119,11 @@ Stage::StageStatus LaneFollowStage::Process(
   ADEBUG << "Number of reference lines:\t"
          << frame->mutable_reference_line_info()->size();
 
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      frame->reference_line_info().size() > 1) {
+    return PlanReferenceLinesConcurrently(planning_start_point, frame);
+  }
+
   unsigned int count = 0;
 
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -204,11 +212,99 @@ Status LaneFollowStage::PlanOnReferenceLine(
     //        << reference_line_info->IsChangeLanePath();
   }
 
+  return FinishPlanOnReferenceLine(planning_start_point, frame,
+                                   reference_line_info, ret.ok());
+}
+
+Stage::StageStatus LaneFollowStage::PlanReferenceLinesConcurrently(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  // the flags sequential planning leaves on the lines it does not reach
+  std::unordered_map<const ReferenceLineInfo*, bool> unplanned_drivable;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    unplanned_drivable[&reference_line_info] = reference_line_info.IsDrivable();
+    if (!reference_line_info.IsChangeLanePath()) {
+      reference_line_info.AddCost(kStraightForwardLineCost);
+    }
+    reference_line_infos.push_back(&reference_line_info);
+  }
+
+  std::vector<PlanningStatus> statuses;
+  const auto task_results = ExecuteTaskListOnReferenceLines(
+      frame, reference_line_infos, &statuses,
+      [this](ReferenceLineInfo* reference_line_info, const Task* task,
+             const double time_diff_ms) {
+        ADEBUG << task->Name() << " time spend: " << time_diff_ms << " ms.";
+        RecordDebugInfo(reference_line_info, task->Name(), time_diff_ms);
+      });
+
+  // by address, the lane change decider may have reordered the lines
+  std::unordered_map<const ReferenceLineInfo*, size_t> line_indexes;
+  std::vector<Status> results;
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    line_indexes[reference_line_infos[i]] = i;
+    results.push_back(FinishPlanOnReferenceLine(planning_start_point, frame,
+                                                reference_line_infos[i],
+                                                task_results[i].ok()));
+  }
+
+  // the same choice as in Process(): the line after the chosen one is not
+  // drivable, the lines after that keep the flag they had before planning
+  bool has_drivable_reference_line = false;
+  bool next_marked = false;
+  const PlanningStatus* last_status = nullptr;
+  std::vector<std::pair<bool, const ReferenceLineInfo*>> preparation_updates;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    if (has_drivable_reference_line) {
+      reference_line_info.SetDrivable(
+          next_marked ? unplanned_drivable[&reference_line_info] : false);
+      next_marked = true;
+      continue;
+    }
+    const size_t index = line_indexes[&reference_line_info];
+    last_status = &statuses[index];
+    if (!results[index].ok()) {
+      reference_line_info.SetDrivable(false);
+      continue;
+    }
+    if (!reference_line_info.IsChangeLanePath()) {
+      has_drivable_reference_line = true;
+      continue;
+    }
+    if (reference_line_info.Cost() < kStraightForwardLineCost &&
+        (LaneChangeDecider::IsClearToChangeLane(&reference_line_info) ||
+         FLAGS_enable_smarter_lane_change)) {
+      has_drivable_reference_line = true;
+      reference_line_info.SetDrivable(true);
+      preparation_updates.emplace_back(true, &reference_line_info);
+    } else {
+      reference_line_info.SetDrivable(false);
+      preparation_updates.emplace_back(false, &reference_line_info);
+    }
+  }
+
+  // the status goes on from the last line that planning one line after
+  // another would have reached, as that line left it after its last barrier
+  if (last_status != nullptr) {
+    *PlanningContext::Instance()->mutable_planning_status() = *last_status;
+  }
+  for (const auto& update : preparation_updates) {
+    LaneChangeDecider::UpdatePreparationDistance(update.first, frame,
+                                                 update.second);
+  }
+
+  return has_drivable_reference_line ? StageStatus::RUNNING
+                                     : StageStatus::ERROR;
+}
+
+Status LaneFollowStage::FinishPlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info, const bool tasks_succeeded) {
   RecordObstacleDebugInfo(reference_line_info);
 
   // check path and speed results for path or speed fallback
   reference_line_info->set_trajectory_type(ADCTrajectory::NORMAL);
-  if (!ret.ok()) {
+  if (!tasks_succeeded) {
     PlanFallbackTrajectory(planning_start_point, frame, reference_line_info);
   }
 
@@ -53,6 +53,21 @@ class LaneFollowStage : public Stage {
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
 
+  /**
+   * @brief Plans all the reference lines at the same time and then picks the
+   * drivable one the way Process() does when it plans them one by one.
+   */
+  StageStatus PlanReferenceLinesConcurrently(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  /**
+   * @brief Falls back if the tasks failed, then builds and checks the
+   * trajectory of the reference line.
+   */
+  common::Status FinishPlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info, const bool tasks_succeeded);
+
   void PlanFallbackTrajectory(
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "cyber/task/task_group.h"
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/speed_profile_generator.h"
@@ -51,25 +52,43 @@ Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
 
   name_ = ScenarioConfig::StageType_Name(config_.stage_type());
   next_stage_ = config_.stage_type();
+  task_list_ = CreateTaskList(&tasks_);
+}
+
+std::vector<Task*> Stage::CreateTaskList(
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks) const {
   std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
       config_map;
   for (const auto& task_config : config_.task_config()) {
     config_map[task_config.task_type()] = &task_config;
   }
+  std::vector<Task*> task_list;
   for (int i = 0; i < config_.task_type_size(); ++i) {
     auto task_type = config_.task_type(i);
     CHECK(config_map.find(task_type) != config_map.end())
         << "Task: " << TaskConfig::TaskType_Name(task_type)
         << " used but not configured";
-    auto iter = tasks_.find(task_type);
-    if (iter == tasks_.end()) {
+    auto iter = tasks->find(task_type);
+    if (iter == tasks->end()) {
       auto ptr = TaskFactory::CreateTask(*config_map[task_type]);
-      task_list_.push_back(ptr.get());
-      tasks_[task_type] = std::move(ptr);
+      task_list.push_back(ptr.get());
+      (*tasks)[task_type] = std::move(ptr);
     } else {
-      task_list_.push_back(iter->second.get());
+      task_list.push_back(iter->second.get());
     }
   }
+  return task_list;
+}
+
+const std::vector<Task*>& Stage::LineTaskList(size_t line_index) {
+  if (line_index == 0) {
+    return task_list_;
+  }
+  while (line_task_lists_.size() < line_index) {
+    line_tasks_.emplace_back();
+    line_task_lists_.push_back(CreateTaskList(&line_tasks_.back()));
+  }
+  return line_task_lists_[line_index - 1];
 }
 
 const std::string& Stage::Name() const { return name_; }
@@ -160,6 +179,69 @@ bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   return true;
 }
 
+std::vector<common::Status> Stage::ExecuteTaskListOnReferenceLines(
+    Frame* frame, const std::vector<ReferenceLineInfo*>& reference_line_infos,
+    std::vector<PlanningStatus>* statuses,
+    const std::function<void(ReferenceLineInfo*, const Task*, double)>&
+        after_task) {
+  const size_t line_num = reference_line_infos.size();
+  std::vector<common::Status> results(line_num, common::Status::OK());
+  statuses->assign(line_num, PlanningContext::Instance()->planning_status());
+  // create all the instances first, line_task_lists_ may grow
+  for (size_t i = 0; i < line_num; ++i) {
+    LineTaskList(i);
+  }
+  std::vector<const std::vector<Task*>*> task_lists;
+  for (size_t i = 0; i < line_num; ++i) {
+    task_lists.push_back(&LineTaskList(i));
+  }
+
+  auto run_task = [&](size_t line, Task* task) {
+    if (!results[line].ok()) {
+      return;
+    }
+    const double start_timestamp = Clock::NowInSeconds();
+    auto ret = task->Execute(frame, reference_line_infos[line]);
+    if (!ret.ok()) {
+      AERROR << "Failed to run tasks[" << task->Name()
+             << "], Error message: " << ret.error_message();
+      results[line] = ret;
+      return;
+    }
+    const double time_diff_ms =
+        (Clock::NowInSeconds() - start_timestamp) * 1000;
+    after_task(reference_line_infos[line], task, time_diff_ms);
+  };
+
+  size_t begin = 0;
+  while (begin < task_list_.size()) {
+    if (!task_list_[begin]->IsReferenceLineLocal()) {
+      // the shared instance on the shared status, as when the lines are
+      // planned one by one, each line then goes on from what it left
+      for (size_t line = 0; line < line_num; ++line) {
+        run_task(line, task_list_[begin]);
+        statuses->at(line) = PlanningContext::Instance()->planning_status();
+      }
+      ++begin;
+      continue;
+    }
+    size_t end = begin + 1;
+    while (end < task_list_.size() && task_list_[end]->IsReferenceLineLocal()) {
+      ++end;
+    }
+    cyber::ParallelFor(static_cast<size_t>(0), line_num,
+                       static_cast<size_t>(1), [&](size_t line) {
+                         PlanningContext::ScopedStatus scoped_status(
+                             &statuses->at(line));
+                         for (size_t i = begin; i < end; ++i) {
+                           run_task(line, task_lists[line]->at(i));
+                         }
+                       });
+    begin = end;
+  }
+  return results;
+}
+
 Stage::StageStatus Stage::FinishScenario() {
   next_stage_ = ScenarioConfig::NO_STAGE;
   return Stage::FINISHED;
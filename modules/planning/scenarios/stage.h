@@ -20,12 +20,14 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_status.pb.h"
 
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
@@ -86,11 +88,46 @@ class Stage {
 
   bool ExecuteTaskOnOpenSpace(Frame* frame);
 
+  /**
+   * @brief Runs the task list on each of reference_line_infos, with the lines
+   * planned at the same time on the cyber task pool.
+   *
+   * Consecutive tasks that are reference line local run on all the lines in
+   * parallel, each line with its own task instances and its own copy of the
+   * planning status. A task that is not local is a barrier: once the tasks
+   * before it finished on all the lines, it runs on them one after another,
+   * in order, on the shared planning status, so that a line sees the changes
+   * the lines before it made, as when the lines are planned one by one. Unlike
+   * then, a line also sees the changes the lines after it made in the
+   * barriers before. statuses holds the status each line left after its last
+   * barrier. A line stops at its first failed task.
+   *
+   * @param after_task called with the line, the task and the time it took in
+   *        ms after each successful task, it may only change that line.
+   * @return the result of each line, OK or the error of its failed task.
+   */
+  std::vector<common::Status> ExecuteTaskListOnReferenceLines(
+      Frame* frame, const std::vector<ReferenceLineInfo*>& reference_line_infos,
+      std::vector<PlanningStatus>* statuses,
+      const std::function<void(ReferenceLineInfo*, const Task*, double)>&
+          after_task);
+
   virtual Stage::StageStatus FinishScenario();
 
+ private:
+  std::vector<Task*> CreateTaskList(
+      std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks) const;
+
+  const std::vector<Task*>& LineTaskList(size_t line_index);
+
  protected:
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
+  // task instances of the reference lines after the first one, created when
+  // the lines are planned at the same time
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      line_tasks_;
+  std::vector<std::vector<Task*>> line_task_lists_;
   ScenarioConfig::StageConfig config_;
   ScenarioConfig::StageType next_stage_;
   void* context_ = nullptr;
@@ -35,6 +35,8 @@ class PathDecider : public Task {
   apollo::common::Status Execute(
       Frame *frame, ReferenceLineInfo *reference_line_info) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   apollo::common::Status Process(const ReferenceLineInfo *reference_line_info,
                                  const PathData &path_data,
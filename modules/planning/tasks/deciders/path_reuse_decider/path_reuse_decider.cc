@@ -32,8 +32,8 @@ using apollo::common::Status;
 using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 
-int PathReuseDecider::reusable_path_counter_ = 0;
-int PathReuseDecider::total_path_counter_ = 0;
+std::atomic<int> PathReuseDecider::reusable_path_counter_{0};
+std::atomic<int> PathReuseDecider::total_path_counter_{0};
 
 PathReuseDecider::PathReuseDecider(const TaskConfig& config)
     : Decider(config) {}
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <utility>
 #include <vector>
 
@@ -76,8 +77,9 @@ class PathReuseDecider : public Decider {
 
  private:
   History* history_ = History::Instance();
-  static int reusable_path_counter_;  // count reused path
-  static int total_path_counter_;     // count total path
+  // shared by the reference lines planned at the same time
+  static std::atomic<int> reusable_path_counter_;  // count reused path
+  static std::atomic<int> total_path_counter_;     // count total path
 };
 
 }  // namespace planning
@@ -34,6 +34,8 @@ class SpeedBoundsDecider : public Decider {
  public:
   explicit SpeedBoundsDecider(const TaskConfig& config);
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   common::Status Process(Frame* const frame,
                          ReferenceLineInfo* const reference_line_info) override;
@@ -236,19 +236,17 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-          results.push_back(
-              cyber::Async(&GriddedPathTimeGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
-        }
-      }
       if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-        for (auto& result : results) {
-          result.get();
+        // a row takes a few microseconds and a column has up to
+        // dimension_s_ rows, so rows are taken four at a time
+        cyber::ParallelFor(next_lowest_row, next_highest_row + 1, size_t(4),
+                           [this, c](size_t r) {
+                             CalculateCostAt(
+                                 std::make_shared<StGraphMessage>(c, r));
+                           });
+      } else {
+        for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
+          CalculateCostAt(std::make_shared<StGraphMessage>(c, r));
         }
       }
     }
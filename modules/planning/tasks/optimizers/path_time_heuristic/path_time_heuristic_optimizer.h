@@ -39,6 +39,8 @@ class PathTimeHeuristicOptimizer : public SpeedOptimizer {
  public:
   explicit PathTimeHeuristicOptimizer(const TaskConfig& config);
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
@@ -74,6 +74,18 @@ common::Status PiecewiseJerkPathOptimizer::Process(
       reference_line_info_->GetCandidatePathBoundaries();
   ADEBUG << "There are " << path_boundaries.size() << " path boundaries.";
 
+  // drop the solvers of the path boundaries gone since the last cycle
+  const common::math::Vec2d start_point(init_point.path_point().x(),
+                                        init_point.path_point().y());
+  for (auto iter = warm_starts_.begin(); iter != warm_starts_.end();) {
+    if (!FLAGS_enable_persistent_osqp_solver ||
+        iter->second.sequence_num + 1 < frame_->SequenceNum()) {
+      iter = warm_starts_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
   std::vector<PathData> candidate_path_data;
   for (const auto& path_boundary : path_boundaries) {
     // if the path_boundary is normal, it is possible to have less than 2 points
@@ -127,10 +139,18 @@ common::Status PiecewiseJerkPathOptimizer::Process(
       ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
     }
 
-    bool res_opt =
-        OptimizePath(init_frenet_state.second, end_state,
-                     path_boundary.delta_s(), path_boundary.boundary(),
-                     ddl_bounds, w, &opt_l, &opt_dl, &opt_ddl, max_iter);
+    WarmStart* warm_start = nullptr;
+    if (FLAGS_enable_persistent_osqp_solver) {
+      warm_start = &warm_starts_[reference_line_info_->Lanes().Id() + "/" +
+                                 path_boundary.label()];
+      ShiftWarmStart(start_point, path_boundary.delta_s(),
+                     path_boundary.boundary().size(), warm_start);
+    }
+
+    bool res_opt = OptimizePath(
+        init_frenet_state.second, end_state, path_boundary.delta_s(),
+        path_boundary.boundary(), ddl_bounds, w, &opt_l, &opt_dl, &opt_ddl,
+        max_iter, warm_start);
 
     if (res_opt) {
       for (size_t i = 0; i < path_boundary.boundary().size(); i += 4) {
@@ -165,7 +185,8 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::vector<std::pair<double, double>>& ddl_bounds,
     const std::array<double, 5>& w, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx, const int max_iter) {
+    std::vector<double>* dx, std::vector<double>* ddx, const int max_iter,
+    WarmStart* warm_start) {
   PiecewiseJerkPathProblem piecewise_jerk_problem(lat_boundaries.size(),
                                                   delta_s, init_state);
 
@@ -207,6 +228,13 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
                                                  axis_distance, max_yaw_rate);
   piecewise_jerk_problem.set_dddx_bound(jerk_bound);
 
+  if (warm_start != nullptr) {
+    piecewise_jerk_problem.set_osqp_solver(&warm_start->osqp_solver);
+    piecewise_jerk_problem.set_warm_start(
+        std::move(warm_start->l), std::move(warm_start->dl),
+        std::move(warm_start->ddl));
+  }
+
   bool success = piecewise_jerk_problem.Optimize(max_iter);
 
   auto end_time = std::chrono::system_clock::now();
@@ -222,9 +250,39 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
   *dx = piecewise_jerk_problem.opt_dx();
   *ddx = piecewise_jerk_problem.opt_ddx();
 
+  if (warm_start != nullptr) {
+    warm_start->l = *x;
+    warm_start->dl = *dx;
+    warm_start->ddl = *ddx;
+  }
   return true;
 }
 
+void PiecewiseJerkPathOptimizer::ShiftWarmStart(
+    const common::math::Vec2d& start_point, const double delta_s,
+    const size_t num_of_knots, WarmStart* warm_start) const {
+  // only a solution of the last cycle on the same knots is a good start, the
+  // knots move along with the planning start point
+  if (warm_start->sequence_num + 1 == frame_->SequenceNum() &&
+      warm_start->delta_s == delta_s && !warm_start->l.empty()) {
+    const double shift =
+        warm_start->start_point.DistanceTo(start_point) / delta_s;
+    warm_start->l =
+        PiecewiseJerkProblem::ShiftedKnots(warm_start->l, shift, num_of_knots);
+    warm_start->dl =
+        PiecewiseJerkProblem::ShiftedKnots(warm_start->dl, shift, num_of_knots);
+    warm_start->ddl = PiecewiseJerkProblem::ShiftedKnots(warm_start->ddl,
+                                                         shift, num_of_knots);
+  } else {
+    warm_start->l.clear();
+    warm_start->dl.clear();
+    warm_start->ddl.clear();
+  }
+  warm_start->sequence_num = frame_->SequenceNum();
+  warm_start->start_point = start_point;
+  warm_start->delta_s = delta_s;
+}
+
 FrenetFramePath PiecewiseJerkPathOptimizer::ToPiecewiseJerkPath(
     const std::vector<double>& x, const std::vector<double>& dx,
     const std::vector<double>& ddx, const double delta_s,
@@ -20,9 +20,13 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/persistent_osqp_solver.h"
+#include "modules/common/math/vec2d.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -34,7 +38,21 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   virtual ~PiecewiseJerkPathOptimizer() = default;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
+  // kept solver of a path boundary and its last solution, which is shifted to
+  // the knots of the next cycle to start from
+  struct WarmStart {
+    common::math::PersistentOsqpSolver osqp_solver;
+    uint32_t sequence_num = 0;
+    common::math::Vec2d start_point;
+    double delta_s = 0.0;
+    std::vector<double> l;
+    std::vector<double> dl;
+    std::vector<double> ddl;
+  };
+
   common::Status Process(const SpeedData& speed_data,
                          const ReferenceLine& reference_line,
                          const common::TrajectoryPoint& init_point,
@@ -47,7 +65,11 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
       const std::vector<std::pair<double, double>>& ddl_bounds,
       const std::array<double, 5>& w, std::vector<double>* ptr_x,
       std::vector<double>* ptr_dx, std::vector<double>* ptr_ddx,
-      const int max_iter);
+      const int max_iter, WarmStart* warm_start);
+
+  void ShiftWarmStart(const common::math::Vec2d& start_point,
+                      const double delta_s, const size_t num_of_knots,
+                      WarmStart* warm_start) const;
 
   FrenetFramePath ToPiecewiseJerkPath(const std::vector<double>& l,
                                       const std::vector<double>& dl,
@@ -58,6 +80,9 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   double EstimateJerkBoundary(const double vehicle_speed,
                               const double axis_distance,
                               const double max_steering_rate) const;
+
+  // by reference line and path boundary label
+  std::unordered_map<std::string, WarmStart> warm_starts_;
 };
 
 }  // namespace planning
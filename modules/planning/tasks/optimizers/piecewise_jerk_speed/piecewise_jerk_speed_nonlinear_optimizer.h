@@ -35,6 +35,8 @@ class PiecewiseJerkSpeedNonlinearOptimizer : public SpeedOptimizer {
 
   virtual ~PiecewiseJerkSpeedNonlinearOptimizer() = default;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
@@ -32,14 +32,13 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/st_graph_data.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
 
 namespace apollo {
 namespace planning {
 
 using apollo::common::ErrorCode;
-using apollo::common::PathPoint;
-using apollo::common::SpeedPoint;
 using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
 
@@ -57,7 +56,7 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   }
 
   CHECK(speed_data != nullptr);
-  SpeedData reference_speed_data = *speed_data;
+  const SpeedArrays reference_speed_data(*speed_data);
 
   if (path_data.discretized_path().empty()) {
     std::string msg("Empty path data");
@@ -144,16 +143,21 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   std::vector<double> penalty_dx;
   std::vector<std::pair<double, double>> s_dot_bounds;
   const SpeedLimit& speed_limit = st_graph_data.speed_limit();
+  std::vector<double> knot_times(num_of_knots);
   for (int i = 0; i < num_of_knots; ++i) {
-    double curr_t = i * delta_t;
-    // get path_s
-    SpeedPoint sp;
-    reference_speed_data.EvaluateByTime(curr_t, &sp);
-    const double path_s = sp.s();
+    knot_times[i] = i * delta_t;
+  }
+  // get path_s, a time out of the reference profile is at s = 0
+  SpeedArrays reference_speed_points;
+  reference_speed_data.EvaluateByTime(knot_times, &reference_speed_points);
+  // get curvature
+  PathArrays path_points;
+  PathArrays(path_data.discretized_path())
+      .Evaluate(reference_speed_points.s, &path_points);
+  for (int i = 0; i < num_of_knots; ++i) {
+    const double path_s = reference_speed_points.s[i];
     x_ref.emplace_back(path_s);
-    // get curvature
-    PathPoint path_point = path_data.GetPathPointWithPathS(path_s);
-    penalty_dx.push_back(std::fabs(path_point.kappa()) *
+    penalty_dx.push_back(std::fabs(path_points.kappa[i]) *
                          piecewise_jerk_speed_config.kappa_penalty_weight());
     // get v_upper_bound
     const double v_lower_bound = 0.0;
@@ -166,6 +170,26 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_penalty_dx(penalty_dx);
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
 
+  // drop the solvers of the reference lines gone since the last cycle
+  for (auto iter = warm_starts_.begin(); iter != warm_starts_.end();) {
+    if (!FLAGS_enable_persistent_osqp_solver ||
+        iter->second.sequence_num + 1 < frame_->SequenceNum()) {
+      iter = warm_starts_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  WarmStart* warm_start = nullptr;
+  if (FLAGS_enable_persistent_osqp_solver) {
+    warm_start = &warm_starts_[reference_line_info_->Lanes().Id()];
+    ShiftWarmStart({init_point.path_point().x(), init_point.path_point().y()},
+                   num_of_knots, warm_start);
+    piecewise_jerk_problem.set_osqp_solver(&warm_start->osqp_solver);
+    piecewise_jerk_problem.set_warm_start(std::move(warm_start->s),
+                                          std::move(warm_start->ds),
+                                          std::move(warm_start->dds));
+  }
+
   // Solve the problem
   if (!piecewise_jerk_problem.Optimize()) {
     std::string msg("Piecewise jerk speed optimizer failed!");
@@ -178,6 +202,11 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   const std::vector<double>& s = piecewise_jerk_problem.opt_x();
   const std::vector<double>& ds = piecewise_jerk_problem.opt_dx();
   const std::vector<double>& dds = piecewise_jerk_problem.opt_ddx();
+  if (warm_start != nullptr) {
+    warm_start->s = s;
+    warm_start->ds = ds;
+    warm_start->dds = dds;
+  }
   for (int i = 0; i < num_of_knots; ++i) {
     ADEBUG << "For t[" << i * delta_t << "], s = " << s[i] << ", v = " << ds[i]
            << ", a = " << dds[i];
@@ -197,5 +226,41 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   return Status::OK();
 }
 
+void PiecewiseJerkSpeedOptimizer::ShiftWarmStart(
+    const common::math::Vec2d& start_point, const size_t num_of_knots,
+    WarmStart* warm_start) const {
+  if (warm_start->sequence_num + 1 != frame_->SequenceNum() ||
+      warm_start->s.size() != num_of_knots) {
+    warm_start->s.clear();
+    warm_start->ds.clear();
+    warm_start->dds.clear();
+  } else {
+    // the new profile starts where the last one reaches the new start point
+    const double travelled_s = warm_start->start_point.DistanceTo(start_point);
+    const auto& last_s = warm_start->s;
+    double shift = static_cast<double>(num_of_knots - 1);
+    for (size_t i = 1; i < num_of_knots; ++i) {
+      if (last_s[i] >= travelled_s) {
+        const double segment_s = last_s[i] - last_s[i - 1];
+        shift = static_cast<double>(i - 1) +
+                (segment_s > 0.0 ? (travelled_s - last_s[i - 1]) / segment_s
+                                 : 0.0);
+        break;
+      }
+    }
+    warm_start->s =
+        PiecewiseJerkProblem::ShiftedKnots(last_s, shift, num_of_knots);
+    for (auto& s : warm_start->s) {
+      s = std::fmax(s - travelled_s, 0.0);
+    }
+    warm_start->ds =
+        PiecewiseJerkProblem::ShiftedKnots(warm_start->ds, shift, num_of_knots);
+    warm_start->dds = PiecewiseJerkProblem::ShiftedKnots(warm_start->dds,
+                                                         shift, num_of_knots);
+  }
+  warm_start->sequence_num = frame_->SequenceNum();
+  warm_start->start_point = start_point;
+}
+
 }  // namespace planning
 }  // namespace apollo
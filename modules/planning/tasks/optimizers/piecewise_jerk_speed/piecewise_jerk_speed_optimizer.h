@@ -20,6 +20,12 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/persistent_osqp_solver.h"
+#include "modules/common/math/vec2d.h"
 #include "modules/planning/tasks/optimizers/speed_optimizer.h"
 
 namespace apollo {
@@ -31,10 +37,29 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
 
   virtual ~PiecewiseJerkSpeedOptimizer() = default;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
+  // kept solver of a reference line and its last solution, which is shifted
+  // to the time and station of the next cycle to start from
+  struct WarmStart {
+    common::math::PersistentOsqpSolver osqp_solver;
+    uint32_t sequence_num = 0;
+    common::math::Vec2d start_point;
+    std::vector<double> s;
+    std::vector<double> ds;
+    std::vector<double> dds;
+  };
+
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
                          SpeedData* const speed_data) override;
+
+  void ShiftWarmStart(const common::math::Vec2d& start_point,
+                      const size_t num_of_knots, WarmStart* warm_start) const;
+
+  // by reference line
+  std::unordered_map<std::string, WarmStart> warm_starts_;
 };
 
 }  // namespace planning
@@ -150,7 +150,7 @@ bool DpRoadGraph::GenerateMinCostPath(
     const auto &level_points = path_waypoints[level];
 
     graph_nodes.emplace_back();
-    std::vector<std::future<void>> results;
+    std::vector<std::shared_ptr<RoadGraphMessage>> msgs;
 
     for (size_t i = 0; i < level_points.size(); ++i) {
       const auto &cur_point = level_points[i];
@@ -162,15 +162,16 @@ bool DpRoadGraph::GenerateMinCostPath(
           &(graph_nodes.back().back()));
 
       if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        results.emplace_back(cyber::Async(&DpRoadGraph::UpdateNode, this, msg));
+        msgs.emplace_back(std::move(msg));
       } else {
         UpdateNode(msg);
       }
     }
     if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-      for (auto &result : results) {
-        result.get();
-      }
+      // a level has a few nodes and each one evaluates a curve from every
+      // node of the level before, so every node is a task
+      cyber::ParallelFor(size_t(0), msgs.size(), size_t(1),
+                         [this, &msgs](size_t i) { UpdateNode(msgs[i]); });
     }
   }
 
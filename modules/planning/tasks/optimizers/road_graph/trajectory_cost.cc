@@ -29,6 +29,7 @@
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/trajectory/trajectory_arrays.h"
 
 namespace apollo {
 namespace planning {
@@ -50,15 +51,29 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
       reference_line_(&reference_line),
       is_change_lane_path_(is_change_lane_path),
       vehicle_param_(vehicle_param),
-      heuristic_speed_data_(heuristic_speed_data),
       init_sl_point_(init_sl_point),
       adc_sl_boundary_(adc_sl_boundary) {
   const double total_time =
-      std::min(heuristic_speed_data_.TotalTime(), FLAGS_prediction_total_time);
+      std::min(heuristic_speed_data.TotalTime(), FLAGS_prediction_total_time);
 
   num_of_time_stamps_ = static_cast<uint32_t>(
       std::floor(total_time / config.eval_time_interval()));
 
+  std::vector<double> time_stamps;
+  double time_stamp = 0.0;
+  for (uint32_t i = 0; i < num_of_time_stamps_;
+       ++i, time_stamp += config.eval_time_interval()) {
+    time_stamps.push_back(time_stamp);
+  }
+  // a time stamp out of the profile is at s = 0, as before
+  SpeedArrays heuristic_speed;
+  SpeedArrays(heuristic_speed_data)
+      .EvaluateByTime(time_stamps, &heuristic_speed);
+  heuristic_ref_s_ = std::move(heuristic_speed.s);
+  for (auto &ref_s : heuristic_ref_s_) {
+    ref_s += init_sl_point_.s();
+  }
+
   for (const auto *ptr_obstacle : obstacles) {
     if (ptr_obstacle->IsIgnore()) {
       continue;
@@ -210,12 +225,8 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     return obstacle_cost;
   }
 
-  double time_stamp = 0.0;
-  for (size_t index = 0; index < num_of_time_stamps_;
-       ++index, time_stamp += config_.eval_time_interval()) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    double ref_s = speed_point.s() + init_sl_point_.s();
+  for (size_t index = 0; index < num_of_time_stamps_; ++index) {
+    const double ref_s = heuristic_ref_s_[index];
     if (ref_s < start_s) {
       continue;
     }
@@ -81,10 +81,12 @@ class TrajectoryCost {
   const ReferenceLine *reference_line_ = nullptr;
   bool is_change_lane_path_ = false;
   const common::VehicleParam vehicle_param_;
-  SpeedData heuristic_speed_data_;
   const common::SLPoint init_sl_point_;
   const SLBoundary adc_sl_boundary_;
   uint32_t num_of_time_stamps_ = 0;
+  // reference line s of the heuristic speed profile at each time stamp, the
+  // same for all the curves
+  std::vector<double> heuristic_ref_s_;
   std::vector<std::vector<common::math::Box2d>> dynamic_obstacle_boxes_;
   std::vector<double> obstacle_probabilities_;
 
@@ -75,6 +75,8 @@ class RssDecider : public Task {
   apollo::common::Status Execute(
       Frame *frame, ReferenceLineInfo *reference_line_info) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   apollo::common::Status Process(Frame *frame,
                                  ReferenceLineInfo *reference_line_info);
@@ -46,6 +46,15 @@ class Task {
 
   virtual common::Status Execute(Frame* frame);
 
+  /**
+   * @brief Whether the task can run on several reference lines at the same
+   * time, each line with its own instance. Such a task only changes the
+   * reference line it is executed on, reads the planning status without
+   * changing it and changes no global state such as the flags. A task only
+   * returns true once it was checked to be so.
+   */
+  virtual bool IsReferenceLineLocal() const { return false; }
+
  protected:
   Frame* frame_ = nullptr;
   ReferenceLineInfo* reference_line_info_ = nullptr;